@@ -116,6 +116,7 @@ void MainApp_Task(void* params) {
         InParallel(sA, sB, r1), 
         ExecutionMode::StaticNetwork
     ); 
+    os::exitSelf(); // The network runs on threads of its own
 }
 
 void RunProcessingChainTest(void) {
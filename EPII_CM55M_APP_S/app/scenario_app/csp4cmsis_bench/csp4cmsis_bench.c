@@ -0,0 +1,78 @@
+#include "csp4cmsis_bench.h"
+
+#if !defined(RTOS2_RTX)
+#define FREERTOS
+#endif
+
+#ifdef FREERTOS
+/* FreeRTOS kernel includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#else
+/* CMSIS-RTOS2 (RTX5) kernel, selected with CSP4CMSIS_OS=rtos2_rtx. */
+#include "cmsis_os2.h"
+#endif
+
+#ifdef TRUSTZONE_SEC
+#if (__ARM_FEATURE_CMSE & 1) == 0
+#error "Need ARMv8-M security extensions"
+#elif (__ARM_FEATURE_CMSE & 2) == 0
+#error "Compile with --cmse"
+#endif
+#include "arm_cmse.h"
+#ifdef NSC
+#include "veneer_table.h"
+#endif
+/* Trustzone config. */
+
+#ifndef TRUSTZONE_SEC_ONLY
+/* FreeRTOS includes. */
+#include "secure_port_macros.h"
+#endif
+#endif
+
+#ifdef FREERTOS
+/* Task priorities. */
+#define hello_task1_PRIORITY	(configMAX_PRIORITIES - 1)
+#define hello_task2_PRIORITY	(configMAX_PRIORITIES - 1)
+#endif
+
+#include "xprintf.h"
+
+extern void csp_app_main_init(void);
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+//static void hello_task1(void *pvParameters);
+//static void hello_task2(void *pvParameters);
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+int app_main(void)
+{
+    printf("Task creation C++ CSP wrapper test.\r\n");
+
+#ifdef FREERTOS
+    // CALL THE C++ INITIALIZATION FUNCTION
+    csp_app_main_init();
+
+    vTaskStartScheduler();
+#else
+    // RTX objects can only be created once the kernel is initialised.
+    osKernelInitialize();
+    csp_app_main_init();
+    osKernelStart();
+#endif
+
+    // Should never return
+    //for (;;);
+}
+
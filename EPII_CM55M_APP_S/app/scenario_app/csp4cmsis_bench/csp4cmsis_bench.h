@@ -0,0 +1,19 @@
+/*
+ * hello_world.h
+ *
+ *  Created on: Dec 3, 2020
+ *      Author: 902447
+ */
+
+#ifndef SCENARIO_APP_HELLO_WORLD_HELLO_WORLD_H_
+#define SCENARIO_APP_HELLO_WORLD_HELLO_WORLD_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "WE2_device.h"
+#include "WE2_core.h"
+#include "board.h"
+
+int app_main(void);
+
+#endif /* SCENARIO_APP_HELLO_WORLD_HELLO_WORLD_H_ */
@@ -0,0 +1,457 @@
+#include "csp/csp4cmsis.h"
+#include "csp/bench.h"
+#include <cstdio>
+#include <utility>
+
+using namespace csp;
+
+// --- Configuration ---
+#define BENCH_SAMPLES 1000   // Measured iterations per result
+#define BENCH_WARMUP 50      // Discarded iterations before measuring
+#define SPAWN_SAMPLES 200    // Run() round trips per spawn/join result
+#define TIMEOUT_SAMPLES 100  // Expiries per timer-guard firing result
+
+static const char* const SUITE = "csp4cmsis_bench";
+
+// Shared by whichever process takes the measurements of the current benchmark.
+static bench::SampleBuffer<BENCH_SAMPLES> samples;
+
+static inline uint32_t now() { return internal::cycleCount(); }
+
+/**
+ * @brief Lets the idle task reclaim the stacks of processes that just
+ * terminated before the next benchmark spawns new ones.
+ */
+static void settle() {
+    os::delay(Milliseconds(10).to_ticks());
+}
+
+/**
+ * @brief Overwriting channel container (the library has none in the public API).
+ */
+template <typename T, size_t SIZE>
+class OverwritingOne2OneChannel {
+private:
+    internal::OverwritingChannel<T> internal_chan;
+public:
+    OverwritingOne2OneChannel() : internal_chan(SIZE) {}
+
+    Chanout<T> writer() { return Chanout<T>(&internal_chan); }
+    Chanin<T> reader() { return Chanin<T>(&internal_chan); }
+};
+
+// =============================================================
+// 1. Ping-Pong Latency per Channel Kind
+// =============================================================
+
+/**
+ * @brief Sends a value and waits for it to come back; one sample per round trip.
+ */
+template <typename T>
+class Ping : public CSProcess {
+private:
+    Chanout<T> out;
+    Chanin<T> in;
+public:
+    Ping(Chanout<T> w, Chanin<T> r) : out(w), in(r) {}
+    const char* name() const override { return "Ping"; }
+
+    void run() override {
+        T value{};
+        for (int i = 0; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+            uint32_t start = now();
+            out << value;
+            in >> value;
+            if (i >= BENCH_WARMUP) samples.add(now() - start);
+        }
+    }
+};
+
+template <typename T>
+class Pong : public CSProcess {
+private:
+    Chanin<T> in;
+    Chanout<T> out;
+public:
+    Pong(Chanin<T> r, Chanout<T> w) : in(r), out(w) {}
+    const char* name() const override { return "Pong"; }
+
+    void run() override {
+        T value{};
+        for (int i = 0; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+            in >> value;
+            out << value;
+        }
+    }
+};
+
+template <typename T, typename CHANNEL>
+static void benchPingPong(const char* variant, CHANNEL& there, CHANNEL& back) {
+    samples.reset();
+    Ping<T> ping(there.writer(), back.reader());
+    Pong<T> pong(there.reader(), back.writer());
+    Run(InParallel(ping, pong));
+    bench::report("pingpong", variant, 0, samples.summarize());
+    settle();
+}
+
+static void benchPingPongAll() {
+    static Channel<int> rv_there, rv_back;
+    benchPingPong<int>("rendezvous", rv_there, rv_back);
+
+    static BufferedOne2OneChannel<int, 1> buf_there, buf_back;
+    benchPingPong<int>("buffered", buf_there, buf_back);
+
+    static OverwritingOne2OneChannel<int, 1> ow_there, ow_back;
+    benchPingPong<int>("overwriting", ow_there, ow_back);
+
+    static DeadlineOne2OneChannel<int> dl_there(StalePolicy::Deliver), dl_back(StalePolicy::Deliver);
+    benchPingPong<FrameToken<int>>("deadline", dl_there, dl_back);
+}
+
+// =============================================================
+// 2./4. Streaming Throughput: Pipeline Depth, Buffer Capacity
+// =============================================================
+
+static const int STREAM_ITEMS = BENCH_WARMUP + BENCH_SAMPLES;
+
+// KIND selects type-erased (AnyChannel) or statically typed channel ends (section 8).
+template <typename KIND = AnyChannel>
+class Source : public CSProcess {
+private:
+    Chanout<int, KIND> out;
+public:
+    Source(Chanout<int, KIND> w) : out(w) {}
+    const char* name() const override { return "Source"; }
+
+    void run() override {
+        for (int i = 0; i < STREAM_ITEMS; ++i) out << i;
+    }
+};
+
+template <typename KIND = AnyChannel>
+class Relay : public CSProcess {
+private:
+    Chanin<int, KIND> in;
+    Chanout<int, KIND> out;
+public:
+    Relay(Chanin<int, KIND> r, Chanout<int, KIND> w) : in(r), out(w) {}
+    const char* name() const override { return "Relay"; }
+
+    void run() override {
+        int x;
+        for (int i = 0; i < STREAM_ITEMS; ++i) {
+            in >> x;
+            out << x;
+        }
+    }
+};
+
+/**
+ * @brief Records the inter-arrival time of every item: cycles per item at steady state.
+ */
+template <typename KIND = AnyChannel>
+class Sink : public CSProcess {
+private:
+    Chanin<int, KIND> in;
+public:
+    Sink(Chanin<int, KIND> r) : in(r) {}
+    const char* name() const override { return "Sink"; }
+
+    void run() override {
+        int x;
+        in >> x;
+        uint32_t last = now();
+        for (int i = 1; i < STREAM_ITEMS; ++i) {
+            in >> x;
+            uint32_t t = now();
+            if (i > BENCH_WARMUP) samples.add(t - last);
+            last = t;
+        }
+    }
+};
+
+template <size_t DEPTH, size_t... I>
+static void benchPipeline(std::index_sequence<I...>) {
+    static Channel<int> channels[DEPTH + 1];
+
+    samples.reset();
+    Sink<> sink(channels[DEPTH].reader());
+    Source<> source(channels[0].writer());
+    Relay<> relays[DEPTH] = { Relay<>(channels[I].reader(), channels[I + 1].writer())... };
+    Run(InParallel(sink, source, relays[I]...));
+    bench::report("pipeline", "rendezvous", DEPTH, samples.summarize());
+    settle();
+}
+
+template <size_t CAPACITY>
+static void benchBuffered() {
+    static BufferedOne2OneChannel<int, CAPACITY> channel;
+
+    samples.reset();
+    Sink<> sink(channel.reader());
+    Source<> source(channel.writer());
+    Run(InParallel(sink, source));
+    bench::report("buffered", "fifo", CAPACITY, samples.summarize());
+    settle();
+}
+
+// =============================================================
+// 3. Fan-In ALT Cost versus Guard Count
+// =============================================================
+
+class Writer : public CSProcess {
+private:
+    Chanout<int> out;
+    int count;
+public:
+    Writer(Chanout<int> w, int n) : out(w), count(n) {}
+    const char* name() const override { return "Writer"; }
+
+    void run() override {
+        for (int i = 0; i < count; ++i) out << i;
+    }
+};
+
+/**
+ * @brief Fair ALT over GUARDS always-ready writers; one sample per fairSelect().
+ */
+template <size_t GUARDS>
+class FanInReader : public CSProcess {
+private:
+    Channel<int>* channels;
+    int total;
+
+    template <size_t... I>
+    void select(std::index_sequence<I...>) {
+        Chanin<int> ins[GUARDS] = { channels[I].reader()... };
+        int values[GUARDS];
+        Alternative alt((ins[I] | values[I])...);
+
+        for (int i = 0; i < total; ++i) {
+            uint32_t start = now();
+            alt.fairSelect();
+            if (i >= BENCH_WARMUP) samples.add(now() - start);
+        }
+    }
+
+public:
+    FanInReader(Channel<int>* c, int n) : channels(c), total(n) {}
+    const char* name() const override { return "FanIn"; }
+
+    void run() override { select(std::make_index_sequence<GUARDS>{}); }
+};
+
+template <size_t GUARDS, size_t... I>
+static void benchFanIn(std::index_sequence<I...>) {
+    static Channel<int> channels[GUARDS];
+    // Every writer delivers the same share, so all of them terminate.
+    const int per_writer = (BENCH_WARMUP + BENCH_SAMPLES + GUARDS - 1) / GUARDS;
+
+    samples.reset();
+    FanInReader<GUARDS> reader(channels, per_writer * GUARDS);
+    Writer writers[GUARDS] = { Writer(channels[I].writer(), per_writer)... };
+    Run(InParallel(reader, writers[I]...));
+    bench::report("fanin_alt", "fair", GUARDS, samples.summarize());
+    settle();
+}
+
+// =============================================================
+// 5. Barrier Sync Cost versus Party Count
+// =============================================================
+
+class BarrierParty : public CSProcess {
+private:
+    Barrier& barrier;
+    bool measure;
+public:
+    BarrierParty(Barrier& b, bool m) : barrier(b), measure(m) {}
+    const char* name() const override { return "Party"; }
+
+    void run() override {
+        for (int i = 0; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+            uint32_t start = now();
+            barrier.sync();
+            if (measure && i >= BENCH_WARMUP) samples.add(now() - start);
+        }
+    }
+};
+
+template <size_t PARTIES, size_t... I>
+static void benchBarrier(std::index_sequence<I...>) {
+    Barrier barrier(PARTIES);
+
+    samples.reset();
+    BarrierParty parties[PARTIES] = { BarrierParty(barrier, I == 0)... };
+    Run(InParallel(parties[I]...));
+    bench::report("barrier", "sync", PARTIES, samples.summarize());
+    settle();
+}
+
+// =============================================================
+// 6. Timer-Guard Overhead
+// =============================================================
+
+/**
+ * @brief priSelect() over an always-ready channel, with or without an armed
+ * (never expiring) timeout guard: the difference is the arm/disarm cost.
+ */
+class TimedReader : public CSProcess {
+private:
+    Chanin<int> in;
+    bool with_timer;
+public:
+    TimedReader(Chanin<int> r, bool t) : in(r), with_timer(t) {}
+    const char* name() const override { return "TimedReader"; }
+
+    void run() override {
+        int value;
+        RelTimeoutGuard timeout(Seconds(10));
+        Alternative plain(in | value);
+        Alternative timed(in | value, timeout);
+        Alternative& alt = with_timer ? timed : plain;
+
+        for (int i = 0; i < BENCH_WARMUP + BENCH_SAMPLES; ++i) {
+            uint32_t start = now();
+            alt.priSelect();
+            if (i >= BENCH_WARMUP) samples.add(now() - start);
+        }
+    }
+};
+
+static void benchTimerGuard(bool with_timer) {
+    static Channel<int> channel;
+
+    samples.reset();
+    TimedReader reader(channel.reader(), with_timer);
+    Writer writer(channel.writer(), BENCH_WARMUP + BENCH_SAMPLES);
+    Run(InParallel(reader, writer));
+    bench::report("timer_guard", with_timer ? "channel+timeout" : "channel", 0, samples.summarize());
+    settle();
+}
+
+/**
+ * @brief A lone one-tick timeout guard: cycles from priSelect() to its return.
+ * Up to one tick of this is the wait for the next tick boundary.
+ */
+static void benchTimeoutExpiry() {
+    RelTimeoutGuard timeout(Time(1));
+    Alternative alt(timeout);
+
+    samples.reset();
+    for (int i = 0; i < TIMEOUT_SAMPLES; ++i) {
+        uint32_t start = now();
+        alt.priSelect();
+        samples.add(now() - start);
+    }
+    bench::report("timer_guard", "expiry", 1, samples.summarize());
+    settle();
+}
+
+// =============================================================
+// 7. Process Spawn/Join Cost
+// =============================================================
+
+class Empty : public CSProcess {
+public:
+    const char* name() const override { return "Empty"; }
+    void run() override {}
+};
+
+/**
+ * @brief Run(InParallel(...)) of SPAWNED + 1 empty processes: the first runs
+ * on the caller's stack, the others are spawned as tasks and joined.
+ */
+template <size_t SPAWNED, size_t... I>
+static void benchSpawnJoin(std::index_sequence<I...>) {
+    Empty first;
+    Empty others[SPAWNED];
+
+    samples.reset();
+    for (int i = 0; i < SPAWN_SAMPLES; ++i) {
+        uint32_t start = now();
+        Run(InParallel(first, others[I]...));
+        samples.add(now() - start);
+        // Terminated tasks are freed by the idle task; keep the heap flat.
+        os::delay(1);
+    }
+    bench::report("spawn_join", "run_in_parallel", SPAWNED, samples.summarize());
+    settle();
+}
+
+// =============================================================
+// 8. Type-Erased versus Static Channel Ends
+// =============================================================
+
+/**
+ * @brief Source -> Relay -> Sink over two channels, once with type-erased
+ * ends (virtual input/output) and once with statically typed ends the
+ * compiler can inline: cycles per item at steady state, i.e. per handshake
+ * of the relay loop.
+ */
+template <typename KIND, typename CHANNEL>
+static void benchEnds(const char* variant, CHANNEL& first, CHANNEL& second) {
+    samples.reset();
+    Sink<KIND> sink(second.template reader<KIND>());
+    Source<KIND> source(first.template writer<KIND>());
+    Relay<KIND> relay(first.template reader<KIND>(), second.template writer<KIND>());
+    Run(InParallel(sink, source, relay));
+    bench::report("ends", variant, 1, samples.summarize());
+    settle();
+}
+
+static void benchEndsAll() {
+    static Channel<int> rv_first, rv_second;
+    benchEnds<AnyChannel>("rendezvous_erased", rv_first, rv_second);
+    benchEnds<RendezvousTag>("rendezvous_static", rv_first, rv_second);
+
+    static BufferedOne2OneChannel<int, 4> buf_first, buf_second;
+    benchEnds<AnyChannel>("buffered_erased", buf_first, buf_second);
+    benchEnds<BufferedTag>("buffered_static", buf_first, buf_second);
+}
+
+// =============================================================
+// Main Benchmark Task
+// =============================================================
+
+void Bench_Task(void* params) {
+    os::delay(Milliseconds(500).to_ticks());
+    bench::printHeader(SUITE);
+
+    benchPingPongAll();
+
+    benchPipeline<1>(std::make_index_sequence<1>{});
+    benchPipeline<2>(std::make_index_sequence<2>{});
+    benchPipeline<4>(std::make_index_sequence<4>{});
+    benchPipeline<8>(std::make_index_sequence<8>{});
+
+    benchFanIn<1>(std::make_index_sequence<1>{});
+    benchFanIn<2>(std::make_index_sequence<2>{});
+    benchFanIn<4>(std::make_index_sequence<4>{});
+    benchFanIn<8>(std::make_index_sequence<8>{});
+
+    benchBuffered<1>();
+    benchBuffered<4>();
+    benchBuffered<16>();
+    benchBuffered<64>();
+
+    benchBarrier<2>(std::make_index_sequence<2>{});
+    benchBarrier<4>(std::make_index_sequence<4>{});
+    benchBarrier<8>(std::make_index_sequence<8>{});
+
+    benchTimerGuard(false);
+    benchTimerGuard(true);
+    benchTimeoutExpiry();
+
+    benchSpawnJoin<1>(std::make_index_sequence<1>{});
+    benchSpawnJoin<3>(std::make_index_sequence<3>{});
+
+    benchEndsAll();
+
+    bench::printFooter(SUITE);
+    os::exitSelf();
+}
+
+extern "C" void RunProcessingChainTest(void) {
+    os::spawn(Bench_Task, NULL, "BenchMain", 2048, CSP_OS_PRIORITY_IDLE + 3);
+}
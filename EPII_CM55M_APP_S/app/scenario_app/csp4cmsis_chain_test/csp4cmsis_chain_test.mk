@@ -38,6 +38,19 @@ override APPL_DEFINES += -DCSP4CMSIS_CHAIN_TEST
 override APPL_DEFINES += -DconfigENABLE_MPU=0
 override APPL_DEFINES += -DconfigENABLE_TRUSTZONE=0
 
+# Channel event trace of the first items through the chain, dumped over UART
+# once the receiver is done. Convert the log with
+# library/csp4cmsis/tools/csp_trace_to_chrome.py and open it in Perfetto.
+# Enable with: make CSP4CMSIS_TRACE=1
+CSP4CMSIS_TRACE ?= 0
+override APPL_DEFINES += -DCSP4CMSIS_TRACE=$(CSP4CMSIS_TRACE)
+
+# Stack canary of N words below every process stack, checked when a process
+# returns and by the PrintFootprint() report at the end of the run.
+# Enable with: make CSP4CMSIS_STACK_CANARY=4
+CSP4CMSIS_STACK_CANARY ?= 0
+override APPL_DEFINES += -DCSP4CMSIS_STACK_CANARY=$(CSP4CMSIS_STACK_CANARY)
+
 # -------------------------------------------------------------------------
 # 5. SOURCE FILES (C and C++)
 # -------------------------------------------------------------------------
@@ -21,6 +21,8 @@ private:
 public:
     CountingSender(Chanout<int> w) : out(w) {}
 
+    const char* name() const override { return "Sender"; }
+
     void run() override {
         printf("[Sender] Starting stream...\r\n");
         for (int i = 1; i <= TEST_ITERATIONS; ++i) {
@@ -47,6 +49,8 @@ public:
     Relay(Chanin<int> r, Chanout<int> w, int relay_id) 
         : in(r), out(w), id(relay_id) {}
 
+    const char* name() const override { return "Relay"; }
+
     void run() override {
         int data;
         while (true) {
@@ -66,6 +70,8 @@ private:
 public:
     CheckerReceiver(Chanin<int> r) : in(r) {}
 
+    const char* name() const override { return "Receiver"; }
+
     void run() override {
         int received;
         bool success = true;
@@ -84,6 +90,12 @@ public:
             printf("[Receiver] SUCCESS: All %d values verified through %d relays.\r\n", 
                    TEST_ITERATIONS, NUM_RELAYS);
         }
+#if CSP4CMSIS_TRACE
+        // The ring holds the start of the stream: the schedule of the whole chain.
+        TraceDump();
+#endif
+        // Every stage has been through its steady state: measured stack peaks.
+        PrintFootprint();
         while (true) {
             vTaskDelay(portMAX_DELAY); 
         }
@@ -115,6 +127,23 @@ void MainApp_Task(void* params) {
         Relay(channels[4].reader(), channels[5].writer(), 4)
     };
 
+    /**
+     * Declared channel graph, used by the priority analysis pass.
+     * SinkFirst lets each stage drain its output before the upstream
+     * stage produces the next item.
+     */
+    static Topology topology;
+    topology.connect(sender, relays[0])
+            .connect(relays[0], relays[1])
+            .connect(relays[1], relays[2])
+            .connect(relays[2], relays[3])
+            .connect(relays[3], relays[4])
+            .connect(relays[4], receiver);
+
+#if CSP4CMSIS_TRACE
+    TraceStart(TraceMode::OneShot);
+#endif
+
     /**
      * SPN Execution: 
      * We compose all processes in Parallel.
@@ -130,8 +159,11 @@ void MainApp_Task(void* params) {
             relays[4],
             receiver
         ),
-        ExecutionMode::StaticNetwork
+        ExecutionMode::StaticNetwork,
+        PriorityPolicy::SinkFirst,
+        topology
     );
+    os::exitSelf(); // The network runs on threads of its own
 }
 
 void RunProcessingChainTest(void) {
@@ -1,6 +1,8 @@
 #include "csp4cmsis_comstime.h"
 
+#if !defined(RTOS2_RTX)
 #define FREERTOS
+#endif
 
 #ifdef FREERTOS
 /* FreeRTOS kernel includes. */
@@ -8,6 +10,9 @@
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#else
+/* CMSIS-RTOS2 (RTX5) kernel, selected with CSP4CMSIS_OS=rtos2_rtx. */
+#include "cmsis_os2.h"
 #endif
 
 #ifdef TRUSTZONE_SEC
@@ -28,9 +33,11 @@
 #endif
 #endif
 
+#ifdef FREERTOS
 /* Task priorities. */
 #define hello_task1_PRIORITY	(configMAX_PRIORITIES - 1)
 #define hello_task2_PRIORITY	(configMAX_PRIORITIES - 1)
+#endif
 
 #include "xprintf.h"
 
@@ -53,10 +60,17 @@ int app_main(void)
 {
     printf("Task creation C++ CSP wrapper test.\r\n");
 
+#ifdef FREERTOS
     // CALL THE C++ INITIALIZATION FUNCTION
     csp_app_main_init();
 
     vTaskStartScheduler();
+#else
+    // RTX objects can only be created once the kernel is initialised.
+    osKernelInitialize();
+    csp_app_main_init();
+    osKernelStart();
+#endif
 
     // Should never return
     //for (;;);
@@ -17,8 +17,11 @@ override TRUSTZONE_FW_TYPE := 0
 # Disable MPU (Fixes the MPU_xTaskResumeAll error)
 override MPU := n
 
-# Force Non-TrustZone FreeRTOS
-override OS_SEL := freertos
+# Kernel: Non-TrustZone FreeRTOS (default) or CMSIS-RTOS2 RTX5
+# Benchmark the same network on RTX5 with: make CSP4CMSIS_OS=rtos2_rtx
+# (csp_config.h switches csp::os to the CMSIS-RTOS2 backend on RTOS2_RTX)
+CSP4CMSIS_OS ?= freertos
+override OS_SEL := $(CSP4CMSIS_OS)
 override EPII_USECASE_SEL := drv_user_defined
 
 # -------------------------------------------------------------------------
@@ -27,9 +30,14 @@ override EPII_USECASE_SEL := drv_user_defined
 # We override INCDIR to ensure core files like app/main.c see your headers
 override INCDIR += $(CURR_PROJ_DIR) \
                    library/csp4cmsis/inc \
-                   library/csp4cmsis/inc/csp \
-                   os/freertos/NTZ/freertos_kernel/include \
+                   library/csp4cmsis/inc/csp
+ifeq ($(CSP4CMSIS_OS), freertos)
+override INCDIR += os/freertos/NTZ/freertos_kernel/include \
                    os/freertos/NTZ/freertos_kernel/portable/GCC/ARM_CM55_NTZ/non_secure
+else
+# RTX_Config.h (board.c, OS_TICK_FREQ) is not on the SDK's RTX include path
+override INCDIR += os/rtos2_rtx/RTX/Config
+endif
 
 # -------------------------------------------------------------------------
 # 4. COMPILER DEFINES
@@ -38,6 +46,25 @@ override APPL_DEFINES += -DCSP4CMSIS_COMSTIME
 override APPL_DEFINES += -DconfigENABLE_MPU=0
 override APPL_DEFINES += -DconfigENABLE_TRUSTZONE=0
 
+# Rendezvous hand-off benchmark switch (see library/csp4cmsis/inc/csp/csp_config.h)
+# 0: original scheduling, 1: yield to the woken reader on completion
+# Compare both with: make CSP4CMSIS_RENDEZVOUS_HANDOFF=1
+CSP4CMSIS_RENDEZVOUS_HANDOFF ?= 0
+override APPL_DEFINES += -DCSP4CMSIS_RENDEZVOUS_HANDOFF=$(CSP4CMSIS_RENDEZVOUS_HANDOFF)
+
+# Per-process/per-channel statistics, printed after every benchmark round
+# Enable with: make CSP4CMSIS_STATS=1
+CSP4CMSIS_STATS ?= 0
+override APPL_DEFINES += -DCSP4CMSIS_STATS=$(CSP4CMSIS_STATS)
+
+# Memory placement benchmark switch (see library/csp4cmsis/inc/csp/placement.h)
+# 0: default (.bss and kernel heap, both in DTCM with this linker script)
+# 1: channels, stacks and kernel objects pinned to DTCM (.bss.csp_fast)
+# 2: the same pinned to system SRAM (.bss.csp_bulk)
+# Compare with: make CSP4CMSIS_COMSTIME_PLACEMENT=1 and =2
+CSP4CMSIS_COMSTIME_PLACEMENT ?= 0
+override APPL_DEFINES += -DCSP4CMSIS_COMSTIME_PLACEMENT=$(CSP4CMSIS_COMSTIME_PLACEMENT)
+
 # -------------------------------------------------------------------------
 # 5. SOURCE FILES (C and C++)
 # -------------------------------------------------------------------------
@@ -49,12 +76,15 @@ LIB_CXX_SOURCES   = $(wildcard ./library/csp4cmsis/src/*.cpp)
 override SCENARIO_APP_CXXSRCS += $(LOCAL_CXX_SOURCES) $(LIB_CXX_SOURCES)
 
 # Add FreeRTOS Kernel C sources (Non-TrustZone paths)
+# RTX5 sources come from os/rtos2_rtx/rtos2_rtx.mk
+ifeq ($(CSP4CMSIS_OS), freertos)
 RTOS_PATH = ./os/freertos/NTZ/freertos_kernel
 APPL_CSRCS += $(RTOS_PATH)/tasks.c \
               $(RTOS_PATH)/queue.c \
               $(RTOS_PATH)/timers.c \
               $(RTOS_PATH)/list.c \
               $(RTOS_PATH)/portable/MemMang/heap_4.c
+endif
 
 # -------------------------------------------------------------------------
 # 6. LINKER & LIBRARIES
@@ -12,6 +12,8 @@
 #include "queue.h"
 #include "timers.h"
 #endif
+
+#ifdef FREERTOS
 /* configUSE_STATIC_ALLOCATION is set to 1, so the application must provide an
  * implementation of vApplicationGetIdleTaskMemory() to provide the memory that is
  * used by the Idle task. */
@@ -70,6 +72,7 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName) {
 	/* Force an assert. */
 	configASSERT(pcTaskName == 0);
 }
+#endif /* FREERTOS */
 
 /*-----------------------------------------------------------*/
 
@@ -3,6 +3,31 @@
 
 using namespace csp;
 
+// Memory placement benchmark switch (see csp4cmsis_comstime.mk)
+// 0: channels in .bss, stacks and kernel objects on the kernel heap
+// 1: channels, stacks and kernel objects pinned to DTCM (CSP_PLACE_FAST)
+// 2: the same, pinned to system SRAM (CSP_PLACE_BULK)
+#ifndef CSP4CMSIS_COMSTIME_PLACEMENT
+#define CSP4CMSIS_COMSTIME_PLACEMENT 0
+#endif
+
+#if CSP4CMSIS_COMSTIME_PLACEMENT == 1
+#define COMSTIME_PLACE CSP_PLACE_FAST
+#define COMSTIME_PLACE_NAME "fast (DTCM)"
+#elif CSP4CMSIS_COMSTIME_PLACEMENT == 2
+#define COMSTIME_PLACE CSP_PLACE_BULK
+#define COMSTIME_PLACE_NAME "bulk (SRAM)"
+#else
+#define COMSTIME_PLACE
+#define COMSTIME_PLACE_NAME "default (.bss + kernel heap)"
+#endif
+
+#if CSP4CMSIS_COMSTIME_PLACEMENT
+template <typename P> using Placed = Pinned<P>;
+#else
+template <typename P> using Placed = P;
+#endif
+
 // --- 1. Basic Ring Components ---
 
 class Buffer : public CSProcess {
@@ -68,27 +93,38 @@ public:
         Alternative alt(data_in | val, trigger_in | signal);
 
         printf("[Comstime] Benchmark starting. Measuring %lu cycles...\n", benchmark_limit);
+        printf("[Comstime] Rendezvous hand-off: %s\r\n", CSP4CMSIS_RENDEZVOUS_HANDOFF ? "ON" : "OFF");
+        printf("[Comstime] Kernel: %s\r\n", CSP4CMSIS_OS_RTOS2 ? "CMSIS-RTOS2 (RTX5)" : "FreeRTOS");
+        printf("[Comstime] Placement: %s\r\n", COMSTIME_PLACE_NAME);
         
-        TickType_t start_time = xTaskGetTickCount();
+        Stopwatch stopwatch;
 
         while (true) {
             int selected = alt.fairSelect();
 
             if (selected == 0) { 
                 if (++count >= benchmark_limit) {
-                    TickType_t end_time = xTaskGetTickCount();
-                    float total_ms = (float)(end_time - start_time) * portTICK_PERIOD_MS;
-                    float micro_per_loop = (total_ms * 1000.0f) / (float)benchmark_limit;
+                    HrTime total = stopwatch.elapsed();
+                    float total_ms = (float)total.to_microseconds() / 1000.0f;
+                    float micro_per_loop = (float)total.to_nanoseconds() / (1000.0f * (float)benchmark_limit);
+                    uint32_t cycles_per_loop = (uint32_t)(total.to_cycles() / benchmark_limit);
                     
                     printf("--- Comstime Results ---\r\n");
+                    printf("Hand-off: %s\r\n", CSP4CMSIS_RENDEZVOUS_HANDOFF ? "ON" : "OFF");
+                    printf("Kernel: %s\r\n", CSP4CMSIS_OS_RTOS2 ? "CMSIS-RTOS2 (RTX5)" : "FreeRTOS");
+                    printf("Placement: %s\r\n", COMSTIME_PLACE_NAME);
                     printf("Iterations: %lu\r\n", count);
                     printf("Total Time: %.2f ms\r\n", total_ms);
-                    printf("Avg Latency: %.2f us/cycle\r\n", micro_per_loop);
+                    printf("Avg Latency: %.3f us/cycle (%lu core cycles)\r\n", micro_per_loop, cycles_per_loop);
                     printf("Last Value: %d\r\n", val);
                     printf("------------------------\r\n");
+#if CSP4CMSIS_STATS
+                    PrintStats();
+                    ResetStats();
+#endif
                     
                     count = 0;
-                    start_time = xTaskGetTickCount();
+                    stopwatch.start();
                 }
             } else if (selected == 1) {
                 printf(">>> [ALT] External Trigger Event Latency Check <<<\r\n");
@@ -105,7 +141,7 @@ public:
     Trigger(Chanout<bool> w) : out(w) {}
     void run() override {
         while (true) {
-            vTaskDelay(pdMS_TO_TICKS(5000)); 
+            os::delay(Milliseconds(5000).to_ticks()); 
             bool dummy = true;
             out << dummy;
         }
@@ -115,27 +151,28 @@ public:
 // --- 4. Main App Task ---
 
 void MainApp_Task(void* params) {
-    vTaskDelay(pdMS_TO_TICKS(500));
+    os::delay(Milliseconds(500).to_ticks());
     
-    // Channels
-    static Channel<int> c1, c2, c3, c4, cb1, cb2;
-    static Channel<bool> c_trigger;
-
-    // Process Instances
-    static Successor proc_succ(c3.reader(), cb1.writer());
-    static Buffer    proc_buf1(cb1.reader(), cb2.writer());
-    static Buffer    proc_buf2(cb2.reader(),  c1.writer());
-    static Prefix    proc_pref( c1.reader(),  c2.writer(), 0);
-    static Delta     proc_delt( c2.reader(),  c3.writer(), c4.writer());
-    static ComstimeConsumer proc_cons(c4.reader(), c_trigger.reader());
-    static Trigger   proc_trig(c_trigger.writer());
+    // Channels (each carries its own mutex control block)
+    COMSTIME_PLACE static Channel<int> c1, c2, c3, c4, cb1, cb2;
+    COMSTIME_PLACE static Channel<bool> c_trigger;
+
+    // Process Instances (Placed<>: stack and thread control block inside the object)
+    COMSTIME_PLACE static Placed<Successor> proc_succ(c3.reader(), cb1.writer());
+    COMSTIME_PLACE static Placed<Buffer>    proc_buf1(cb1.reader(), cb2.writer());
+    COMSTIME_PLACE static Placed<Buffer>    proc_buf2(cb2.reader(),  c1.writer());
+    COMSTIME_PLACE static Placed<Prefix>    proc_pref( c1.reader(),  c2.writer(), 0);
+    COMSTIME_PLACE static Placed<Delta>     proc_delt( c2.reader(),  c3.writer(), c4.writer());
+    COMSTIME_PLACE static Placed<ComstimeConsumer> proc_cons(c4.reader(), c_trigger.reader());
+    static Trigger   proc_trig(c_trigger.writer()); // Cold: wakes every 5 s
 
     Run(
         InParallel(proc_succ, proc_buf1, proc_buf2, proc_pref, proc_delt, proc_cons, proc_trig),
         ExecutionMode::StaticNetwork
     );
+    os::exitSelf(); // The network runs on threads of its own
 }
 
 extern "C" void RunProcessingChainTest(void) {
-    xTaskCreate(MainApp_Task, "ComsMain", 2048, NULL, tskIDLE_PRIORITY + 3, NULL);
+    os::spawn(MainApp_Task, NULL, "ComsMain", 2048, CSP_OS_PRIORITY_IDLE + 3);
 }
@@ -0,0 +1,13 @@
+// This file provides the missing definition for the linker.
+#include <cstdio>
+
+// Declare the test function defined in tests.cpp
+extern void RunHxEventTest(void);
+
+// Define the required function with C linkage
+extern "C" void csp_app_main_init(void) {
+    printf("Application initialization (via csp_app_main_init) started.\r\n");
+
+    // Builds the stackless network and enters the hxevent loop (no RTOS)
+    RunHxEventTest();
+}
@@ -0,0 +1,18 @@
+#include "csp4cmsis_hxevent.h"
+
+#include "xprintf.h"
+
+extern void csp_app_main_init(void);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+int app_main(void)
+{
+    printf("Stackless CSP on hxevent (no RTOS).\r\n");
+
+    // Builds the network and enters hx_eventloop_start(); does not return.
+    csp_app_main_init();
+
+    return 0;
+}
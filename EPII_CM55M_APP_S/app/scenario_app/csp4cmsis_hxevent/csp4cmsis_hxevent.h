@@ -0,0 +1,18 @@
+/*
+ * csp4cmsis_hxevent.h
+ *
+ * Stackless CSP network on the hxevent loop (no RTOS).
+ */
+
+#ifndef SCENARIO_APP_CSP4CMSIS_HXEVENT_H_
+#define SCENARIO_APP_CSP4CMSIS_HXEVENT_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "WE2_device.h"
+#include "WE2_core.h"
+#include "board.h"
+
+int app_main(void);
+
+#endif /* SCENARIO_APP_CSP4CMSIS_HXEVENT_H_ */
@@ -0,0 +1,59 @@
+# -------------------------------------------------------------------------
+# 1. APPLICATION IDENTITY & FOLDER PATHS
+# -------------------------------------------------------------------------
+override SCENARIO_APP_SUPPORT_LIST := $(APP_TYPE)
+
+CURR_PROJ_DIR := ./app/scenario_app/csp4cmsis_hxevent
+
+# -------------------------------------------------------------------------
+# 2. SYSTEM & ARCHITECTURE OVERRIDES
+# -------------------------------------------------------------------------
+# Disable TrustZone
+override TRUSTZONE      := n
+override TRUSTZONE_TYPE := non-security
+override TRUSTZONE_FW_TYPE := 0
+
+override MPU := n
+
+# No RTOS: stackless CSP processes run to completion on the hxevent loop
+override OS_SEL :=
+override EPII_USECASE_SEL := drv_user_defined
+
+# -------------------------------------------------------------------------
+# 3. LIBRARIES & INCLUDE PATHS
+# -------------------------------------------------------------------------
+LIB_SEL = hxevent
+
+override INCDIR += $(CURR_PROJ_DIR) \
+                   library/csp4cmsis/inc \
+                   library/csp4cmsis/inc/csp \
+                   library/hxevent
+
+# -------------------------------------------------------------------------
+# 4. COMPILER DEFINES
+# -------------------------------------------------------------------------
+override APPL_DEFINES += -DCSP4CMSIS_HXEVENT
+
+# Process slots (one hxevent event each), see library/csp4cmsis/inc/csp/csp_config.h
+CSP4CMSIS_HX_MAX_PROCESSES ?= 16
+override APPL_DEFINES += -DCSP4CMSIS_HX_MAX_PROCESSES=$(CSP4CMSIS_HX_MAX_PROCESSES)
+
+# -------------------------------------------------------------------------
+# 5. SOURCE FILES (C and C++)
+# -------------------------------------------------------------------------
+# Only the hxevent backend of the library: src/*.cpp needs an RTOS
+LOCAL_CXX_SOURCES = $(wildcard $(CURR_PROJ_DIR)/*.cpp)
+LIB_CXX_SOURCES   = $(wildcard ./library/csp4cmsis/src/hx/*.cpp)
+
+override SCENARIO_APP_CXXSRCS += $(LOCAL_CXX_SOURCES) $(LIB_CXX_SOURCES)
+
+# -------------------------------------------------------------------------
+# 6. LINKER & LIBRARIES
+# -------------------------------------------------------------------------
+APPL_LIBS += -lm -lstdc++ -lc
+
+ifeq ($(strip $(TOOLCHAIN)), arm)
+override LINKER_SCRIPT_FILE := $(CURR_PROJ_DIR)/csp4cmsis_hxevent.sct
+else
+override LINKER_SCRIPT_FILE := $(CURR_PROJ_DIR)/csp4cmsis_hxevent.ld
+endif
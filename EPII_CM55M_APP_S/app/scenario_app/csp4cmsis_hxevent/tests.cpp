@@ -0,0 +1,184 @@
+#include "csp/hx/hx_channel.h"
+#include <cstdio>
+
+using namespace csp::hx;
+
+// --- Configuration ---
+#define NUM_RELAYS 3
+#define TEST_ITERATIONS 1000
+#define CHECK_INTERVAL 250
+#define BURST_LENGTH 64
+#define BURST_CAPACITY 4
+
+// hxevent priorities: 0 is dispatched first. Downstream stages outrank
+// upstream ones, so every stage drains its input before more is produced.
+#define PRIO_CHECKER 10
+#define PRIO_RELAY   20
+#define PRIO_SOURCE  30
+#define PRIO_NETWORK 40
+
+// --- 1. Define the Stackless Processes ---
+
+/**
+ * @brief Source process.
+ * Outputs 1..TEST_ITERATIONS and raises the progress signal every
+ * CHECK_INTERVAL values, as a timer interrupt would on the board.
+ */
+class CountingSender : public CSProcess {
+private:
+    Chanout<int> out;
+    Signal& progress;
+    int i = 0;
+public:
+    CountingSender(Chanout<int> w, Signal& s) : CSProcess(PRIO_SOURCE), out(w), progress(s) {}
+
+    Step step() override {
+        CSP_HX_BEGIN();
+        for (i = 1; i <= TEST_ITERATIONS; ++i) {
+            CSP_HX_WRITE(out, i);
+            if (i % CHECK_INTERVAL == 0) progress.raiseFromIsr();
+        }
+        CSP_HX_END();
+    }
+};
+
+/**
+ * @brief Second source on a buffered channel: only blocks when it is full.
+ */
+class BurstSender : public CSProcess {
+private:
+    Chanout<int> out;
+    int i = 0;
+public:
+    BurstSender(Chanout<int> w) : CSProcess(PRIO_SOURCE), out(w) {}
+
+    Step step() override {
+        CSP_HX_BEGIN();
+        for (i = 1; i <= BURST_LENGTH; ++i) {
+            CSP_HX_WRITE(out, -i);
+        }
+        CSP_HX_END();
+    }
+};
+
+/**
+ * @brief Relay process: one input, one output, no stack of its own.
+ */
+class Relay : public CSProcess {
+private:
+    Chanin<int> in;
+    Chanout<int> out;
+    int data = 0;
+    int count = 0;
+public:
+    Relay(Chanin<int> r, Chanout<int> w) : CSProcess(PRIO_RELAY), in(r), out(w) {}
+
+    Step step() override {
+        CSP_HX_BEGIN();
+        for (count = 0; count < TEST_ITERATIONS; ++count) {
+            CSP_HX_READ(in, data);
+            CSP_HX_WRITE(out, data);
+        }
+        CSP_HX_END();
+    }
+};
+
+/**
+ * @brief Sink process.
+ * ALTs over the relay chain, the burst channel and the progress signal,
+ * and verifies that each stream arrives complete and in order.
+ */
+class CheckerReceiver : public CSProcess {
+private:
+    Chanin<int> chain;
+    Chanin<int> burst;
+    Signal& progress;
+    int selected = 0;
+    int received = 0;
+    int next_chain = 1;
+    int next_burst = -1;
+    bool success = true;
+public:
+    CheckerReceiver(Chanin<int> c, Chanin<int> b, Signal& s)
+        : CSProcess(PRIO_CHECKER), chain(c), burst(b), progress(s) {}
+
+    bool passed() const { return success; }
+
+    Step step() override {
+        CSP_HX_BEGIN();
+        while (next_chain <= TEST_ITERATIONS || next_burst >= -BURST_LENGTH) {
+            CSP_HX_ALT(selected,
+                       progress,
+                       when(next_chain <= TEST_ITERATIONS, chain),
+                       when(next_burst >= -BURST_LENGTH, burst));
+
+            if (selected == 0) {
+                CSP_HX_TAKE(progress);
+                printf("[Receiver] Verified up to %d...\r\n", next_chain - 1);
+            } else if (selected == 1) {
+                CSP_HX_READ(chain, received);
+                if (received != next_chain) {
+                    printf("[Receiver] !! DATA ERROR: Expected %d, Got %d\r\n", next_chain, received);
+                    success = false;
+                }
+                ++next_chain;
+            } else {
+                CSP_HX_READ(burst, received);
+                if (received != next_burst) {
+                    printf("[Receiver] !! BURST ERROR: Expected %d, Got %d\r\n", next_burst, received);
+                    success = false;
+                }
+                --next_burst;
+            }
+        }
+        if (success) {
+            printf("[Receiver] SUCCESS: %d values through %d relays and %d buffered values verified.\r\n",
+                   TEST_ITERATIONS, NUM_RELAYS, BURST_LENGTH);
+        }
+        CSP_HX_END();
+    }
+};
+
+// --- 2. Network Construction ---
+
+static Channel<int> channels[NUM_RELAYS + 1];
+static BufferedChannel<int, BURST_CAPACITY> burst_channel;
+static Signal progress;
+
+static CountingSender sender(channels[0].writer(), progress);
+static BurstSender burst_sender(burst_channel.writer());
+static CheckerReceiver receiver(channels[NUM_RELAYS].reader(), burst_channel.reader(), progress);
+static Relay relays[NUM_RELAYS] = {
+    Relay(channels[0].reader(), channels[1].writer()),
+    Relay(channels[1].reader(), channels[2].writer()),
+    Relay(channels[2].reader(), channels[3].writer())
+};
+
+/**
+ * @brief Parent process: starts the network, then joins the receiver.
+ * Everything here runs on the single hxevent loop stack.
+ */
+class Network : public CSProcess {
+public:
+    Network() : CSProcess(PRIO_NETWORK) {}
+
+    Step step() override {
+        CSP_HX_BEGIN();
+        printf("\r\n--- Launching stackless CSP network on hxevent ---\r\n");
+        Spawn(receiver);
+        for (Relay& relay : relays) Spawn(relay);
+        Spawn(burst_sender);
+        Spawn(sender);
+
+        CSP_HX_JOIN(receiver);
+        printf("--- Network %s. ---\r\n", receiver.passed() ? "complete" : "FAILED");
+        CSP_HX_END();
+    }
+};
+
+void RunHxEventTest(void) {
+    static Network network;
+
+    // Never returns: the event loop idles once the network has finished.
+    Run(network);
+}
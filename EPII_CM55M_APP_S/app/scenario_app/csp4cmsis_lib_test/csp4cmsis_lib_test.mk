@@ -0,0 +1,90 @@
+# -------------------------------------------------------------------------
+# 1. APPLICATION IDENTITY & FOLDER PATHS
+# -------------------------------------------------------------------------
+override SCENARIO_APP_SUPPORT_LIST := $(APP_TYPE)
+
+# Use the actual folder name (matching the rename to 'cmsis')
+CURR_PROJ_DIR := ./app/scenario_app/csp4cmsis_lib_test
+
+# -------------------------------------------------------------------------
+# 2. SYSTEM & ARCHITECTURE OVERRIDES (The "Linker Fixes")
+# -------------------------------------------------------------------------
+# Disable TrustZone
+override TRUSTZONE      := n
+override TRUSTZONE_TYPE := non-security
+override TRUSTZONE_FW_TYPE := 0
+
+# Disable MPU (Fixes the MPU_xTaskResumeAll error)
+override MPU := n
+
+# Kernel: Non-TrustZone FreeRTOS (default) or CMSIS-RTOS2 RTX5
+# Run the same checks on RTX5 with: make CSP4CMSIS_OS=rtos2_rtx
+# (csp_config.h switches csp::os to the CMSIS-RTOS2 backend on RTOS2_RTX)
+CSP4CMSIS_OS ?= freertos
+override OS_SEL := $(CSP4CMSIS_OS)
+override EPII_USECASE_SEL := drv_user_defined
+
+# -------------------------------------------------------------------------
+# 3. GLOBAL INCLUDE PATHS (The "Fatal Error" Fix)
+# -------------------------------------------------------------------------
+# We override INCDIR to ensure core files like app/main.c see your headers
+override INCDIR += $(CURR_PROJ_DIR) \
+                   library/csp4cmsis/inc \
+                   library/csp4cmsis/inc/csp
+ifeq ($(CSP4CMSIS_OS), freertos)
+override INCDIR += os/freertos/NTZ/freertos_kernel/include \
+                   os/freertos/NTZ/freertos_kernel/portable/GCC/ARM_CM55_NTZ/non_secure
+else
+# RTX_Config.h (board.c, OS_TICK_FREQ) is not on the SDK's RTX include path
+override INCDIR += os/rtos2_rtx/RTX/Config
+endif
+
+# -------------------------------------------------------------------------
+# 4. COMPILER DEFINES
+# -------------------------------------------------------------------------
+override APPL_DEFINES += -DCSP4CMSIS_LIB_TEST
+override APPL_DEFINES += -DconfigENABLE_MPU=0
+override APPL_DEFINES += -DconfigENABLE_TRUSTZONE=0
+
+# Rendezvous hand-off switch (see library/csp4cmsis/inc/csp/csp_config.h)
+# 0: original scheduling, 1: yield to the woken reader on completion
+# Compare both with: make CSP4CMSIS_RENDEZVOUS_HANDOFF=1
+CSP4CMSIS_RENDEZVOUS_HANDOFF ?= 0
+override APPL_DEFINES += -DCSP4CMSIS_RENDEZVOUS_HANDOFF=$(CSP4CMSIS_RENDEZVOUS_HANDOFF)
+
+# Per-process/per-channel statistics (adds probe cost to every channel operation)
+# Enable with: make CSP4CMSIS_STATS=1
+CSP4CMSIS_STATS ?= 0
+override APPL_DEFINES += -DCSP4CMSIS_STATS=$(CSP4CMSIS_STATS)
+
+# -------------------------------------------------------------------------
+# 5. SOURCE FILES (C and C++)
+# -------------------------------------------------------------------------
+# Collect all local C++ files and library C++ files
+LOCAL_CXX_SOURCES = $(wildcard $(CURR_PROJ_DIR)/*.cpp)
+LIB_CXX_SOURCES   = $(wildcard ./library/csp4cmsis/src/*.cpp)
+
+# Register C++ files with the SDK build system
+override SCENARIO_APP_CXXSRCS += $(LOCAL_CXX_SOURCES) $(LIB_CXX_SOURCES)
+
+# Add FreeRTOS Kernel C sources (Non-TrustZone paths)
+# RTX5 sources come from os/rtos2_rtx/rtos2_rtx.mk
+ifeq ($(CSP4CMSIS_OS), freertos)
+RTOS_PATH = ./os/freertos/NTZ/freertos_kernel
+APPL_CSRCS += $(RTOS_PATH)/tasks.c \
+              $(RTOS_PATH)/queue.c \
+              $(RTOS_PATH)/timers.c \
+              $(RTOS_PATH)/list.c \
+              $(RTOS_PATH)/portable/MemMang/heap_4.c
+endif
+
+# -------------------------------------------------------------------------
+# 6. LINKER & LIBRARIES
+# -------------------------------------------------------------------------
+APPL_LIBS += -lm -lstdc++ -lc
+
+ifeq ($(strip $(TOOLCHAIN)), arm)
+override LINKER_SCRIPT_FILE := $(CURR_PROJ_DIR)/csp4cmsis_lib_test.sct
+else
+override LINKER_SCRIPT_FILE := $(CURR_PROJ_DIR)/csp4cmsis_lib_test.ld
+endif
@@ -0,0 +1,365 @@
+#include "csp/csp4cmsis.h"
+#include <atomic>
+#include <cstdio>
+
+using namespace csp;
+
+// Regression checks of library behaviour. Each section runs one network to
+// completion and checks its outcome; the last line is "PASS" or "FAIL". A
+// network that deadlocks never prints it (the host `make test` waits
+// TEST_MS for the line).
+
+static const char* const SUITE = "csp4cmsis_lib_test";
+
+static int checks = 0;
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    checks++;
+    if (!ok) {
+        failures++;
+        printf("[%s] FAILED: %s\r\n", SUITE, what);
+    }
+}
+
+/**
+ * @brief Lets the idle task reclaim the stacks of processes that just
+ * terminated before the next section spawns new ones.
+ */
+static void settle() {
+    os::delay(Milliseconds(10).to_ticks());
+}
+
+// =============================================================
+// 1. Barrier Reuse
+// =============================================================
+
+static const int BARRIER_PARTIES = 4;
+static const int BARRIER_ROUNDS = 2000;
+
+static std::atomic<int> barrier_round[BARRIER_PARTIES];
+static std::atomic<int> barrier_early{0};
+
+/**
+ * @brief Announces each round before syncing, then checks that every other
+ * party announced it too: a party let through a phase early (a token left
+ * over from the previous one) sees a slower party still in the last round.
+ */
+class BarrierRound : public CSProcess {
+private:
+    Barrier& barrier;
+    int id;
+public:
+    BarrierRound(Barrier& b, int i) : barrier(b), id(i) {}
+    const char* name() const override { return "Round"; }
+
+    void run() override {
+        for (int r = 1; r <= BARRIER_ROUNDS; ++r) {
+            barrier_round[id] = r;
+            barrier.sync();
+            for (int j = 0; j < BARRIER_PARTIES; ++j) {
+                if (barrier_round[j] < r) barrier_early++;
+            }
+        }
+    }
+};
+
+static void testBarrier() {
+    Barrier barrier(BARRIER_PARTIES);
+    BarrierRound p0(barrier, 0), p1(barrier, 1), p2(barrier, 2), p3(barrier, 3);
+    Run(InParallel(p0, p1, p2, p3));
+    check(barrier_early == 0, "barrier: no party leaves a phase before all arrived");
+    settle();
+}
+
+// =============================================================
+// 2. Timer Guard Bound Through the Variadic Alternative
+// =============================================================
+
+/**
+ * @brief A RelTimeoutGuard passed to Alternative(in | v, timeout) must stay
+ * the one armed by select(). A copy made by the constructor deleted the
+ * timer of the original on destruction, so the timeout never fired.
+ */
+static void testAltTimeout() {
+    static Channel<int> silent;
+    Chanin<int> in = silent.reader();
+    int value = 0;
+
+    RelTimeoutGuard timeout(Milliseconds(20));
+    Alternative alt(in | value, timeout);
+    for (int i = 0; i < 3; ++i) {
+        check(alt.priSelect() == 1, "alt: timeout guard fires with no writer");
+    }
+}
+
+// =============================================================
+// 3. Repeated Spawn/Join
+// =============================================================
+
+static const int JOIN_ROUNDS = 500;
+
+static std::atomic<int> join_ran{0};
+
+class Joined : public CSProcess {
+public:
+    const char* name() const override { return "Joined"; }
+    void run() override { join_ran++; }
+};
+
+/**
+ * @brief Run() deletes its join semaphore as soon as the last process has
+ * given it. The host port used to signal the semaphore after releasing its
+ * lock, so the giver could touch it after the joiner freed it (reported by
+ * `make SANITIZE=thread test`).
+ */
+static void testSpawnJoin() {
+    Joined a, b, c;
+    for (int i = 0; i < JOIN_ROUNDS; ++i) {
+        Run(InParallel(a, b, c));
+    }
+    check(join_ran == 3 * JOIN_ROUNDS, "run: every process of every round joined");
+    settle();
+}
+
+// =============================================================
+// 4. Deadline Channels: Stale Drop and EDF Boost
+// =============================================================
+
+/**
+ * @brief Takes one frame, reports it, then holds it until told to let go.
+ */
+class FrameHolder : public CSProcess {
+private:
+    Chanin<FrameToken<int>> in;
+    Chanout<int> ack;
+    Chanin<int> done;
+public:
+    os::ThreadId task = nullptr;
+    os::Priority base = 0;
+    os::Priority released = 0;
+    int value = 0;
+
+    FrameHolder(Chanin<FrameToken<int>> r, Chanout<int> a, Chanin<int> d) : in(r), ack(a), done(d) {}
+    const char* name() const override { return "Holder"; }
+
+    void run() override {
+        task = os::self();
+        base = os::priority();
+        FrameToken<int> token;
+        in >> token;
+        value = token.value;
+        ack << 1;
+
+        int go;
+        done >> go;
+        ReleaseDeadline();
+        released = os::priority();
+        ack << 2;
+    }
+};
+
+/**
+ * @brief Sends a stale frame then a fresh one to the first holder, a more
+ * urgent frame to the second, and checks who runs boosted as the holders
+ * release their frames in turn.
+ */
+class FrameFeeder : public CSProcess {
+private:
+    DeadlineOne2OneChannel<int>& chan0;
+    Chanout<FrameToken<int>> out0, out1;
+    Chanin<int> ack0, ack1;
+    Chanout<int> done0, done1;
+    FrameHolder& h0;
+    FrameHolder& h1;
+public:
+    FrameFeeder(DeadlineOne2OneChannel<int>& c0, Chanout<FrameToken<int>> o0, Chanout<FrameToken<int>> o1,
+                Chanin<int> a0, Chanin<int> a1, Chanout<int> d0, Chanout<int> d1,
+                FrameHolder& holder0, FrameHolder& holder1)
+        : chan0(c0), out0(o0), out1(o1), ack0(a0), ack1(a1), done0(d0), done1(d1), h0(holder0), h1(holder1) {}
+    const char* name() const override { return "Feeder"; }
+
+    void run() override {
+        const os::Priority BOOST = CSP_DEADLINE_BOOST_PRIORITY;
+        int a;
+
+        FrameToken<int> stale{ 1, Time(os::tickCount() - 10) };
+        out0 << stale;
+        out0 << MakeFrame(2, Milliseconds(1000));
+        ack0 >> a;
+        check(h0.value == 2 && chan0.dropped() == 1, "deadline: stale frame dropped, next one delivered");
+        check(h0.base < BOOST, "deadline: holder starts below the boost priority");
+        check(os::priority(h0.task) == BOOST, "deadline: single holder boosted");
+
+        out1 << MakeFrame(3, Milliseconds(500));
+        ack1 >> a;
+        check(h1.base < BOOST, "deadline: holder starts below the boost priority");
+        check(os::priority(h1.task) == BOOST, "deadline: earliest deadline holder boosted");
+        check(os::priority(h0.task) == h0.base, "deadline: later holder back at its base priority");
+
+        done1 << 0;
+        ack1 >> a;
+        check(h1.released == h1.base, "deadline: release() restores the base priority");
+        check(os::priority(h0.task) == BOOST, "deadline: next earliest holder boosted on release()");
+
+        done0 << 0;
+        ack0 >> a;
+        check(h0.released == h0.base, "deadline: last holder restored on release()");
+    }
+};
+
+static void testDeadline() {
+    static DeadlineOne2OneChannel<int> frames0, frames1; // StalePolicy::Drop
+    static Channel<int> ack0, ack1, done0, done1;
+
+    FrameHolder h0(frames0.reader(), ack0.writer(), done0.reader());
+    FrameHolder h1(frames1.reader(), ack1.writer(), done1.reader());
+    FrameFeeder feeder(frames0, frames0.writer(), frames1.writer(), ack0.reader(), ack1.reader(),
+                       done0.writer(), done1.writer(), h0, h1);
+    Run(InParallel(feeder, h0, h1));
+    settle();
+}
+
+// =============================================================
+// 5. Static Network Launch
+// =============================================================
+
+/**
+ * @brief Reports the thread it runs on.
+ */
+class ThreadReporter : public CSProcess {
+private:
+    Chanout<os::ThreadId> out;
+public:
+    explicit ThreadReporter(Chanout<os::ThreadId> w) : out(w) {}
+    const char* name() const override { return "Reporter"; }
+    void run() override { out << os::self(); }
+};
+
+/**
+ * @brief A StaticNetwork starts every process on a thread of its own and
+ * returns: the first process used to take over the caller, which never got
+ * back from Run() when that process loops forever (and, before the scheduler
+ * starts, never reached vTaskStartScheduler()).
+ */
+static void testStaticLaunch() {
+    static Channel<os::ThreadId> ids0, ids1;
+    static ThreadReporter first(ids0.writer()), second(ids1.writer());
+
+    Run(InParallel(first, second), ExecutionMode::StaticNetwork);
+    os::ThreadId a = nullptr, b = nullptr;
+    ids0.reader() >> a;
+    ids1.reader() >> b;
+    check(a != os::self() && b != os::self() && a != b, "static network: every process on its own thread");
+    settle();
+}
+
+// =============================================================
+// 6. Pinned Process Started Twice
+// =============================================================
+
+static std::atomic<int> pinned_ran{0};
+
+class PinnedRun : public CSProcess {
+public:
+    const char* name() const override { return "PinnedRun"; }
+    void run() override { pinned_ran++; }
+};
+
+/**
+ * @brief The thread a Pinned process ended may not be reclaimed yet, so a
+ * second start is refused: Run() reports it and returns instead of building
+ * a thread on memory the kernel still uses, or waiting for one never started.
+ */
+static void testPinnedTwice() {
+    static Pinned<PinnedRun, 256> pinned;
+    Joined first;
+
+    Run(InParallel(first, pinned));
+    Run(InParallel(first, pinned));
+    check(pinned_ran == 1, "pinned: a second start is refused");
+    settle();
+}
+
+#if CSP4CMSIS_STATS
+// =============================================================
+// 7. Transfer Statistics Through an ALT (make CSP4CMSIS_STATS=1 test)
+// =============================================================
+
+static const int ALT_MSGS = 200;
+
+class CountWriter : public CSProcess {
+private:
+    Chanout<int> out;
+public:
+    explicit CountWriter(Chanout<int> w) : out(w) {}
+    const char* name() const override { return "CountWriter"; }
+
+    void run() override {
+        for (int i = 0; i < ALT_MSGS; ++i) out << i;
+    }
+};
+
+class AltCountReader : public CSProcess {
+private:
+    Chanin<int> in0, in1;
+public:
+    AltCountReader(Chanin<int> r0, Chanin<int> r1) : in0(r0), in1(r1) {}
+    const char* name() const override { return "AltCountReader"; }
+
+    void run() override {
+        int v0 = 0, v1 = 0;
+        Alternative alt(in0 | v0, in1 | v1);
+        for (int i = 0; i < 2 * ALT_MSGS; ++i) alt.fairSelect();
+    }
+};
+
+/**
+ * @brief Every message read through the ALT is one transfer of its channel,
+ * so each channel's reader-side count matches the writer's.
+ */
+static void testAltStats() {
+    static Channel<int> sync;
+    static BufferedOne2OneChannel<int, 4> buffered;
+    int dummy = 0;
+    internal::ChannelStats* sync_stats = sync.reader().getGuard(dummy)->stats_channel;
+    internal::ChannelStats* buffered_stats = buffered.reader().getGuard(dummy)->stats_channel;
+
+    CountWriter w0(sync.writer()), w1(buffered.writer());
+    AltCountReader reader(sync.reader(), buffered.reader());
+    Run(InParallel(w0, w1, reader));
+
+    check(sync_stats->writes == ALT_MSGS && sync_stats->transfers == ALT_MSGS,
+          "stats: rendezvous transfers through an ALT match the writes");
+    check(buffered_stats->writes == ALT_MSGS && buffered_stats->transfers == ALT_MSGS,
+          "stats: buffered transfers through an ALT match the writes");
+    settle();
+}
+#endif // CSP4CMSIS_STATS
+
+// =============================================================
+// Main Test Task
+// =============================================================
+
+void LibTest_Task(void* params) {
+    os::delay(Milliseconds(500).to_ticks());
+    printf("\r\n--- %s ---\r\n", SUITE);
+
+    testBarrier();
+    testAltTimeout();
+    testSpawnJoin();
+    testDeadline();
+    testStaticLaunch();
+    testPinnedTwice();
+#if CSP4CMSIS_STATS
+    testAltStats();
+#endif
+
+    printf("[%s] %d checks, %d failed\r\n", SUITE, checks, failures);
+    printf("%s\r\n", failures ? "FAIL" : "PASS");
+    os::exitSelf();
+}
+
+extern "C" void RunProcessingChainTest(void) {
+    os::spawn(LibTest_Task, NULL, "LibTest", 2048, CSP_OS_PRIORITY_IDLE + 3);
+}
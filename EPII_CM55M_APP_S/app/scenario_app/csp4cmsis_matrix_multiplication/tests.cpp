@@ -1,5 +1,6 @@
 #include "csp/csp4cmsis.h"
 #include <cstdio>
+#include <utility>
 
 using namespace csp;
 
@@ -89,53 +90,54 @@ public:
     }
 };
 
-// --- 4. Main Application ---
+// --- 4. Network Description ---
+// Channel ids: h[r][c] carries row r into column c (c == 3: the edge sink),
+// v[r][c] carries column c into row r (r == 3: the edge sink).
+constexpr size_t H(size_t r, size_t c) { return r * 4 + c; }
+constexpr size_t V(size_t r, size_t c) { return 12 + r * 3 + c; }
+
+template <size_t... I>
+net::Channels<net::Edge<I, int>...> gridChannels(std::index_sequence<I...>);
+
+template <size_t R, size_t C>
+using PE = net::Node<ProcessingElement, net::Reads<H(R, C), V(R, C)>,
+                     net::Writes<H(R, C + 1), V(R + 1, C)>, net::Args<(int)R, (int)C>>;
+
+using SystolicArray = net::StaticNetwork<
+    decltype(gridChannels(std::make_index_sequence<24>{})),
+    net::Processes<
+        // Matrix A (Rows) - Stagger 0
+        net::Node<Feeder, net::Reads<>, net::Writes<H(0, 0)>, net::Args<1, 2, 3, 0>>,
+        net::Node<Feeder, net::Reads<>, net::Writes<H(1, 0)>, net::Args<4, 5, 6, 0>>,
+        net::Node<Feeder, net::Reads<>, net::Writes<H(2, 0)>, net::Args<7, 8, 9, 0>>,
+        // Matrix B (Cols) - Identity - Stagger 0
+        net::Node<Feeder, net::Reads<>, net::Writes<V(0, 0)>, net::Args<1, 0, 0, 0>>,
+        net::Node<Feeder, net::Reads<>, net::Writes<V(0, 1)>, net::Args<0, 1, 0, 0>>,
+        net::Node<Feeder, net::Reads<>, net::Writes<V(0, 2)>, net::Args<0, 0, 1, 0>>,
+        // Grid of PEs
+        PE<0, 0>, PE<0, 1>, PE<0, 2>,
+        PE<1, 0>, PE<1, 1>, PE<1, 2>,
+        PE<2, 0>, PE<2, 1>, PE<2, 2>,
+        // Edge Sinks
+        net::Node<Sink, net::Reads<H(0, 3)>>, net::Node<Sink, net::Reads<H(1, 3)>>, net::Node<Sink, net::Reads<H(2, 3)>>,
+        net::Node<Sink, net::Reads<V(3, 0)>>, net::Node<Sink, net::Reads<V(3, 1)>>, net::Node<Sink, net::Reads<V(3, 2)>>
+    >>;
+
+// Channels, processes and stacks: one zero-initialised object, sized at compile time.
+static SystolicArray network;
+
+// --- 5. Main Application ---
 void MainApp_Task(void* params) {
     vTaskDelay(pdMS_TO_TICKS(1000));
     printf("\r\n--- Systolic Array 3x3: A * Identity ---\r\n");
+    printf("Static network: %u processes, %u channels, %lu B (stacks %lu B, channels %lu B, processes %lu B)\r\n",
+           (unsigned)SystolicArray::NUM_PROCESSES, (unsigned)SystolicArray::NUM_CHANNELS,
+           (unsigned long)SystolicArray::ramBytes(), (unsigned long)SystolicArray::STACK_BYTES,
+           (unsigned long)SystolicArray::CHANNEL_BYTES, (unsigned long)SystolicArray::PROCESS_BYTES);
 
-    // Static channels for the grid
-    static Channel<int> h[3][4]; // Horizontal channels
-    static Channel<int> v[4][3]; // Vertical channels
-
-    // Matrix A (Rows) - Stagger 0
-    static Feeder row0(h[0][0].writer(), 1, 2, 3, 0); 
-    static Feeder row1(h[1][0].writer(), 4, 5, 6, 0); 
-    static Feeder row2(h[2][0].writer(), 7, 8, 9, 0); 
-
-    // Matrix B (Cols) - Identity - Stagger 0
-    static Feeder col0(v[0][0].writer(), 1, 0, 0, 0); 
-    static Feeder col1(v[0][1].writer(), 0, 1, 0, 0); 
-    static Feeder col2(v[0][2].writer(), 0, 0, 1, 0);
-
-    // Grid of PEs
-    static ProcessingElement pe00(h[0][0].reader(), v[0][0].reader(), h[0][1].writer(), v[1][0].writer(), 0, 0);
-    static ProcessingElement pe01(h[0][1].reader(), v[0][1].reader(), h[0][2].writer(), v[1][1].writer(), 0, 1);
-    static ProcessingElement pe02(h[0][2].reader(), v[0][2].reader(), h[0][3].writer(), v[1][2].writer(), 0, 2);
-
-    static ProcessingElement pe10(h[1][0].reader(), v[1][0].reader(), h[1][1].writer(), v[2][0].writer(), 1, 0);
-    static ProcessingElement pe11(h[1][1].reader(), v[1][1].reader(), h[1][2].writer(), v[2][1].writer(), 1, 1);
-    static ProcessingElement pe12(h[1][2].reader(), v[1][2].reader(), h[1][3].writer(), v[2][2].writer(), 1, 2);
-
-    static ProcessingElement pe20(h[2][0].reader(), v[2][0].reader(), h[2][1].writer(), v[3][0].writer(), 2, 0);
-    static ProcessingElement pe21(h[2][1].reader(), v[2][1].reader(), h[2][2].writer(), v[3][1].writer(), 2, 1);
-    static ProcessingElement pe22(h[2][2].reader(), v[2][2].reader(), h[2][3].writer(), v[3][2].writer(), 2, 2);
-
-    // Edge Sinks
-    static Sink sH0(h[0][3].reader()), sH1(h[1][3].reader()), sH2(h[2][3].reader());
-    static Sink sV0(v[3][0].reader()), sV1(v[3][1].reader()), sV2(v[3][2].reader());
-
-    Run(
-        InParallel(
-            row0, row1, row2, 
-            col0, col1, col2, 
-            pe00, pe01, pe02, 
-            pe10, pe11, pe12, 
-            pe20, pe21, pe22,
-            sH0, sH1, sH2, sV0, sV1, sV2
-        ),
-        ExecutionMode::StaticNetwork
-    );
+    network.start();
+
+    vTaskDelete(NULL);
 }
 
 void RunProcessingChainTest(void) {
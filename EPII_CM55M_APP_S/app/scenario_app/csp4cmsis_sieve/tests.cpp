@@ -92,6 +92,7 @@ void MainApp_Task(void* params) {
         InParallel(generator, f0, f1, f2, f3, f4, sink),
         ExecutionMode::StaticNetwork
     );
+    os::exitSelf(); // The network runs on threads of its own
 }
 
 void RunProcessingChainTest(void) {
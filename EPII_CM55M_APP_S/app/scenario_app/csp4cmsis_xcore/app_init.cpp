@@ -0,0 +1,16 @@
+// This file provides the missing definition for the linker.
+#include <cstdio>
+#include "csp/csp4cmsis.h" // Includes the declaration
+
+// Declare the test function defined in tests.cpp
+extern void RunXcoreTest(void); 
+
+// Define the required function with C linkage
+extern "C" void csp_app_main_init(void) {
+    printf("Application initialization (via csp_app_main_init) started.\r\n");
+
+    // Call the C++ function that attaches the other core and creates the CSP tasks
+    RunXcoreTest(); 
+
+    printf("Application tasks created successfully.\r\n");
+}
@@ -0,0 +1,137 @@
+#include "csp/csp4cmsis.h"
+#include <cstdio>
+
+using namespace csp;
+
+// --- Configuration ---
+#define TOTAL_WAKE_EVENTS 20
+#define FRAME_MS 10          // Audio frame of the always-on listener
+#define FRAMES_PER_HIT 7     // Simulated keyword rate
+#define INFERENCE_MS 30      // Simulated big-core model run per wake event
+
+/**
+ * @brief Wake-word hit, handed from the CM55 Little to the CM55 Big.
+ * Plain data: it is copied bytewise through the shared SRAM segment.
+ */
+struct WakeEvent {
+    uint32_t seq;
+    uint16_t keyword;
+    uint16_t score;          // Q8 confidence
+    uint32_t audio_offset;   // Start of the utterance in the shared audio ring
+};
+
+// Declared identically in both images: the id selects the shared slot and doorbell.
+static XcoreBufferedOne2OneChannel<WakeEvent, 4> wake_events(0);
+static XcoreOne2OneChannel<uint32_t> resume(1);
+
+// --- CM55 Little: always-on listener ---
+
+/**
+ * @brief VAD/KWS loop of the always-on core.
+ * Runs a frame at a time; on a keyword hit it hands the event to the big
+ * core and keeps listening. Between frames it takes the big core's resume
+ * acknowledgements, so it never stalls on the big core.
+ */
+class WakeWordListener : public CSProcess {
+private:
+    Chanout<WakeEvent> out;
+    Chanin<uint32_t> ack_in;
+public:
+    WakeWordListener(Chanout<WakeEvent> w, Chanin<uint32_t> r) : out(w), ack_in(r) {}
+
+    const char* name() const override { return "Listener"; }
+
+    void run() override {
+        printf("[Little] Listening...\r\n");
+        uint32_t sent = 0, acked = 0, frame = 0;
+        while (acked < TOTAL_WAKE_EVENTS) {
+            uint32_t ack;
+            RelTimeoutGuard next_frame(Milliseconds(FRAME_MS));
+            Alternative alt(ack_in | ack, next_frame);
+            if (alt.priSelect() == 0) {
+                acked++;
+                if (ack != acked) printf("[Little] !! Resume %lu out of order (expected %lu)\r\n",
+                                         (unsigned long)ack, (unsigned long)acked);
+                continue;
+            }
+
+            frame++;
+            if (sent < TOTAL_WAKE_EVENTS && frame % FRAMES_PER_HIT == 0) {
+                WakeEvent e = { ++sent, (uint16_t)(sent % 3), (uint16_t)(200 + sent), frame * FRAME_MS * 16 };
+                out << e;
+            }
+        }
+        printf("[Little] All %d wake events acknowledged.\r\n", TOTAL_WAKE_EVENTS);
+        while (true) {
+            os::delay(os::WAIT_FOREVER);
+        }
+    }
+};
+
+// --- CM55 Big: woken for the heavy work ---
+
+/**
+ * @brief Takes each wake event, runs the (simulated) heavy model on the
+ * utterance and tells the little core when it is done.
+ */
+class WakeHandler : public CSProcess {
+private:
+    Chanin<WakeEvent> in;
+    Chanout<uint32_t> ack_out;
+public:
+    WakeHandler(Chanin<WakeEvent> r, Chanout<uint32_t> w) : in(r), ack_out(w) {}
+
+    const char* name() const override { return "WakeHandler"; }
+
+    void run() override {
+        bool success = true;
+        for (uint32_t i = 1; i <= TOTAL_WAKE_EVENTS; ++i) {
+            WakeEvent e;
+            in >> e;
+            if (e.seq != i) {
+                printf("[Big] !! DATA ERROR: Expected event %lu, Got %lu\r\n", (unsigned long)i, (unsigned long)e.seq);
+                success = false;
+                break;
+            }
+            printf("[Big] Wake %lu: keyword %u, score %u, audio @%lu\r\n", (unsigned long)e.seq,
+                   (unsigned)e.keyword, (unsigned)e.score, (unsigned long)e.audio_offset);
+            os::delay(Milliseconds(INFERENCE_MS).to_ticks());
+            ack_out << e.seq;
+        }
+        if (success) {
+            printf("[Big] SUCCESS: %d wake events passed between the cores.\r\n", TOTAL_WAKE_EVENTS);
+        }
+        PrintFootprint();
+        while (true) {
+            os::delay(os::WAIT_FOREVER);
+        }
+    }
+};
+
+// --- Network Construction ---
+
+static bool little_core = CSP4CMSIS_XCORE_LITTLE;
+
+void MainApp_Task(void* params) {
+    os::delay(Milliseconds(500).to_ticks());
+
+    if (little_core) {
+        static WakeWordListener listener(wake_events.writer(), resume.reader());
+        Run(InParallel(listener), ExecutionMode::StaticNetwork);
+    } else {
+        printf("\r\n--- Launching Cross-Core Wake-Word Handoff ---\r\n");
+        static WakeHandler handler(wake_events.reader(), resume.writer());
+        Run(InParallel(handler), ExecutionMode::StaticNetwork);
+    }
+    os::exitSelf(); // The network runs on threads of its own
+}
+
+void RunXcoreTest(void) {
+    // Both cores must be attached before either uses a channel.
+#if defined(CSP4CMSIS_HOST)
+    little_core = xcore::hostForkCores();
+#else
+    xcore::attachMailbox();
+#endif
+    xTaskCreate(MainApp_Task, "MainApp", 4096, NULL, tskIDLE_PRIORITY + 3, NULL);
+}
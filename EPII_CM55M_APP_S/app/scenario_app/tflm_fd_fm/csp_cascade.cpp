@@ -0,0 +1,568 @@
+/*
+ * csp_cascade.cpp
+ *
+ *  Face detection -> face mesh -> iris landmark cascade on csp4cmsis
+ *  (TFLM_FD_FM_CSP=1).
+ *
+ *  Detect --frame-------------------------------------------> Uplink
+ *     |  \                                                    ^  |
+ *     |   +--face--> Mesh --face--> Iris --face---------------+  |
+ *     |               |               |                          |
+ *     +-- job --> Npu <-- job --------+                          |
+ *     ^                                                          |
+ *     +------------------free frame / free face------------------+
+ *
+ *  Detect runs the hxevent loop. On every frame-ready event it resizes the
+ *  raw image, has Npu run face detection (the boxes are decoded there, see
+ *  below), copies the JPEG and sends the frame to Uplink. Then it crops
+ *  each face into a face token of its own, sends it to Mesh and retriggers
+ *  the sensor. Mesh queues the face mesh job of the next face of the frame
+ *  before it waits for the current one, so the NPU runs face i+1 while face
+ *  i is post-processed. Iris crops both eyes and submits them back to back
+ *  on the iris model, post-processing the left eye while the right one
+ *  runs. Uplink collects the faces of each frame, returns them, sends the
+ *  frame (UART JSON and/or SPI, as set by the PC tool) and returns it.
+ *
+ *  The three interpreters share one tensor arena, so tensors are only
+ *  touched by the invoke functions, which all run on Npu; everything else
+ *  works on the buffers of the tokens. Frames and faces move between the
+ *  processes as pointers: whoever holds the pointer owns the buffer. Each
+ *  return channel holds every token, so returning never blocks. With the
+ *  faces of a frame in order on one chain, Mesh only waits for a face that
+ *  Detect can produce as long as there are two face tokens.
+ */
+#if TFLM_FD_FM_CSP
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <forward_list>
+#include <string>
+#include "csp/csp4cmsis.h"
+
+#include "WE2_core.h"
+#include "xprintf.h"
+#include "sensor_dp_lib.h"
+#include "spi_master_protocol.h"
+#include "common_config.h"
+#include "cisdp_sensor.h"
+#include "cvapp_fd_fm.h"
+#include "memory_manage.h"
+#include "csp_cascade.h"
+#include <send_result.h>
+extern "C" {
+#include "event_handler.h"
+}
+
+using namespace csp;
+
+#if TFLM_FD_FM_CSP_ROIS < 2
+#error "TFLM_FD_FM_CSP_ROIS must be at least 2"
+#endif
+
+#define CSP_CASCADE_EYE_POINTS	16
+
+/* The FreeRTOS heap (configAPPLICATION_ALLOCATED_HEAP) goes to system SRAM */
+extern "C" {
+CSP_PLACE_BULK uint8_t ucHeap[configTOTAL_HEAP_SIZE];
+}
+
+namespace {
+
+	enum Stage { STAGE_DETECT, STAGE_CROP, STAGE_MESH, STAGE_IRIS, STAGE_UPLINK, STAGE_COUNT };
+
+	struct FrameSlot {
+		int8_t *input;				// Detect's staging buffer, while face detection runs
+		uint8_t *jpeg;
+		uint32_t jpeg_sz;
+		int status;
+		int faces;					// Face tokens that follow it to Uplink
+		HrTime captured;
+		uint64_t cycles[STAGE_COUNT];
+		struct_algoResult detections;
+	};
+
+	struct Roi {
+		FrameSlot *frame;
+		int index;					// Face of the frame, biggest first
+		uint8_t *face;				// Square face, resized to the face mesh input (planes)
+		int8_t *output;				// Face mesh outputs
+		int8_t *output2;
+		int status;
+		bool tracked;				// Mesh score >= 0.35: iris and angles ran
+		struct_position eye_r[CSP_CASCADE_EYE_POINTS];
+		struct_position eye_l[CSP_CASCADE_EYE_POINTS];
+		uint64_t cycles[STAGE_COUNT];
+		struct_fm_algoResult_with_fps result;	// This face's, in face_bbox[0]
+	};
+
+	/* One eye on the iris model; LR as crop_single_eye_IL(): 0 left, 1 right */
+	struct Eye {
+		int lr;
+		uint8_t *crop;
+		int8_t *input;
+		int8_t *output;
+		int8_t *output2;
+		struct_position center;
+	};
+
+	FrameSlot slots[TFLM_FD_FM_CSP_FRAMES];
+	CSP_PLACE_BULK Roi rois[TFLM_FD_FM_CSP_ROIS];
+	Eye eyes[2];
+	int8_t *fd_input;
+	uint8_t *crop_scratch;
+	uint32_t jpeg_capacity;
+
+	using FrameChannel = BufferedOne2OneChannel<FrameSlot*, TFLM_FD_FM_CSP_FRAMES>;
+	using RoiChannel = BufferedOne2OneChannel<Roi*, TFLM_FD_FM_CSP_ROIS>;
+
+	/* Run on the Npu process, which registers them as "fd", "fm" and "il" */
+	int invoke_fd(void *arg)
+	{
+		FrameSlot *slot = static_cast<FrameSlot *>(arg);
+		return cv_fd_fm_fd_invoke(slot->input, &slot->detections);
+	}
+
+	int invoke_fm(void *arg)
+	{
+		Roi *roi = static_cast<Roi *>(arg);
+		return cv_fd_fm_fm_invoke(roi->face, roi->output, roi->output2);
+	}
+
+	int invoke_il(void *arg)
+	{
+		Eye *eye = static_cast<Eye *>(arg);
+		return cv_fd_fm_il_invoke(eye->input, eye->output, eye->output2);
+	}
+
+	/**
+	 * @brief Runs the hxevent loop; frame() is called from its datapath
+	 * callback. Blocks for a free frame slot and for each face token,
+	 * which throttles the sensor to the speed of the slowest stage.
+	 */
+	class Detect : public CSProcess {
+	private:
+		Chanin<FrameSlot*> free_slots;
+		Chanin<Roi*> free_rois;
+		Chanout<NpuJob> npu_requests;
+		Chanin<NpuJob> npu_responses;
+		Chanout<FrameSlot*> frames;
+		Chanout<Roi*> faces;
+		size_t fresh_slots = 0;
+		size_t fresh_rois = 0;
+	public:
+		Detect(Chanin<FrameSlot*> fs, Chanin<Roi*> fr, Chanout<NpuJob> rq, Chanin<NpuJob> rs,
+			   Chanout<FrameSlot*> f, Chanout<Roi*> o)
+			: free_slots(fs), free_rois(fr), npu_requests(rq), npu_responses(rs), frames(f), faces(o) {}
+		const char* name() const override { return "detect"; }
+
+		void frame(uint32_t jpeg_addr, uint32_t jpeg_sz) {
+			FrameSlot *slot;
+			NpuJob job;
+			if (fresh_slots < TFLM_FD_FM_CSP_FRAMES) slot = &slots[fresh_slots++];
+			else free_slots >> slot;
+
+			slot->captured = HrNow();
+			Stopwatch watch;
+			cv_fd_fm_fd_preprocess(fd_input);
+			slot->input = fd_input;
+			memset(&slot->detections, 0, sizeof(slot->detections));
+			// Npu blocks on the NPU interrupt: the other processes run meanwhile
+			job.arg = slot;
+			npu_requests << job;
+			npu_responses >> job;
+			slot->input = nullptr;
+			slot->status = job.status;
+			slot->faces = (job.status == 0) ? slot->detections.num_tracked_human_targets : 0;
+
+			// The next capture overwrites the JPEG buffer: keep a copy
+			if (jpeg_sz > jpeg_capacity) jpeg_sz = jpeg_capacity;
+			hx_InvalidateDCache_by_Addr((volatile void *)jpeg_addr, jpeg_sz);
+			memcpy(slot->jpeg, (const void *)jpeg_addr, jpeg_sz);
+			hx_CleanDCache_by_Addr((volatile void *)slot->jpeg, jpeg_sz);
+			slot->jpeg_sz = jpeg_sz;
+			slot->cycles[STAGE_DETECT] = watch.lap().to_cycles();
+			frames << slot;
+
+			// Every face is cropped before the sensor overwrites the raw frame
+			for (int i = 0; i < slot->faces; ++i) {
+				Roi *roi;
+				if (fresh_rois < TFLM_FD_FM_CSP_ROIS) roi = &rois[fresh_rois++];
+				else free_rois >> roi;
+				watch.start();
+				const struct_algoResult &det = slot->detections;
+				memset(&roi->result, 0, sizeof(roi->result));
+				memset(roi->cycles, 0, sizeof(roi->cycles));
+				roi->frame = slot;
+				roi->index = i;
+				roi->status = -1;
+				roi->tracked = false;
+				roi->result.num_tracked_face_targets = 1;
+				roi->result.face_bbox[0].x = (uint16_t)det.ht[i].upper_body_bbox.x;
+				roi->result.face_bbox[0].y = (uint16_t)det.ht[i].upper_body_bbox.y;
+				roi->result.face_bbox[0].width = (uint16_t)det.ht[i].upper_body_bbox.width;
+				roi->result.face_bbox[0].height = (uint16_t)det.ht[i].upper_body_bbox.height;
+				roi->result.face_bbox[0].face_score = (uint16_t)det.ht[i].upper_body_score;
+				cv_fd_fm_crop_face(&roi->result.face_bbox[0], roi->face, crop_scratch);
+				roi->cycles[STAGE_CROP] = watch.lap().to_cycles();
+				faces << roi;
+			}
+
+			sensordplib_retrigger_capture();
+		}
+
+		void run() override {
+			event_handler_start();
+		}
+	};
+
+	Detect *detect = nullptr;
+
+	/**
+	 * @brief Runs face mesh on each face. Keeps the NPU busy across the
+	 * faces of a frame: the next face's job is queued before the current
+	 * one is waited for and post-processed.
+	 */
+	class Mesh : public CSProcess {
+	private:
+		Chanin<Roi*> in;
+		Chanout<NpuJob> npu_requests;
+		Chanin<NpuJob> npu_responses;
+		Chanout<Roi*> out;
+
+		void submit(Roi *roi) {
+			NpuJob job;
+			job.arg = roi;
+			npu_requests << job;
+		}
+
+		// Responses come back in submission order: one model, one NPU
+		void finish(Roi *roi) {
+			NpuJob job;
+			npu_responses >> job;
+			Stopwatch watch;
+			roi->status = job.status;
+			if (job.status == 0) {
+				roi->tracked = cv_fd_fm_fm_postprocess(roi->output, roi->output2, &roi->result,
+													   roi->eye_r, roi->eye_l) != 0;
+			}
+			roi->cycles[STAGE_MESH] = job.npu_cycles + watch.lap().to_cycles();
+		}
+
+	public:
+		Mesh(Chanin<Roi*> i, Chanout<NpuJob> rq, Chanin<NpuJob> rs, Chanout<Roi*> o)
+			: in(i), npu_requests(rq), npu_responses(rs), out(o) {}
+		const char* name() const override { return "mesh"; }
+
+		void run() override {
+			Roi *roi, *next;
+			in >> roi;
+			submit(roi);
+			while (true) {
+				next = nullptr;
+				if (roi->index + 1 < roi->frame->faces) {
+					in >> next;
+					submit(next);
+				}
+				finish(roi);
+				out << roi;
+				if (next != nullptr) {
+					roi = next;
+				} else {
+					in >> roi;
+					submit(roi);
+				}
+			}
+		}
+	};
+
+	/**
+	 * @brief Runs iris landmark on both eyes of each tracked face, then the
+	 * face angles. The eyes go to the NPU back to back on the same model.
+	 */
+	class Iris : public CSProcess {
+	private:
+		Chanin<Roi*> in;
+		Chanout<NpuJob> npu_requests;
+		Chanin<NpuJob> npu_responses;
+		Chanout<Roi*> out;
+
+		void track(Roi *roi) {
+			Eye &left = eyes[0], &right = eyes[1];
+			NpuJob job;
+			cv_fd_fm_crop_eye(roi->face, roi->eye_l, left.lr, &left.center, left.crop, left.input);
+			job.arg = &left;
+			npu_requests << job;
+			cv_fd_fm_crop_eye(roi->face, roi->eye_r, right.lr, &right.center, right.crop, right.input);
+			job.arg = &right;
+			npu_requests << job;
+
+			for (Eye *eye : { &left, &right }) {
+				npu_responses >> job;
+				if (job.status == 0) {
+					cv_fd_fm_il_postprocess(eye->output, eye->output2, &roi->result, &eye->center, eye->lr);
+				}
+			}
+			cv_fd_fm_angles(&roi->result);
+		}
+
+	public:
+		Iris(Chanin<Roi*> i, Chanout<NpuJob> rq, Chanin<NpuJob> rs, Chanout<Roi*> o)
+			: in(i), npu_requests(rq), npu_responses(rs), out(o) {}
+		const char* name() const override { return "iris"; }
+
+		void run() override {
+			Roi *roi;
+			while (true) {
+				in >> roi;
+				Stopwatch watch;
+				if (roi->tracked) track(roi);
+				roi->cycles[STAGE_IRIS] = watch.lap().to_cycles();
+				out << roi;
+			}
+		}
+	};
+
+	/**
+	 * @brief Collects the faces of each frame, sends the frame and returns
+	 * its tokens. Also accumulates the stage times and reports them every
+	 * TFLM_FD_FM_CSP_REPORT_FRAMES frames.
+	 */
+	class Uplink : public CSProcess {
+	private:
+		Chanin<FrameSlot*> frames;
+		Chanin<Roi*> in;
+		Chanout<FrameSlot*> free_slots;
+		Chanout<Roi*> free_rois;
+		bool spi_open = false;
+		uint32_t frame_count = 0;
+		uint32_t face_count = 0;
+		uint64_t totals[STAGE_COUNT] = {};
+		uint64_t latency = 0;
+		Stopwatch window;
+		std::forward_list<el_fm_point_t> points;
+		struct_fm_algoResult_with_fps summary;	// SPI: face_bbox[] of the frame, mesh and iris of the biggest face
+
+		void collect(FrameSlot *slot, Roi *roi) {
+			if (roi->index == 0) summary = roi->result;
+			points.emplace_front();
+			cv_fd_fm_result_to_point(&roi->result, roi->index, &points.front());
+			for (int s = STAGE_CROP; s <= STAGE_IRIS; ++s) slot->cycles[s] += roi->cycles[s];
+		}
+
+		void send(FrameSlot *slot) {
+			const struct_algoResult &det = slot->detections;
+			if (slot->faces == 0) memset(&summary, 0, sizeof(summary));
+			for (int i = 0; i < MAX_TRACKED_ALGO_RES; ++i) {
+				summary.face_bbox[i].x = (uint16_t)det.ht[i].upper_body_bbox.x;
+				summary.face_bbox[i].y = (uint16_t)det.ht[i].upper_body_bbox.y;
+				summary.face_bbox[i].width = (uint16_t)det.ht[i].upper_body_bbox.width;
+				summary.face_bbox[i].height = (uint16_t)det.ht[i].upper_body_bbox.height;
+				summary.face_bbox[i].face_score = (uint16_t)det.ht[i].upper_body_score;
+			}
+			summary.num_tracked_face_targets = (short)slot->faces;
+			summary.algo_tick = (uint32_t)(slot->cycles[STAGE_DETECT] + slot->cycles[STAGE_CROP]
+										   + slot->cycles[STAGE_MESH] + slot->cycles[STAGE_IRIS]);
+
+			uint32_t judge_case_data;
+			hx_drv_swreg_aon_get_appused1(&judge_case_data);
+			uint32_t trans_type = (judge_case_data >> 16);
+#ifdef UART_SEND_ALOGO_RESEULT
+			if (trans_type == 0 || trans_type == 2) {// transfer type is (UART) or (UART & SPI)
+				el_img_t img = el_img_t{};
+				img.data = slot->jpeg;
+				img.size = slot->jpeg_sz;
+				img.width = app_get_raw_width();
+				img.height = app_get_raw_height();
+				img.format = EL_PIXEL_FORMAT_JPEG;
+				img.rotate = EL_PIXEL_ROTATE_0;
+
+				std::forward_list<el_box_t> boxes;
+				for (int i = 0; i < MAX_TRACKED_ALGO_RES; ++i) {
+					el_box_t box;
+					box.x = summary.face_bbox[i].x;
+					box.y = summary.face_bbox[i].y;
+					box.w = summary.face_bbox[i].width;
+					box.h = summary.face_bbox[i].height;
+					box.score = summary.face_bbox[i].face_score;
+					box.target = i;
+					boxes.emplace_front(box);
+				}
+
+				send_device_id();
+				event_reply(concat_strings(", ", fm_face_bbox_results_2_json_str(boxes), ", ",
+						algo_tick_2_json_str(summary.algo_tick), ", ", fm_point_results_2_json_str(points), ", ",
+						img_2_json_str(&img)));
+			}
+			bool use_spi = (trans_type == 1 || trans_type == 2);
+#else
+			(void)trans_type;
+			bool use_spi = true;
+#endif
+#if FRAME_CHECK_DEBUG
+			if (use_spi && !spi_open) {
+				if (hx_drv_spi_mst_open_speed(SPI_SEN_PIC_CLK) != 0) {
+					xprintf("DEBUG SPI master init fail\r\n");
+				} else {
+					spi_open = true;
+				}
+			}
+			if (use_spi && spi_open) {
+				hx_drv_spi_mst_protocol_write_sp((uint32_t)slot->jpeg, slot->jpeg_sz, DATA_TYPE_JPG);
+				hx_drv_spi_mst_protocol_write_sp((uint32_t)&summary, sizeof(struct_fm_algoResult_with_fps),
+						DATA_TYPE_META_FM_WITH_FPS_DATA);
+			}
+#else
+			(void)use_spi;
+#endif
+#ifdef UART_SEND_ALOGO_RESEULT
+			set_model_change_by_uart();
+#endif
+		}
+
+		void account(FrameSlot *slot) {
+			for (int s = 0; s < STAGE_COUNT; ++s) totals[s] += slot->cycles[s];
+			latency += (HrNow() - slot->captured).to_cycles();
+			face_count += slot->faces;
+			if (TFLM_FD_FM_CSP_REPORT_FRAMES == 0 || ++frame_count < TFLM_FD_FM_CSP_REPORT_FRAMES) return;
+
+			const uint32_t per_face = (face_count != 0) ? face_count : 1;
+			uint64_t window_us = window.lap().to_microseconds();
+			uint32_t fps_x10 = (window_us != 0) ? (uint32_t)(frame_count * 10000000ull / window_us) : 0;
+			uint32_t faces_x10 = (window_us != 0) ? (uint32_t)(face_count * 10000000ull / window_us) : 0;
+			xprintf("[cascade] %u frames %u faces, avg us per frame: detect %u crop %u uplink %u, latency %u; "
+					"per face: mesh %u iris %u; %u.%u fps, %u.%u faces/s\r\n",
+					(unsigned)frame_count, (unsigned)face_count,
+					(unsigned)HrTime(totals[STAGE_DETECT] / frame_count).to_microseconds(),
+					(unsigned)HrTime(totals[STAGE_CROP] / frame_count).to_microseconds(),
+					(unsigned)HrTime(totals[STAGE_UPLINK] / frame_count).to_microseconds(),
+					(unsigned)HrTime(latency / frame_count).to_microseconds(),
+					(unsigned)HrTime(totals[STAGE_MESH] / per_face).to_microseconds(),
+					(unsigned)HrTime(totals[STAGE_IRIS] / per_face).to_microseconds(),
+					(unsigned)(fps_x10 / 10), (unsigned)(fps_x10 % 10),
+					(unsigned)(faces_x10 / 10), (unsigned)(faces_x10 % 10));
+			frame_count = 0;
+			face_count = 0;
+			latency = 0;
+			for (int s = 0; s < STAGE_COUNT; ++s) totals[s] = 0;
+		}
+
+	public:
+		Uplink(Chanin<FrameSlot*> f, Chanin<Roi*> i, Chanout<FrameSlot*> fs, Chanout<Roi*> fr)
+			: frames(f), in(i), free_slots(fs), free_rois(fr) {}
+		const char* name() const override { return "uplink"; }
+
+		void run() override {
+			FrameSlot *slot;
+			Roi *roi;
+			window.start();
+			while (true) {
+				frames >> slot;
+				// Faces are returned as they arrive: Detect may need them for this frame
+				for (int i = 0; i < slot->faces; ++i) {
+					in >> roi;
+					collect(slot, roi);
+					free_rois << roi;
+				}
+				Stopwatch watch;
+				send(slot);
+				slot->cycles[STAGE_UPLINK] = watch.lap().to_cycles();
+				account(slot);
+
+				points.clear();
+				memset(slot->cycles, 0, sizeof(slot->cycles));
+				free_slots << slot;
+			}
+		}
+	};
+
+	bool reserve_buffers() {
+		// Size of the JPEG (WDMA1) buffer of cisdp_sensor.c
+		jpeg_capacity = app_get_raw_width() * app_get_raw_height() / 4;
+
+		fd_input = (int8_t *)mm_reserve_align(cv_fd_fm_fd_input_bytes(), 0x20);
+		crop_scratch = (uint8_t *)mm_reserve_align(cv_fd_fm_crop_scratch_bytes(), 0x20);
+		if (fd_input == nullptr || crop_scratch == nullptr) return false;
+		for (int i = 0; i < TFLM_FD_FM_CSP_FRAMES; ++i) {
+			slots[i].jpeg = (uint8_t *)mm_reserve_align(jpeg_capacity, 0x20);
+			if (slots[i].jpeg == nullptr) return false;
+		}
+		for (int i = 0; i < TFLM_FD_FM_CSP_ROIS; ++i) {
+			rois[i].face = (uint8_t *)mm_reserve_align(cv_fd_fm_face_bytes(), 0x20);
+			rois[i].output = (int8_t *)mm_reserve_align(cv_fd_fm_fm_output_bytes(0), 0x20);
+			rois[i].output2 = (int8_t *)mm_reserve_align(cv_fd_fm_fm_output_bytes(1), 0x20);
+			if (rois[i].face == nullptr || rois[i].output == nullptr || rois[i].output2 == nullptr) return false;
+		}
+		for (int i = 0; i < 2; ++i) {
+			eyes[i].lr = i;
+			eyes[i].crop = (uint8_t *)mm_reserve_align(cv_fd_fm_eye_crop_bytes(), 0x20);
+			eyes[i].input = (int8_t *)mm_reserve_align(cv_fd_fm_eye_input_bytes(), 0x20);
+			eyes[i].output = (int8_t *)mm_reserve_align(cv_fd_fm_il_output_bytes(0), 0x20);
+			eyes[i].output2 = (int8_t *)mm_reserve_align(cv_fd_fm_il_output_bytes(1), 0x20);
+			if (eyes[i].crop == nullptr || eyes[i].input == nullptr || eyes[i].output == nullptr
+				|| eyes[i].output2 == nullptr) return false;
+		}
+		return true;
+	}
+
+} // namespace
+
+void csp_cascade_frame(uint32_t jpeg_addr, uint32_t jpeg_sz)
+{
+	detect->frame(jpeg_addr, jpeg_sz);
+}
+
+void csp_cascade_idle(void)
+{
+	os::delay(1);
+}
+
+void csp_cascade_start(void)
+{
+	if (!reserve_buffers()) {
+		xprintf("csp cascade: out of memory for %d frames and %d faces, lower TFLM_FD_FM_CSP_FRAMES/ROIS\r\n",
+				TFLM_FD_FM_CSP_FRAMES, TFLM_FD_FM_CSP_ROIS);
+		return;
+	}
+
+	CSP_PLACE_BULK static FrameChannel to_uplink, slot_return;
+	CSP_PLACE_BULK static RoiChannel to_mesh, to_iris, roi_uplink, roi_return;
+	CSP_PLACE_BULK static BufferedOne2OneChannel<NpuJob, 1> fd_requests, fm_requests, il_requests;
+	CSP_PLACE_BULK static One2OneChannel<NpuJob> fd_responses;
+	// Mesh and Iris have two jobs out at a time: Npu must not wait for them to read a response
+	CSP_PLACE_BULK static BufferedOne2OneChannel<NpuJob, 2> fm_responses, il_responses;
+
+	CSP_PLACE_BULK static Pinned<Detect, 1024> proc_detect(slot_return.reader(), roi_return.reader(),
+														   fd_requests.writer(), fd_responses.reader(),
+														   to_uplink.writer(), to_mesh.writer());
+	CSP_PLACE_BULK static Pinned<Mesh, 1024>   proc_mesh(to_mesh.reader(), fm_requests.writer(), fm_responses.reader(),
+														 to_iris.writer());
+	CSP_PLACE_BULK static Pinned<Iris, 1024>   proc_iris(to_iris.reader(), il_requests.writer(), il_responses.reader(),
+														 roi_uplink.writer());
+	CSP_PLACE_BULK static Pinned<NpuInferenceProcess, 1024> proc_npu(TFLM_FD_FM_CSP_REPORT_FRAMES);
+	CSP_PLACE_BULK static Pinned<Uplink, 2048> proc_uplink(to_uplink.reader(), roi_uplink.reader(),
+														   slot_return.writer(), roi_return.writer());
+	detect = &proc_detect;
+	proc_npu.attach({ "fd", invoke_fd }, fd_requests.reader(), fd_responses.writer());
+	proc_npu.attach({ "fm", invoke_fm }, fm_requests.reader(), fm_responses.writer());
+	proc_npu.attach({ "il", invoke_il }, il_requests.reader(), il_responses.writer());
+
+	// Source first keeps the NPU fed. The return channels are left out:
+	// they close the loop and carry no work.
+	Topology topology;
+	topology.connect(proc_detect, proc_npu)
+			.connect(proc_detect, proc_mesh)
+			.connect(proc_mesh, proc_npu)
+			.connect(proc_mesh, proc_iris)
+			.connect(proc_iris, proc_npu)
+			.connect(proc_iris, proc_uplink)
+			.connect(proc_detect, proc_uplink);
+
+	xprintf("csp cascade: %d frames, %d faces in flight\r\n", TFLM_FD_FM_CSP_FRAMES, TFLM_FD_FM_CSP_ROIS);
+	// Each process gets a thread on its own stack, Detect's runs the event
+	// loop; none of them runs before the scheduler starts
+	Run(InParallel(proc_detect, proc_mesh, proc_iris, proc_npu, proc_uplink),
+		ExecutionMode::StaticNetwork, PriorityPolicy::SourceFirst, topology);
+
+	vTaskStartScheduler();
+}
+#endif /* TFLM_FD_FM_CSP */
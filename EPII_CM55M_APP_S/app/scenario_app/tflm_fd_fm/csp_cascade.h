@@ -0,0 +1,50 @@
+/*
+ * csp_cascade.h
+ *
+ *  Cascade build of tflm_fd_fm (TFLM_FD_FM_CSP=1): face detection, face mesh,
+ *  iris landmark and uplink run as csp4cmsis processes. Detection emits one
+ *  token per face, so every face goes through mesh and iris, and the three
+ *  models share the NPU.
+ */
+
+#ifndef SCENARIO_TFLM_FD_FM_CSP_CASCADE_
+#define SCENARIO_TFLM_FD_FM_CSP_CASCADE_
+
+#include <stdint.h>
+
+/* Frames in flight: each one holds its JPEG and detections */
+#ifndef TFLM_FD_FM_CSP_FRAMES
+#define TFLM_FD_FM_CSP_FRAMES	2
+#endif
+
+/* Faces in flight (at least 2): each one holds its resized face, mesh outputs and result */
+#ifndef TFLM_FD_FM_CSP_ROIS
+#define TFLM_FD_FM_CSP_ROIS	4
+#endif
+
+/* Per-stage timing report, every N frames (0: off) */
+#ifndef TFLM_FD_FM_CSP_REPORT_FRAMES
+#define TFLM_FD_FM_CSP_REPORT_FRAMES	30
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Reserves the frame and face buffers, starts the processes and the scheduler.
+ * Call after cv_fd_fm_init() and app_start_state(); does not return.
+ */
+void csp_cascade_start(void);
+
+/* Frame-ready hook of the datapath event callback (detect process) */
+void csp_cascade_frame(uint32_t jpeg_addr, uint32_t jpeg_sz);
+
+/* hxevent idle callback: lets the other processes run between events */
+void csp_cascade_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCENARIO_TFLM_FD_FM_CSP_CASCADE_ */
@@ -26,9 +26,15 @@
 #include "tensorflow/lite/c/common.h"
 #if TFLM2209_U55TAG2205
 #include "tensorflow/lite/micro/micro_error_reporter.h"
+#else
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tflm_arena_tflm.h"
 #endif
 #include "img_proc_helium.h"
+#include "img_proc_fused.h"
+#include "img_proc_strip.h"
 #include "yolo_postprocessing.h"
+#include "yolo_nms.h"
 #include "pose_processing.h"
 
 
@@ -38,6 +44,9 @@
 #include "memory_manage.h"
 #include "common_config.h"
 #include "send_result.h"
+#if TFLM_FD_FM_CSP
+#include "FreeRTOS.h"
+#endif
 
 #ifdef TRUSTZONE_SEC
 #define U55_BASE	BASE_ADDR_APB_U55_CTRL_ALIAS
@@ -92,6 +101,17 @@
 #define TOTAL_STEP_TICK 1
 #define CPU_CLK	0xffffff+1
 static uint32_t capture_image_tick = 0;
+
+/* Face candidates above the score threshold, before NMS */
+#define FD_MAX_CANDIDATES 256
+static uint16_t cand_anchor[FD_MAX_CANDIDATES];
+static uint16_t cand_class[FD_MAX_CANDIDATES];
+static float cand_score[FD_MAX_CANDIDATES];
+static float cand_x[FD_MAX_CANDIDATES];
+static float cand_y[FD_MAX_CANDIDATES];
+static float cand_w[FD_MAX_CANDIDATES];
+static float cand_h[FD_MAX_CANDIDATES];
+static yolo_nms_work_t nms_work;
 //left eyes indices #16 point
 int LEFT_EYE_mesh_index[16] ={ 362, 382, 381, 380, 374, 373, 390, 249, 263, 466, 388, 387, 386, 385,384, 398 };
 
@@ -160,8 +180,10 @@ using namespace std;
 
 namespace {
 
+#if TFLM2209_U55TAG2205
 //constexpr int tensor_arena_size_second_model_tail_size = 736 ;
 constexpr int tensor_arena_model_tail_size = 1224;//568;
+#endif
 constexpr int tensor_arena_size = 460*1024;//435*1024;
 #ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
 constexpr int resize_image_size = FM_INPUT_TENSOR_WIDTH*FM_INPUT_TENSOR_HEIGHT*COLOR_CHANNEL;
@@ -173,7 +195,7 @@ constexpr int crop_image_size = CROP_IMAGE_WIDTH*CROP_IMAGE_HEIGHT;
 constexpr int crop_eye_size = IL_INPUT_TENSOR_WIDTH*IL_INPUT_TENSOR_HEIGHT; //64*64 = 4096 = 0x1000
 #endif
 
-static uint32_t tensor_arena=0, resized_img=0, crop_img=0,pad_img=0;;
+static uint32_t tensor_arena=0, resized_img=0, strip_scratch=0;
 static uint32_t crop_eye_l=0,crop_eye_r = 0;
 
 struct ethosu_driver ethosu_drv; /* Default Ethos-U device driver */
@@ -184,12 +206,17 @@ tflite::MicroInterpreter *fm_int_ptr=nullptr;
 TfLiteTensor *fm_input, *fm_output, *fm_output2;
 
 tflite::MicroInterpreter *il_int_ptr=nullptr;
-TfLiteTensor *il_input, *il_output;
+TfLiteTensor *il_input, *il_output, *il_output2;
 
 network fd_net;
 static uint32_t g_fd_fm_init = 0, g_image_mapping_init = 0;
 
 static tflite::MicroMutableOpResolver<2> op_resolver;
+#if !TFLM2209_U55TAG2205
+/* fd, fm and il run one at a time: their scratch overlays in tensor_arena */
+static tflm_arena_t arena_plan;
+static int fd_arena_id, fm_arena_id, il_arena_id;
+#endif
 /*struct_algoResult algoresult;
 constexpr int resize_image_temp_buffer_size = MAX_RESIZE_IMAGE_SIDE_LENGTTH*MAX_RESIZE_IMAGE_SIDE_LENGTTH;
 static uint8_t resize_imaage_temp_buffer[resize_image_temp_buffer_size]  __attribute__((section(".resize_image_buffer")));
@@ -241,32 +268,6 @@ static void Y_to_YYY(uint8_t*in_image, int8_t*out_image,int32_t in_image_width,
 			}
 	}
 
-}
-//TODO maybe use helium optimize
-static void BGRU3C_to_GRAY(uint8_t*in_image, int8_t*out_image,int32_t in_image_width, int32_t in_image_height)
-{
-	int32_t x,y;
-	uint8_t *b_image=in_image, *g_image= in_image+in_image_width*in_image_height, *r_image = g_image+in_image_width*in_image_height;
-	
-	//channel adjust (in_image BBBBBB/GGGGGG/RRRRRR => out_image RGBRGB)
-	for (y = 0; y < in_image_height; y++) {//compute new pixels
-			for (x = 0; x < in_image_width; x++) {
-				int32_t b,g,r;
-				b = b_image[y * in_image_width + x];
-				g = g_image[y * in_image_width + x];
-				r = r_image[y * in_image_width + x];
-
-				#if 0
-					out_image[(in_image_width*y+x)] = (int8_t)((b+g+r)/3-128);
-				#else
-					int16_t r_i = int16_t((float)r*(float)0.299); 
-					int16_t g_i = int16_t((float)g*(float)0.587); 
-					int16_t b_i = int16_t((float)b*(float)0.144); 
-					out_image[(in_image_width*y+x)] = (int8_t)((b_i+g_i+r_i)-128);
-				#endif
-			}
-	}
-
 }
 
 static network yolo_post_processing_init(TfLiteTensor* out_ten, TfLiteTensor* out2_ten)
@@ -295,23 +296,27 @@ static network yolo_post_processing_init(TfLiteTensor* out_ten, TfLiteTensor* ou
 
 static void yolo_post_processing(network* net, struct_algoResult *alg_result)
 {
-	int nboxes=0;
 	float thresh = .50;
 	float nms = .45;
 	uint8_t counter = 0;
 	uint32_t sensor_width = app_get_raw_width();
 	uint32_t sensor_height = app_get_raw_height();
 
-	std::forward_list<detection> dets = get_network_boxes(net, sensor_width, sensor_height, thresh, &nboxes);
+	yolo_post_cands_t cands = { cand_anchor, cand_class, cand_score, { cand_x, cand_y, cand_w, cand_h }, FD_MAX_CANDIDATES, 0, 0 };
+	get_network_cands(net, sensor_width, sensor_height, thresh, &cands);
 #ifdef FD_FL_DEBUG
-	dbg_printf(DBG_LESS_INFO,"box:%d\n",nboxes);
+	dbg_printf(DBG_LESS_INFO,"box:%d\n",cands.count);
 #endif
 
 	//clear_alg_rsult(&alg_result);
-	// do nms
-	diounms_sort(dets, net->num_classes, nms);
-
-	for (std::forward_list<detection>::iterator it=dets.begin(); it != dets.end(); ++it){
+	// do nms: DIoU per class as diounms_sort(), on the candidate arrays
+	uint16_t nms_keep[MAX_TRACKED_ALGO_RES];
+	uint32_t nms_count = yolo_nms(&cands.box, cand_score, cand_class, cands.count, nms, 0.6f,
+		MAX_TRACKED_ALGO_RES, &nms_work, nms_keep);
+
+	for (uint32_t i = 0; i < nms_count; i++){
+		int idx = nms_keep[i];
+		box bbox = { cand_x[idx] + cand_w[idx] / 2, cand_y[idx] + cand_h[idx] / 2, cand_w[idx], cand_h[idx] };
 		/**************
 		 *
 		 * To let FD bbox do not too tight to do FL
@@ -336,10 +341,10 @@ static void yolo_post_processing(network* net, struct_algoResult *alg_result)
 
 		float box_scale_factor = 1.6;//1.8;
 
-		float ymin = it->bbox.y - ((it->bbox.h * box_scale_factor) / 2.);
-		float xmin = it->bbox.x - ((it->bbox.w * box_scale_factor) / 2.);
-		float xmax = it->bbox.x + ((it->bbox.w * box_scale_factor) / 2.);
-		float ymax = it->bbox.y + ((it->bbox.h * box_scale_factor) / 2.);
+		float ymin = bbox.y - ((bbox.h * box_scale_factor) / 2.);
+		float xmin = bbox.x - ((bbox.w * box_scale_factor) / 2.);
+		float xmax = bbox.x + ((bbox.w * box_scale_factor) / 2.);
+		float ymax = bbox.y + ((bbox.h * box_scale_factor) / 2.);
 
 		if (xmin < 0) xmin = 0;
 		if (ymin < 0) ymin = 0;
@@ -350,30 +355,55 @@ static void yolo_post_processing(network* net, struct_algoResult *alg_result)
 		float by = ymin;
 		float bw = xmax - xmin;
 		float bh = ymax - ymin;
-		for (int j = 0; j < net->num_classes; ++j) {
-			if (it->prob[j] > 0 && counter < MAX_TRACKED_ALGO_RES) {
-				#ifdef FD_DEBUG
-				xprintf("{%d \"bbox\":[%d, %d, %d, %d], \"score\":%d},\n", j, (int)(bx), (int)(by), (int)(bw), (int)(bh), (int)(it->prob[j]*100));
-				xprintf("xmin: %d, ymin:%d, xmax: %d, ymax: %d\n",(int)(bx), (int)(by), (int)(bx+bw), (int)(by+bh));
-				#endif
-				alg_result->ht[counter].upper_body_score = (uint32_t)(it->prob[j]*100);
-				alg_result->ht[counter].upper_body_bbox.x = (uint32_t)(bx);      //xmin
-				alg_result->ht[counter].upper_body_bbox.y = (uint32_t)(by);      //ymin
-				alg_result->ht[counter].upper_body_bbox.width = (uint32_t)(bw);  //xmax
-				alg_result->ht[counter].upper_body_bbox.height = (uint32_t)(bh); //ymax
-				alg_result->ht[counter].upper_body_scale = j;
-				counter++;
-				alg_result->num_tracked_human_targets++;
-			}
+		int j = cand_class[idx];
+		if (counter < MAX_TRACKED_ALGO_RES) {
+			#ifdef FD_DEBUG
+			xprintf("{%d \"bbox\":[%d, %d, %d, %d], \"score\":%d},\n", j, (int)(bx), (int)(by), (int)(bw), (int)(bh), (int)(cand_score[idx]*100));
+			xprintf("xmin: %d, ymin:%d, xmax: %d, ymax: %d\n",(int)(bx), (int)(by), (int)(bx+bw), (int)(by+bh));
+			#endif
+			alg_result->ht[counter].upper_body_score = (uint32_t)(cand_score[idx]*100);
+			alg_result->ht[counter].upper_body_bbox.x = (uint32_t)(bx);      //xmin
+			alg_result->ht[counter].upper_body_bbox.y = (uint32_t)(by);      //ymin
+			alg_result->ht[counter].upper_body_bbox.width = (uint32_t)(bw);  //xmax
+			alg_result->ht[counter].upper_body_bbox.height = (uint32_t)(bh); //ymax
+			alg_result->ht[counter].upper_body_scale = j;
+			counter++;
+			alg_result->num_tracked_human_targets++;
 		}
 		#ifdef FD_DEBUG
 		xprintf("alg_result->num_tracked_human_targets: %d\r\n",alg_result->num_tracked_human_targets);
 		#endif
 	}
-	free_dets(dets);
 	//free((net->branchs));
 }
 
+/* Moves the biggest face to ht[0]: face mesh and iris run on that one */
+static void sort_biggest_face(struct_algoResult *alg_result)
+{
+	for(int i=0;i<MAX_TRACKED_ALGO_RES;i++)
+	{
+		if((alg_result->ht[0].upper_body_bbox.width*alg_result->ht[0].upper_body_bbox.height)<(alg_result->ht[i].upper_body_bbox.width*alg_result->ht[i].upper_body_bbox.height))
+		{
+			uint32_t temp_width = alg_result->ht[0].upper_body_bbox.width;
+			uint32_t temp_height = alg_result->ht[0].upper_body_bbox.height;
+			uint32_t temp_x = alg_result->ht[0].upper_body_bbox.x;
+			uint32_t temp_y = alg_result->ht[0].upper_body_bbox.y;
+			uint32_t temp_score = alg_result->ht[0].upper_body_score;
+			alg_result->ht[0].upper_body_bbox.width = alg_result->ht[i].upper_body_bbox.width;
+			alg_result->ht[0].upper_body_bbox.height = alg_result->ht[i].upper_body_bbox.height;
+			alg_result->ht[0].upper_body_bbox.x = alg_result->ht[i].upper_body_bbox.x;
+			alg_result->ht[0].upper_body_bbox.y = alg_result->ht[i].upper_body_bbox.y;
+			alg_result->ht[0].upper_body_score = alg_result->ht[i].upper_body_score;
+
+			alg_result->ht[i].upper_body_bbox.width = temp_width;
+			alg_result->ht[i].upper_body_bbox.height = temp_height;
+			alg_result->ht[i].upper_body_bbox.x = temp_x;
+			alg_result->ht[i].upper_body_bbox.y = temp_y;
+			alg_result->ht[i].upper_body_score = temp_score;
+		}
+	}
+}
+
 float CaculateDistance(uint32_t x1,uint32_t y1,uint32_t x2,uint32_t y2)
 {
 	return (float)sqrt(pow((float)x1 - (float)x2,2)+pow((float)y1 - (float)y2,2));
@@ -1003,6 +1033,12 @@ static void _arm_npu_irq_init(void)
      * Note, this handler comes from the EthosU driver */
     EPII_NVIC_SetVector(ethosu_irqnum, (uint32_t)_arm_npu_irq_handler);
 
+#if TFLM_FD_FM_CSP
+    /* The driver's semaphore is a csp4cmsis IrqEvent (CSP4CMSIS_ETHOSU), raised
+     * from this handler: it must not preempt the kernel's critical sections */
+    NVIC_SetPriority(ethosu_irqnum, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+#endif
+
     /* Enable the IRQ */
     NVIC_EnableIRQ(ethosu_irqnum);
 
@@ -1037,6 +1073,18 @@ static int _arm_npu_init(bool security_enable, bool privilege_enable)
     return 0;
 }
 
+#if !TFLM2209_U55TAG2205
+static int arena_add(const char *name, const tflite::Model *model)
+{
+	uint32_t persistent, scratch;
+	if(tflm_arena_probe((uint8_t*)tensor_arena, tensor_arena_size, model, op_resolver, &persistent, &scratch) != 0) {
+		xprintf("[ERROR] %s model does not fit in the %d byte tensor arena\n", name, tensor_arena_size);
+		return -1;
+	}
+	return tflm_arena_add(&arena_plan, name, persistent, scratch, 0);
+}
+#endif
+
 int cv_fd_fm_init(bool security_enable, bool privilege_enable, uint32_t fd_model_addr, uint32_t fm_model_addr, uint32_t il_model_addr) {
 	int ercode = 0;
 
@@ -1104,9 +1152,27 @@ int cv_fd_fm_init(bool security_enable, bool privilege_enable, uint32_t fd_model
 	static tflite::MicroInterpreter fm_static_interpreter(FM_model, op_resolver, (uint8_t*)tensor_arena, tensor_arena_size-tensor_arena_model_tail_size, &micro_error_reporter);
 	static tflite::MicroInterpreter il_static_interpreter(IL_model, op_resolver, (uint8_t*)tensor_arena, tensor_arena_size-(tensor_arena_model_tail_size*2), &micro_error_reporter);
 	#else
-	static tflite::MicroInterpreter fd_static_interpreter(model, op_resolver, (uint8_t*)tensor_arena, tensor_arena_size);
-	static tflite::MicroInterpreter fm_static_interpreter(FM_model, op_resolver, (uint8_t*)tensor_arena, tensor_arena_size-tensor_arena_model_tail_size);
-	static tflite::MicroInterpreter il_static_interpreter(IL_model, op_resolver, (uint8_t*)tensor_arena, tensor_arena_size-(tensor_arena_model_tail_size*2));
+	//measure each model, then overlay their scratch and stack their persistent areas
+	tflm_arena_init(&arena_plan, (uint8_t*)tensor_arena, tensor_arena_size, tflm_arena_clock);
+	fd_arena_id = arena_add("fd", model);
+	fm_arena_id = arena_add("fm", FM_model);
+	il_arena_id = arena_add("il", IL_model);
+	if(fd_arena_id < 0 || fm_arena_id < 0 || il_arena_id < 0)
+		return false;
+	if(tflm_arena_plan(&arena_plan) != 0) {
+		xprintf("[ERROR] fd, fm and il need more than the %d byte tensor arena\n", tensor_arena_size);
+		return false;
+	}
+	for(uint32_t i = 0; i < arena_plan.count; i++) {
+		const tflm_arena_model_t *m = &arena_plan.model[i];
+		xprintf("%s arena: persistent %u at %u, scratch %u at %u\n", m->name, m->persistent, m->persistent_off,
+				m->scratch, m->scratch_off);
+	}
+	xprintf("tensor arena: %u of %d bytes used, %u saved, plan %u cycles\n", arena_plan.used, tensor_arena_size,
+			tflm_arena_saved(&arena_plan), arena_plan.plan_cycles);
+	static tflite::MicroInterpreter fd_static_interpreter(model, op_resolver, tflm_arena_allocator(&arena_plan, fd_arena_id));
+	static tflite::MicroInterpreter fm_static_interpreter(FM_model, op_resolver, tflm_arena_allocator(&arena_plan, fm_arena_id));
+	static tflite::MicroInterpreter il_static_interpreter(IL_model, op_resolver, tflm_arena_allocator(&arena_plan, il_arena_id));
 	#endif
 	if(fd_static_interpreter.AllocateTensors()!= kTfLiteOk) {
 		return false;
@@ -1134,6 +1200,7 @@ int cv_fd_fm_init(bool security_enable, bool privilege_enable, uint32_t fd_model
 	il_int_ptr = &il_static_interpreter;
 	il_input = il_static_interpreter.input(0);
 	il_output = il_static_interpreter.output(0);
+	il_output2 = il_static_interpreter.output(1);
 
 	xprintf("initial done\n");
 
@@ -1147,6 +1214,45 @@ int cv_fd_fm_init(bool security_enable, bool privilege_enable, uint32_t fd_model
 
 
 
+void cv_fd_fm_result_to_point(const struct_fm_algoResult_with_fps *alg_fm_result, int target, el_fm_point_t *point)
+{
+	point->el_box.x = alg_fm_result->face_bbox[0].x;
+	point->el_box.y = alg_fm_result->face_bbox[0].y;
+	point->el_box.w = alg_fm_result->face_bbox[0].width;
+	point->el_box.h = alg_fm_result->face_bbox[0].height;
+	point->el_box.score = alg_fm_result->face_bbox[0].face_score;
+	point->el_box.target = target;
+	for(int c=0;c<FACE_MESH_POINT_NUM;c++)
+	{
+		
+		point->el_fm_point[c].x = alg_fm_result->fmr[c].x;
+		point->el_fm_point[c].y = alg_fm_result->fmr[c].y;
+		point->el_fm_point[c].score = point->el_box.score;
+		point->el_fm_point[c].target = target;
+	}
+
+	for(int c=0;c<FM_IRIS_POINT_NUM;c++)
+	{
+		point->el_fm_iris[c].x = alg_fm_result->fmr_iris[c].x;
+		point->el_fm_iris[c].y = alg_fm_result->fmr_iris[c].y;
+		point->el_fm_iris[c].score = point->el_box.score;
+		point->el_fm_iris[c].target = target;
+	}
+
+
+	point->el_fm_angle.yaw = alg_fm_result->face_angle.yaw * 100.0;
+	point->el_fm_angle.pitch = alg_fm_result->face_angle.pitch* 100.0;
+	point->el_fm_angle.roll = alg_fm_result->face_angle.roll* 100.0;
+	point->el_fm_angle.MAR = alg_fm_result->face_angle.MAR* 100.0;
+	point->el_fm_angle.LEAR = alg_fm_result->face_angle.LEAR* 100.0;
+	point->el_fm_angle.REAR = alg_fm_result->face_angle.REAR* 100.0;
+
+	point->el_fm_angle.left_iris_theta = alg_fm_result->left_iris_theta* 100.0;
+	point->el_fm_angle.left_iris_phi = alg_fm_result->left_iris_phi* 100.0;
+	point->el_fm_angle.right_iris_theta = alg_fm_result->right_iris_theta* 100.0;
+	point->el_fm_angle.right_iris_phi = alg_fm_result->right_iris_phi* 100.0;
+}
+
 int cv_fd_fm_run(struct_algoResult *alg_result, struct_fm_algoResult_with_fps *alg_fm_result) {
 
 static uint32_t algo_tick = 0;
@@ -1158,10 +1264,6 @@ static uint32_t algo_tick = 0;
 	int ercode = 0;
 	TfLiteStatus invoke_status=kTfLiteOk;
 
-	float w_scale;
-    float h_scale;
-	int pad_sz = 0;
-
     uint32_t img_w = app_get_raw_width();
     uint32_t img_h = app_get_raw_height();
 	#ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
@@ -1175,15 +1277,13 @@ static uint32_t algo_tick = 0;
 		g_image_mapping_init = 1;
 		#ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
 			resized_img = mm_reserve_align(resize_image_size,0x20); //192*192*3
-			crop_img = mm_reserve_align(img_w*img_h*ch,0x20); //320*240*3
-			pad_img = mm_reserve_align(img_w*img_w*ch,0x20); //320*320*3
+			strip_scratch = mm_reserve_align(IMG_STRIP_SCRATCH_SIZE(img_w, ch, IMG_STRIP_ROWS),0x20); //320*3*17
 		#else
 			resized_img = mm_reserve_align(resize_image_size,0x20); //192*192*1
-			crop_img = mm_reserve_align(img_w*img_h*ch,0x20); //640*480*1
-			pad_img = mm_reserve_align(img_w*img_w*ch,0x20); //640*640*1
+			strip_scratch = mm_reserve_align(IMG_STRIP_SCRATCH_SIZE(img_w, ch, IMG_STRIP_ROWS),0x20); //640*1*17
 		#endif
 		#if DBG_APP_LOG
-		xprintf("addr: resized[%x] crop[%x] pad[%x]\n",resized_img, crop_img, pad_img, raw_addr);
+		xprintf("addr: resized[%x] strip[%x]\n",resized_img, strip_scratch);
 		#endif
 	}
     //send jpeg image and no wait
@@ -1191,23 +1291,12 @@ static uint32_t algo_tick = 0;
 	#if DBG_APP_LOG
     xprintf("raw info: w[%d] h[%d] ch[%d] addr[%x]\n",img_w, img_h, ch, raw_addr);
 	#endif
-    w_scale = (float)(img_w - 1) / (FD_INPUT_TENSOR_WIDTH - 1);
-	h_scale = (float)(img_h - 1) / (FD_INPUT_TENSOR_HEIGHT - 1);
-	
 	#ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
-		hx_lib_image_resize_helium((uint8_t*)raw_addr, (uint8_t*)resized_img,
-					img_w, img_h, (int)COLOR_CHANNEL,
-					FD_INPUT_TENSOR_WIDTH, FD_INPUT_TENSOR_HEIGHT, w_scale,h_scale);
-
-    	BGRU3C_to_GRAY((uint8_t*)resized_img, (int8_t*)fd_input->data.int8, FD_INPUT_TENSOR_WIDTH, FD_INPUT_TENSOR_HEIGHT);
+		hx_lib_image_resize_BGR8U3C_to_GRAY_int8_helium((uint8_t*)raw_addr, fd_input->data.int8,
+					img_w, img_h, FD_INPUT_TENSOR_WIDTH, FD_INPUT_TENSOR_HEIGHT, -128);
 	#else
-		hx_lib_image_resize_helium((uint8_t*)raw_addr, (uint8_t*)fd_input->data.data,
-					img_w, img_h, (int)COLOR_CHANNEL,
-					FD_INPUT_TENSOR_WIDTH, FD_INPUT_TENSOR_HEIGHT, w_scale,h_scale);
-
-		for (int i = 0; i < fd_input->bytes; ++i) {
-			*((int8_t *)fd_input->data.data+i) = *((int8_t *)fd_input->data.data+i) - 128;
-		}
+		hx_lib_image_resize_Y8_int8_helium((uint8_t*)raw_addr, fd_input->data.int8,
+					img_w, img_h, FD_INPUT_TENSOR_WIDTH, FD_INPUT_TENSOR_HEIGHT, -128);
 	#endif
 	invoke_status = fd_int_ptr->Invoke();
 
@@ -1243,28 +1332,7 @@ static uint32_t algo_tick = 0;
 	}
     else {
     	/* sort biggest face */
-		for(int i=0;i<MAX_TRACKED_ALGO_RES;i++)
-		{
-			if((alg_result->ht[0].upper_body_bbox.width*alg_result->ht[0].upper_body_bbox.height)<(alg_result->ht[i].upper_body_bbox.width*alg_result->ht[i].upper_body_bbox.height))
-			{
-				uint32_t temp_width = alg_result->ht[0].upper_body_bbox.width;
-				uint32_t temp_height = alg_result->ht[0].upper_body_bbox.height;
-				uint32_t temp_x = alg_result->ht[0].upper_body_bbox.x;
-				uint32_t temp_y = alg_result->ht[0].upper_body_bbox.y;
-				uint32_t temp_score = alg_result->ht[0].upper_body_score;
-				alg_result->ht[0].upper_body_bbox.width = alg_result->ht[i].upper_body_bbox.width;
-				alg_result->ht[0].upper_body_bbox.height = alg_result->ht[i].upper_body_bbox.height;
-				alg_result->ht[0].upper_body_bbox.x = alg_result->ht[i].upper_body_bbox.x;
-				alg_result->ht[0].upper_body_bbox.y = alg_result->ht[i].upper_body_bbox.y;
-				alg_result->ht[0].upper_body_score = alg_result->ht[i].upper_body_score;
-
-				alg_result->ht[i].upper_body_bbox.width = temp_width;
-				alg_result->ht[i].upper_body_bbox.height = temp_height;
-				alg_result->ht[i].upper_body_bbox.x = temp_x;
-				alg_result->ht[i].upper_body_bbox.y = temp_y;
-				alg_result->ht[i].upper_body_score = temp_score;
-			}
-		}
+		sort_biggest_face(alg_result);
 
 		/**copy face detect result to struct_fm_algoResult_with_fps - alg_fm_result*/
 		for(int i=0;i<MAX_TRACKED_ALGO_RES;i++)
@@ -1277,10 +1345,19 @@ static uint32_t algo_tick = 0;
 		}
 		alg_fm_result->num_tracked_face_targets = alg_result->num_tracked_human_targets;
 
-		//crop face area to crop_img
-		hx_lib_image_copy_helium((uint8_t*)raw_addr, (uint8_t*)crop_img, img_w, img_h, ch, \
-				alg_fm_result->face_bbox[0].x, alg_fm_result->face_bbox[0].y, \
+		//crop and pad the face area to a square, resize it into the face mesh input and keep the
+		//resized image for the iris crop, one band at a time: the raw frame is read before recapture
+		img_strip_window_t face_win = img_strip_square_window(alg_fm_result->face_bbox[0].x, alg_fm_result->face_bbox[0].y, \
 				alg_fm_result->face_bbox[0].width, alg_fm_result->face_bbox[0].height);
+		#ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
+			hx_lib_image_crop_pad_resize_strip_int8((uint8_t*)raw_addr, img_w, img_h, &face_win, \
+					(int8_t*)fm_input->data.int8, (uint8_t*)resized_img, FM_INPUT_TENSOR_WIDTH, FM_INPUT_TENSOR_HEIGHT, \
+					-128, IMG_FUSED_BGR8U3C_TO_RGB24, (uint8_t*)strip_scratch, IMG_STRIP_ROWS);
+		#else
+			hx_lib_image_crop_pad_resize_strip_int8((uint8_t*)raw_addr, img_w, img_h, &face_win, \
+					(int8_t*)fm_input->data.int8, (uint8_t*)resized_img, FM_INPUT_TENSOR_WIDTH, FM_INPUT_TENSOR_HEIGHT, \
+					-128, IMG_FUSED_Y8_TO_YYY, (uint8_t*)strip_scratch, IMG_STRIP_ROWS);
+		#endif
 
 #ifdef UART_SEND_ALOGO_RESEULT
 #else
@@ -1288,43 +1365,6 @@ static uint32_t algo_tick = 0;
     	sensordplib_retrigger_capture();				
 #endif			
 
-		if(alg_fm_result->face_bbox[0].height > alg_fm_result->face_bbox[0].width)
-		{
-			int diff = alg_fm_result->face_bbox[0].height - alg_fm_result->face_bbox[0].width;
-			pad_sz = alg_fm_result->face_bbox[0].height;
-
-			hx_lib_pad_image((uint8_t*)crop_img, (uint8_t*)pad_img,
-					alg_fm_result->face_bbox[0].width, alg_fm_result->face_bbox[0].height, ch,
-				0, 0, (diff / 2),  (diff / 2 + diff % 2), pad_sz, pad_sz);/**pad_top, pad_bottom, pad_left,  pad_right**/
-
-		}
-		else if(alg_fm_result->face_bbox[0].width > alg_fm_result->face_bbox[0].height)
-		{
-			int diff = alg_fm_result->face_bbox[0].width - alg_fm_result->face_bbox[0].height;
-			pad_sz = alg_fm_result->face_bbox[0].width;
-
-			hx_lib_pad_image((uint8_t*)crop_img, (uint8_t*)pad_img,
-					alg_fm_result->face_bbox[0].width, alg_fm_result->face_bbox[0].height, ch,
-				(diff / 2),  (diff / 2 + diff % 2) , 0,  0, pad_sz, pad_sz);/**pad_top, pad_bottom, pad_left,  pad_right**/
-
-		}
-		else
-		{
-			pad_sz = alg_fm_result->face_bbox[0].width;
-
-			memcpy((void *)crop_img, (void *)pad_img, sizeof(uint8_t)*pad_sz*pad_sz*ch);
-		}
-
-		w_scale = (float)(pad_sz- 1) / (FM_INPUT_TENSOR_WIDTH - 1);
-		h_scale = (float)(pad_sz - 1) / (FM_INPUT_TENSOR_HEIGHT - 1);
-		hx_lib_image_resize_helium((uint8_t*)pad_img, (uint8_t*)resized_img,
-					pad_sz, pad_sz, ch, \
-					FM_INPUT_TENSOR_WIDTH, FM_INPUT_TENSOR_HEIGHT,w_scale,h_scale);
-		#ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
-			BGRU3C_to_RGB24((uint8_t*)resized_img, (int8_t*)fm_input->data.int8, FM_INPUT_TENSOR_WIDTH, FM_INPUT_TENSOR_HEIGHT);
-    	#else
-			Y_to_YYY((uint8_t*)resized_img, (int8_t*)fm_input->data.int8, FM_INPUT_TENSOR_WIDTH, FM_INPUT_TENSOR_HEIGHT);
-		#endif
 		invoke_status = fm_int_ptr->Invoke();
 		if(invoke_status != kTfLiteOk)
 		{
@@ -1462,41 +1502,7 @@ if( g_trans_type == 0 || g_trans_type == 2)// transfer type is (UART) or (UART &
 	std::forward_list<el_fm_point_t> el_fm_point_algo;
 
 	el_fm_point_t temp_el_fm_point_algo;
-	temp_el_fm_point_algo.el_box.x = alg_fm_result->face_bbox[0].x;
-	temp_el_fm_point_algo.el_box.y = alg_fm_result->face_bbox[0].y;
-	temp_el_fm_point_algo.el_box.w = alg_fm_result->face_bbox[0].width;
-	temp_el_fm_point_algo.el_box.h = alg_fm_result->face_bbox[0].height;
-	temp_el_fm_point_algo.el_box.score = alg_fm_result->face_bbox[0].face_score;
-	temp_el_fm_point_algo.el_box.target = 0;
-	for(int c=0;c<FACE_MESH_POINT_NUM;c++)
-	{
-		
-		temp_el_fm_point_algo.el_fm_point[c].x = alg_fm_result->fmr[c].x;
-		temp_el_fm_point_algo.el_fm_point[c].y = alg_fm_result->fmr[c].y;
-		temp_el_fm_point_algo.el_fm_point[c].score = temp_el_fm_point_algo.el_box.score;
-		temp_el_fm_point_algo.el_fm_point[c].target = 0;
-	}
-
-	for(int c=0;c<FM_IRIS_POINT_NUM;c++)
-	{
-		temp_el_fm_point_algo.el_fm_iris[c].x = alg_fm_result->fmr_iris[c].x;
-		temp_el_fm_point_algo.el_fm_iris[c].y = alg_fm_result->fmr_iris[c].y;
-		temp_el_fm_point_algo.el_fm_iris[c].score = temp_el_fm_point_algo.el_box.score;
-		temp_el_fm_point_algo.el_fm_iris[c].target = 0;
-	}
-
-
-	temp_el_fm_point_algo.el_fm_angle.yaw = alg_fm_result->face_angle.yaw * 100.0;
-	temp_el_fm_point_algo.el_fm_angle.pitch = alg_fm_result->face_angle.pitch* 100.0;
-	temp_el_fm_point_algo.el_fm_angle.roll = alg_fm_result->face_angle.roll* 100.0;
-	temp_el_fm_point_algo.el_fm_angle.MAR = alg_fm_result->face_angle.MAR* 100.0;
-	temp_el_fm_point_algo.el_fm_angle.LEAR = alg_fm_result->face_angle.LEAR* 100.0;
-	temp_el_fm_point_algo.el_fm_angle.REAR = alg_fm_result->face_angle.REAR* 100.0;
-
-	temp_el_fm_point_algo.el_fm_angle.left_iris_theta = alg_fm_result->left_iris_theta* 100.0;
-	temp_el_fm_point_algo.el_fm_angle.left_iris_phi = alg_fm_result->left_iris_phi* 100.0;
-	temp_el_fm_point_algo.el_fm_angle.right_iris_theta = alg_fm_result->right_iris_theta* 100.0;
-	temp_el_fm_point_algo.el_fm_angle.right_iris_phi = alg_fm_result->right_iris_phi* 100.0;
+	cv_fd_fm_result_to_point(alg_fm_result, 0, &temp_el_fm_point_algo);
 
 	el_fm_point_algo.emplace_front(temp_el_fm_point_algo);
 
@@ -1537,6 +1543,167 @@ else if( g_trans_type == 1)// transfer type is (SPI)
 	return ercode;
 }
 
+#if TFLM_FD_FM_CSP
+#ifndef APP_IRIS_LANDMARK
+#error "TFLM_FD_FM_CSP runs the iris landmark model: define APP_IRIS_LANDMARK"
+#endif
+/*
+ * Stages of cv_fd_fm_run() for the CSP cascade (csp_cascade.cpp). They work
+ * on buffers owned by the caller, so that several faces of a frame can be in
+ * different stages at once. The three interpreters share one arena: only the
+ * *_invoke() functions, which all run on the NPU process, touch tensors.
+ */
+#ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
+#define FM_STRIP_LAYOUT		IMG_FUSED_BGR8U3C_TO_RGB24
+#else
+#define FM_STRIP_LAYOUT		IMG_FUSED_Y8_TO_YYY
+#endif
+
+uint32_t cv_fd_fm_fd_input_bytes(void)
+{
+	return fd_input->bytes;
+}
+
+uint32_t cv_fd_fm_face_bytes(void)
+{
+	return resize_image_size;
+}
+
+uint32_t cv_fd_fm_crop_scratch_bytes(void)
+{
+	return IMG_STRIP_SCRATCH_SIZE(app_get_raw_width(), COLOR_CHANNEL, IMG_STRIP_ROWS);
+}
+
+uint32_t cv_fd_fm_fm_output_bytes(int index)
+{
+	return (index == 0) ? fm_output->bytes : fm_output2->bytes;
+}
+
+uint32_t cv_fd_fm_eye_crop_bytes(void)
+{
+	return IL_INPUT_TENSOR_WIDTH*IL_INPUT_TENSOR_HEIGHT*COLOR_CHANNEL;
+}
+
+uint32_t cv_fd_fm_eye_input_bytes(void)
+{
+	return il_input->bytes;
+}
+
+uint32_t cv_fd_fm_il_output_bytes(int index)
+{
+	return (index == 0) ? il_output->bytes : il_output2->bytes;
+}
+
+void cv_fd_fm_fd_preprocess(int8_t *input)
+{
+	uint32_t img_w = app_get_raw_width();
+	uint32_t img_h = app_get_raw_height();
+	uint32_t raw_addr = app_get_raw_addr();
+
+	#ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
+		hx_lib_image_resize_BGR8U3C_to_GRAY_int8_helium((uint8_t*)raw_addr, input,
+					img_w, img_h, FD_INPUT_TENSOR_WIDTH, FD_INPUT_TENSOR_HEIGHT, -128);
+	#else
+		hx_lib_image_resize_Y8_int8_helium((uint8_t*)raw_addr, input,
+					img_w, img_h, FD_INPUT_TENSOR_WIDTH, FD_INPUT_TENSOR_HEIGHT, -128);
+	#endif
+}
+
+int cv_fd_fm_fd_invoke(const int8_t *input, struct_algoResult *alg_result)
+{
+	memcpy(fd_input->data.int8, input, fd_input->bytes);
+	if(fd_int_ptr->Invoke() != kTfLiteOk)
+	{
+		xprintf("face detection invoke fail\n");
+		return -1;
+	}
+	//fd_net reads the output tensors in place: decode them before the next model overwrites the arena
+	alg_result->num_tracked_human_targets = 0;
+	yolo_post_processing(&fd_net, alg_result);
+	sort_biggest_face(alg_result);
+	return 0;
+}
+
+void cv_fd_fm_crop_face(const struct_face_box *face, uint8_t *face_img, uint8_t *scratch)
+{
+	//the resized planes only: the face mesh input is converted from them in cv_fd_fm_fm_invoke()
+	img_strip_window_t face_win = img_strip_square_window(face->x, face->y, face->width, face->height);
+	hx_lib_image_crop_pad_resize_strip_int8((uint8_t*)app_get_raw_addr(), app_get_raw_width(), app_get_raw_height(),
+			&face_win, NULL, face_img, FM_INPUT_TENSOR_WIDTH, FM_INPUT_TENSOR_HEIGHT, -128, FM_STRIP_LAYOUT,
+			scratch, IMG_STRIP_ROWS);
+}
+
+int cv_fd_fm_fm_invoke(const uint8_t *face_img, int8_t *output, int8_t *output2)
+{
+	#ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
+		BGRU3C_to_RGB24((uint8_t*)face_img, fm_input->data.int8, FM_INPUT_TENSOR_WIDTH, FM_INPUT_TENSOR_HEIGHT);
+	#else
+		Y_to_YYY((uint8_t*)face_img, fm_input->data.int8, FM_INPUT_TENSOR_WIDTH, FM_INPUT_TENSOR_HEIGHT);
+	#endif
+	if(fm_int_ptr->Invoke() != kTfLiteOk)
+	{
+		xprintf("face mesh invoke fail\n");
+		return -1;
+	}
+	memcpy(output, fm_output->data.int8, fm_output->bytes);
+	memcpy(output2, fm_output2->data.int8, fm_output2->bytes);
+	return 0;
+}
+
+int cv_fd_fm_fm_postprocess(const int8_t *output, const int8_t *output2, struct_fm_algoResult_with_fps *alg_fm_result,
+		struct_position *fm_eye_r_wo_scale_R, struct_position *fm_eye_r_wo_scale_L)
+{
+	//quantization and shape of the model's tensors, data of the caller's copy
+	TfLiteTensor out = *fm_output, out2 = *fm_output2;
+	out.data.int8 = (int8_t*)output;
+	out2.data.int8 = (int8_t*)output2;
+	blazeface_mesh_post_procees(&out, &out2, alg_fm_result, fm_eye_r_wo_scale_R, fm_eye_r_wo_scale_L);
+	return alg_fm_result->score>=0.35;
+}
+
+void cv_fd_fm_crop_eye(const uint8_t *face_img, struct_position *fm_eye_r_wo_scale, int LR,
+		struct_position *eye_center, uint8_t *crop, int8_t *input)
+{
+	crop_single_eye_IL((uint8_t*)face_img, crop, fm_eye_r_wo_scale, eye_center, LR);
+	#ifndef YUV_640_480_INPUT /*RGB_320_240_INPUT*/
+		BGRU3C_to_RGB24(crop, input, IL_INPUT_TENSOR_WIDTH, IL_INPUT_TENSOR_HEIGHT);
+	#else
+		Y_to_YYY(crop, input, IL_INPUT_TENSOR_WIDTH, IL_INPUT_TENSOR_HEIGHT);
+	#endif
+}
+
+int cv_fd_fm_il_invoke(const int8_t *input, int8_t *output, int8_t *output2)
+{
+	memcpy(il_input->data.int8, input, il_input->bytes);
+	if(il_int_ptr->Invoke() != kTfLiteOk)
+	{
+		xprintf("iris landmark invoke fail\n");
+		return -1;
+	}
+	memcpy(output, il_output->data.int8, il_output->bytes);
+	memcpy(output2, il_output2->data.int8, il_output2->bytes);
+	return 0;
+}
+
+void cv_fd_fm_il_postprocess(const int8_t *output, const int8_t *output2, struct_fm_algoResult_with_fps *alg_fm_result,
+		struct_position *eye_center, int LR)
+{
+	TfLiteTensor out = *il_output, out2 = *il_output2;
+	out.data.int8 = (int8_t*)output;
+	out2.data.int8 = (int8_t*)output2;
+	IL_post_proccessing(&out, &out2, alg_fm_result, eye_center, LR);
+	cal_iris_angle(alg_fm_result, LR);
+}
+
+void cv_fd_fm_angles(struct_fm_algoResult_with_fps *alg_fm_result)
+{
+#ifdef COMPUTE_ANGLE
+	compute_ypr_face_mesh(alg_fm_result);
+	compute_ANGLE_face_mesh(alg_fm_result);
+#endif
+}
+#endif /* TFLM_FD_FM_CSP */
+
 int cv_fd_fm_deinit()
 {
 	free(fd_net.branchs);
@@ -20,8 +20,36 @@ int cv_fd_fm_run(struct_algoResult *alg_result, struct_fm_algoResult_with_fps *a
 
 int cv_fd_fm_deinit();
 
+#if TFLM_FD_FM_CSP
+/* Cascade stages of cv_fd_fm_run(), on caller-owned frame and face buffers */
+uint32_t cv_fd_fm_fd_input_bytes(void);
+uint32_t cv_fd_fm_face_bytes(void);
+uint32_t cv_fd_fm_crop_scratch_bytes(void);
+uint32_t cv_fd_fm_fm_output_bytes(int index);
+uint32_t cv_fd_fm_eye_crop_bytes(void);
+uint32_t cv_fd_fm_eye_input_bytes(void);
+uint32_t cv_fd_fm_il_output_bytes(int index);
+void cv_fd_fm_fd_preprocess(int8_t *input);
+int cv_fd_fm_fd_invoke(const int8_t *input, struct_algoResult *alg_result);
+void cv_fd_fm_crop_face(const struct_face_box *face, uint8_t *face_img, uint8_t *scratch);
+int cv_fd_fm_fm_invoke(const uint8_t *face_img, int8_t *output, int8_t *output2);
+int cv_fd_fm_fm_postprocess(const int8_t *output, const int8_t *output2, struct_fm_algoResult_with_fps *alg_fm_result,
+		struct_position *fm_eye_r_wo_scale_R, struct_position *fm_eye_r_wo_scale_L);
+void cv_fd_fm_crop_eye(const uint8_t *face_img, struct_position *fm_eye_r_wo_scale, int LR,
+		struct_position *eye_center, uint8_t *crop, int8_t *input);
+int cv_fd_fm_il_invoke(const int8_t *input, int8_t *output, int8_t *output2);
+void cv_fd_fm_il_postprocess(const int8_t *output, const int8_t *output2, struct_fm_algoResult_with_fps *alg_fm_result,
+		struct_position *eye_center, int LR);
+void cv_fd_fm_angles(struct_fm_algoResult_with_fps *alg_fm_result);
+#endif
 #ifdef __cplusplus
 }
 #endif
 
+#ifdef __cplusplus
+struct el_fm_point_t;
+/* UART JSON point of a face result, its face being face_bbox[0] */
+void cv_fd_fm_result_to_point(const struct_fm_algoResult_with_fps *alg_fm_result, int target, el_fm_point_t *point);
+#endif
+
 #endif /* APP_SCENARIO_APP_TFLM_FD_FM_CVAPP_FD_FM_H_ */
@@ -74,6 +74,10 @@
 
 #include "memory_manage.h"
 #include "hx_drv_watchdog.h"
+#if TFLM_FD_FM_CSP
+#include "hxevent.h"
+#include "csp_cascade.h"
+#endif
 
 #ifdef EPII_FPGA
 #define DBG_APP_LOG             (1)
@@ -397,6 +401,17 @@ static void dp_app_cv_fd_fm_eventhdl_cb(EVT_INDEX_E event)
 		}
 #endif
 
+#if TFLM_FD_FM_CSP
+		//detection, face mesh, iris landmark and send run in csp_cascade.cpp
+		csp_cascade_frame(jpeg_addr, jpeg_sz);
+#ifdef CIS_IMX
+		if (chipid == WE2_CHIP_VERSION_C)   // mipi workaround for WE2 chip version C
+		{
+			set_mipi_csirx_enable();
+			cisdp_stream_on();
+		}
+#endif
+#else
 #if FRAME_CHECK_DEBUG
 			if(g_spi_master_initial_status == 0) {
 				if(hx_drv_spi_mst_open_speed(SPI_SEN_PIC_CLK) != 0)
@@ -552,6 +567,7 @@ static void dp_app_cv_fd_fm_eventhdl_cb(EVT_INDEX_E event)
 		algoresult_fm.face_angle.MAR = 0;
 		algoresult_fm.face_angle.REAR = 0;
 		algoresult_fm.face_angle.LEAR = 0;
+#endif /* TFLM_FD_FM_CSP */
 	}
 
 	if(g_md_detect == 1)
@@ -630,7 +646,12 @@ void app_start_state(APP_STATE_E state)
 
 	event_handler_init();
     cisdp_sensor_start();
+#if TFLM_FD_FM_CSP
+	//the detect process runs the event loop on its own thread, started by csp_cascade_start()
+	hx_event_set_idlecb(csp_cascade_idle);
+#else
    	event_handler_start();
+#endif
 }
 
 
@@ -682,12 +703,26 @@ int app_main(void) {
 	xprintf("hx_drv_watchdog_start\n");
 #endif
 
+#if TFLM_FD_FM_CSP
+	//the csp4cmsis bulk section (processes, channels, FreeRTOS heap) sits ahead of the mm region
+#ifdef __GNU__
+	extern char __mm_start_addr__;
+	mm_set_initial((int)(&__mm_start_addr__), 0x00200000-((int)(&__mm_start_addr__)-0x34000000));
+#else
+	static uint8_t mm_start_addr __attribute__((section(".bss.mm_start_addr")));
+	mm_set_initial((int)(&mm_start_addr), 0x00200000-((int)(&mm_start_addr)-0x34000000));
+#endif
+#else
 	mm_set_initial(BOOT2NDLOADER_BASE, 0x00200000-(BOOT2NDLOADER_BASE-0x34000000));
+#endif
 
 	//Face Detection Face mesh
 	xprintf("Face Detection Face mesh\n");
 	cv_fd_fm_init(true, true, FACE_DECTECT_FLASH_ADDR, FACE_MESH_FLASH_ADDR, IRIS_LANDMARKS_FLASH_ADDR);
 	app_start_state(APP_STATE_ALLON_FD_FM);
+#if TFLM_FD_FM_CSP
+	csp_cascade_start();
+#endif
 	
 	return 0;
 }
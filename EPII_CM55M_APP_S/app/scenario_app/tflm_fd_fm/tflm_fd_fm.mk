@@ -18,7 +18,7 @@ EVENTHANDLER_SUPPORT_LIST += evt_datapath
 # The source code should be loacted in ~\library\{lib_name}\
 ##
 # LIB_SEL = pwrmgmt sensordp tflmtag2209_u55tag2205 spi_ptl spi_eeprom hxevent img_proc
-LIB_SEL = pwrmgmt sensordp tflmtag2412_u55tag2411 spi_ptl spi_eeprom hxevent img_proc
+LIB_SEL = pwrmgmt sensordp tflmtag2412_u55tag2411 spi_ptl spi_eeprom hxevent img_proc yolo_post tflm_arena
 ##
 # middleware support feature
 # Add new middleware here
@@ -48,6 +48,46 @@ else ifeq ($(CIS_SUPPORT_INAPP_MODEL), cis_imx708)
 APPL_DEFINES += -DCIS_IMX
 endif
 
+##
+# CSP cascade variant (csp_cascade.cpp): face detection, face mesh, iris landmark
+# and uplink as csp4cmsis processes on FreeRTOS, every detected face through
+# mesh and iris, the three models sharing the NPU.
+# Build with: make TFLM_FD_FM_CSP=1
+# Frames in flight, TFLM_FD_FM_CSP_FRAMES (2): 75KB each for the 640x480 JPEG.
+# Faces in flight, TFLM_FD_FM_CSP_ROIS (4): ~40KB each for the 192x192 face and
+# the mesh outputs (~115KB with RGB_320_240_INPUT).
+##
+TFLM_FD_FM_CSP ?= 0
+ifeq ($(TFLM_FD_FM_CSP), 1)
+TFLM_FD_FM_CSP_FRAMES ?= 2
+TFLM_FD_FM_CSP_ROIS ?= 4
+override OS_SEL := freertos
+override MPU := n
+APPL_DEFINES += -DTFLM_FD_FM_CSP=1
+APPL_DEFINES += -DTFLM_FD_FM_CSP_FRAMES=$(TFLM_FD_FM_CSP_FRAMES)
+APPL_DEFINES += -DTFLM_FD_FM_CSP_ROIS=$(TFLM_FD_FM_CSP_ROIS)
+# Ethos-U driver hooks from csp4cmsis (npu.cpp): the NPU wait is an ALT on its interrupt
+APPL_DEFINES += -DCSP4CMSIS_ETHOSU=1
+APPL_DEFINES += -DconfigENABLE_MPU=0
+APPL_DEFINES += -DconfigENABLE_TRUSTZONE=0
+# Kernel heap in system SRAM (ucHeap in csp_cascade.cpp): JSON strings live there
+APPL_DEFINES += -DconfigAPPLICATION_ALLOCATED_HEAP=1
+APPL_DEFINES += -DconfigTOTAL_HEAP_SIZE=98304
+
+override INCDIR += library/csp4cmsis/inc \
+                   library/csp4cmsis/inc/csp \
+                   os/freertos/NTZ/freertos_kernel/include \
+                   os/freertos/NTZ/freertos_kernel/portable/GCC/ARM_CM55_NTZ/non_secure
+override SCENARIO_APP_CXXSRCS += $(wildcard ./library/csp4cmsis/src/*.cpp)
+
+RTOS_PATH = ./os/freertos/NTZ/freertos_kernel
+APPL_CSRCS += $(RTOS_PATH)/tasks.c \
+              $(RTOS_PATH)/queue.c \
+              $(RTOS_PATH)/timers.c \
+              $(RTOS_PATH)/list.c \
+              $(RTOS_PATH)/portable/MemMang/heap_4.c
+endif
+
 ifeq ($(strip $(TOOLCHAIN)), arm)
 override LINKER_SCRIPT_FILE := $(SCENARIO_APP_ROOT)/$(APP_TYPE)/tflm_fd_fm.sct
 else#TOOLChain
@@ -28,6 +28,7 @@
 #include "tensorflow/lite/micro/micro_error_reporter.h"
 #endif
 #include "img_proc_helium.h"
+#include "img_proc_fused.h"
 #include <forward_list>
 
 #include "xprintf.h"
@@ -355,8 +356,6 @@ static void peoplenet_post_processing(tflite::MicroInterpreter* static_interpret
 
 int cv_peoplenet_run(struct_peoplenet_algoResult *algoresult_peoplenet){
 	int ercode = 0;
-    float w_scale;
-    float h_scale;
     uint32_t img_w = app_get_raw_width();
     uint32_t img_h = app_get_raw_height();
     uint32_t ch = app_get_raw_channels();
@@ -376,32 +375,13 @@ int cv_peoplenet_run(struct_peoplenet_algoResult *algoresult_peoplenet){
 			SystemGetTick(&systick_1, &loop_cnt_1);
 		#endif
     	//get image from sensor and resize
-		w_scale = (float)(img_w - 1) / (PEOPLENET_INPUT_TENSOR_WIDTH - 1);
-		h_scale = (float)(img_h - 1) / (PEOPLENET_INPUT_TENSOR_HEIGHT - 1);
-
-		
-		hx_lib_image_resize_BGR8U3C_to_RGB24_helium((uint8_t*)raw_addr, (uint8_t*)peoplenet_input->data.data,  
-		                    img_w, img_h, ch, 
-                        	PEOPLENET_INPUT_TENSOR_WIDTH, PEOPLENET_INPUT_TENSOR_HEIGHT, w_scale,h_scale);
+		hx_lib_image_resize_BGR8U3C_to_RGB24_int8_helium((uint8_t*)raw_addr, peoplenet_input->data.int8,
+						img_w, img_h, PEOPLENET_INPUT_TENSOR_WIDTH, PEOPLENET_INPUT_TENSOR_HEIGHT, -128);
 		#if EACH_STEP_TICK						
 			SystemGetTick(&systick_2, &loop_cnt_2);
-			dbg_printf(DBG_LESS_INFO,"Tick for resize image BGR8U3C_to_RGB24_helium for peoplenet:[%d]\r\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));							
-		#endif
-
-		#if EACH_STEP_TICK
-			SystemGetTick(&systick_1, &loop_cnt_1);
+			dbg_printf(DBG_LESS_INFO,"Tick for resize image BGR8U3C_to_RGB24_int8_helium for peoplenet:[%d]\r\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));							
 		#endif
 
-		// //uint8 to int8
-		for (int i = 0; i < peoplenet_input->bytes; ++i) {
-			*((int8_t *)peoplenet_input->data.data+i) = *((int8_t *)peoplenet_input->data.data+i) - 128;
-    	}
-
-		#if EACH_STEP_TICK
-		SystemGetTick(&systick_2, &loop_cnt_2);
-		dbg_printf(DBG_LESS_INFO,"Tick for Invoke for uint8toint8 for peoplenet:[%d]\r\n\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));    
-		#endif	
-
 		#if EACH_STEP_TICK
 		SystemGetTick(&systick_1, &loop_cnt_1);
 		#endif
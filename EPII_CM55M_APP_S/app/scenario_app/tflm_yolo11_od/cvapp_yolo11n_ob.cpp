@@ -26,7 +26,10 @@
 #include "tensorflow/lite/c/common.h"
 
 #include "img_proc_helium.h"
+#include "img_proc_fused.h"
 #include "yolo_postprocessing.h"
+#include "yolo_post.h"
+#include "yolo_nms.h"
 
 
 #include "xprintf.h"
@@ -50,6 +53,17 @@
 
 #define YOLO11N_OB_DBG_APP_LOG 0
 
+/* Detections above the score threshold kept per frame, before NMS */
+#define YOLO11_OB_MAX_CANDIDATES 256
+static uint16_t cand_anchor[YOLO11_OB_MAX_CANDIDATES];
+static uint16_t cand_class[YOLO11_OB_MAX_CANDIDATES];
+static float cand_score[YOLO11_OB_MAX_CANDIDATES];
+static float cand_x[YOLO11_OB_MAX_CANDIDATES];
+static float cand_y[YOLO11_OB_MAX_CANDIDATES];
+static float cand_w[YOLO11_OB_MAX_CANDIDATES];
+static float cand_h[YOLO11_OB_MAX_CANDIDATES];
+static yolo_nms_work_t nms_work;
+
 
 // #define EACH_STEP_TICK
 #define TOTAL_STEP_TICK
@@ -534,54 +548,6 @@ int cv_yolo11n_ob_init(bool security_enable, bool privilege_enable, uint32_t mod
 
 
 
-typedef struct detection_cls_yolo11{
-    box bbox;
-    float confidence;
-    float index;
-
-} detection_cls_yolo11;
-
-static bool yolo11_det_comparator(detection_cls_yolo11 &pa, detection_cls_yolo11 &pb)
-{
-    return pa.confidence > pb.confidence;
-}
-
-static void  yolo11_NMSBoxes(std::vector<box> &boxes,std::vector<float> &confidences,float modelScoreThreshold,float modelNMSThreshold,std::vector<int>& nms_result)
-{
-    detection_cls_yolo11 yolo11_bbox;
-    std::vector<detection_cls_yolo11> yolo11_bboxes{};
-    for(int i = 0; i < boxes.size(); i++)
-    {
-        yolo11_bbox.bbox = boxes[i];
-        yolo11_bbox.confidence = confidences[i];
-        yolo11_bbox.index = i;
-        yolo11_bboxes.push_back(yolo11_bbox);
-    }
-    sort(yolo11_bboxes.begin(), yolo11_bboxes.end(), yolo11_det_comparator);
-    int updated_size = yolo11_bboxes.size();
-    for(int k = 0; k < updated_size; k++)
-    {
-        if(yolo11_bboxes[k].confidence < modelScoreThreshold)
-        {
-            continue;
-        }
-        
-        nms_result.push_back(yolo11_bboxes[k].index);
-        for(int j = k + 1; j < updated_size; j++)
-        {
-            float iou = box_iou(yolo11_bboxes[k].bbox, yolo11_bboxes[j].bbox);
-            // float iou = box_diou(yolo11_bboxes[k].bbox, yolo11_bboxes[j].bbox);
-            if(iou > modelNMSThreshold)
-            {
-                yolo11_bboxes.erase(yolo11_bboxes.begin() + j);
-                updated_size = yolo11_bboxes.size();
-                j = j -1;
-            }
-        }
-
-    }
-}
-
 #if YOLO11_NO_POST_SEPARATE_OUTPUT
 static void yolo11_ob_post_processing(tflite::MicroInterpreter* static_interpreter,float modelScoreThreshold, float modelNMSThreshold, struct_yolov8_ob_algoResult *alg,	std::forward_list<el_box_t> &el_algo)
 {
@@ -621,69 +587,41 @@ static void yolo11_ob_post_processing(tflite::MicroInterpreter* static_interpret
 	int input_w = YOLO11_OB_INPUT_TENSOR_WIDTH;
 	int input_h = YOLO11_OB_INPUT_TENSOR_HEIGHT;
 
-	std::vector<uint16_t> class_idxs;
-	std::vector<float> confidences;
-	std::vector<box> boxes;
-
 	#if YOLO11_POST_EACH_STEP_TICK
 		SystemGetTick(&systick_1, &loop_cnt_1);
 	#endif
 	/***
-	 * dequantize the output result for box
-	 * 
-	 * 
+	 * select on the int8 class channels (64..143) of each tensor, then
+	 * decode the boxes of the selected anchors only
 	 ******/
-	 for(int j = 0;j < out_dim_total; j++)
+	int class_id_start = 64;
+	yolo_post_cands_t cands = { cand_anchor, cand_class, cand_score, { cand_x, cand_y, cand_w, cand_h }, YOLO11_OB_MAX_CANDIDATES, 0, 0 };
+	for(int out_num = 0; out_num < numOutputs; out_num++)
 	{
-		int class_id_start = 64;
-		int output_data_idx;
-		int dims_cnt_1 ;
-		int dims_cnt_2 ;
-		int idx;
-		if(j < out_dim_size[0] )//576
-		{
-			output_data_idx = 0;
-			dims_cnt_1 = j / output[output_data_idx]->dims->data[1];//28
-			dims_cnt_2 = j % output[output_data_idx]->dims->data[2];//28
-		}
-		else if(j < out_dim_size[1] )//720
-		{
-			output_data_idx = 1;
-			idx = j - out_dim_size[0] ;//576
-			dims_cnt_1 = idx / output[output_data_idx]->dims->data[1];//14
-			dims_cnt_2 = idx % output[output_data_idx]->dims->data[2];//14
-		}
-		else
-		{
-			output_data_idx = 2;
-			idx = j - out_dim_size[1] ;//720
-			dims_cnt_1 = idx / output[output_data_idx]->dims->data[1];//7
-			dims_cnt_2 = idx % output[output_data_idx]->dims->data[2];//7
-		}
-		float maxScore_no_sigmoid = yolo11_nopost_dequant_value(dims_cnt_1, dims_cnt_2,class_id_start,output[output_data_idx]);
-		uint16_t maxClassIndex = 0;
-		for(int class_id_cnt = class_id_start;class_id_cnt < output[output_data_idx]->dims->data[3];class_id_cnt++)
-		{
-			float tmp_score_no_sigmoid = yolo11_nopost_dequant_value(dims_cnt_1, dims_cnt_2,class_id_cnt,output[output_data_idx]);
-			/***
-			 * find maximum Score and correspond Class id
-			 * **/
-			if(maxScore_no_sigmoid<tmp_score_no_sigmoid)
-			{
-				maxScore_no_sigmoid=tmp_score_no_sigmoid;
-				maxClassIndex = class_id_cnt - class_id_start;
-			}
-		}
-		float maxScore = sigmoid(maxScore_no_sigmoid);
-		if (maxScore >= modelScoreThreshold)
+		TfLiteAffineQuantization* quant = (TfLiteAffineQuantization*)(output[out_num]->quantization.params);
+		int channels = output[out_num]->dims->data[3];
+		yolo_post_scores_t scores = { output[out_num]->data.int8 + class_id_start,
+			output[out_num]->dims->data[1] * output[out_num]->dims->data[2], channels - class_id_start, channels, 1,
+			quant->scale->data[0], quant->zero_point->data[0], 1 };
+		yolo_post_select(&scores, modelScoreThreshold, (out_num == 0) ? 0 : out_dim_size[out_num - 1], &cands);
+	}
+	for(uint32_t i = 0; i < cands.count; i++)
+	{
+		int j = cand_anchor[i];
+		int output_data_idx = 0;
+		while(j >= out_dim_size[output_data_idx])
 		{
-			box bbox;
-			yolo11_nopost_cal_xywh(j,dims_cnt_1, dims_cnt_2,output[output_data_idx],&bbox, anchor_756_2,stride_756_1 );
-			boxes.push_back(bbox);
-			class_idxs.push_back(maxClassIndex);
-			confidences.push_back(maxScore);
-			
+			output_data_idx++;
 		}
+		int idx = (output_data_idx == 0) ? j : j - out_dim_size[output_data_idx - 1];
+		int dims_cnt_1 = idx / output[output_data_idx]->dims->data[1];
+		int dims_cnt_2 = idx % output[output_data_idx]->dims->data[2];
+		box bbox;
+		yolo11_nopost_cal_xywh(j,dims_cnt_1, dims_cnt_2,output[output_data_idx],&bbox, anchor_756_2,stride_756_1 );
+		cand_x[i] = bbox.x;
+		cand_y[i] = bbox.y;
+		cand_w[i] = bbox.w;
+		cand_h[i] = bbox.h;
 	}
 
 	#if YOLO11_POST_EACH_STEP_TICK						
@@ -691,38 +629,38 @@ static void yolo11_ob_post_processing(tflite::MicroInterpreter* static_interpret
 		dbg_printf(DBG_LESS_INFO,"Tick for dequantize the output result for box for yolo11 OB:[%d]\r\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));							
 	#endif
 	#if DBG_APP_LOG
-		xprintf("boxes.size(): %d\r\n",boxes.size());
+		xprintf("cands.count: %d\r\n",cands.count);
 	#endif
 	/**
-	 * do nms
+	 * do nms: class-agnostic, on the candidate arrays, no heap
 	 * 
 	 * **/
 
-	std::vector<int> nms_result;
-	yolo11_NMSBoxes(boxes, confidences, modelScoreThreshold, modelNMSThreshold, nms_result);
+	uint16_t nms_keep[MAX_TRACKED_YOLOV8_ALGO_RES];
+	uint32_t nms_count = yolo_nms(&cands.box, cand_score, NULL, cands.count, modelNMSThreshold, 0.f,
+		MAX_TRACKED_YOLOV8_ALGO_RES, &nms_work, nms_keep);
 	#if DBG_APP_LOG
-		xprintf("nms_result.size(): %d\r\n",nms_result.size());
+		xprintf("nms_count: %d\r\n",nms_count);
 	#endif
-	for (int i = 0; i < nms_result.size(); i++)
+	for (uint32_t i = 0; i < nms_count; i++)
 	{
-		if(!(MAX_TRACKED_YOLOV8_ALGO_RES-i))break;
-		int idx = nms_result[i];
+		int idx = nms_keep[i];
 
 		float scale_factor_w = (float)img_w / (float)YOLO11_OB_INPUT_TENSOR_WIDTH; 
 		float scale_factor_h = (float)img_h / (float)YOLO11_OB_INPUT_TENSOR_HEIGHT; 
-		alg->obr[i].confidence = confidences[idx];
-		alg->obr[i].bbox.x = (uint32_t)(boxes[idx].x * scale_factor_w);
-		alg->obr[i].bbox.y = (uint32_t)(boxes[idx].y * scale_factor_h);
-		alg->obr[i].bbox.width = (uint32_t)(boxes[idx].w * scale_factor_w);
-		alg->obr[i].bbox.height = (uint32_t)(boxes[idx].h * scale_factor_h);
-		alg->obr[i].class_idx = class_idxs[idx];
+		alg->obr[i].confidence = cand_score[idx];
+		alg->obr[i].bbox.x = (uint32_t)(cand_x[idx] * scale_factor_w);
+		alg->obr[i].bbox.y = (uint32_t)(cand_y[idx] * scale_factor_h);
+		alg->obr[i].bbox.width = (uint32_t)(cand_w[idx] * scale_factor_w);
+		alg->obr[i].bbox.height = (uint32_t)(cand_h[idx] * scale_factor_h);
+		alg->obr[i].class_idx = cand_class[idx];
 		el_box_t temp_el_box;
-		temp_el_box.score =  confidences[idx]*100;
-		temp_el_box.target =  class_idxs[idx];
-		temp_el_box.x = (uint32_t)(boxes[idx].x * scale_factor_w);
-		temp_el_box.y =  (uint32_t)(boxes[idx].y * scale_factor_h);
-		temp_el_box.w = (uint32_t)(boxes[idx].w * scale_factor_w);
-		temp_el_box.h = (uint32_t)(boxes[idx].h * scale_factor_h);
+		temp_el_box.score =  cand_score[idx]*100;
+		temp_el_box.target =  cand_class[idx];
+		temp_el_box.x = (uint32_t)(cand_x[idx] * scale_factor_w);
+		temp_el_box.y =  (uint32_t)(cand_y[idx] * scale_factor_h);
+		temp_el_box.w = (uint32_t)(cand_w[idx] * scale_factor_w);
+		temp_el_box.h = (uint32_t)(cand_h[idx] * scale_factor_h);
 
 
 		// printf("temp_el_box.x %d,temp_el_box.y: %d\r\n",temp_el_box.x,temp_el_box.y);
@@ -731,7 +669,7 @@ static void yolo11_ob_post_processing(tflite::MicroInterpreter* static_interpret
 		// 	printf("el_algo.box.x %d,el_algo.box.y%d\r\n",box.x,box.y);
 		// }
 		#if YOLO11N_OB_DBG_APP_LOG
-			printf("detect object[%d]: %s confidences: %f\r\n",i, coco_classes[class_idxs[idx]].c_str(),confidences[idx]);
+			printf("detect object[%d]: %s confidences: %f\r\n",i, coco_classes[cand_class[idx]].c_str(),cand_score[idx]);
 
 		#endif
 	}
@@ -753,10 +691,6 @@ static void yolo11_ob_post_processing(tflite::MicroInterpreter* static_interpret
 	int input_w = YOLO11_OB_INPUT_TENSOR_WIDTH;
 	int input_h = YOLO11_OB_INPUT_TENSOR_HEIGHT;
 
-	std::vector<uint16_t> class_idxs;
-	std::vector<float> confidences;
-	std::vector<box> boxes;
-
 
 	float output_scale = ((TfLiteAffineQuantization*)(output->quantization.params))->scale->data[0];
 	int output_zeropoint = ((TfLiteAffineQuantization*)(output->quantization.params))->zero_point->data[0];
@@ -772,92 +706,48 @@ static void yolo11_ob_post_processing(tflite::MicroInterpreter* static_interpret
 		// xprintf("output->dims->data[2]: %d\r\n",output->dims->data[2]);//756
 	#endif
 	/***
-	 * dequantize the output result
-	 * 
-	 * 
+	 * rows 0..3 are the box, rows 4.. the class scores: select on the int8
+	 * scores, then dequantize the selected anchors only
 	 ******/
-	for(int dims_cnt_2 = 0; dims_cnt_2 < output->dims->data[2]; dims_cnt_2++)
-	{
-		float outputs_bbox_data[4];
-		float maxScore = (-1);// the first four indexes are bbox information
-		uint16_t maxClassIndex = 0;
-		for(int dims_cnt_1 = 0; dims_cnt_1 < output->dims->data[1]; dims_cnt_1++)
-		{
-			int value =  output->data.int8[ dims_cnt_2 + dims_cnt_1 * output->dims->data[2]];
-			
-			float deq_value = ((float) value-(float)output_zeropoint) * output_scale ;
-			if(dims_cnt_1<4)
-			{
-				/***
-				 * fix big score
-				 * ****/
-				if(dims_cnt_1%2)//==1
-				{
-					deq_value *= (float)input_h;
-				}
-				else
-				{
-					deq_value *= (float)input_w;
-				}
-				outputs_bbox_data[dims_cnt_1] = deq_value;
-			}
-			else
-			{
-				/***
-				 * find maximum Score and correspond Class idx
-				 * **/
-				if(maxScore < deq_value)
-				{
-					maxScore = deq_value;
-					maxClassIndex = dims_cnt_1-4;
-				}
-			}
+	int num_anchors = output->dims->data[2];
+	yolo_post_cands_t cands = { cand_anchor, cand_class, cand_score, { cand_x, cand_y, cand_w, cand_h }, YOLO11_OB_MAX_CANDIDATES, 0, 0 };
+	yolo_post_scores_t scores = { output->data.int8 + 4 * num_anchors, num_anchors, num_classes, 1, num_anchors,
+		output_scale, output_zeropoint, 0 };
+	yolo_post_select(&scores, modelScoreThreshold, 0, &cands);
+	yolo_post_decode_xywh(output->data.int8, num_anchors, output_scale, output_zeropoint,
+		(float)input_w, (float)input_h, &cands, 0);
+
 
-		}
-		if (maxScore >= modelScoreThreshold)
-		{
-			box bbox;
-			
-			bbox.x = (outputs_bbox_data[0] - (0.5 * outputs_bbox_data[2]));
-			bbox.y = (outputs_bbox_data[1] - (0.5 * outputs_bbox_data[3]));
-			bbox.w =(outputs_bbox_data[2]);
-			bbox.h = (outputs_bbox_data[3]);
-			boxes.push_back(bbox);
-			class_idxs.push_back(maxClassIndex);
-			confidences.push_back(maxScore);
-			
-		}
-	}
 	#if YOLO11N_OB_DBG_APP_LOG
-		xprintf("boxes.size(): %d\r\n",boxes.size());
+		xprintf("cands.count: %d\r\n",cands.count);
 	#endif
 	/**
-	 * do nms
+	 * do nms: class-agnostic, on the candidate arrays, no heap
 	 * 
 	 * **/
 
-	std::vector<int> nms_result;
-	yolo11_NMSBoxes(boxes, confidences, modelScoreThreshold, modelNMSThreshold, nms_result);
-	for (int i = 0; i < nms_result.size(); i++)
+	uint16_t nms_keep[MAX_TRACKED_YOLOV8_ALGO_RES];
+	uint32_t nms_count = yolo_nms(&cands.box, cand_score, NULL, cands.count, modelNMSThreshold, 0.f,
+		MAX_TRACKED_YOLOV8_ALGO_RES, &nms_work, nms_keep);
+	for (uint32_t i = 0; i < nms_count; i++)
 	{
-		if(!(MAX_TRACKED_YOLOV8_ALGO_RES-i))break;
-		int idx = nms_result[i];
+		int idx = nms_keep[i];
 
 		float scale_factor_w = (float)img_w / (float)YOLO11_OB_INPUT_TENSOR_WIDTH; 
 		float scale_factor_h = (float)img_h / (float)YOLO11_OB_INPUT_TENSOR_HEIGHT; 
-		alg->obr[i].confidence = confidences[idx];
-		alg->obr[i].bbox.x = (uint32_t)(boxes[idx].x * scale_factor_w);
-		alg->obr[i].bbox.y = (uint32_t)(boxes[idx].y * scale_factor_h);
-		alg->obr[i].bbox.width = (uint32_t)(boxes[idx].w * scale_factor_w);
-		alg->obr[i].bbox.height = (uint32_t)(boxes[idx].h * scale_factor_h);
-		alg->obr[i].class_idx = class_idxs[idx];
+		alg->obr[i].confidence = cand_score[idx];
+		alg->obr[i].bbox.x = (uint32_t)(cand_x[idx] * scale_factor_w);
+		alg->obr[i].bbox.y = (uint32_t)(cand_y[idx] * scale_factor_h);
+		alg->obr[i].bbox.width = (uint32_t)(cand_w[idx] * scale_factor_w);
+		alg->obr[i].bbox.height = (uint32_t)(cand_h[idx] * scale_factor_h);
+		alg->obr[i].class_idx = cand_class[idx];
 		el_box_t temp_el_box;
-		temp_el_box.score =  confidences[idx]*100;
-		temp_el_box.target =  class_idxs[idx];
-		temp_el_box.x = (uint32_t)(boxes[idx].x * scale_factor_w);
-		temp_el_box.y =  (uint32_t)(boxes[idx].y * scale_factor_h);
-		temp_el_box.w = (uint32_t)(boxes[idx].w * scale_factor_w);
-		temp_el_box.h = (uint32_t)(boxes[idx].h * scale_factor_h);
+		temp_el_box.score =  cand_score[idx]*100;
+		temp_el_box.target =  cand_class[idx];
+		temp_el_box.x = (uint32_t)(cand_x[idx] * scale_factor_w);
+		temp_el_box.y =  (uint32_t)(cand_y[idx] * scale_factor_h);
+		temp_el_box.w = (uint32_t)(cand_w[idx] * scale_factor_w);
+		temp_el_box.h = (uint32_t)(cand_h[idx] * scale_factor_h);
 
 
 		// printf("temp_el_box.x %d,temp_el_box.y: %d\r\n",temp_el_box.x,temp_el_box.y);
@@ -866,7 +756,7 @@ static void yolo11_ob_post_processing(tflite::MicroInterpreter* static_interpret
 		// 	printf("el_algo.box.x %d,el_algo.box.y%d\r\n",box.x,box.y);
 		// }
 		#if YOLO11N_OB_DBG_APP_LOG
-			printf("detect object[%d]: %s confidences: %f\r\n",i, coco_classes[class_idxs[idx]].c_str(),confidences[idx]);
+			printf("detect object[%d]: %s confidences: %f\r\n",i, coco_classes[cand_class[idx]].c_str(),cand_score[idx]);
 
 		#endif
 	}
@@ -876,8 +766,6 @@ static void yolo11_ob_post_processing(tflite::MicroInterpreter* static_interpret
 
 int cv_yolo11n_ob_run(struct_yolov8_ob_algoResult *algoresult_yolo11n_ob) {
 	int ercode = 0;
-    float w_scale;
-    float h_scale;
     uint32_t img_w = app_get_raw_width();
     uint32_t img_h = app_get_raw_height();
     uint32_t ch = app_get_raw_channels();
@@ -897,32 +785,13 @@ int cv_yolo11n_ob_run(struct_yolov8_ob_algoResult *algoresult_yolo11n_ob) {
 			SystemGetTick(&systick_1, &loop_cnt_1);
 		#endif
     	//get image from sensor and resize
-		w_scale = (float)(img_w - 1) / (YOLO11_OB_INPUT_TENSOR_WIDTH - 1);
-		h_scale = (float)(img_h - 1) / (YOLO11_OB_INPUT_TENSOR_HEIGHT - 1);
-
-		
-		hx_lib_image_resize_BGR8U3C_to_RGB24_helium((uint8_t*)raw_addr, (uint8_t*)yolo11n_ob_input->data.data,  
-		                    img_w, img_h, ch, 
-                        	YOLO11_OB_INPUT_TENSOR_WIDTH, YOLO11_OB_INPUT_TENSOR_HEIGHT, w_scale,h_scale);
+		hx_lib_image_resize_BGR8U3C_to_RGB24_int8_helium((uint8_t*)raw_addr, yolo11n_ob_input->data.int8,
+							img_w, img_h, YOLO11_OB_INPUT_TENSOR_WIDTH, YOLO11_OB_INPUT_TENSOR_HEIGHT, -128);
 		#ifdef EACH_STEP_TICK						
 			SystemGetTick(&systick_2, &loop_cnt_2);
-			dbg_printf(DBG_LESS_INFO,"Tick for resize image BGR8U3C_to_RGB24_helium for yolo11 OB:[%d]\r\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));							
+			dbg_printf(DBG_LESS_INFO,"Tick for resize image BGR8U3C_to_RGB24_int8_helium for yolo11 OB:[%d]\r\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));							
 		#endif
 
-		#ifdef EACH_STEP_TICK
-			SystemGetTick(&systick_1, &loop_cnt_1);
-		#endif
-
-		// //uint8 to int8
-		for (int i = 0; i < yolo11n_ob_input->bytes; ++i) {
-			*((int8_t *)yolo11n_ob_input->data.data+i) = *((int8_t *)yolo11n_ob_input->data.data+i) - 128;
-    	}
-
-		#ifdef EACH_STEP_TICK
-		SystemGetTick(&systick_2, &loop_cnt_2);
-		dbg_printf(DBG_LESS_INFO,"Tick for Invoke for uint8toint8 for YOLO11_OB:[%d]\r\n\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));    
-		#endif	
-
 		#ifdef EACH_STEP_TICK
 		SystemGetTick(&systick_1, &loop_cnt_1);
 		#endif
@@ -987,7 +856,15 @@ if( g_trans_type == 0 || g_trans_type == 2)// transfer type is (UART) or (UART &
 
 	send_device_id();
 	// event_reply(concat_strings(", ", box_results_2_json_str(el_algo), ", ", img_2_json_str(&temp_el_jpg_img)));
-	event_reply(concat_strings(", ", algo_tick_2_json_str(algoresult_yolo11n_ob->algo_tick),", ", box_results_2_json_str(el_algo), ", ", img_2_json_str(&temp_el_jpg_img)));
+	// event_reply(concat_strings(", ", algo_tick_2_json_str(algoresult_yolo11n_ob->algo_tick),", ", box_results_2_json_str(el_algo), ", ", img_2_json_str(&temp_el_jpg_img)));
+	json_stream_t *reply = event_reply_begin();
+	json_stream_str(reply, ", ");
+	json_stream_algo_tick(reply, algoresult_yolo11n_ob->algo_tick);
+	json_stream_str(reply, ", ");
+	box_results_2_json_stream(reply, el_algo);
+	json_stream_str(reply, ", ");
+	img_2_json_stream(reply, &temp_el_jpg_img);
+	event_reply_end(reply);
 }
 	set_model_change_by_uart();
 #endif	
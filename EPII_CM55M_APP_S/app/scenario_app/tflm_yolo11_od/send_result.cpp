@@ -182,7 +182,7 @@ void el_base64_encode(const unsigned char* in, int in_len, char* out) {
         char_array_4[2] = ((char_array_3[1] & 0x0f) << 2) + ((char_array_3[2] & 0xc0) >> 6);
         char_array_4[3] = char_array_3[2] & 0x3f;
 
-        for (j = 0; j < i + 1; j++) *out++ = BASE64_CHARS_TABLE[char_array_4[i]];
+        for (j = 0; j < i + 1; j++) *out++ = BASE64_CHARS_TABLE[char_array_4[j]];
 
         while (i++ < 3) *out++ = '=';
     }
@@ -809,4 +809,66 @@ std::string  algo_tick_2_json_str(uint32_t algo_tick) {
 
     return ss;
 }
+
+/*
+ * Streaming INVOKE reply (library/json_stream): the bytes of event_reply(),
+ * written into event_reply_ring and sent by send_bytes() whenever the ring
+ * fills, so neither the reply nor the base64 image is built in memory.
+ */
+static char          event_reply_ring[EVENT_REPLY_RING_SIZE];
+static json_stream_t event_reply_tx;
+
+static uint32_t event_reply_sink(const char* data, uint32_t len, void* ctx) {
+    send_bytes(data, len);
+    return len;
+}
+
+json_stream_t* event_reply_begin() {
+    if (!event_reply_tx.ring) [[unlikely]]
+        json_stream_init(&event_reply_tx, event_reply_ring, sizeof(event_reply_ring), event_reply_sink, nullptr);
+    json_stream_invoke_begin(&event_reply_tx);
+    return &event_reply_tx;
+}
+
+void event_reply_end(json_stream_t* reply) { json_stream_invoke_end(reply); }
+
+void box_results_2_json_stream(json_stream_t* reply, std::forward_list<el_box_t>& results) {
+    const char* delim = "";
+
+    json_stream_str(reply, "\"boxes\": [");
+    for (const auto& box : results) {
+        json_stream_str(reply, delim);
+        json_stream_box(reply, box.x, box.y, box.w, box.h, box.score, box.target);
+        delim = ", ";
+    }
+    json_stream_str(reply, "]");
+}
+
+void keypoint_results_2_json_stream(json_stream_t* reply, std::forward_list<el_keypoint_t>& results) {
+    const char* delim = "";
+
+    json_stream_str(reply, "\"keypoints\": [");
+    for (const auto& kp : results) {
+        json_stream_str(reply, delim);
+        json_stream_str(reply, "[");
+        json_stream_box(reply, kp.el_box.x, kp.el_box.y, kp.el_box.w, kp.el_box.h, kp.el_box.score, kp.el_box.target);
+        delim = ", [";
+        for (int i = 0; i < KEYPOINT_NUM; i++) {
+            json_stream_str(reply, delim);
+            json_stream_point(reply, kp.el_keypoint[i].x, kp.el_keypoint[i].y, kp.el_keypoint[i].score,
+                              kp.el_keypoint[i].target);
+            delim = ", ";
+        }
+        json_stream_str(reply, "]]");
+        delim = ", ";
+    }
+    json_stream_str(reply, "]");
+}
+
+void img_2_json_stream(json_stream_t* reply, const el_img_t* img) {
+    if (!img) [[unlikely]]
+        json_stream_image(reply, nullptr, 0);
+    else
+        json_stream_image(reply, img->data, img->size);
+}
 #endif
\ No newline at end of file
@@ -26,7 +26,9 @@
 #include "tensorflow/lite/c/common.h"
 
 #include "img_proc_helium.h"
+#include "img_proc_fused.h"
 #include "yolo_postprocessing.h"
+#include "yolo_nms.h"
 
 
 #include "xprintf.h"
@@ -89,6 +91,18 @@ network fd_net;
 
 static uint32_t g_fd_gender_init = 0, g_image_mapping_init = 0;
 uint32_t num_face_counter = 0;
+
+/* Face candidates above the score threshold, before NMS */
+#define FD_MAX_CANDIDATES 256
+static uint16_t cand_anchor[FD_MAX_CANDIDATES];
+static uint16_t cand_class[FD_MAX_CANDIDATES];
+static float cand_score[FD_MAX_CANDIDATES];
+static float cand_x[FD_MAX_CANDIDATES];
+static float cand_y[FD_MAX_CANDIDATES];
+static float cand_w[FD_MAX_CANDIDATES];
+static float cand_h[FD_MAX_CANDIDATES];
+static yolo_nms_work_t nms_work;
+
 static tflite::MicroMutableOpResolver<1> op_resolver;
 
 static uint32_t crop_img=0,pad_img=0,resized_img = 0;
@@ -178,22 +192,26 @@ static network yolo_post_processing_init(TfLiteTensor* out_ten, TfLiteTensor* ou
 
 static void yolo_post_processing(network* net, struct_yolov8_gender_cls_algoResult * alg)
 {
-	int nboxes=0;
 	float thresh = .50;
 	float nms = .45;
 	uint32_t sensor_width = app_get_raw_width();
 	uint32_t sensor_height = app_get_raw_height();
 
-	std::forward_list<detection> dets = get_network_boxes(net, sensor_width, sensor_height, thresh, &nboxes);
+	yolo_post_cands_t cands = { cand_anchor, cand_class, cand_score, { cand_x, cand_y, cand_w, cand_h }, FD_MAX_CANDIDATES, 0, 0 };
+	get_network_cands(net, sensor_width, sensor_height, thresh, &cands);
 #ifdef FD_FL_DEBUG
-	dbg_printf(DBG_LESS_INFO,"box:%d\n",nboxes);
+	dbg_printf(DBG_LESS_INFO,"box:%d\n",cands.count);
 #endif
 
 	//clear_alg_rsult(&alg_result);
-	// do nms
-	diounms_sort(dets, net->num_classes, nms);
-
-	for (std::forward_list<detection>::iterator it=dets.begin(); it != dets.end(); ++it){
+	// do nms: DIoU per class as diounms_sort(), on the candidate arrays
+	uint16_t nms_keep[MAX_TRACKED_YOLOV8_ALGO_RES];
+	uint32_t nms_count = yolo_nms(&cands.box, cand_score, cand_class, cands.count, nms, 0.6f,
+		MAX_TRACKED_YOLOV8_ALGO_RES, &nms_work, nms_keep);
+
+	for (uint32_t i = 0; i < nms_count; i++){
+		int idx = nms_keep[i];
+		box bbox = { cand_x[idx] + cand_w[idx] / 2, cand_y[idx] + cand_h[idx] / 2, cand_w[idx], cand_h[idx] };
 		/**************
 		 *
 		 * To let FD bbox do not too tight to do FL
@@ -214,10 +232,10 @@ static void yolo_post_processing(network* net, struct_yolov8_gender_cls_algoResu
 
 		float box_scale_factor = 1.3;
 
-		float ymin = it->bbox.y - ((it->bbox.h ) / box_scale_factor);
-		float xmin = it->bbox.x - ((it->bbox.w * box_scale_factor) / 2.);
-		float xmax = it->bbox.x + ((it->bbox.w * box_scale_factor) / 2.);
-		float ymax = it->bbox.y + ((it->bbox.h * box_scale_factor) / 2.);
+		float ymin = bbox.y - ((bbox.h ) / box_scale_factor);
+		float xmin = bbox.x - ((bbox.w * box_scale_factor) / 2.);
+		float xmax = bbox.x + ((bbox.w * box_scale_factor) / 2.);
+		float ymax = bbox.y + ((bbox.h * box_scale_factor) / 2.);
 
 		if (xmin < 0) xmin = 0;
 		if (ymin < 0) ymin = 0;
@@ -228,23 +246,20 @@ static void yolo_post_processing(network* net, struct_yolov8_gender_cls_algoResu
 		float by = ymin;
 		float bw = xmax - xmin;
 		float bh = ymax - ymin;
-		for (int j = 0; j < net->num_classes; ++j) {
-			if (it->prob[j] > 0 && num_face_counter < MAX_TRACKED_YOLOV8_ALGO_RES) {
-				alg->obr[num_face_counter].confidence = it->prob[j];
-				alg->obr[num_face_counter].bbox.x = (uint32_t)(bx);      //xmin
-				alg->obr[num_face_counter].bbox.y = (uint32_t)(by);      //ymin
-				alg->obr[num_face_counter].bbox.width = (uint32_t)(bw);  //xmax
-				alg->obr[num_face_counter].bbox.height = (uint32_t)(bh); //ymax
-				alg->obr[num_face_counter].class_idx = 0;//face
-
-				num_face_counter++;
-			}
+		if (num_face_counter < MAX_TRACKED_YOLOV8_ALGO_RES) {
+			alg->obr[num_face_counter].confidence = cand_score[idx];
+			alg->obr[num_face_counter].bbox.x = (uint32_t)(bx);      //xmin
+			alg->obr[num_face_counter].bbox.y = (uint32_t)(by);      //ymin
+			alg->obr[num_face_counter].bbox.width = (uint32_t)(bw);  //xmax
+			alg->obr[num_face_counter].bbox.height = (uint32_t)(bh); //ymax
+			alg->obr[num_face_counter].class_idx = 0;//face
+
+			num_face_counter++;
 		}
 		#ifdef FD_DEBUG
 		xprintf("alg_result->num_tracked_human_targets: %d\r\n",alg_result->num_tracked_human_targets);
 		#endif
 	}
-	free_dets(dets);
 	//free((net->branchs));
 }
 
@@ -375,15 +390,8 @@ int cv_yolov8_gender_cls_run(struct_yolov8_gender_cls_algoResult *algoresult_yol
 			#endif
 		}
 
-		w_scale = (float)(img_w - 1) / (FD_INPUT_TENSOR_WIDTH - 1);
-		h_scale = (float)(img_h - 1) / (FD_INPUT_TENSOR_HEIGHT - 1);
-		hx_lib_image_resize_helium((uint8_t*)raw_addr, (uint8_t*)fd_input->data.data,
-			img_w, img_h, (int)FD_COLOR_CHANNEL,
-			FD_INPUT_TENSOR_WIDTH, FD_INPUT_TENSOR_HEIGHT, w_scale,h_scale);
-
-		for (int i = 0; i < fd_input->bytes; ++i) {
-			*((int8_t *)fd_input->data.data+i) = *((int8_t *)fd_input->data.data+i) - 128;
-		}
+		hx_lib_image_resize_Y8_int8_helium((uint8_t*)raw_addr, fd_input->data.int8,
+			img_w, img_h, FD_INPUT_TENSOR_WIDTH, FD_INPUT_TENSOR_HEIGHT, -128);
 		invoke_status = fd_int_ptr->Invoke();
 		
 		if(invoke_status != kTfLiteOk)
@@ -120,6 +120,58 @@ std::forward_list<detection> get_network_boxes(network *net, int image_w, int im
     return dets;
 }
 
+uint32_t get_network_cands(network *net, int image_w, int image_h, float thresh, yolo_post_cands_t *c)
+{
+    int num_classes = net->num_classes;
+    uint32_t anchor = 0;
+
+    for (int i = 0; i < net->num_branch; ++i) {
+        int height  = net->branchs[i].resolution;
+        int width = net->branchs[i].resolution;
+        int channel  = net->branchs[i].num_box*(5+num_classes);
+
+        for (int h = 0; h < net->branchs[i].resolution; h++) {
+            for (int w = 0; w < net->branchs[i].resolution; w++) {
+                for (int anc = 0; anc < net->branchs[i].num_box; anc++, anchor++) {
+                    int bbox_obj_offset = h * width * channel + w * channel + anc * (num_classes + 5) + 4;
+                    float objectness = sigmoid(((float)net->branchs[i].tf_output[bbox_obj_offset] - net->branchs[i].zero_point) * net->branchs[i].scale);
+                    if (objectness <= thresh) continue;
+
+                    // Same box as get_network_boxes(), stored as top-left corner and size
+                    int bbox_x_offset = bbox_obj_offset - 4;
+                    int bbox_scores_offset = bbox_x_offset + 5;
+                    float bx = ((float)net->branchs[i].tf_output[bbox_x_offset] - net->branchs[i].zero_point) * net->branchs[i].scale;
+                    float by = ((float)net->branchs[i].tf_output[bbox_x_offset + 1] - net->branchs[i].zero_point) * net->branchs[i].scale;
+                    float bw = ((float)net->branchs[i].tf_output[bbox_x_offset + 2] - net->branchs[i].zero_point) * net->branchs[i].scale;
+                    float bh = ((float)net->branchs[i].tf_output[bbox_x_offset + 3] - net->branchs[i].zero_point) * net->branchs[i].scale;
+                    bx = (sigmoid(bx) + w) / width * image_w;
+                    by = (sigmoid(by) + h) / height * image_h;
+                    bw = exp(bw) * net->branchs[i].anchor[anc*2] / net->input_w * image_w;
+                    bh = exp(bh) * net->branchs[i].anchor[anc*2+1] / net->input_h * image_h;
+
+                    for (int s = 0; s < num_classes; s++) {
+                        float prob = sigmoid(((float)net->branchs[i].tf_output[bbox_scores_offset + s] - net->branchs[i].zero_point) * net->branchs[i].scale)*objectness;
+                        if (prob <= thresh) continue;
+                        if (c->count >= c->capacity) {
+                            c->dropped++;
+                            continue;
+                        }
+                        c->anchor[c->count] = (uint16_t)anchor;
+                        c->class_idx[c->count] = (uint16_t)s;
+                        c->score[c->count] = prob;
+                        c->box.x[c->count] = bx - bw / 2;
+                        c->box.y[c->count] = by - bh / 2;
+                        c->box.w[c->count] = bw;
+                        c->box.h[c->count] = bh;
+                        c->count++;
+                    }
+                }
+            }
+        }
+    }
+    return c->count;
+}
+
 // init part
 
 branch create_brach(int resolution, int num_box, float *anchor, int8_t *tf_output, size_t size, float scale, int zero_point){
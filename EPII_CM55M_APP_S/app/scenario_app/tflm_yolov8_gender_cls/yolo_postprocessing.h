@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <forward_list>
+#include "yolo_post.h"
 
 typedef struct boxabs {
     float left, right, top, bot;
@@ -44,6 +45,9 @@ branch create_brach(int resolution, int num_box, float *anchor, int8_t *tf_outpu
 network creat_network(int input_w, int input_h, int num_classes, int num_branch, branch* branchs, int topN);
 
 std::forward_list<detection> get_network_boxes(network *net, int image_w, int image_h, float thresh, int *num);
+/* The (box, class) pairs get_network_boxes() would keep, appended to c without
+ * allocating: boxes as top-left corner and size, topN not applied */
+uint32_t get_network_cands(network *net, int image_w, int image_h, float thresh, yolo_post_cands_t *c);
 
 void do_nms_sort(std::forward_list<detection> &dets, int classes, float thresh);
 void diounms_sort(std::forward_list<detection> &dets, int classes, float thresh);
@@ -26,5 +26,11 @@
 //0x3AB7B000 //(2220032 bytes => 0x21E000, set to 0x21E000)
 #define YOLOV8_OBJECT_DETECTION_FLASH_ADDR 0x3AB7B000
 
+//night model of the CSP pipeline's day/night switch; flash it after the day model (0x3AD99000)
+//and point this there. Defaults to the day model, so the switch runs without a second image.
+#ifndef YOLOV8_OBJECT_DETECTION_NIGHT_FLASH_ADDR
+#define YOLOV8_OBJECT_DETECTION_NIGHT_FLASH_ADDR YOLOV8_OBJECT_DETECTION_FLASH_ADDR
+#endif
+
 
 #endif /* SCENARIO_TFLM_2IN1_FD_FL_PL_COMMON_CONFIG_H_ */
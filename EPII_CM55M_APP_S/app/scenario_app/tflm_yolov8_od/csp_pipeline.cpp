@@ -0,0 +1,566 @@
+/*
+ * csp_pipeline.cpp
+ *
+ *  Pipelined yolov8n object detection on csp4cmsis (TFLM_YOLOV8_OD_CSP=1).
+ *
+ *  Capture --frame--> Infer --frame--> Post --frame--> Uplink
+ *     ^  ^            |  |  ^ ^        |                  |
+ *     |  +---input----+  |  | |loaded  |retired           |
+ *     |                  |  | |        v                  |
+ *     |            job   |  | +-- ModelManager            |
+ *     |                  v  |      | job                  |
+ *     |                  Npu <-----+                      |
+ *     +--------------------free frame---------------------+
+ *
+ *  Capture runs the hxevent loop. On every frame-ready event it resizes the
+ *  raw image into a staging input buffer, copies the JPEG into a free frame
+ *  slot and retriggers the sensor. Infer sends an inference job to Npu, which
+ *  owns the NPU, loads the input tensor and blocks in an ALT on its interrupt
+ *  while the model runs; Infer then hands the staging buffer back.
+ *  Post decodes the boxes and Uplink sends them (UART JSON and/or SPI, as
+ *  set by the PC tool) before returning the slot. So frame k+1 is resized while frame k is on the NPU
+ *  and frame k-1 is post-processed and sent.
+ *
+ *  Model switch (day/night): each frame carries the model wanted when it was
+ *  captured. When that differs from the model being served, Infer asks
+ *  ModelManager to load it into the idle interpreter bank and keeps serving
+ *  frames with the current one. ModelManager waits until Post has retired the
+ *  idle bank (no frame in flight still uses it), constructs the interpreter,
+ *  and has Npu run AllocateTensors, since the banks share their scratch. Infer
+ *  takes the loaded bank between two frames, so every frame runs on one model,
+ *  and reports the load time and the frames the sensor lost meanwhile.
+ *
+ *  Slots and input buffers move between the processes as pointers: whoever
+ *  holds the pointer owns the buffer, so nothing is shared and nothing is
+ *  locked. Each return channel holds every token, so returning never blocks.
+ */
+#if TFLM_YOLOV8_OD_CSP
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <forward_list>
+#include <string>
+#include "csp/csp4cmsis.h"
+
+#include "WE2_core.h"
+#include "xprintf.h"
+#include "sensor_dp_lib.h"
+#include "spi_master_protocol.h"
+#include "common_config.h"
+#include "cisdp_sensor.h"
+#include "cvapp_yolov8n_ob.h"
+#include "memory_manage.h"
+#include "csp_pipeline.h"
+#include <send_result.h>
+extern "C" {
+#include "event_handler.h"
+}
+
+using namespace csp;
+
+#define CSP_PIPELINE_INPUTS		2	/* One being resized, one held by Infer until the NPU has copied it */
+
+/* The FreeRTOS heap (configAPPLICATION_ALLOCATED_HEAP) goes to system SRAM */
+extern "C" {
+CSP_PLACE_BULK uint8_t ucHeap[configTOTAL_HEAP_SIZE];
+}
+
+namespace {
+
+	const uint32_t model_addr[TFLM_YOLOV8_OD_CSP_MODELS] = {
+		YOLOV8_OBJECT_DETECTION_FLASH_ADDR,
+		YOLOV8_OBJECT_DETECTION_NIGHT_FLASH_ADDR,
+	};
+	const char *const model_name[TFLM_YOLOV8_OD_CSP_MODELS] = { "day", "night" };
+
+	enum Stage { STAGE_RESIZE, STAGE_NPU, STAGE_POST, STAGE_UPLINK, STAGE_COUNT };
+
+	struct FrameSlot {
+		int8_t *input;				// Staging buffer, owned from Capture to Infer
+		uint32_t model;				// Model wanted at capture
+		int bank;					// Interpreter bank that ran it
+		int8_t *output;
+		int8_t *output2;
+		uint8_t *jpeg;
+		uint32_t jpeg_sz;
+		int status;
+		HrTime captured;
+		uint64_t cycles[STAGE_COUNT];
+		struct_yolov8_ob_algoResult result;
+		std::forward_list<el_box_t> boxes;
+	};
+
+	/* An interpreter bank of cvapp_yolov8n_ob.cpp, passed between Infer and ModelManager */
+	struct ModelBank {
+		int id;
+		uint32_t model;				// Index in model_addr[]
+		int status;					// Result of the last load, 0 if it can serve
+		HrTime requested;			// When Infer asked for the load
+		uint64_t prepare_cycles;	// Interpreter construction, on ModelManager
+		uint64_t allocate_cycles;	// AllocateTensors, on Npu
+	};
+
+	FrameSlot slots[TFLM_YOLOV8_OD_CSP_FRAMES];
+	ModelBank banks[CV_YOLOV8N_OB_BANKS];
+	int8_t *inputs[CSP_PIPELINE_INPUTS];
+	uint32_t jpeg_capacity;
+	volatile uint32_t wanted_model = 0;
+
+	using FrameChannel = BufferedOne2OneChannel<FrameSlot*, TFLM_YOLOV8_OD_CSP_FRAMES>;
+	using InputChannel = BufferedOne2OneChannel<int8_t*, CSP_PIPELINE_INPUTS>;
+	using BankChannel = BufferedOne2OneChannel<ModelBank*, 1>;
+
+	/**
+	 * @brief Runs the hxevent loop; frame() is called from its datapath
+	 * callback. Blocks for a free slot and input buffer, which throttles
+	 * the sensor to the speed of the slowest stage.
+	 */
+	class Capture : public CSProcess {
+	private:
+		Chanin<FrameSlot*> free_slots;
+		Chanin<int8_t*> free_inputs;
+		Chanout<FrameSlot*> out;
+		size_t fresh_slots = 0;
+		size_t fresh_inputs = 0;
+		uint32_t frames = 0;
+	public:
+		Capture(Chanin<FrameSlot*> fs, Chanin<int8_t*> fi, Chanout<FrameSlot*> o)
+			: free_slots(fs), free_inputs(fi), out(o) {}
+		const char* name() const override { return "capture"; }
+
+		void frame(uint32_t jpeg_addr, uint32_t jpeg_sz) {
+			FrameSlot *slot;
+			int8_t *input;
+			if (fresh_slots < TFLM_YOLOV8_OD_CSP_FRAMES) slot = &slots[fresh_slots++];
+			else free_slots >> slot;
+			if (fresh_inputs < CSP_PIPELINE_INPUTS) input = inputs[fresh_inputs++];
+			else free_inputs >> input;
+
+#if TFLM_YOLOV8_OD_CSP_SWAP_FRAMES
+			if (++frames % TFLM_YOLOV8_OD_CSP_SWAP_FRAMES == 0) {
+				wanted_model = (wanted_model + 1) % TFLM_YOLOV8_OD_CSP_MODELS;
+			}
+#endif
+			slot->model = wanted_model;
+			slot->captured = HrNow();
+			Stopwatch watch;
+			cv_yolov8n_ob_preprocess(input);
+			slot->input = input;
+
+			// The next capture overwrites the JPEG buffer: keep a copy
+			if (jpeg_sz > jpeg_capacity) jpeg_sz = jpeg_capacity;
+			hx_InvalidateDCache_by_Addr((volatile void *)jpeg_addr, jpeg_sz);
+			memcpy(slot->jpeg, (const void *)jpeg_addr, jpeg_sz);
+			hx_CleanDCache_by_Addr((volatile void *)slot->jpeg, jpeg_sz);
+			slot->jpeg_sz = jpeg_sz;
+			slot->cycles[STAGE_RESIZE] = watch.lap().to_cycles();
+
+			sensordplib_retrigger_capture();
+			out << slot;
+		}
+
+		void run() override {
+			event_handler_start();
+		}
+	};
+
+	Capture *capture = nullptr;
+
+	/* Run on the Npu process, which registers them as "yolov8_od" and "model_load" */
+	int invoke_yolov8_od(void *arg)
+	{
+		FrameSlot *slot = static_cast<FrameSlot *>(arg);
+		return cv_yolov8n_ob_invoke(slot->bank, slot->input, slot->output, slot->output2);
+	}
+
+	int invoke_model_load(void *arg)
+	{
+		ModelBank *bank = static_cast<ModelBank *>(arg);
+		return cv_yolov8n_ob_bank_allocate(bank->id);
+	}
+
+	/**
+	 * @brief Runs every frame on the active bank. Takes a loaded bank in
+	 * preference to the next frame, so the switch falls between two frames.
+	 */
+	class Infer : public CSProcess {
+	private:
+		Chanin<FrameSlot*> in;
+		Chanout<int8_t*> free_inputs;
+		Chanout<NpuJob> npu_requests;
+		Chanin<NpuJob> npu_responses;
+		Chanout<FrameSlot*> out;
+		Chanout<ModelBank*> load_requests;
+		Chanin<ModelBank*> loaded;
+		ModelBank *active;
+		bool loading = false;
+		bool refused[TFLM_YOLOV8_OD_CSP_MODELS] = {};
+		// Switch report: frame period before the load, frames lost while loading
+		HrTime last_frame;
+		uint64_t period = 0;
+		uint32_t dropped = 0;
+		int switched_from = -1;
+
+		void request(uint32_t model, HrTime now) {
+			ModelBank *idle = &banks[active->id ^ 1];
+			idle->model = model;
+			idle->requested = now;
+			load_requests << idle;
+			loading = true;
+			dropped = 0;
+		}
+
+		void report(HrTime now) {
+			xprintf("[models] %s -> %s: load %u us (prepare %u, allocate %u on npu), request to switch %u us, "
+					"%u frames dropped\r\n",
+					model_name[switched_from], model_name[active->model],
+					(unsigned)HrTime(active->prepare_cycles + active->allocate_cycles).to_microseconds(),
+					(unsigned)HrTime(active->prepare_cycles).to_microseconds(),
+					(unsigned)HrTime(active->allocate_cycles).to_microseconds(),
+					(unsigned)(now - active->requested).to_microseconds(),
+					(unsigned)dropped);
+			switched_from = -1;
+		}
+
+		// Frames the sensor would have delivered in the gap, at the period before the load
+		void track(HrTime now) {
+			uint64_t gap = (now - last_frame).to_cycles();
+			last_frame = now;
+			if (period == 0) {
+				period = gap;
+			} else if (loading || switched_from >= 0) {
+				if (gap > period + period / 2) dropped += (uint32_t)((gap + period / 2) / period - 1);
+			} else {
+				period = (period * 7 + gap) / 8;
+			}
+		}
+
+	public:
+		Infer(Chanin<FrameSlot*> i, Chanout<int8_t*> fi, Chanout<NpuJob> rq, Chanin<NpuJob> rs,
+			  Chanout<FrameSlot*> o, Chanout<ModelBank*> lr, Chanin<ModelBank*> ld, ModelBank *initial)
+			: in(i), free_inputs(fi), npu_requests(rq), npu_responses(rs), out(o),
+			  load_requests(lr), loaded(ld), active(initial) {}
+		const char* name() const override { return "infer"; }
+
+		void run() override {
+			FrameSlot *slot;
+			ModelBank *bank;
+			NpuJob job;
+			bool first = true;
+			Alternative alt(loaded | bank, in | slot);
+			while (true) {
+				if (alt.priSelect() == 0) {
+					loading = false;
+					if (bank->status != 0) {
+						xprintf("[models] %s refused: load failed (%d)\r\n", model_name[bank->model], bank->status);
+						refused[bank->model] = true;
+						continue;
+					}
+					switched_from = (int)active->model;
+					active = bank;
+					continue;
+				}
+
+				HrTime now = HrNow();
+				if (first) last_frame = now;
+				first = false;
+				track(now);
+				if (switched_from >= 0) report(now);
+				if (slot->model != active->model && !loading && !refused[slot->model]) request(slot->model, now);
+
+				Stopwatch watch;
+				slot->bank = active->id;
+				// Npu blocks on the NPU interrupt: the other processes run meanwhile
+				job.arg = slot;
+				npu_requests << job;
+				npu_responses >> job;
+				free_inputs << slot->input;
+				slot->input = nullptr;
+				slot->status = job.status;
+				slot->cycles[STAGE_NPU] = watch.lap().to_cycles();
+				out << slot;
+			}
+		}
+	};
+
+	/**
+	 * @brief Loads a model into the bank Infer sends, while the other bank
+	 * serves frames, and sends the bank back with its status.
+	 */
+	class ModelManager : public CSProcess {
+	private:
+		Chanin<ModelBank*> requests;
+		Chanin<int> retired;
+		Chanout<NpuJob> npu_requests;
+		Chanin<NpuJob> npu_responses;
+		Chanout<ModelBank*> loaded;
+		bool serving[CV_YOLOV8N_OB_BANKS] = {};	// Frames may be in flight on the bank
+	public:
+		ModelManager(Chanin<ModelBank*> rq, Chanin<int> rt, Chanout<NpuJob> nrq, Chanin<NpuJob> nrs,
+					 Chanout<ModelBank*> ld, int initial)
+			: requests(rq), retired(rt), npu_requests(nrq), npu_responses(nrs), loaded(ld) {
+			serving[initial] = true;
+		}
+		const char* name() const override { return "models"; }
+
+		void run() override {
+			ModelBank *bank;
+			NpuJob job;
+			while (true) {
+				requests >> bank;
+				// Post still reads the output tensors of frames run on the bank
+				while (serving[bank->id]) {
+					int id;
+					retired >> id;
+					serving[id] = false;
+				}
+
+				Stopwatch watch;
+				bank->status = cv_yolov8n_ob_bank_prepare(bank->id, model_addr[bank->model]);
+				bank->prepare_cycles = watch.lap().to_cycles();
+				bank->allocate_cycles = 0;
+				if (bank->status == 0) {
+					job.arg = bank;
+					npu_requests << job;
+					npu_responses >> job;
+					bank->status = job.status;
+					bank->allocate_cycles = job.npu_cycles;
+				}
+				serving[bank->id] = (bank->status == 0);
+				loaded << bank;
+			}
+		}
+	};
+
+	/**
+	 * @brief Decodes the boxes of a frame. Frames arrive in order, so the
+	 * first frame of a new bank retires the previous one.
+	 */
+	class Post : public CSProcess {
+	private:
+		Chanin<FrameSlot*> in;
+		Chanout<FrameSlot*> out;
+		Chanout<int> retired;
+		int bank = -1;
+	public:
+		Post(Chanin<FrameSlot*> i, Chanout<FrameSlot*> o, Chanout<int> r) : in(i), out(o), retired(r) {}
+		const char* name() const override { return "post"; }
+
+		void run() override {
+			FrameSlot *slot;
+			while (true) {
+				in >> slot;
+				if (slot->bank != bank) {
+					if (bank >= 0) retired << bank;
+					bank = slot->bank;
+				}
+				Stopwatch watch;
+				if (slot->status == 0) {
+					cv_yolov8n_ob_postprocess(slot->bank, slot->output, slot->output2, &slot->result, slot->boxes);
+				}
+				slot->cycles[STAGE_POST] = watch.lap().to_cycles();
+				slot->result.algo_tick = (uint32_t)(slot->cycles[STAGE_RESIZE] + slot->cycles[STAGE_NPU]
+													+ slot->cycles[STAGE_POST]);
+				out << slot;
+			}
+		}
+	};
+
+	/**
+	 * @brief Sends the results of a frame and returns its slot. Also
+	 * accumulates the stage times and reports them every
+	 * TFLM_YOLOV8_OD_CSP_REPORT_FRAMES frames.
+	 */
+	class Uplink : public CSProcess {
+	private:
+		Chanin<FrameSlot*> in;
+		Chanout<FrameSlot*> free_slots;
+		bool spi_open = false;
+		uint32_t frames = 0;
+		uint64_t totals[STAGE_COUNT] = {};
+		uint64_t latency = 0;
+		Stopwatch window;
+
+		void send(FrameSlot *slot) {
+			uint32_t judge_case_data;
+			hx_drv_swreg_aon_get_appused1(&judge_case_data);
+			uint32_t trans_type = (judge_case_data >> 16);
+#ifdef UART_SEND_ALOGO_RESEULT
+			if (trans_type == 0 || trans_type == 2) {// transfer type is (UART) or (UART & SPI)
+				el_img_t img = el_img_t{};
+				img.data = slot->jpeg;
+				img.size = slot->jpeg_sz;
+				img.width = app_get_raw_width();
+				img.height = app_get_raw_height();
+				img.format = EL_PIXEL_FORMAT_JPEG;
+				img.rotate = EL_PIXEL_ROTATE_0;
+
+				send_device_id();
+				json_stream_t *reply = event_reply_begin();
+				json_stream_str(reply, ", ");
+				json_stream_algo_tick(reply, slot->result.algo_tick);
+				json_stream_str(reply, ", ");
+				box_results_2_json_stream(reply, slot->boxes);
+				json_stream_str(reply, ", ");
+				img_2_json_stream(reply, &img);
+				event_reply_end(reply);
+			}
+			bool use_spi = (trans_type == 1 || trans_type == 2);
+#else
+			(void)trans_type;
+			bool use_spi = true;
+#endif
+#if FRAME_CHECK_DEBUG
+			if (use_spi && !spi_open) {
+				if (hx_drv_spi_mst_open_speed(SPI_SEN_PIC_CLK) != 0) {
+					xprintf("DEBUG SPI master init fail\r\n");
+				} else {
+					spi_open = true;
+				}
+			}
+			if (use_spi && spi_open) {
+				hx_drv_spi_mst_protocol_write_sp((uint32_t)slot->jpeg, slot->jpeg_sz, DATA_TYPE_JPG);
+				hx_drv_spi_mst_protocol_write_sp((uint32_t)&slot->result, sizeof(struct_yolov8_ob_algoResult),
+						DATA_TYPE_META_YOLOV8_OB_DATA);
+			}
+#else
+			(void)use_spi;
+#endif
+#ifdef UART_SEND_ALOGO_RESEULT
+			set_model_change_by_uart();
+#endif
+		}
+
+		void account(FrameSlot *slot) {
+			for (int s = 0; s < STAGE_COUNT; ++s) totals[s] += slot->cycles[s];
+			latency += (HrNow() - slot->captured).to_cycles();
+			if (TFLM_YOLOV8_OD_CSP_REPORT_FRAMES == 0 || ++frames < TFLM_YOLOV8_OD_CSP_REPORT_FRAMES) return;
+
+			uint64_t window_us = window.lap().to_microseconds();
+			uint32_t fps_x10 = (window_us != 0) ? (uint32_t)(frames * 10000000ull / window_us) : 0;
+			xprintf("[pipeline] %u frames, avg us: resize %u npu %u post %u uplink %u, latency %u, %u.%u fps\r\n",
+					(unsigned)frames,
+					(unsigned)HrTime(totals[STAGE_RESIZE] / frames).to_microseconds(),
+					(unsigned)HrTime(totals[STAGE_NPU] / frames).to_microseconds(),
+					(unsigned)HrTime(totals[STAGE_POST] / frames).to_microseconds(),
+					(unsigned)HrTime(totals[STAGE_UPLINK] / frames).to_microseconds(),
+					(unsigned)HrTime(latency / frames).to_microseconds(),
+					(unsigned)(fps_x10 / 10), (unsigned)(fps_x10 % 10));
+			frames = 0;
+			latency = 0;
+			for (int s = 0; s < STAGE_COUNT; ++s) totals[s] = 0;
+		}
+
+	public:
+		Uplink(Chanin<FrameSlot*> i, Chanout<FrameSlot*> fs) : in(i), free_slots(fs) {}
+		const char* name() const override { return "uplink"; }
+
+		void run() override {
+			FrameSlot *slot;
+			window.start();
+			while (true) {
+				in >> slot;
+				Stopwatch watch;
+				send(slot);
+				slot->cycles[STAGE_UPLINK] = watch.lap().to_cycles();
+				account(slot);
+
+				slot->boxes.clear();
+				memset(&slot->result, 0, sizeof(slot->result));
+				free_slots << slot;
+			}
+		}
+	};
+
+	bool reserve_buffers() {
+		const uint32_t input_bytes = cv_yolov8n_ob_input_bytes();
+		// Size of the JPEG (WDMA1) buffer of cisdp_sensor.c
+		jpeg_capacity = app_get_raw_width() * app_get_raw_height() / 4;
+
+		for (int i = 0; i < CSP_PIPELINE_INPUTS; ++i) {
+			inputs[i] = (int8_t *)mm_reserve_align(input_bytes, 0x20);
+			if (inputs[i] == nullptr) return false;
+		}
+		for (int i = 0; i < TFLM_YOLOV8_OD_CSP_FRAMES; ++i) {
+			slots[i].output = (int8_t *)mm_reserve_align(cv_yolov8n_ob_output_bytes(0), 0x20);
+			slots[i].output2 = (int8_t *)mm_reserve_align(cv_yolov8n_ob_output_bytes(1), 0x20);
+			slots[i].jpeg = (uint8_t *)mm_reserve_align(jpeg_capacity, 0x20);
+			if (slots[i].output == nullptr || slots[i].output2 == nullptr || slots[i].jpeg == nullptr) return false;
+		}
+		return true;
+	}
+
+} // namespace
+
+void csp_pipeline_frame(uint32_t jpeg_addr, uint32_t jpeg_sz)
+{
+	capture->frame(jpeg_addr, jpeg_sz);
+}
+
+void csp_pipeline_idle(void)
+{
+	os::delay(1);
+}
+
+void csp_pipeline_select_model(uint32_t model)
+{
+	if (model < TFLM_YOLOV8_OD_CSP_MODELS) wanted_model = model;
+}
+
+void csp_pipeline_start(uint32_t model)
+{
+	if (model >= TFLM_YOLOV8_OD_CSP_MODELS) model = 0;
+	for (int b = 0; b < CV_YOLOV8N_OB_BANKS; ++b) banks[b].id = b;
+	banks[0].model = model;
+	wanted_model = model;
+	// The first model is loaded before the processes start, straight on this thread
+	if (cv_yolov8n_ob_banks_init(model_addr, TFLM_YOLOV8_OD_CSP_MODELS) != 0 ||
+		cv_yolov8n_ob_bank_prepare(0, model_addr[model]) != 0 || cv_yolov8n_ob_bank_allocate(0) != 0) {
+		xprintf("csp pipeline: cannot load the %s model\r\n", model_name[model]);
+		return;
+	}
+	if (!reserve_buffers()) {
+		xprintf("csp pipeline: out of memory for %d frames, lower TFLM_YOLOV8_OD_CSP_FRAMES\r\n",
+				TFLM_YOLOV8_OD_CSP_FRAMES);
+		return;
+	}
+
+	CSP_PLACE_BULK static FrameChannel to_infer, to_post, to_uplink, slot_return;
+	CSP_PLACE_BULK static InputChannel input_return;
+	CSP_PLACE_BULK static BufferedOne2OneChannel<NpuJob, 1> npu_requests, load_jobs;
+	CSP_PLACE_BULK static One2OneChannel<NpuJob> npu_responses, load_done;
+	CSP_PLACE_BULK static BankChannel load_requests, loaded;
+	CSP_PLACE_BULK static BufferedOne2OneChannel<int, CV_YOLOV8N_OB_BANKS> retired;
+
+	CSP_PLACE_BULK static Pinned<Capture, 1024> proc_capture(slot_return.reader(), input_return.reader(), to_infer.writer());
+	CSP_PLACE_BULK static Pinned<Infer, 1024>   proc_infer(to_infer.reader(), input_return.writer(),
+														   npu_requests.writer(), npu_responses.reader(), to_post.writer(),
+														   load_requests.writer(), loaded.reader(), &banks[0]);
+	CSP_PLACE_BULK static Pinned<ModelManager, 1024> proc_models(load_requests.reader(), retired.reader(),
+																 load_jobs.writer(), load_done.reader(), loaded.writer(), 0);
+	CSP_PLACE_BULK static Pinned<NpuInferenceProcess, 1024> proc_npu(TFLM_YOLOV8_OD_CSP_REPORT_FRAMES);
+	CSP_PLACE_BULK static Pinned<Post, 1024>    proc_post(to_post.reader(), to_uplink.writer(), retired.writer());
+	CSP_PLACE_BULK static Pinned<Uplink, 2048>  proc_uplink(to_uplink.reader(), slot_return.writer());
+	capture = &proc_capture;
+	proc_npu.attach({ "yolov8_od", invoke_yolov8_od }, npu_requests.reader(), npu_responses.writer());
+	proc_npu.attach({ "model_load", invoke_model_load }, load_jobs.reader(), load_done.writer());
+
+	// Source first keeps the NPU fed. The return channels are left out:
+	// they close the loop and carry no work.
+	Topology topology;
+	topology.connect(proc_capture, proc_infer)
+			.connect(proc_infer, proc_npu)
+			.connect(proc_infer, proc_models)
+			.connect(proc_models, proc_npu)
+			.connect(proc_infer, proc_post)
+			.connect(proc_post, proc_uplink);
+
+	xprintf("csp pipeline: %d frames in flight, serving the %s model\r\n", TFLM_YOLOV8_OD_CSP_FRAMES, model_name[model]);
+	// Each process gets a thread on its own stack, Capture's runs the event
+	// loop; none of them runs before the scheduler starts
+	Run(InParallel(proc_capture, proc_infer, proc_models, proc_npu, proc_post, proc_uplink),
+		ExecutionMode::StaticNetwork, PriorityPolicy::SourceFirst, topology);
+
+	vTaskStartScheduler();
+}
+#endif /* TFLM_YOLOV8_OD_CSP */
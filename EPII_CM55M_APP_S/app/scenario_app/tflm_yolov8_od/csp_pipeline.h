@@ -0,0 +1,56 @@
+/*
+ * csp_pipeline.h
+ *
+ *  Pipelined build of tflm_yolov8_od (TFLM_YOLOV8_OD_CSP=1): capture/resize,
+ *  NPU inference, post-processing and uplink run as csp4cmsis processes
+ *  connected by buffered channels, so that consecutive frames overlap.
+ */
+
+#ifndef SCENARIO_TFLM_YOLOV8_OD_CSP_PIPELINE_
+#define SCENARIO_TFLM_YOLOV8_OD_CSP_PIPELINE_
+
+#include <stdint.h>
+
+/* Frames in flight: each one holds its own input, output and JPEG buffers */
+#ifndef TFLM_YOLOV8_OD_CSP_FRAMES
+#define TFLM_YOLOV8_OD_CSP_FRAMES	3
+#endif
+
+/* Models the pipeline can switch between: day and night (model_addr[] of csp_pipeline.cpp) */
+#define TFLM_YOLOV8_OD_CSP_MODELS	2
+
+/* Switch to the next model every N frames, to exercise the switch (0: only on request) */
+#ifndef TFLM_YOLOV8_OD_CSP_SWAP_FRAMES
+#define TFLM_YOLOV8_OD_CSP_SWAP_FRAMES	0
+#endif
+
+/* Per-stage timing report, every N frames (0: off) */
+#ifndef TFLM_YOLOV8_OD_CSP_REPORT_FRAMES
+#define TFLM_YOLOV8_OD_CSP_REPORT_FRAMES	30
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Loads the given model, reserves the frame buffers, starts the processes
+ * and the scheduler. Call after cv_yolov8n_ob_init() with model_addr 0 and
+ * app_start_state(); does not return.
+ */
+void csp_pipeline_start(uint32_t model);
+
+/* Model for the frames captured from now on; switched in the background, at a frame boundary */
+void csp_pipeline_select_model(uint32_t model);
+
+/* Frame-ready hook of the datapath event callback (capture process) */
+void csp_pipeline_frame(uint32_t jpeg_addr, uint32_t jpeg_sz);
+
+/* hxevent idle callback: lets the other processes run between events */
+void csp_pipeline_idle(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCENARIO_TFLM_YOLOV8_OD_CSP_PIPELINE_ */
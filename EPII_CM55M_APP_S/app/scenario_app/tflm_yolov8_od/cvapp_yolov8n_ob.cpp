@@ -28,7 +28,10 @@
 #include "tensorflow/lite/micro/micro_error_reporter.h"
 #endif
 #include "img_proc_helium.h"
+#include "img_proc_fused.h"
 #include "yolo_postprocessing.h"
+#include "yolo_post.h"
+#include "yolo_nms.h"
 
 
 #include "xprintf.h"
@@ -36,6 +39,12 @@
 #include "cisdp_cfg.h"
 #include "memory_manage.h"
 #include <send_result.h>
+#if TFLM_YOLOV8_OD_CSP
+#include <new>
+#include "FreeRTOS.h"
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tflm_arena_tflm.h"
+#endif
 
 #define CHANGE_YOLOV8_OB_OUPUT_SHAPE 1
 
@@ -54,6 +63,17 @@
 
 #define YOLOV8N_OB_DBG_APP_LOG 0
 
+/* Detections above the score threshold kept per frame, before NMS */
+#define YOLOV8_OB_MAX_CANDIDATES 256
+static uint16_t cand_anchor[YOLOV8_OB_MAX_CANDIDATES];
+static uint16_t cand_class[YOLOV8_OB_MAX_CANDIDATES];
+static float cand_score[YOLOV8_OB_MAX_CANDIDATES];
+static float cand_x[YOLOV8_OB_MAX_CANDIDATES];
+static float cand_y[YOLOV8_OB_MAX_CANDIDATES];
+static float cand_w[YOLOV8_OB_MAX_CANDIDATES];
+static float cand_h[YOLOV8_OB_MAX_CANDIDATES];
+static yolo_nms_work_t nms_work;
+
 
 // #define EACH_STEP_TICK
 #define TOTAL_STEP_TICK
@@ -77,13 +97,20 @@ using namespace std;
 
 namespace {
 
+#if TFLM_YOLOV8_OD_CSP
+/* Model requirements are measured in the first 1053KB; the rest holds the second bank's persistent area */
+constexpr int tensor_arena_model_size = 1053*1024;
+constexpr int tensor_arena_size = tensor_arena_model_size + TFLM_ARENA_PROBE_PERSISTENT;
+#else
 constexpr int tensor_arena_size = 1053*1024;
+#endif
 
 static uint32_t tensor_arena=0;
 
 struct ethosu_driver ethosu_drv; /* Default Ethos-U device driver */
 tflite::MicroInterpreter *yolov8n_ob_int_ptr=nullptr;
 TfLiteTensor *yolov8n_ob_input, *yolov8n_ob_output, *yolov8n_ob_output2;
+static tflite::MicroMutableOpResolver<2> yolov8n_ob_op_resolver;
 };
 
 #if YOLOV8N_OB_DBG_APP_LOG
@@ -112,6 +139,12 @@ static void _arm_npu_irq_init(void)
      * Note, this handler comes from the EthosU driver */
     EPII_NVIC_SetVector(ethosu_irqnum, (uint32_t)_arm_npu_irq_handler);
 
+#if TFLM_YOLOV8_OD_CSP
+    /* The driver's semaphore is a csp4cmsis IrqEvent (CSP4CMSIS_ETHOSU), raised
+     * from this handler: it must not preempt the kernel's critical sections */
+    NVIC_SetPriority(ethosu_irqnum, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+#endif
+
     /* Enable the IRQ */
     NVIC_EnableIRQ(ethosu_irqnum);
 
@@ -159,6 +192,12 @@ int cv_yolov8n_ob_init(bool security_enable, bool privilege_enable, uint32_t mod
 	if(_arm_npu_init(security_enable, privilege_enable)!=0)
 		return -1;
 
+	yolov8n_ob_op_resolver.AddTranspose();
+	if (kTfLiteOk != yolov8n_ob_op_resolver.AddEthosU()){
+		xprintf("Failed to add Arm NPU support to op resolver.");
+		return false;
+	}
+
 	if(model_addr != 0) {
 		static const tflite::Model*yolov8n_ob_model = tflite::GetModel((const void *)model_addr);
 
@@ -175,13 +214,6 @@ int cv_yolov8n_ob_init(bool security_enable, bool privilege_enable, uint32_t mod
 		#if TFLM2209_U55TAG2205
 		static tflite::MicroErrorReporter yolov8n_ob_micro_error_reporter;
 		#endif
-		static tflite::MicroMutableOpResolver<2> yolov8n_ob_op_resolver;
-
-		yolov8n_ob_op_resolver.AddTranspose();
-		if (kTfLiteOk != yolov8n_ob_op_resolver.AddEthosU()){
-			xprintf("Failed to add Arm NPU support to op resolver.");
-			return false;
-		}
 		#if TFLM2209_U55TAG2205
 			static tflite::MicroInterpreter yolov8n_ob_static_interpreter(yolov8n_ob_model, yolov8n_ob_op_resolver,
 					(uint8_t*)tensor_arena, tensor_arena_size, &yolov8n_ob_micro_error_reporter);
@@ -208,58 +240,9 @@ int cv_yolov8n_ob_init(bool security_enable, bool privilege_enable, uint32_t mod
 
 
 
-typedef struct detection_cls_yolov8{
-    box bbox;
-    float confidence;
-    float index;
-
-} detection_cls_yolov8;
-
-static bool yolov8_det_comparator(detection_cls_yolov8 &pa, detection_cls_yolov8 &pb)
-{
-    return pa.confidence > pb.confidence;
-}
-
-static void  yolov8_NMSBoxes(std::vector<box> &boxes,std::vector<float> &confidences,float modelScoreThreshold,float modelNMSThreshold,std::vector<int>& nms_result)
-{
-    detection_cls_yolov8 yolov8_bbox;
-    std::vector<detection_cls_yolov8> yolov8_bboxes{};
-    for(int i = 0; i < boxes.size(); i++)
-    {
-        yolov8_bbox.bbox = boxes[i];
-        yolov8_bbox.confidence = confidences[i];
-        yolov8_bbox.index = i;
-        yolov8_bboxes.push_back(yolov8_bbox);
-    }
-    sort(yolov8_bboxes.begin(), yolov8_bboxes.end(), yolov8_det_comparator);
-    int updated_size = yolov8_bboxes.size();
-    for(int k = 0; k < updated_size; k++)
-    {
-        if(yolov8_bboxes[k].confidence < modelScoreThreshold)
-        {
-            continue;
-        }
-        
-        nms_result.push_back(yolov8_bboxes[k].index);
-        for(int j = k + 1; j < updated_size; j++)
-        {
-            float iou = box_iou(yolov8_bboxes[k].bbox, yolov8_bboxes[j].bbox);
-            // float iou = box_diou(yolov8_bboxes[k].bbox, yolov8_bboxes[j].bbox);
-            if(iou > modelNMSThreshold)
-            {
-                yolov8_bboxes.erase(yolov8_bboxes.begin() + j);
-                updated_size = yolov8_bboxes.size();
-                j = j -1;
-            }
-        }
-
-    }
-}
-
-
-
 #if CHANGE_YOLOV8_OB_OUPUT_SHAPE
-static void yolov8_ob_post_processing(tflite::MicroInterpreter* static_interpreter,float modelScoreThreshold, float modelNMSThreshold, struct_yolov8_ob_algoResult *alg,	std::forward_list<el_box_t> &el_algo)
+static void yolov8_ob_post_processing(tflite::MicroInterpreter* static_interpreter,float modelScoreThreshold, float modelNMSThreshold, struct_yolov8_ob_algoResult *alg,	std::forward_list<el_box_t> &el_algo,
+	const int8_t *output_data, const int8_t *output_2_data)
 {
 	uint32_t img_w = app_get_raw_width();
     uint32_t img_h = app_get_raw_height();
@@ -284,10 +267,6 @@ static void yolov8_ob_post_processing(tflite::MicroInterpreter* static_interpret
 	int input_w = YOLOV8_OB_INPUT_TENSOR_WIDTH;
 	int input_h = YOLOV8_OB_INPUT_TENSOR_HEIGHT;
 
-	std::vector<uint16_t> class_idxs;
-	std::vector<float> confidences;
-	std::vector<box> boxes;
-
 
 	float output_scale = ((TfLiteAffineQuantization*)(output->quantization.params))->scale->data[0];
 	int output_zeropoint = ((TfLiteAffineQuantization*)(output->quantization.params))->zero_point->data[0];
@@ -304,98 +283,51 @@ static void yolov8_ob_post_processing(tflite::MicroInterpreter* static_interpret
 		xprintf("output_2_zeropoint: %d\r\n",output_2_zeropoint);
 	#endif
 	/***
-	 * dequantize the output result for box
-	 * 
-	 * 
+	 * select on the int8 scores (argmax and threshold, Helium on the M55),
+	 * then dequantize the scores and boxes of the selected anchors only
 	 ******/
-	for(int dims_cnt_2 = 0; dims_cnt_2 < output->dims->data[2]; dims_cnt_2++)//// output->dims->data[2] is 756
-	{
-		float outputs_bbox_data[4];
-		float maxScore = (-1);// the first four indexes are bbox information
-		uint16_t maxClassIndex = 0;
-		for(int dims_cnt_1 = 0; dims_cnt_1 < output->dims->data[1]; dims_cnt_1++)// output->dims->data[1] is 4 
-		{
-			int value =  output->data.int8[ dims_cnt_2 + dims_cnt_1 * output->dims->data[2]];
-			
-			float deq_value = ((float) value-(float)output_zeropoint) * output_scale ;
-
-			/***
-			 * fix big score
-			 * ****/
-			if(dims_cnt_1%2)//==1
-			{
-				deq_value *= (float)input_h;
-			}
-			else
-			{
-				deq_value *= (float)input_w;
-			}
-			outputs_bbox_data[dims_cnt_1] = deq_value;
-		}
+	yolo_post_cands_t cands = { cand_anchor, cand_class, cand_score, { cand_x, cand_y, cand_w, cand_h }, YOLOV8_OB_MAX_CANDIDATES, 0, 0 };
+	yolo_post_scores_t scores = { output_2_data, output->dims->data[2], num_classes, num_classes, 1,
+		output_2_scale, output_2_zeropoint, 0 };
+	yolo_post_select(&scores, modelScoreThreshold, 0, &cands);
+	yolo_post_decode_xywh(output_data, output->dims->data[2], output_scale, output_zeropoint,
+		(float)input_w, (float)input_h, &cands, 0);
 
-		for(int output_2_dims_cnt_1 = 0; output_2_dims_cnt_1 < output_2->dims->data[2]; output_2_dims_cnt_1++)//output_2->dims->data[2] is 80
-		{
-			int value_2 =  output_2->data.int8[ output_2_dims_cnt_1 + dims_cnt_2 * output_2->dims->data[2]];
-			
-			float deq_value_2 = ((float) value_2-(float)output_2_zeropoint) * output_2_scale ;
-			/***
-			 * find maximum Score and correspond Class idx
-			 * **/
-			if(maxScore < deq_value_2)
-			{
-				maxScore = deq_value_2;
-				maxClassIndex = output_2_dims_cnt_1;
-			}
-		}
-		if (maxScore >= modelScoreThreshold)
-		{
-			box bbox;
-			
-			bbox.x = (outputs_bbox_data[0] - (0.5 * outputs_bbox_data[2]));
-			bbox.y = (outputs_bbox_data[1] - (0.5 * outputs_bbox_data[3]));
-			bbox.w =(outputs_bbox_data[2]);
-			bbox.h = (outputs_bbox_data[3]);
-			boxes.push_back(bbox);
-			class_idxs.push_back(maxClassIndex);
-			confidences.push_back(maxScore);
-			
-		}
-	}
 
 	
 	#if YOLOV8N_OB_DBG_APP_LOG
-		xprintf("boxes.size(): %d\r\n",boxes.size());
+		xprintf("cands.count: %d, dropped: %d\r\n",cands.count,cands.dropped);
 	#endif
 	/**
-	 * do nms
+	 * do nms: class-agnostic, on the candidate arrays, no heap
 	 * 
 	 * **/
 
-	std::vector<int> nms_result;
-	yolov8_NMSBoxes(boxes, confidences, modelScoreThreshold, modelNMSThreshold, nms_result);
+	uint16_t nms_keep[MAX_TRACKED_YOLOV8_ALGO_RES];
+	uint32_t nms_count = yolo_nms(&cands.box, cand_score, NULL, cands.count, modelNMSThreshold, 0.f,
+		MAX_TRACKED_YOLOV8_ALGO_RES, &nms_work, nms_keep);
 	#if YOLOV8N_OB_DBG_APP_LOG
-		xprintf("nms_result.size(): %d\r\n",nms_result.size());
+		xprintf("nms_count: %d\r\n",nms_count);
 	#endif
-	for (int i = 0; i < nms_result.size(); i++)
+	for (uint32_t i = 0; i < nms_count; i++)
 	{
-		if(!(MAX_TRACKED_YOLOV8_ALGO_RES-i))break;
-		int idx = nms_result[i];
+		int idx = nms_keep[i];
 
 		float scale_factor_w = (float)img_w / (float)YOLOV8_OB_INPUT_TENSOR_WIDTH; 
 		float scale_factor_h = (float)img_h / (float)YOLOV8_OB_INPUT_TENSOR_HEIGHT; 
-		alg->obr[i].confidence = confidences[idx];
-		alg->obr[i].bbox.x = (uint32_t)(boxes[idx].x * scale_factor_w);
-		alg->obr[i].bbox.y = (uint32_t)(boxes[idx].y * scale_factor_h);
-		alg->obr[i].bbox.width = (uint32_t)(boxes[idx].w * scale_factor_w);
-		alg->obr[i].bbox.height = (uint32_t)(boxes[idx].h * scale_factor_h);
-		alg->obr[i].class_idx = class_idxs[idx];
+		alg->obr[i].confidence = cand_score[idx];
+		alg->obr[i].bbox.x = (uint32_t)(cand_x[idx] * scale_factor_w);
+		alg->obr[i].bbox.y = (uint32_t)(cand_y[idx] * scale_factor_h);
+		alg->obr[i].bbox.width = (uint32_t)(cand_w[idx] * scale_factor_w);
+		alg->obr[i].bbox.height = (uint32_t)(cand_h[idx] * scale_factor_h);
+		alg->obr[i].class_idx = cand_class[idx];
 		el_box_t temp_el_box;
-		temp_el_box.score =  confidences[idx]*100;
-		temp_el_box.target =  class_idxs[idx];
-		temp_el_box.x = (uint32_t)(boxes[idx].x * scale_factor_w);
-		temp_el_box.y =  (uint32_t)(boxes[idx].y * scale_factor_h);
-		temp_el_box.w = (uint32_t)(boxes[idx].w * scale_factor_w);
-		temp_el_box.h = (uint32_t)(boxes[idx].h * scale_factor_h);
+		temp_el_box.score =  cand_score[idx]*100;
+		temp_el_box.target =  cand_class[idx];
+		temp_el_box.x = (uint32_t)(cand_x[idx] * scale_factor_w);
+		temp_el_box.y =  (uint32_t)(cand_y[idx] * scale_factor_h);
+		temp_el_box.w = (uint32_t)(cand_w[idx] * scale_factor_w);
+		temp_el_box.h = (uint32_t)(cand_h[idx] * scale_factor_h);
 
 
 		// printf("temp_el_box.x %d,temp_el_box.y: %d\r\n",temp_el_box.x,temp_el_box.y);
@@ -404,7 +336,7 @@ static void yolov8_ob_post_processing(tflite::MicroInterpreter* static_interpret
 		// 	printf("el_algo.box.x %d,el_algo.box.y%d\r\n",box.x,box.y);
 		// }
 		#if YOLOV8N_OB_DBG_APP_LOG
-			printf("detect object[%d]: %s confidences: %f\r\n",i, coco_classes[class_idxs[idx]].c_str(),confidences[idx]);
+			printf("detect object[%d]: %s confidences: %f\r\n",i, coco_classes[cand_class[idx]].c_str(),cand_score[idx]);
 
 		#endif
 	}
@@ -426,10 +358,6 @@ static void yolov8_ob_post_processing(tflite::MicroInterpreter* static_interpret
 	int input_w = YOLOV8_OB_INPUT_TENSOR_WIDTH;
 	int input_h = YOLOV8_OB_INPUT_TENSOR_HEIGHT;
 
-	std::vector<uint16_t> class_idxs;
-	std::vector<float> confidences;
-	std::vector<box> boxes;
-
 
 	float output_scale = ((TfLiteAffineQuantization*)(output->quantization.params))->scale->data[0];
 	int output_zeropoint = ((TfLiteAffineQuantization*)(output->quantization.params))->zero_point->data[0];
@@ -445,87 +373,43 @@ static void yolov8_ob_post_processing(tflite::MicroInterpreter* static_interpret
 		// xprintf("output->dims->data[2]: %d\r\n",output->dims->data[2]);//756
 	#endif
 	/***
-	 * dequantize the output result
-	 * 
-	 * 
+	 * rows 0..3 are the box, rows 4.. the class scores: select on the int8
+	 * scores, then dequantize the selected anchors only
 	 ******/
-	for(int dims_cnt_2 = 0; dims_cnt_2 < output->dims->data[2]; dims_cnt_2++)
-	{
-		float outputs_bbox_data[4];
-		float maxScore = (-1);// the first four indexes are bbox information
-		uint16_t maxClassIndex = 0;
-		for(int dims_cnt_1 = 0; dims_cnt_1 < output->dims->data[1]; dims_cnt_1++)
-		{
-			int value =  output->data.int8[ dims_cnt_2 + dims_cnt_1 * output->dims->data[2]];
-			
-			float deq_value = ((float) value-(float)output_zeropoint) * output_scale ;
-			if(dims_cnt_1<4)
-			{
-				/***
-				 * fix big score
-				 * ****/
-				if(dims_cnt_1%2)//==1
-				{
-					deq_value *= (float)input_h;
-				}
-				else
-				{
-					deq_value *= (float)input_w;
-				}
-				outputs_bbox_data[dims_cnt_1] = deq_value;
-			}
-			else
-			{
-				/***
-				 * find maximum Score and correspond Class idx
-				 * **/
-				if(maxScore < deq_value)
-				{
-					maxScore = deq_value;
-					maxClassIndex = dims_cnt_1-4;
-				}
-			}
+	int num_anchors = output->dims->data[2];
+	yolo_post_cands_t cands = { cand_anchor, cand_class, cand_score, { cand_x, cand_y, cand_w, cand_h }, YOLOV8_OB_MAX_CANDIDATES, 0, 0 };
+	yolo_post_scores_t scores = { output->data.int8 + 4 * num_anchors, num_anchors, num_classes, 1, num_anchors,
+		output_scale, output_zeropoint, 0 };
+	yolo_post_select(&scores, modelScoreThreshold, 0, &cands);
+	yolo_post_decode_xywh(output->data.int8, num_anchors, output_scale, output_zeropoint,
+		(float)input_w, (float)input_h, &cands, 0);
+
 
-		}
-		if (maxScore >= modelScoreThreshold)
-		{
-			box bbox;
-			
-			bbox.x = (outputs_bbox_data[0] - (0.5 * outputs_bbox_data[2]));
-			bbox.y = (outputs_bbox_data[1] - (0.5 * outputs_bbox_data[3]));
-			bbox.w =(outputs_bbox_data[2]);
-			bbox.h = (outputs_bbox_data[3]);
-			boxes.push_back(bbox);
-			class_idxs.push_back(maxClassIndex);
-			confidences.push_back(maxScore);
-			
-		}
-	}
 	#if YOLOV8N_OB_DBG_APP_LOG
-		xprintf("boxes.size(): %d\r\n",boxes.size());
+		xprintf("cands.count: %d, dropped: %d\r\n",cands.count,cands.dropped);
 	#endif
 	/**
-	 * do nms
+	 * do nms: class-agnostic, on the candidate arrays, no heap
 	 * 
 	 * **/
 
-	std::vector<int> nms_result;
-	yolov8_NMSBoxes(boxes, confidences, modelScoreThreshold, modelNMSThreshold, nms_result);
-	for (int i = 0; i < nms_result.size(); i++)
+	uint16_t nms_keep[MAX_TRACKED_YOLOV8_ALGO_RES];
+	uint32_t nms_count = yolo_nms(&cands.box, cand_score, NULL, cands.count, modelNMSThreshold, 0.f,
+		MAX_TRACKED_YOLOV8_ALGO_RES, &nms_work, nms_keep);
+	for (uint32_t i = 0; i < nms_count; i++)
 	{
-		if(!(MAX_TRACKED_YOLOV8_ALGO_RES-i))break;
-		int idx = nms_result[i];
+		int idx = nms_keep[i];
 
 		float scale_factor_w = (float)img_w / (float)YOLOV8_OB_INPUT_TENSOR_WIDTH; 
 		float scale_factor_h = (float)img_h / (float)YOLOV8_OB_INPUT_TENSOR_HEIGHT; 
-		alg->obr[i].confidence = confidences[idx];
-		alg->obr[i].bbox.x = (uint32_t)(boxes[idx].x * scale_factor_w);
-		alg->obr[i].bbox.y = (uint32_t)(boxes[idx].y * scale_factor_h);
-		alg->obr[i].bbox.width = (uint32_t)(boxes[idx].w * scale_factor_w);
-		alg->obr[i].bbox.height = (uint32_t)(boxes[idx].h * scale_factor_h);
-		alg->obr[i].class_idx = class_idxs[idx];
+		alg->obr[i].confidence = cand_score[idx];
+		alg->obr[i].bbox.x = (uint32_t)(cand_x[idx] * scale_factor_w);
+		alg->obr[i].bbox.y = (uint32_t)(cand_y[idx] * scale_factor_h);
+		alg->obr[i].bbox.width = (uint32_t)(cand_w[idx] * scale_factor_w);
+		alg->obr[i].bbox.height = (uint32_t)(cand_h[idx] * scale_factor_h);
+		alg->obr[i].class_idx = cand_class[idx];
 		#if YOLOV8N_OB_DBG_APP_LOG
-			printf("detect object[%d]: %s confidences: %f\r\n",i, coco_classes[class_idxs[idx]].c_str(),confidences[idx]);
+			printf("detect object[%d]: %s confidences: %f\r\n",i, coco_classes[cand_class[idx]].c_str(),cand_score[idx]);
 
 		#endif
 	}
@@ -535,8 +419,6 @@ static void yolov8_ob_post_processing(tflite::MicroInterpreter* static_interpret
 
 int cv_yolov8n_ob_run(struct_yolov8_ob_algoResult *algoresult_yolov8n_ob) {
 	int ercode = 0;
-    float w_scale;
-    float h_scale;
     uint32_t img_w = app_get_raw_width();
     uint32_t img_h = app_get_raw_height();
     uint32_t ch = app_get_raw_channels();
@@ -556,32 +438,13 @@ int cv_yolov8n_ob_run(struct_yolov8_ob_algoResult *algoresult_yolov8n_ob) {
 			SystemGetTick(&systick_1, &loop_cnt_1);
 		#endif
     	//get image from sensor and resize
-		w_scale = (float)(img_w - 1) / (YOLOV8_OB_INPUT_TENSOR_WIDTH - 1);
-		h_scale = (float)(img_h - 1) / (YOLOV8_OB_INPUT_TENSOR_HEIGHT - 1);
-
-		
-		hx_lib_image_resize_BGR8U3C_to_RGB24_helium((uint8_t*)raw_addr, (uint8_t*)yolov8n_ob_input->data.data,  
-		                    img_w, img_h, ch, 
-                        	YOLOV8_OB_INPUT_TENSOR_WIDTH, YOLOV8_OB_INPUT_TENSOR_HEIGHT, w_scale,h_scale);
+		hx_lib_image_resize_BGR8U3C_to_RGB24_int8_helium((uint8_t*)raw_addr, yolov8n_ob_input->data.int8,
+							img_w, img_h, YOLOV8_OB_INPUT_TENSOR_WIDTH, YOLOV8_OB_INPUT_TENSOR_HEIGHT, -128);
 		#ifdef EACH_STEP_TICK						
 			SystemGetTick(&systick_2, &loop_cnt_2);
-			dbg_printf(DBG_LESS_INFO,"Tick for resize image BGR8U3C_to_RGB24_helium for yolov8 OB:[%d]\r\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));							
-		#endif
-
-		#ifdef EACH_STEP_TICK
-			SystemGetTick(&systick_1, &loop_cnt_1);
+			dbg_printf(DBG_LESS_INFO,"Tick for resize image BGR8U3C_to_RGB24_int8_helium for yolov8 OB:[%d]\r\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));							
 		#endif
 
-		// //uint8 to int8
-		for (int i = 0; i < yolov8n_ob_input->bytes; ++i) {
-			*((int8_t *)yolov8n_ob_input->data.data+i) = *((int8_t *)yolov8n_ob_input->data.data+i) - 128;
-    	}
-
-		#ifdef EACH_STEP_TICK
-		SystemGetTick(&systick_2, &loop_cnt_2);
-		dbg_printf(DBG_LESS_INFO,"Tick for Invoke for uint8toint8 for YOLOV8_OB:[%d]\r\n\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));    
-		#endif	
-
 		#ifdef EACH_STEP_TICK
 		SystemGetTick(&systick_1, &loop_cnt_1);
 		#endif
@@ -609,7 +472,8 @@ int cv_yolov8n_ob_run(struct_yolov8_ob_algoResult *algoresult_yolov8n_ob) {
 			SystemGetTick(&systick_1, &loop_cnt_1);
 		#endif
 		//retrieve output data
-		yolov8_ob_post_processing(yolov8n_ob_int_ptr,0.25, 0.45, algoresult_yolov8n_ob,el_algo);
+		yolov8_ob_post_processing(yolov8n_ob_int_ptr,0.25, 0.45, algoresult_yolov8n_ob,el_algo,
+			yolov8n_ob_output->data.int8, yolov8n_ob_output2->data.int8);
 		#ifdef EACH_STEP_TICK
 			SystemGetTick(&systick_2, &loop_cnt_2);
 			dbg_printf(DBG_LESS_INFO,"Tick for Invoke for YOLOV8_OB_post_processing:[%d]\r\n\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));    
@@ -646,7 +510,15 @@ if( g_trans_type == 0 || g_trans_type == 2)// transfer type is (UART) or (UART &
 
 	send_device_id();
 	// event_reply(concat_strings(", ", box_results_2_json_str(el_algo), ", ", img_2_json_str(&temp_el_jpg_img)));
-	event_reply(concat_strings(", ", algo_tick_2_json_str(algoresult_yolov8n_ob->algo_tick),", ", box_results_2_json_str(el_algo), ", ", img_2_json_str(&temp_el_jpg_img)));
+	// event_reply(concat_strings(", ", algo_tick_2_json_str(algoresult_yolov8n_ob->algo_tick),", ", box_results_2_json_str(el_algo), ", ", img_2_json_str(&temp_el_jpg_img)));
+	json_stream_t *reply = event_reply_begin();
+	json_stream_str(reply, ", ");
+	json_stream_algo_tick(reply, algoresult_yolov8n_ob->algo_tick);
+	json_stream_str(reply, ", ");
+	box_results_2_json_stream(reply, el_algo);
+	json_stream_str(reply, ", ");
+	img_2_json_stream(reply, &temp_el_jpg_img);
+	event_reply_end(reply);
 }
 	set_model_change_by_uart();
 #endif	
@@ -661,6 +533,177 @@ if( g_trans_type == 0 || g_trans_type == 2)// transfer type is (UART) or (UART &
 	return ercode;
 }
 
+#if TFLM_YOLOV8_OD_CSP && CHANGE_YOLOV8_OB_OUPUT_SHAPE
+/*
+ * Stages of cv_yolov8n_ob_run() for the CSP pipeline (csp_pipeline.cpp).
+ * They work on frame buffers owned by the caller, so that consecutive frames
+ * can be in different stages at once; only cv_yolov8n_ob_invoke() touches the
+ * interpreter's tensors.
+ *
+ * The pipeline keeps two interpreter banks in tensor_arena so that the next
+ * model can be loaded while the current one serves frames. Each bank has its
+ * own persistent block, sized for the largest model of the table; the scratch
+ * is one block shared by both, since only the NPU job in flight uses it. The
+ * model weights stay in XIP flash.
+ */
+namespace {
+struct model_bank_t {
+	const tflite::Model *model;
+	tflite::MicroInterpreter *interpreter;
+	alignas(tflite::MicroInterpreter) uint8_t storage[sizeof(tflite::MicroInterpreter)];
+	TfLiteTensor *input, *output, *output2;
+};
+
+static model_bank_t banks[CV_YOLOV8N_OB_BANKS];
+static tflm_arena_t arena_plan;
+/* Tensor sizes of the first model loaded: the pipeline's frame buffers */
+static uint32_t bank_input_bytes = 0, bank_output_bytes = 0, bank_output2_bytes = 0;
+};
+
+static const tflite::Model *bank_model(uint32_t model_addr)
+{
+	const tflite::Model *model = tflite::GetModel((const void *)model_addr);
+	if (model->version() != TFLITE_SCHEMA_VERSION) {
+		xprintf(
+			"[ERROR] yolov8n_ob_model's schema version %d is not equal "
+			"to supported version %d\n",
+			model->version(), TFLITE_SCHEMA_VERSION);
+		return nullptr;
+	}
+	return model;
+}
+
+int cv_yolov8n_ob_banks_init(const uint32_t *model_addr, int models)
+{
+	uint32_t persistent = 0, scratch = 0;
+
+	for(int i = 0; i < models; i++) {
+		uint32_t p, s;
+		const tflite::Model *model = bank_model(model_addr[i]);
+		if(model == nullptr)
+			return -1;
+		if(tflm_arena_probe((uint8_t*)tensor_arena, tensor_arena_size, model, yolov8n_ob_op_resolver, &p, &s) != 0) {
+			xprintf("[ERROR] model %d at %x does not fit in the %d byte tensor arena\n", i, model_addr[i], tensor_arena_size);
+			return -1;
+		}
+		xprintf("model %d at %x: persistent %u, scratch %u\n", i, model_addr[i], p, s);
+		if(p > persistent) persistent = p;
+		if(s > scratch) scratch = s;
+	}
+
+	tflm_arena_init(&arena_plan, (uint8_t*)tensor_arena, tensor_arena_size, tflm_arena_clock);
+	for(int b = 0; b < CV_YOLOV8N_OB_BANKS; b++) {
+		tflm_arena_add(&arena_plan, b ? "bank1" : "bank0", persistent, scratch, 0);
+		banks[b].model = nullptr;
+		banks[b].interpreter = nullptr;
+	}
+	if(tflm_arena_plan(&arena_plan) != 0) {
+		xprintf("[ERROR] %d model banks need more than the %d byte tensor arena\n", CV_YOLOV8N_OB_BANKS, tensor_arena_size);
+		return -1;
+	}
+	for(uint32_t i = 0; i < arena_plan.count; i++) {
+		const tflm_arena_model_t *m = &arena_plan.model[i];
+		xprintf("%s arena: persistent %u at %u, scratch %u at %u\n", m->name, m->persistent, m->persistent_off,
+				m->scratch, m->scratch_off);
+	}
+	xprintf("tensor arena: %u of %d bytes used, %u saved, plan %u cycles\n", arena_plan.used, tensor_arena_size,
+			tflm_arena_saved(&arena_plan), arena_plan.plan_cycles);
+	return 0;
+}
+
+int cv_yolov8n_ob_bank_prepare(int bank, uint32_t model_addr)
+{
+	model_bank_t *b = &banks[bank];
+	const tflite::Model *model = bank_model(model_addr);
+	if(model == nullptr)
+		return -1;
+
+	if(b->interpreter != nullptr) {
+		b->interpreter->~MicroInterpreter();
+		b->interpreter = nullptr;
+	}
+	b->model = nullptr;
+	b->input = b->output = b->output2 = nullptr;
+
+	//the allocator objects live in the bank's persistent block: a new one starts it empty
+	tflite::MicroAllocator *allocator = tflm_arena_allocator(&arena_plan, bank);
+	if(allocator == nullptr)
+		return -1;
+	b->interpreter = new (b->storage) tflite::MicroInterpreter(model, yolov8n_ob_op_resolver, allocator);
+	b->model = model;
+	return 0;
+}
+
+int cv_yolov8n_ob_bank_allocate(int bank)
+{
+	model_bank_t *b = &banks[bank];
+	if(b->interpreter == nullptr)
+		return -1;
+	if(b->interpreter->AllocateTensors() != kTfLiteOk)
+		return -1;
+	TfLiteTensor *input = b->interpreter->input(0);
+	TfLiteTensor *output = b->interpreter->output(0);
+	TfLiteTensor *output2 = b->interpreter->output(1);
+
+	if(bank_input_bytes == 0) {
+		bank_input_bytes = input->bytes;
+		bank_output_bytes = output->bytes;
+		bank_output2_bytes = output2->bytes;
+	}
+	else if(input->bytes != bank_input_bytes || output->bytes != bank_output_bytes || output2->bytes != bank_output2_bytes) {
+		return -2;
+	}
+	b->input = input;
+	b->output = output;
+	b->output2 = output2;
+	return 0;
+}
+
+uint32_t cv_yolov8n_ob_input_bytes(void)
+{
+	return bank_input_bytes;
+}
+
+uint32_t cv_yolov8n_ob_output_bytes(int index)
+{
+	return (index == 0) ? bank_output_bytes : bank_output2_bytes;
+}
+
+void cv_yolov8n_ob_preprocess(int8_t *input)
+{
+	uint32_t img_w = app_get_raw_width();
+	uint32_t img_h = app_get_raw_height();
+	uint32_t raw_addr = app_get_raw_addr();
+
+	hx_lib_image_resize_BGR8U3C_to_RGB24_int8_helium((uint8_t*)raw_addr, input,
+						img_w, img_h, YOLOV8_OB_INPUT_TENSOR_WIDTH, YOLOV8_OB_INPUT_TENSOR_HEIGHT, -128);
+}
+
+int cv_yolov8n_ob_invoke(int bank, const int8_t *input, int8_t *output, int8_t *output2)
+{
+	model_bank_t *b = &banks[bank];
+	if(b->input == nullptr)
+		return -1;
+
+	//the input tensor is in the shared scratch: fill it in the same NPU job as the invoke
+	memcpy(b->input->data.data, input, b->input->bytes);
+	if(b->interpreter->Invoke() != kTfLiteOk)
+	{
+		xprintf("yolov8 object detect invoke fail\n");
+		return -1;
+	}
+	memcpy(output, b->output->data.data, b->output->bytes);
+	memcpy(output2, b->output2->data.data, b->output2->bytes);
+	return 0;
+}
+
+void cv_yolov8n_ob_postprocess(int bank, const int8_t *output, const int8_t *output2,
+		struct_yolov8_ob_algoResult *algoresult_yolov8n_ob, std::forward_list<el_box_t> &el_algo)
+{
+	yolov8_ob_post_processing(banks[bank].interpreter,0.25, 0.45, algoresult_yolov8n_ob,el_algo, output, output2);
+}
+#endif
+
 int cv_yolov8n_ob_deinit()
 {
 	
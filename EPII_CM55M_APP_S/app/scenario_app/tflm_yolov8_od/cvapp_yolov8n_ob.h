@@ -19,8 +19,44 @@ int cv_yolov8n_ob_init(bool security_enable, bool privilege_enable, uint32_t mod
 int cv_yolov8n_ob_run(struct_yolov8_ob_algoResult *algoresult_yolov8n_ob);
 
 int cv_yolov8n_ob_deinit();
+
+#if TFLM_YOLOV8_OD_CSP
+/* Interpreter banks: one serves frames while the next model is loaded into the other */
+#define CV_YOLOV8N_OB_BANKS 2
+
+/**
+ * @brief Measures the arena needs of every model and plans the banks for the largest.
+ * Call after cv_yolov8n_ob_init() with model_addr 0.
+ * @return 0, or -1 if a model is invalid or the banks do not fit in the tensor arena
+ */
+int cv_yolov8n_ob_banks_init(const uint32_t *model_addr, int models);
+/**
+ * @brief Replaces the interpreter of a bank that no frame uses any more by one
+ * for the model at model_addr. Does not touch the shared scratch.
+ */
+int cv_yolov8n_ob_bank_prepare(int bank, uint32_t model_addr);
+/**
+ * @brief Allocates the tensors of a prepared bank. Uses the shared scratch:
+ * run it where the invokes run.
+ * @return 0, -1 on failure, -2 if the tensors differ in size from the first model's
+ */
+int cv_yolov8n_ob_bank_allocate(int bank);
+
+/* Pipeline stages of cv_yolov8n_ob_run(), on caller-owned frame buffers */
+uint32_t cv_yolov8n_ob_input_bytes(void);
+uint32_t cv_yolov8n_ob_output_bytes(int index);
+void cv_yolov8n_ob_preprocess(int8_t *input);
+int cv_yolov8n_ob_invoke(int bank, const int8_t *input, int8_t *output, int8_t *output2);
+#endif
 #ifdef __cplusplus
 }
 #endif
 
+#if TFLM_YOLOV8_OD_CSP && defined(__cplusplus)
+#include <forward_list>
+struct el_box_t;
+void cv_yolov8n_ob_postprocess(int bank, const int8_t *output, const int8_t *output2,
+		struct_yolov8_ob_algoResult *algoresult_yolov8n_ob, std::forward_list<el_box_t> &el_algo);
+#endif
+
 #endif /* SCENARIO_TFLM_2IN1_FD_FL_PL_CVAPP_PL_ */
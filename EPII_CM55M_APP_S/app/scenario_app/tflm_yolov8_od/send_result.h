@@ -10,6 +10,7 @@
 
 #include <hx_drv_uart.h>
 #include <math.h>
+#include "json_stream.h"
 extern "C" {
 #include "hx_drv_swreg_aon.h"
 }
@@ -17,6 +18,7 @@ extern "C" {
 #define EL_ATTR_WEAK __attribute__((weak))
 #define EL_VERSION                 __TIMESTAMP__
 #define CONFIG_SSCMA_CMD_MAX_LENGTH (4096)
+#define EVENT_REPLY_RING_SIZE (4096)    /* Transmit ring of the streaming replies, a power of two */
 #define KEYPOINT_NUM 17
 #define FM_POINT_NUM 468
 #define FM_IRIS_POINT_NUM 10
@@ -180,4 +182,10 @@ std::string  img_res_2_json_str(const el_img_t* img);
 std::string  algo_tick_2_json_str(uint32_t algo_tick);
 std::string  fd_fl_results_2_json_str(std::forward_list<el_fd_fl_t>& results);
 std::string  fd_fl_el_9t_results_2_json_str(std::forward_list<el_fd_fl_el_9pt_t>& results);
-std::string  fm_face_bbox_results_2_json_str(std::forward_list<el_box_t>& results);
\ No newline at end of file
+std::string  fm_face_bbox_results_2_json_str(std::forward_list<el_box_t>& results);
+/* Streaming INVOKE reply: event_reply_begin(), the results, event_reply_end() */
+json_stream_t* event_reply_begin();
+void event_reply_end(json_stream_t* reply);
+void box_results_2_json_stream(json_stream_t* reply, std::forward_list<el_box_t>& results);
+void keypoint_results_2_json_stream(json_stream_t* reply, std::forward_list<el_keypoint_t>& results);
+void img_2_json_stream(json_stream_t* reply, const el_img_t* img);
\ No newline at end of file
@@ -67,6 +67,10 @@
 #include "cvapp_yolov8n_ob.h"
 #include "memory_manage.h"
 #include "hx_drv_watchdog.h"
+#if TFLM_YOLOV8_OD_CSP
+#include "hxevent.h"
+#include "csp_pipeline.h"
+#endif
 
 
 #ifdef EPII_FPGA
@@ -721,6 +725,14 @@ static void dp_app_cv_yolov8n_ob_eventhdl_cb(EVT_INDEX_E event)
 // 		if(EPII_get_memory(0x5610F02c)==g_use_case)
 // 			hx_drv_watchdog_update(WATCHDOG_ID_0, WATCH_DOG_TIMEOUT_TH);
 // #endif
+#if TFLM_YOLOV8_OD_CSP
+		//a model case alone is switched by the pipeline, without a reboot
+		if( ((judge_case_data&0xff) !=g_use_case) && ( (judge_case_data>>16) == g_trans_type )
+			&& ((judge_case_data&0xff) < TFLM_YOLOV8_OD_CSP_MODELS) ) {
+			g_use_case = (judge_case_data&0xff);
+			csp_pipeline_select_model(g_use_case);
+		}
+#endif
 		if( ((judge_case_data&0xff) !=g_use_case) || ( (judge_case_data>>16) != g_trans_type ) ) {
 			//cisdp_sensor_stop();
 			model_change();
@@ -737,6 +749,10 @@ static void dp_app_cv_yolov8n_ob_eventhdl_cb(EVT_INDEX_E event)
 
 		cisdp_get_jpginfo(&jpeg_sz, &jpeg_addr);
 
+#if TFLM_YOLOV8_OD_CSP
+		//resize, inference, post-processing and send run in csp_pipeline.cpp
+		csp_pipeline_frame(jpeg_addr, jpeg_sz);
+#else
 #if FRAME_CHECK_DEBUG
 			if(g_spi_master_initial_status == 0) {
 				if(hx_drv_spi_mst_open_speed(SPI_SEN_PIC_CLK) != 0)
@@ -833,6 +849,7 @@ static void dp_app_cv_yolov8n_ob_eventhdl_cb(EVT_INDEX_E event)
 			algoresult_yolov8n_ob.obr[i].class_idx = 0;
 		}
 #endif
+#endif /* TFLM_YOLOV8_OD_CSP */
 		//recapture image
 		//comment here, we will re-trigger at cv run
 		//sensordplib_retrigger_capture();
@@ -899,7 +916,12 @@ void app_start_state(APP_STATE_E state)
 
     cisdp_sensor_start();
 
+#if TFLM_YOLOV8_OD_CSP
+	//the capture process runs the event loop on its own thread, started by csp_pipeline_start()
+	hx_event_set_idlecb(csp_pipeline_idle);
+#else
    	event_handler_start();
+#endif
 }
 
 void model_change() {
@@ -1024,6 +1046,15 @@ int tflm_yolov8_od_app(void) {
 	xprintf("mm_start_addr address: %x \r\n",&mm_start_addr);
 	mm_set_initial((int)(&mm_start_addr), 0x00200000-((int)(&mm_start_addr)-0x34000000));
 #endif
+#if TFLM_YOLOV8_OD_CSP
+	//day or night model: the pipeline loads it and switches on request
+	if(g_use_case < TFLM_YOLOV8_OD_CSP_MODELS) {
+		xprintf("YOLOv8n object detection\n");
+		cv_yolov8n_ob_init(true, true, 0);
+	    app_start_state(APP_STATE_ALLON_YOLOV8N_OB);
+	    csp_pipeline_start(g_use_case);
+	}
+#else
 	if(g_use_case == 0) {
 		xprintf("YOLOv8n object detection\n");
 #ifdef EN_ALGO
@@ -1031,5 +1062,6 @@ int tflm_yolov8_od_app(void) {
 #endif
 	    app_start_state(APP_STATE_ALLON_YOLOV8N_OB);
 	}
+#endif
 	return 0;
 }
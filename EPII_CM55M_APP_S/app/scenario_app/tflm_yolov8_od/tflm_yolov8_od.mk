@@ -17,7 +17,7 @@ EVENTHANDLER_SUPPORT_LIST += evt_datapath
 # The source code should be loacted in ~\library\{lib_name}\
 ##
 # LIB_SEL = pwrmgmt sensordp tflmtag2209_u55tag2205 spi_ptl spi_eeprom hxevent img_proc
-LIB_SEL = pwrmgmt sensordp tflmtag2412_u55tag2411 spi_ptl spi_eeprom hxevent img_proc
+LIB_SEL = pwrmgmt sensordp tflmtag2412_u55tag2411 spi_ptl spi_eeprom hxevent img_proc yolo_post tflm_arena json_stream
 
 ##
 # middleware support feature
@@ -46,6 +46,46 @@ else ifeq ($(CIS_SUPPORT_INAPP_MODEL), cis_imx708)
 APPL_DEFINES += -DCIS_IMX
 endif
 
+##
+# CSP pipelined variant (csp_pipeline.cpp): capture/resize, NPU, post-processing
+# and uplink as csp4cmsis processes on FreeRTOS, overlapping consecutive frames.
+# Build with: make TFLM_YOLOV8_OD_CSP=1
+# Frames in flight, TFLM_YOLOV8_OD_CSP_FRAMES (3): each takes ~83KB for outputs
+# and JPEG, on top of two 110KB resize buffers; 3 fit next to the 1069KB arena
+# (two interpreter banks for the day/night switch, sharing their scratch).
+# TFLM_YOLOV8_OD_CSP_SWAP_FRAMES=N switches model every N frames (0: on request).
+##
+TFLM_YOLOV8_OD_CSP ?= 0
+ifeq ($(TFLM_YOLOV8_OD_CSP), 1)
+TFLM_YOLOV8_OD_CSP_FRAMES ?= 3
+TFLM_YOLOV8_OD_CSP_SWAP_FRAMES ?= 0
+override OS_SEL := freertos
+override MPU := n
+APPL_DEFINES += -DTFLM_YOLOV8_OD_CSP=1
+APPL_DEFINES += -DTFLM_YOLOV8_OD_CSP_FRAMES=$(TFLM_YOLOV8_OD_CSP_FRAMES)
+APPL_DEFINES += -DTFLM_YOLOV8_OD_CSP_SWAP_FRAMES=$(TFLM_YOLOV8_OD_CSP_SWAP_FRAMES)
+# Ethos-U driver hooks from csp4cmsis (npu.cpp): the NPU wait is an ALT on its interrupt
+APPL_DEFINES += -DCSP4CMSIS_ETHOSU=1
+APPL_DEFINES += -DconfigENABLE_MPU=0
+APPL_DEFINES += -DconfigENABLE_TRUSTZONE=0
+# Kernel heap in system SRAM (ucHeap in csp_pipeline.cpp): JSON strings live there
+APPL_DEFINES += -DconfigAPPLICATION_ALLOCATED_HEAP=1
+APPL_DEFINES += -DconfigTOTAL_HEAP_SIZE=98304
+
+override INCDIR += library/csp4cmsis/inc \
+                   library/csp4cmsis/inc/csp \
+                   os/freertos/NTZ/freertos_kernel/include \
+                   os/freertos/NTZ/freertos_kernel/portable/GCC/ARM_CM55_NTZ/non_secure
+override SCENARIO_APP_CXXSRCS += $(wildcard ./library/csp4cmsis/src/*.cpp)
+
+RTOS_PATH = ./os/freertos/NTZ/freertos_kernel
+APPL_CSRCS += $(RTOS_PATH)/tasks.c \
+              $(RTOS_PATH)/queue.c \
+              $(RTOS_PATH)/timers.c \
+              $(RTOS_PATH)/list.c \
+              $(RTOS_PATH)/portable/MemMang/heap_4.c
+endif
+
 ifeq ($(strip $(TOOLCHAIN)), arm)
 override LINKER_SCRIPT_FILE := $(SCENARIO_APP_ROOT)/$(APP_TYPE)/TFLM_yolov8_od_S_only.sct
 else#TOOLChain
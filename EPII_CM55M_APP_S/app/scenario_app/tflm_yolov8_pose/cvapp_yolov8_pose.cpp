@@ -28,6 +28,7 @@
 #include "tensorflow/lite/micro/micro_error_reporter.h"
 #endif
 #include "img_proc_helium.h"
+#include "img_proc_fused.h"
 
 
 #include "xprintf.h"
@@ -35,6 +36,8 @@
 #include "cisdp_cfg.h"
 #include "memory_manage.h"
 #include "yolo_postprocessing.h"
+#include "yolo_post.h"
+#include "yolo_nms.h"
 #include "send_result.h"
 #define YOLOV8_POSE_INPUT_224 0
 #define YOLOV8_POSE_INPUT_256 1
@@ -55,6 +58,17 @@
 #define INPUT_IMAGE_CHANNELS 3
 #define YOLOV8_POSE_INPUT_TENSOR_CHANNEL INPUT_IMAGE_CHANNELS
 
+/* Detections above the score threshold kept per frame, before NMS */
+#define YOLOV8_POSE_MAX_CANDIDATES 256
+static uint16_t cand_anchor[YOLOV8_POSE_MAX_CANDIDATES];
+static uint16_t cand_class[YOLOV8_POSE_MAX_CANDIDATES];
+static float cand_score[YOLOV8_POSE_MAX_CANDIDATES];
+static float cand_x[YOLOV8_POSE_MAX_CANDIDATES];
+static float cand_y[YOLOV8_POSE_MAX_CANDIDATES];
+static float cand_w[YOLOV8_POSE_MAX_CANDIDATES];
+static float cand_h[YOLOV8_POSE_MAX_CANDIDATES];
+static yolo_nms_work_t nms_work;
+
 
 #define  EACH_STEP_TICK 0
 #define TOTAL_STEP_TICK 1
@@ -347,54 +361,6 @@ int cv_yolov8_pose_init(bool security_enable, bool privilege_enable, uint32_t mo
 	return ercode;
 }
 
-typedef struct detection_cls_yolov8{
-    box bbox;
-    float confidence;
-    float index;
-
-} detection_cls_yolov8;
-
-bool yolov8_det_comparator(detection_cls_yolov8 &pa, detection_cls_yolov8 &pb)
-{
-    return pa.confidence > pb.confidence;
-}
-
-static void  yolov8_NMSBoxes(std::vector<box> &boxes,std::vector<float> &confidences,float modelScoreThreshold,float modelNMSThreshold,std::vector<int>& nms_result)
-{
-    detection_cls_yolov8 yolov8_bbox;
-    std::vector<detection_cls_yolov8> yolov8_bboxes{};
-    for(int i = 0; i < boxes.size(); i++)
-    {
-        yolov8_bbox.bbox = boxes[i];
-        yolov8_bbox.confidence = confidences[i];
-        yolov8_bbox.index = i;
-        yolov8_bboxes.push_back(yolov8_bbox);
-    }
-    sort(yolov8_bboxes.begin(), yolov8_bboxes.end(), yolov8_det_comparator);
-    int updated_size = yolov8_bboxes.size();
-    for(int k = 0; k < updated_size; k++)
-    {
-        if(yolov8_bboxes[k].confidence < modelScoreThreshold)
-        {
-            continue;
-        }
-        
-        nms_result.push_back(yolov8_bboxes[k].index);
-        for(int j = k + 1; j < updated_size; j++)
-        {
-            float iou = box_iou(yolov8_bboxes[k].bbox, yolov8_bboxes[j].bbox);
-            // float iou = box_diou(yolov8_bboxes[k].bbox, yolov8_bboxes[j].bbox);
-            if(iou > modelNMSThreshold)
-            {
-                yolov8_bboxes.erase(yolov8_bboxes.begin() + j);
-                updated_size = yolov8_bboxes.size();
-                j = j -1;
-            }
-        }
-
-    }
-}
-
 static void softmax(float *input, size_t input_len) {
   assert(input);
   // assert(input_len >= 0);  Not needed
@@ -582,76 +548,59 @@ static void yolov8_pose_post_processing(tflite::MicroInterpreter* static_interpr
 	// // start postprocessing
 
 
-	std::vector<int> class_ids;
-	std::vector<float> confidences;
-	std::vector<box> boxes;
-	std::vector< struct_human_pose_17> kpts_vector;
-
-	for(int dims_cnt_1=0;dims_cnt_1<dim_total_size;dims_cnt_1++)
+	/***
+	 * select on the int8 person scores of the three tensors, then decode
+	 * the boxes of the selected anchors and the keypoints of the kept ones only
+	 ******/
+	const int score_output_idx[3] = { 4, 6, 2 };
+	yolo_post_cands_t cands = { cand_anchor, cand_class, cand_score, { cand_x, cand_y, cand_w, cand_h }, YOLOV8_POSE_MAX_CANDIDATES, 0, 0 };
+	for(int out_num = 0; out_num < out_dim_size_num; out_num++)
 	{
-		//////conferen ok
-		float maxScore = 0;
-
-		float tmp_result = 0;
-		if(dims_cnt_1 < out_dim_size[0])//576
-		{
-			output_data_idx = 4;
-			maxScore = sigmoid(yolov8_pose_bbox_dequant_value(dims_cnt_1, 0,output[output_data_idx]));
-		}
-		else if(dims_cnt_1 < out_dim_size[1])//720
-		{
-			output_data_idx = 6;
-			maxScore = sigmoid(yolov8_pose_bbox_dequant_value(dims_cnt_1 - out_dim_size[0], 0, output[output_data_idx]));
-		}
-		else 
-		{
-			output_data_idx = 2;
-			maxScore = sigmoid(yolov8_pose_bbox_dequant_value(dims_cnt_1 - out_dim_size[1], 0,output[output_data_idx]));
-		}
-		// float maxScore = sigmoid(outputs_data_756_1[dims_cnt_2]);// the first four indexes are bbox information
-
-		if (maxScore >= modelScoreThreshold)
-		{
-			box bbox;
-	
-			yolov8_pose_cal_xywh(dims_cnt_1, output, &bbox, anchor_756_2, stride_756_1,out_dim_size );
-			boxes.push_back(bbox);
-			confidences.push_back(maxScore);
-			
-			// printf("idx: %d,bbox.x: %f, bbox.y: %f, bbox.w: %f , bbox.h: %f\r\n",dims_cnt_2,bbox.x,bbox.y,bbox.w,bbox.h);
-			struct_human_pose_17 kpts;
-			for(int k = 0 ; k < 17 ; k++)
-			{
-				kpts.hpr[k].x = yolov8_pose_key_pts_dequant_value(dims_cnt_1,k*3 , output[3],anchor_756_2[dims_cnt_1][0],anchor_756_2[dims_cnt_1][1],stride_756_1[dims_cnt_1]);
-				kpts.hpr[k].y = yolov8_pose_key_pts_dequant_value(dims_cnt_1,k*3+1 , output[3],anchor_756_2[dims_cnt_1][0],anchor_756_2[dims_cnt_1][1],stride_756_1[dims_cnt_1]);
-				kpts.hpr[k].score = yolov8_pose_key_pts_dequant_value(dims_cnt_1,k*3+2 , output[3],anchor_756_2[dims_cnt_1][0],anchor_756_2[dims_cnt_1][1],stride_756_1[dims_cnt_1]);
-				// printf("idx: %d,kpts[%d] x: %d, y: %d, score: %f\r\n",dims_cnt_2,k,kpts.hpr[k].x,kpts.hpr[k].y,kpts.hpr[k].score);
-			}
-			kpts_vector.push_back(kpts);
-			// printf("\r\n");
-		}
+		TfLiteTensor* score_output = output[score_output_idx[out_num]];
+		TfLiteAffineQuantization* quant = (TfLiteAffineQuantization*)(score_output->quantization.params);
+		yolo_post_scores_t scores = { score_output->data.int8, score_output->dims->data[1], 1, score_output->dims->data[2], 1,
+			quant->scale->data[0], quant->zero_point->data[0], 1 };
+		yolo_post_select(&scores, modelScoreThreshold, (out_num == 0) ? 0 : out_dim_size[out_num - 1], &cands);
+	}
+	for(uint32_t i = 0; i < cands.count; i++)
+	{
+		int dims_cnt_1 = cand_anchor[i];
+		box bbox;
+
+		yolov8_pose_cal_xywh(dims_cnt_1, output, &bbox, anchor_756_2, stride_756_1,out_dim_size );
+		cand_x[i] = bbox.x;
+		cand_y[i] = bbox.y;
+		cand_w[i] = bbox.w;
+		cand_h[i] = bbox.h;
 	}
 	#if DBG_APP_LOG
-		printf("boxes.size(): %d\r\n",boxes.size());
+		printf("cands.count: %d\r\n",cands.count);
 	#endif
 
 	/**
-	 * do nms
+	 * do nms: on the candidate arrays, no heap
 	 * **/
 
-	std::vector<int> nms_result;
-	yolov8_NMSBoxes(boxes, confidences, modelScoreThreshold, modelNMSThreshold, nms_result);
-	std::vector<detection_yolov8_pose> results_yolov8_pose;
-	for (int i = 0; i < nms_result.size(); i++)
+	uint16_t nms_keep[MAX_TRACKED_YOLOV8_ALGO_RES];
+	uint32_t nms_count = yolo_nms(&cands.box, cand_score, NULL, cands.count, modelNMSThreshold, 0.f,
+		MAX_TRACKED_YOLOV8_ALGO_RES, &nms_work, nms_keep);
+	for (uint32_t i = 0; i < nms_count; i++)
 	{
-		if(!(MAX_TRACKED_YOLOV8_ALGO_RES-i))break;
-		int idx = nms_result[i];
+		int idx = nms_keep[i];
+		int dims_cnt_1 = cand_anchor[idx];
+		struct_human_pose_17 kpts;
+		for(int k = 0 ; k < 17 ; k++)
+		{
+			kpts.hpr[k].x = yolov8_pose_key_pts_dequant_value(dims_cnt_1,k*3 , output[3],anchor_756_2[dims_cnt_1][0],anchor_756_2[dims_cnt_1][1],stride_756_1[dims_cnt_1]);
+			kpts.hpr[k].y = yolov8_pose_key_pts_dequant_value(dims_cnt_1,k*3+1 , output[3],anchor_756_2[dims_cnt_1][0],anchor_756_2[dims_cnt_1][1],stride_756_1[dims_cnt_1]);
+			kpts.hpr[k].score = yolov8_pose_key_pts_dequant_value(dims_cnt_1,k*3+2 , output[3],anchor_756_2[dims_cnt_1][0],anchor_756_2[dims_cnt_1][1],stride_756_1[dims_cnt_1]);
+		}
 
-		alg->dypr[i].bbox.x = (uint32_t)boxes[idx].x;
+		alg->dypr[i].bbox.x = (uint32_t)cand_x[idx];
 
-		alg->dypr[i].bbox.y = (uint32_t)boxes[idx].y;
-		alg->dypr[i].bbox.width = (uint32_t)boxes[idx].w;
-		alg->dypr[i].bbox.height = (uint32_t)boxes[idx].h;
+		alg->dypr[i].bbox.y = (uint32_t)cand_y[idx];
+		alg->dypr[i].bbox.width = (uint32_t)cand_w[idx];
+		alg->dypr[i].bbox.height = (uint32_t)cand_h[idx];
 
 		if(alg->dypr[i].bbox.x >= YOLOV8_POSE_INPUT_TENSOR_WIDTH)alg->dypr[i].bbox.x = YOLOV8_POSE_INPUT_TENSOR_WIDTH;
 		if(alg->dypr[i].bbox.y >= YOLOV8_POSE_INPUT_TENSOR_HEIGHT)alg->dypr[i].bbox.y = YOLOV8_POSE_INPUT_TENSOR_HEIGHT;
@@ -666,16 +615,16 @@ static void yolov8_pose_post_processing(tflite::MicroInterpreter* static_interpr
 		alg->dypr[i].bbox.height = (float)alg->dypr[i].bbox.height / (float)YOLOV8_POSE_INPUT_TENSOR_HEIGHT * (float)img_h;
 
 
-		alg->dypr[i].confidence = confidences[idx];
+		alg->dypr[i].confidence = cand_score[idx];
 
 		el_keypoint_t temp_el_keypoint;
 		for(int k = 0 ; k < KEYPOINT_NUM ; k++)
 		{
-			alg->dypr[i].hpr[k].x = kpts_vector[idx].hpr[k].x;
-			alg->dypr[i].hpr[k].y = kpts_vector[idx].hpr[k].y;
-			alg->dypr[i].hpr[k].score = kpts_vector[idx].hpr[k].score;
+			alg->dypr[i].hpr[k].x = kpts.hpr[k].x;
+			alg->dypr[i].hpr[k].y = kpts.hpr[k].y;
+			alg->dypr[i].hpr[k].score = kpts.hpr[k].score;
 			#if DBG_APP_LOG
-				printf("idx: %d,kpts[%d] x: %d, y: %d, score: %f\r\n",idx,k,kpts_vector[idx].hpr[k].x,kpts_vector[idx].hpr[k].y,kpts_vector[idx].hpr[k].score);
+				printf("idx: %d,kpts[%d] x: %d, y: %d, score: %f\r\n",idx,k,kpts.hpr[k].x,kpts.hpr[k].y,kpts.hpr[k].score);
 			#endif
 			////resize to original image size
 			if(alg->dypr[i].hpr[k].x >= YOLOV8_POSE_INPUT_TENSOR_WIDTH)alg->dypr[i].hpr[k].x = YOLOV8_POSE_INPUT_TENSOR_WIDTH;
@@ -714,8 +663,6 @@ static void yolov8_pose_post_processing(tflite::MicroInterpreter* static_interpr
 
 int cv_yolov8_pose_run(struct_yolov8_pose_algoResult *algoresult_yolov8_pose) {
 	int ercode = 0;
-    float w_scale;
-    float h_scale;
     uint32_t img_w = app_get_raw_width();
     uint32_t img_h = app_get_raw_height();
     uint32_t ch = app_get_raw_channels();
@@ -734,32 +681,15 @@ int cv_yolov8_pose_run(struct_yolov8_pose_algoResult *algoresult_yolov8_pose) {
 
     if(yolov8_pose_int_ptr!= nullptr) {
     	//get image from sensor and resize
-		w_scale = (float)(img_w - 1) / (YOLOV8_POSE_INPUT_TENSOR_WIDTH - 1);
-		h_scale = (float)(img_h - 1) / (YOLOV8_POSE_INPUT_TENSOR_HEIGHT - 1);
-
         #if EACH_STEP_TICK
             SystemGetTick(&systick_1, &loop_cnt_1);
         #endif
-		hx_lib_image_resize_BGR8U3C_to_RGB24_helium((uint8_t*)raw_addr, (uint8_t*)yolov8_pose_input->data.data,  
-		                    img_w, img_h, ch, 
-                        	YOLOV8_POSE_INPUT_TENSOR_WIDTH, YOLOV8_POSE_INPUT_TENSOR_HEIGHT, w_scale,h_scale);
+		hx_lib_image_resize_BGR8U3C_to_RGB24_int8_helium((uint8_t*)raw_addr, yolov8_pose_input->data.int8,
+						img_w, img_h, YOLOV8_POSE_INPUT_TENSOR_WIDTH, YOLOV8_POSE_INPUT_TENSOR_HEIGHT, -128);
 		#if EACH_STEP_TICK						
             SystemGetTick(&systick_2, &loop_cnt_2);
-            xprintf("Tick for resize image BGR8U3C_to_RGB24_helium for yolov8 POSE:[%d]\r\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));							
+            xprintf("Tick for resize image BGR8U3C_to_RGB24_int8_helium for yolov8 POSE:[%d]\r\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));							
 		#endif
-        #if EACH_STEP_TICK
-            SystemGetTick(&systick_1, &loop_cnt_1);
-        #endif
-        
-        // //uint8 to int8
-		for (int i = 0; i < yolov8_pose_input->bytes; ++i) {
-			*((int8_t *)yolov8_pose_input->data.data+i) = *((int8_t *)yolov8_pose_input->data.data+i) - 128;
-    	}
-
-        #if EACH_STEP_TICK
-            SystemGetTick(&systick_2, &loop_cnt_2);
-            xprintf("Tick for Invoke for uint8toint8 for YOLOV8_POSE:[%d]\r\n\n",(loop_cnt_2-loop_cnt_1)*CPU_CLK+(systick_1-systick_2));    
-        #endif	
 
 
         #if EACH_STEP_TICK
@@ -828,7 +758,15 @@ if( g_trans_type == 0 || g_trans_type == 2)// transfer type is (UART) or (UART &
 
 	 send_device_id();
 	// event_reply(concat_strings(", ", keypoint_results_2_json_str(el_keypoint_algo), ", ", img_2_json_str(&temp_el_jpg_img)));
-	event_reply(concat_strings(", ", algo_tick_2_json_str(algoresult_yolov8_pose->algo_tick),", ", keypoint_results_2_json_str(el_keypoint_algo), ", ", img_2_json_str(&temp_el_jpg_img)));
+	// event_reply(concat_strings(", ", algo_tick_2_json_str(algoresult_yolov8_pose->algo_tick),", ", keypoint_results_2_json_str(el_keypoint_algo), ", ", img_2_json_str(&temp_el_jpg_img)));
+	json_stream_t *reply = event_reply_begin();
+	json_stream_str(reply, ", ");
+	json_stream_algo_tick(reply, algoresult_yolov8_pose->algo_tick);
+	json_stream_str(reply, ", ");
+	keypoint_results_2_json_stream(reply, el_keypoint_algo);
+	json_stream_str(reply, ", ");
+	img_2_json_stream(reply, &temp_el_jpg_img);
+	event_reply_end(reply);
 }
 	set_model_change_by_uart();
 #endif	
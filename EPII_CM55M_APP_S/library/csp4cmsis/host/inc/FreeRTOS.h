@@ -0,0 +1,71 @@
+/* --- FreeRTOS.h (csp4cmsis host port) ---
+ * Minimal FreeRTOS kernel API on top of POSIX threads. It covers exactly the
+ * subset used by library/csp4cmsis and the csp4cmsis_* scenario apps so that
+ * process networks can be built and run natively (see host/Makefile).
+ *
+ * Behavioural differences to the target kernel:
+ *  - Tasks are real threads and may run in parallel on several host cores.
+ *  - Priorities are recorded and reported but not enforced by the host scheduler.
+ *  - taskENTER_CRITICAL() and vTaskSuspendAll() take one global recursive lock.
+ *  - There are no context-switch trace hooks, so CSP4CMSIS_STATS reports no
+ *    run time (blocked times and message counts are exact).
+ */
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef uint32_t      TickType_t;
+typedef long          BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t      StackType_t;
+
+/* Static allocation buffers. The host port allocates its own objects, so a
+ * buffer handed to a *Static create function stays unused; the sizes feed
+ * the csp4cmsis footprint report. */
+typedef struct xSTATIC_QUEUE { void* pvDummy[4]; } StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+typedef struct xSTATIC_EVENT_GROUP { void* pvDummy[2]; } StaticEventGroup_t;
+typedef struct xSTATIC_TIMER { void* pvDummy[4]; } StaticTimer_t;
+
+#include "FreeRTOSConfig.h"
+
+#define portMAX_DELAY        ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS   ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(xTimeInMs) \
+    ((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+
+#define pdFALSE  ((BaseType_t)0)
+#define pdTRUE   ((BaseType_t)1)
+#define pdFAIL   (pdFALSE)
+#define pdPASS   (pdTRUE)
+#define errQUEUE_EMPTY ((BaseType_t)0)
+#define errQUEUE_FULL  ((BaseType_t)0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Port layer */
+void        vHostEnterCritical(void);
+void        vHostExitCritical(void);
+UBaseType_t uxHostEnterCriticalFromISR(void);
+void        vHostExitCriticalFromISR(UBaseType_t uxSaved);
+void        vHostYield(void);
+void        vHostAssertFailed(const char* pcFile, int iLine);
+uint64_t    ullHostCycleCount(void);   /* Nanoseconds since process start */
+BaseType_t  xPortIsInsideInterrupt(void);
+
+void* pvPortMalloc(size_t xSize);
+void  vPortFree(void* pv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define portYIELD()                    vHostYield()
+#define portYIELD_FROM_ISR(x)          do { if ((x) != pdFALSE) vHostYield(); } while (0)
+#define portEND_SWITCHING_ISR(x)       portYIELD_FROM_ISR(x)
+
+#endif /* INC_FREERTOS_H */
@@ -0,0 +1,39 @@
+/* --- FreeRTOSConfig.h (csp4cmsis host port) ---
+ * Mirrors the values of os/freertos/NTZ/config/FreeRTOSConfig.h that the
+ * library and the csp4cmsis_* scenario apps depend on, so networks behave the
+ * same way on the host as on the Cortex-M55.
+ */
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+/* The host cycle counter runs at 1 GHz, i.e. one "cycle" per nanosecond. */
+extern uint32_t SystemCoreClock;
+
+#define configCPU_CLOCK_HZ                      (SystemCoreClock)
+#define configTICK_RATE_HZ                      ((TickType_t)1000)
+#define configMAX_PRIORITIES                    5
+#define configMINIMAL_STACK_SIZE                ((unsigned short)90)
+#define configMAX_TASK_NAME_LEN                 20
+#define configUSE_TASK_NOTIFICATIONS            1
+#define configUSE_MUTEXES                       1
+#define configUSE_COUNTING_SEMAPHORES           1
+#define configNUM_THREAD_LOCAL_STORAGE_POINTERS 5
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        1
+#define configUSE_TRACE_FACILITY                1
+#define configUSE_TIMERS                        1
+#define configTIMER_TASK_PRIORITY               (configMAX_PRIORITIES - 1)
+
+#define INCLUDE_vTaskPrioritySet                1
+#define INCLUDE_uxTaskPriorityGet               1
+#define INCLUDE_vTaskDelete                     1
+#define INCLUDE_vTaskSuspend                    1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_xTaskGetCurrentTaskHandle       1
+
+#define configASSERT(x) do { if ((x) == 0) vHostAssertFailed(__FILE__, __LINE__); } while (0)
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,35 @@
+/* --- semphr.h (csp4cmsis host port) ---
+ * As in FreeRTOS, semaphores are queues with zero-sized items.
+ * Mutexes carry no priority inheritance on the host, and the *Static
+ * variants allocate like the others (see FreeRTOS.h).
+ */
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+#include "queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef QueueHandle_t SemaphoreHandle_t;
+
+QueueHandle_t xQueueCreateCountingSemaphore(const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount);
+QueueHandle_t xQueueCreateMutex(void);
+
+#define xSemaphoreCreateMutex()                 xQueueCreateMutex()
+#define xSemaphoreCreateMutexStatic(buffer)     ((void)(buffer), xQueueCreateMutex())
+#define xSemaphoreCreateBinary()                xQueueCreateCountingSemaphore(1, 0)
+#define xSemaphoreCreateCounting(max, initial)  xQueueCreateCountingSemaphore((max), (initial))
+#define xSemaphoreTake(sem, ticks)              xQueueReceive((sem), NULL, (ticks))
+#define xSemaphoreGive(sem)                     xQueueSend((sem), NULL, 0)
+#define xSemaphoreTakeFromISR(sem, woken)       xQueueReceiveFromISR((sem), NULL, (woken))
+#define xSemaphoreGiveFromISR(sem, woken)       xQueueSendFromISR((sem), NULL, (woken))
+#define uxSemaphoreGetCount(sem)                uxQueueMessagesWaiting((sem))
+#define vSemaphoreDelete(sem)                   vQueueDelete((sem))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEMAPHORE_H */
@@ -0,0 +1,86 @@
+/* --- task.h (csp4cmsis host port) --- */
+#ifndef INC_TASK_H
+#define INC_TASK_H
+
+#include "FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+/* Static allocation buffer; the host port keeps its own control block. */
+typedef struct xSTATIC_TCB { void* pvDummy; } StaticTask_t;
+
+#define tskIDLE_PRIORITY ((UBaseType_t)0U)
+
+typedef enum { eRunning = 0, eReady, eBlocked, eSuspended, eDeleted, eInvalid } eTaskState;
+
+/* Filled in by uxTaskGetSystemState(). The host has no stack to inspect:
+ * pxStackBase is NULL and usStackHighWaterMark 0. */
+typedef struct xTASK_STATUS {
+    TaskHandle_t xHandle;
+    const char* pcTaskName;
+    UBaseType_t xTaskNumber;
+    eTaskState eCurrentState;
+    UBaseType_t uxCurrentPriority;
+    UBaseType_t uxBasePriority;
+    uint32_t ulRunTimeCounter;
+    StackType_t* pxStackBase;
+    uint16_t usStackHighWaterMark;
+} TaskStatus_t;
+
+#define taskYIELD()                     portYIELD()
+#define taskENTER_CRITICAL()            vHostEnterCritical()
+#define taskEXIT_CRITICAL()             vHostExitCritical()
+#define taskENTER_CRITICAL_FROM_ISR()   uxHostEnterCriticalFromISR()
+#define taskEXIT_CRITICAL_FROM_ISR(x)   vHostExitCriticalFromISR(x)
+#define taskDISABLE_INTERRUPTS()        vHostEnterCritical()
+#define taskENABLE_INTERRUPTS()         vHostExitCritical()
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char* const pcName,
+                       const uint32_t usStackDepth, void* const pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t* const pxCreatedTask);
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char* const pcName,
+                               const uint32_t ulStackDepth, void* const pvParameters,
+                               UBaseType_t uxPriority, StackType_t* const puxStackBuffer,
+                               StaticTask_t* const pxTaskBuffer);
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+
+void vTaskDelay(const TickType_t xTicksToDelay);
+void vTaskDelayUntil(TickType_t* const pxPreviousWakeTime, const TickType_t xTimeIncrement);
+
+TickType_t xTaskGetTickCount(void);
+TickType_t xTaskGetTickCountFromISR(void);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+char* pcTaskGetName(TaskHandle_t xTaskToQuery);
+UBaseType_t uxTaskPriorityGet(const TaskHandle_t xTask);
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority);
+
+void vTaskSetThreadLocalStoragePointer(TaskHandle_t xTaskToSet, BaseType_t xIndex, void* pvValue);
+void* pvTaskGetThreadLocalStoragePointer(TaskHandle_t xTaskToQuery, BaseType_t xIndex);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t* pxHigherPriorityTaskWoken);
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+BaseType_t xTaskNotifyStateClear(TaskHandle_t xTask);
+
+UBaseType_t uxTaskGetNumberOfTasks(void);
+UBaseType_t uxTaskGetSystemState(TaskStatus_t* const pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                 uint32_t* const pulTotalRunTime);
+
+void vTaskSuspendAll(void);
+BaseType_t xTaskResumeAll(void);
+
+/* Releases every task created so far and blocks until all of them have
+ * deleted themselves, or until CSP4CMSIS_HOST_RUN_MS (environment) elapses. */
+void vTaskStartScheduler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TASK_H */
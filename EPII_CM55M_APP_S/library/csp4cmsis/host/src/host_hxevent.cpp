@@ -0,0 +1,101 @@
+// --- host_hxevent.cpp (hxevent loop for the host build) ---
+// Single-threaded stand-in for the prebuilt libhxevent.a: activated events
+// are dispatched lowest priority value first, in activation order among
+// equals. There are no interrupts on the host, so an empty queue means the
+// network is finished (or deadlocked) and the loop stops.
+extern "C" {
+#include "hxevent.h"
+}
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace {
+
+    evt_t events[HX_EVENTQUE_MAXSIZE];
+    uint8_t num_events = 0;
+
+    hx_event_t queue[HX_EVENTQUE_MAXSIZE];
+    uint8_t queued = 0;
+
+    hx_idle_cbfunc_t idle_cb = nullptr;
+    volatile bool stop_requested = false;
+
+    [[noreturn]] void finish(const char* reason) {
+        printf("%s", reason);
+        fflush(stdout);
+        fflush(stderr);
+        _exit(0);
+    }
+
+} // namespace
+
+extern "C" {
+
+void hx_event_init() {
+    num_events = 0;
+    queued = 0;
+    idle_cb = nullptr;
+}
+
+void hx_event_create(hx_event_t* event) {
+    if (num_events == HX_EVENTQUE_MAXSIZE) {
+        printf("[HOST] hxevent table full.\r\n");
+        abort();
+    }
+    events[num_events].event_prio = HX_EVENT_DEFAULT_PRIORITY;
+    events[num_events].event_cb = nullptr;
+    *event = num_events++;
+}
+
+void hx_event_set_priority(hx_event_t event, uint8_t prio) { events[event].event_prio = prio; }
+void hx_event_set_callback(hx_event_t event, hx_event_cbfunc_t fct) { events[event].event_cb = fct; }
+void hx_event_set_idlecb(hx_idle_cbfunc_t fct) { idle_cb = fct; }
+void hx_event_set_cycle_cnt() {}
+
+void hx_event_activate_ISR(hx_event_t event) {
+    if (queued == HX_EVENTQUE_MAXSIZE) {
+        printf("[HOST] hxevent queue overflow.\r\n");
+        abort();
+    }
+    queue[queued++] = event;
+}
+
+void hx_eventloop_stop() { stop_requested = true; }
+
+void hx_eventloop_start() {
+    using Clock = std::chrono::steady_clock;
+    const char* limit = getenv("CSP4CMSIS_HOST_RUN_MS");
+    const long limit_ms = limit ? strtol(limit, nullptr, 10) : 0;
+    const Clock::time_point start = Clock::now();
+    static char message[64];
+
+    stop_requested = false;
+    for (uint32_t n = 0; !stop_requested; ++n) {
+        if (limit_ms > 0 && (n & 0x3FF) == 0 &&
+            Clock::now() - start >= std::chrono::milliseconds(limit_ms)) {
+            snprintf(message, sizeof(message), "[HOST] Run limit of %ld ms reached, stopping.\r\n", limit_ms);
+            finish(message);
+        }
+
+        if (queued == 0) {
+            if (idle_cb) idle_cb();
+            if (queued == 0) finish("[HOST] Event queue empty, stopping.\r\n");
+            continue;
+        }
+
+        uint8_t best = 0;
+        for (uint8_t i = 1; i < queued; ++i) {
+            if (events[queue[i]].event_prio < events[queue[best]].event_prio) best = i;
+        }
+        hx_event_t event = queue[best];
+        for (uint8_t i = best + 1; i < queued; ++i) queue[i - 1] = queue[i];
+        --queued;
+
+        if (events[event].event_cb) events[event].event_cb();
+    }
+}
+
+} // extern "C"
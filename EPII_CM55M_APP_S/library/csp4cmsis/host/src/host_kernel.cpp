@@ -0,0 +1,629 @@
+// --- host_kernel.cpp (FreeRTOS API subset on POSIX threads) ---
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "timers.h"
+
+#include <pthread.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using Clock = std::chrono::steady_clock;
+
+uint32_t SystemCoreClock = 1000000000u;
+
+// =============================================================
+// Kernel State
+// =============================================================
+
+struct tskTaskControlBlock {
+    char name[configMAX_TASK_NAME_LEN];
+    std::atomic<UBaseType_t> priority{0};
+    void* tls[configNUM_THREAD_LOCAL_STORAGE_POINTERS] = {};
+    TaskFunction_t code = nullptr;
+    void* params = nullptr;
+
+    std::mutex notify_mutex;
+    std::condition_variable notify_cv;
+    uint32_t notify_value = 0;
+};
+
+namespace {
+
+    // Minimum host stack per task. Host code (printf, sanitizers) needs far
+    // more than the word counts sized for the Cortex-M55.
+    const size_t HOST_MIN_STACK_BYTES = 256 * 1024;
+
+    Clock::time_point epoch() {
+        static const Clock::time_point start = Clock::now();
+        return start;
+    }
+
+    std::recursive_mutex& criticalLock() {
+        static std::recursive_mutex lock;
+        return lock;
+    }
+
+    // Scheduler gate and live tasks, guarded by kernelMutex().
+    std::mutex& kernelMutex() {
+        static std::mutex m;
+        return m;
+    }
+    std::condition_variable& kernelCv() {
+        static std::condition_variable cv;
+        return cv;
+    }
+    bool scheduler_started = false;
+    unsigned live_tasks = 0;
+    std::vector<TaskHandle_t> task_list; // Created by xTaskCreate and not yet deleted
+
+    thread_local TaskHandle_t current_task = nullptr;
+
+    TaskHandle_t newControlBlock(const char* name, UBaseType_t priority) {
+        TaskHandle_t t = new tskTaskControlBlock();
+        strncpy(t->name, name ? name : "", configMAX_TASK_NAME_LEN - 1);
+        t->name[configMAX_TASK_NAME_LEN - 1] = '\0';
+        t->priority = priority;
+        return t;
+    }
+
+    // Threads not created through xTaskCreate (main, timer service) get a
+    // control block on first use so every API call has a calling "task".
+    TaskHandle_t self() {
+        if (current_task == nullptr) current_task = newControlBlock("main", tskIDLE_PRIORITY);
+        return current_task;
+    }
+
+    TaskHandle_t resolve(TaskHandle_t t) { return t ? t : self(); }
+
+    void waitForScheduler() {
+        std::unique_lock<std::mutex> lk(kernelMutex());
+        kernelCv().wait(lk, [] { return scheduler_started; });
+    }
+
+    // Blocks on 'cv' until 'pred' holds or 'ticks' have passed. Returns pred().
+    template <typename Pred>
+    bool waitTicks(std::unique_lock<std::mutex>& lk, std::condition_variable& cv,
+                   TickType_t ticks, Pred pred) {
+        if (ticks == portMAX_DELAY) {
+            cv.wait(lk, pred);
+            return true;
+        }
+        return cv.wait_for(lk, std::chrono::milliseconds(ticks), pred);
+    }
+
+    [[noreturn]] void exitTask() {
+        {
+            std::lock_guard<std::mutex> lk(kernelMutex());
+            live_tasks--;
+            task_list.erase(std::remove(task_list.begin(), task_list.end(), current_task), task_list.end());
+        }
+        kernelCv().notify_all();
+        pthread_exit(nullptr);
+    }
+
+    void* taskEntry(void* arg) {
+        TaskHandle_t t = static_cast<TaskHandle_t>(arg);
+        current_task = t;
+        waitForScheduler();
+        t->code(t->params);
+        // FreeRTOS tasks must not return; treat it as vTaskDelete(NULL).
+        exitTask();
+    }
+
+    void startTimerService();
+
+} // namespace
+
+// =============================================================
+// Port Layer
+// =============================================================
+
+extern "C" {
+
+void vHostEnterCritical(void) { criticalLock().lock(); }
+void vHostExitCritical(void) { criticalLock().unlock(); }
+UBaseType_t uxHostEnterCriticalFromISR(void) { criticalLock().lock(); return 0; }
+void vHostExitCriticalFromISR(UBaseType_t) { criticalLock().unlock(); }
+void vHostYield(void) { std::this_thread::yield(); }
+BaseType_t xPortIsInsideInterrupt(void) { return pdFALSE; }
+
+void vHostAssertFailed(const char* pcFile, int iLine) {
+    fprintf(stderr, "[HOST] configASSERT failed at %s:%d\n", pcFile, iLine);
+    abort();
+}
+
+uint64_t ullHostCycleCount(void) {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch()).count();
+}
+
+void* pvPortMalloc(size_t xSize) { return malloc(xSize); }
+void vPortFree(void* pv) { free(pv); }
+
+// =============================================================
+// Tasks
+// =============================================================
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char* const pcName,
+                       const uint32_t usStackDepth, void* const pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t* const pxCreatedTask) {
+    TaskHandle_t t = newControlBlock(pcName, uxPriority);
+    t->code = pxTaskCode;
+    t->params = pvParameters;
+
+    size_t stack_bytes = (size_t)usStackDepth * sizeof(StackType_t);
+    if (stack_bytes < HOST_MIN_STACK_BYTES) stack_bytes = HOST_MIN_STACK_BYTES;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, stack_bytes);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+    {
+        std::lock_guard<std::mutex> lk(kernelMutex());
+        live_tasks++;
+        task_list.push_back(t);
+    }
+
+    pthread_t thread;
+    int rc = pthread_create(&thread, &attr, taskEntry, t);
+    pthread_attr_destroy(&attr);
+    if (rc != 0) {
+        {
+            std::lock_guard<std::mutex> lk(kernelMutex());
+            live_tasks--;
+            task_list.pop_back();
+        }
+        delete t;
+        return pdFAIL;
+    }
+
+    if (pxCreatedTask) *pxCreatedTask = t;
+    return pdPASS;
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char* const pcName,
+                               const uint32_t ulStackDepth, void* const pvParameters,
+                               UBaseType_t uxPriority, StackType_t* const,
+                               StaticTask_t* const) {
+    TaskHandle_t t = nullptr;
+    xTaskCreate(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &t);
+    return t;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    if (xTaskToDelete == nullptr || xTaskToDelete == current_task) exitTask();
+    printf("[HOST] WARNING: vTaskDelete of another task is not supported, ignored.\r\n");
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay) {
+    if (xTicksToDelay == 0) {
+        std::this_thread::yield();
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay));
+}
+
+void vTaskDelayUntil(TickType_t* const pxPreviousWakeTime, const TickType_t xTimeIncrement) {
+    const TickType_t wake = *pxPreviousWakeTime + xTimeIncrement;
+    const int32_t remaining = (int32_t)(wake - xTaskGetTickCount());
+    if (remaining > 0) std::this_thread::sleep_for(std::chrono::milliseconds(remaining));
+    *pxPreviousWakeTime = wake;
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - epoch()).count();
+}
+
+TickType_t xTaskGetTickCountFromISR(void) { return xTaskGetTickCount(); }
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return self(); }
+
+char* pcTaskGetName(TaskHandle_t xTaskToQuery) { return resolve(xTaskToQuery)->name; }
+
+UBaseType_t uxTaskPriorityGet(const TaskHandle_t xTask) { return resolve(xTask)->priority; }
+
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority) {
+    if (uxNewPriority >= (UBaseType_t)configMAX_PRIORITIES) uxNewPriority = configMAX_PRIORITIES - 1;
+    resolve(xTask)->priority = uxNewPriority;
+}
+
+void vTaskSetThreadLocalStoragePointer(TaskHandle_t xTaskToSet, BaseType_t xIndex, void* pvValue) {
+    if (xIndex >= 0 && xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS) resolve(xTaskToSet)->tls[xIndex] = pvValue;
+}
+
+void* pvTaskGetThreadLocalStoragePointer(TaskHandle_t xTaskToQuery, BaseType_t xIndex) {
+    if (xIndex < 0 || xIndex >= configNUM_THREAD_LOCAL_STORAGE_POINTERS) return nullptr;
+    return resolve(xTaskToQuery)->tls[xIndex];
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify) {
+    {
+        std::lock_guard<std::mutex> lk(xTaskToNotify->notify_mutex);
+        xTaskToNotify->notify_value++;
+    }
+    xTaskToNotify->notify_cv.notify_one();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t* pxHigherPriorityTaskWoken) {
+    xTaskNotifyGive(xTaskToNotify);
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    TaskHandle_t t = self();
+    std::unique_lock<std::mutex> lk(t->notify_mutex);
+    waitTicks(lk, t->notify_cv, xTicksToWait, [t] { return t->notify_value != 0; });
+    const uint32_t value = t->notify_value;
+    if (value != 0) t->notify_value = xClearCountOnExit ? 0 : value - 1;
+    return value;
+}
+
+// Like FreeRTOS, this clears the pending state only; the count is untouched.
+BaseType_t xTaskNotifyStateClear(TaskHandle_t xTask) {
+    TaskHandle_t t = resolve(xTask);
+    std::lock_guard<std::mutex> lk(t->notify_mutex);
+    return t->notify_value != 0 ? pdPASS : pdFAIL;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks(void) {
+    std::lock_guard<std::mutex> lk(kernelMutex());
+    return (UBaseType_t)task_list.size();
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t* const pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                 uint32_t* const pulTotalRunTime) {
+    std::lock_guard<std::mutex> lk(kernelMutex());
+    if (pulTotalRunTime) *pulTotalRunTime = 0;
+    // Like FreeRTOS: nothing is filled in unless every task fits.
+    if (uxArraySize < task_list.size()) return 0;
+    for (size_t i = 0; i < task_list.size(); ++i) {
+        TaskHandle_t t = task_list[i];
+        TaskStatus_t& s = pxTaskStatusArray[i];
+        s.xHandle = t;
+        s.pcTaskName = t->name;
+        s.xTaskNumber = (UBaseType_t)(i + 1);
+        s.eCurrentState = (t == current_task) ? eRunning : eReady;
+        s.uxCurrentPriority = t->priority;
+        s.uxBasePriority = t->priority;
+        s.ulRunTimeCounter = 0;
+        s.pxStackBase = nullptr;
+        s.usStackHighWaterMark = 0;
+    }
+    return (UBaseType_t)task_list.size();
+}
+
+void vTaskSuspendAll(void) { criticalLock().lock(); }
+
+BaseType_t xTaskResumeAll(void) {
+    criticalLock().unlock();
+    return pdFALSE;
+}
+
+void vTaskStartScheduler(void) {
+    self();
+    startTimerService();
+    {
+        std::lock_guard<std::mutex> lk(kernelMutex());
+        scheduler_started = true;
+    }
+    kernelCv().notify_all();
+
+    const char* limit = getenv("CSP4CMSIS_HOST_RUN_MS");
+    const long limit_ms = limit ? strtol(limit, nullptr, 10) : 0;
+
+    bool finished;
+    {
+        std::unique_lock<std::mutex> lk(kernelMutex());
+        auto all_done = [] { return live_tasks == 0; };
+        if (limit_ms > 0) {
+            finished = kernelCv().wait_for(lk, std::chrono::milliseconds(limit_ms), all_done);
+        } else {
+            kernelCv().wait(lk, all_done);
+            finished = true;
+        }
+    }
+
+    if (!finished) printf("[HOST] Run limit of %ld ms reached, stopping.\r\n", limit_ms);
+    else printf("[HOST] All tasks deleted, stopping.\r\n");
+
+    // Like on the target the scheduler never returns. Static channels may still
+    // be in use by blocked threads, so skip the static destructors.
+    fflush(stdout);
+    fflush(stderr);
+    _exit(0);
+}
+
+// =============================================================
+// Queues and Semaphores
+// =============================================================
+
+} // extern "C"
+
+struct QueueDefinition {
+    std::mutex m;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t count = 0;
+    UBaseType_t head = 0;
+    std::vector<uint8_t> storage;
+
+    QueueDefinition(UBaseType_t len, UBaseType_t size)
+        : length(len), item_size(size), storage((size_t)len * size) {}
+};
+
+extern "C" {
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+    if (uxQueueLength == 0) return nullptr;
+    return new QueueDefinition(uxQueueLength, uxItemSize);
+}
+
+QueueHandle_t xQueueCreateCountingSemaphore(const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount) {
+    QueueHandle_t q = xQueueCreate(uxMaxCount, 0);
+    if (q) q->count = uxInitialCount > uxMaxCount ? uxMaxCount : uxInitialCount;
+    return q;
+}
+
+QueueHandle_t xQueueCreateMutex(void) { return xQueueCreateCountingSemaphore(1, 1); }
+
+void vQueueDelete(QueueHandle_t xQueue) { delete xQueue; }
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void* const pvItemToQueue, TickType_t xTicksToWait) {
+    std::unique_lock<std::mutex> lk(xQueue->m);
+    if (!waitTicks(lk, xQueue->not_full, xTicksToWait, [xQueue] { return xQueue->count < xQueue->length; })) {
+        return errQUEUE_FULL;
+    }
+    if (xQueue->item_size) {
+        const UBaseType_t tail = (xQueue->head + xQueue->count) % xQueue->length;
+        memcpy(&xQueue->storage[(size_t)tail * xQueue->item_size], pvItemToQueue, xQueue->item_size);
+    }
+    xQueue->count++;
+    // Notify under the lock: a woken receiver may delete the queue (e.g. a
+    // join semaphore) as soon as it returns.
+    xQueue->not_empty.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void* const pvItemToQueue,
+                             BaseType_t* const pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+    return xQueueSend(xQueue, pvItemToQueue, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* const pvBuffer, TickType_t xTicksToWait) {
+    std::unique_lock<std::mutex> lk(xQueue->m);
+    if (!waitTicks(lk, xQueue->not_empty, xTicksToWait, [xQueue] { return xQueue->count > 0; })) {
+        return errQUEUE_EMPTY;
+    }
+    if (xQueue->item_size) {
+        memcpy(pvBuffer, &xQueue->storage[(size_t)xQueue->head * xQueue->item_size], xQueue->item_size);
+    }
+    xQueue->head = (xQueue->head + 1) % xQueue->length;
+    xQueue->count--;
+    xQueue->not_full.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void* const pvBuffer,
+                                BaseType_t* const pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+    return xQueueReceive(xQueue, pvBuffer, 0);
+}
+
+UBaseType_t uxQueueMessagesWaiting(const QueueHandle_t xQueue) {
+    std::lock_guard<std::mutex> lk(xQueue->m);
+    return xQueue->count;
+}
+
+UBaseType_t uxQueueSpacesAvailable(const QueueHandle_t xQueue) {
+    std::lock_guard<std::mutex> lk(xQueue->m);
+    return xQueue->length - xQueue->count;
+}
+
+} // extern "C"
+
+// =============================================================
+// Event Groups
+// =============================================================
+
+struct EventGroupDef_t {
+    std::mutex m;
+    std::condition_variable cv;
+    EventBits_t bits = 0;
+};
+
+extern "C" {
+
+EventGroupHandle_t xEventGroupCreate(void) { return new EventGroupDef_t(); }
+
+void vEventGroupDelete(EventGroupHandle_t xEventGroup) { delete xEventGroup; }
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor,
+                                const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits,
+                                TickType_t xTicksToWait) {
+    std::unique_lock<std::mutex> lk(xEventGroup->m);
+    auto satisfied = [=] {
+        const EventBits_t set = xEventGroup->bits & uxBitsToWaitFor;
+        return xWaitForAllBits ? set == uxBitsToWaitFor : set != 0;
+    };
+    const bool ok = waitTicks(lk, xEventGroup->cv, xTicksToWait, satisfied);
+    const EventBits_t result = xEventGroup->bits;
+    if (ok && xClearOnExit) xEventGroup->bits &= ~uxBitsToWaitFor;
+    return result;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet) {
+    std::lock_guard<std::mutex> lk(xEventGroup->m);
+    xEventGroup->bits |= uxBitsToSet;
+    xEventGroup->cv.notify_all();
+    return xEventGroup->bits;
+}
+
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet,
+                                     BaseType_t* pxHigherPriorityTaskWoken) {
+    xEventGroupSetBits(xEventGroup, uxBitsToSet);
+    if (pxHigherPriorityTaskWoken) *pxHigherPriorityTaskWoken = pdFALSE;
+    return pdPASS;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToClear) {
+    std::lock_guard<std::mutex> lk(xEventGroup->m);
+    const EventBits_t before = xEventGroup->bits;
+    xEventGroup->bits &= ~uxBitsToClear;
+    return before;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t xEventGroup) {
+    std::lock_guard<std::mutex> lk(xEventGroup->m);
+    return xEventGroup->bits;
+}
+
+} // extern "C"
+
+// =============================================================
+// Software Timers
+// =============================================================
+
+struct tmrTimerControl {
+    TickType_t period;
+    bool auto_reload;
+    void* id;
+    TimerCallbackFunction_t callback;
+    bool active = false;
+    bool deleted = false;
+    Clock::time_point expiry;
+};
+
+namespace {
+
+    std::mutex timer_mutex;
+    std::condition_variable timer_cv;
+    std::vector<TimerHandle_t> timers;
+
+    // Single service thread, the host counterpart of the FreeRTOS timer task.
+    // Deleted timers are freed here, never while their callback is running.
+    void timerService() {
+        current_task = newControlBlock("Tmr Svc", configTIMER_TASK_PRIORITY);
+        waitForScheduler();
+
+        std::unique_lock<std::mutex> lk(timer_mutex);
+        for (;;) {
+            for (size_t i = 0; i < timers.size();) {
+                if (timers[i]->deleted) {
+                    delete timers[i];
+                    timers[i] = timers.back();
+                    timers.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+
+            TimerHandle_t next = nullptr;
+            for (TimerHandle_t t : timers) {
+                if (t->active && (next == nullptr || t->expiry < next->expiry)) next = t;
+            }
+            if (next == nullptr) {
+                timer_cv.wait(lk);
+                continue;
+            }
+            if (Clock::now() < next->expiry) {
+                timer_cv.wait_until(lk, next->expiry);
+                continue;
+            }
+
+            if (next->auto_reload) next->expiry += std::chrono::milliseconds(next->period);
+            else next->active = false;
+
+            lk.unlock();
+            next->callback(next);
+            lk.lock();
+        }
+    }
+
+    void startTimerService() {
+        static std::once_flag once;
+        std::call_once(once, [] { std::thread(timerService).detach(); });
+    }
+
+    BaseType_t arm(TimerHandle_t t) {
+        {
+            std::lock_guard<std::mutex> lk(timer_mutex);
+            if (t->deleted) return pdFAIL;
+            t->expiry = Clock::now() + std::chrono::milliseconds(t->period);
+            t->active = true;
+        }
+        timer_cv.notify_all();
+        return pdPASS;
+    }
+
+} // namespace
+
+extern "C" {
+
+TimerHandle_t xTimerCreate(const char* const, const TickType_t xTimerPeriodInTicks,
+                           const UBaseType_t uxAutoReload, void* const pvTimerID,
+                           TimerCallbackFunction_t pxCallbackFunction) {
+    if (xTimerPeriodInTicks == 0) return nullptr;
+    TimerHandle_t t = new tmrTimerControl();
+    t->period = xTimerPeriodInTicks;
+    t->auto_reload = uxAutoReload != pdFALSE;
+    t->id = pvTimerID;
+    t->callback = pxCallbackFunction;
+
+    std::lock_guard<std::mutex> lk(timer_mutex);
+    timers.push_back(t);
+    return t;
+}
+
+BaseType_t xTimerStart(TimerHandle_t xTimer, TickType_t) { return arm(xTimer); }
+
+BaseType_t xTimerReset(TimerHandle_t xTimer, TickType_t) { return arm(xTimer); }
+
+BaseType_t xTimerChangePeriod(TimerHandle_t xTimer, TickType_t xNewPeriod, TickType_t) {
+    if (xNewPeriod == 0) return pdFAIL;
+    {
+        std::lock_guard<std::mutex> lk(timer_mutex);
+        xTimer->period = xNewPeriod;
+    }
+    return arm(xTimer);
+}
+
+BaseType_t xTimerStop(TimerHandle_t xTimer, TickType_t) {
+    std::lock_guard<std::mutex> lk(timer_mutex);
+    xTimer->active = false;
+    return pdPASS;
+}
+
+BaseType_t xTimerDelete(TimerHandle_t xTimer, TickType_t) {
+    {
+        std::lock_guard<std::mutex> lk(timer_mutex);
+        xTimer->active = false;
+        xTimer->deleted = true;
+    }
+    timer_cv.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xTimerIsTimerActive(TimerHandle_t xTimer) {
+    std::lock_guard<std::mutex> lk(timer_mutex);
+    return xTimer->active ? pdTRUE : pdFALSE;
+}
+
+void* pvTimerGetTimerID(const TimerHandle_t xTimer) { return xTimer->id; }
+
+} // extern "C"
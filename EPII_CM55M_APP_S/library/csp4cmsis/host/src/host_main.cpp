@@ -0,0 +1,20 @@
+// --- host_main.cpp (Native entry point for csp4cmsis scenario apps) ---
+// Stands in for app_main() in <app>.c: same init call, same scheduler start.
+#include "FreeRTOS.h"
+#include "task.h"
+#include <cstdio>
+
+extern "C" void csp_app_main_init(void);
+
+int main(void) {
+    // Line-buffer the console so output interleaves like the UART does.
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    printf("Task creation C++ CSP wrapper test (host).\r\n");
+
+    csp_app_main_init();
+
+    vTaskStartScheduler();
+
+    return 0;
+}
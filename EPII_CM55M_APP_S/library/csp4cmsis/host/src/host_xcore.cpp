@@ -0,0 +1,83 @@
+// --- host_xcore.cpp (Cross-core transport for the host build) ---
+// The second CM55 core is a forked copy of the scenario process. Both share
+// one anonymous MAP_SHARED mapping as the shared SRAM segment; the mailbox
+// interrupt of each side is a pipe, drained by a listener thread that hands
+// the doorbell masks to xcore::deliver(). Host caches are coherent, so
+// clean() and invalidate() stay no-ops.
+#include "xcore.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+    class HostXcoreTransport : public csp::XcoreTransport {
+    public:
+        void* shared = nullptr;
+        int to_peer = -1;
+
+        void* segment() override { return shared; }
+
+        void signal(uint32_t channel_mask) override {
+            // A pipe write up to PIPE_BUF bytes is atomic: masks never interleave.
+            if (write(to_peer, &channel_mask, sizeof(channel_mask)) != (ssize_t)sizeof(channel_mask)) {
+                // The other side is gone (end of run): nobody left to wake.
+            }
+        }
+    };
+
+    HostXcoreTransport transport;
+
+    void listen(int from_peer) {
+        uint32_t mask;
+        while (read(from_peer, &mask, sizeof(mask)) == (ssize_t)sizeof(mask)) {
+            csp::xcore::deliver(mask);
+        }
+    }
+
+} // namespace
+
+namespace csp::xcore {
+
+bool hostForkCores() {
+    const size_t bytes = CSP4CMSIS_XCORE_MAX_CHANNELS * CSP4CMSIS_XCORE_SLOT_BYTES;
+    void* shared = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    int to_little[2], to_big[2];
+    if (shared == MAP_FAILED || pipe(to_little) != 0 || pipe(to_big) != 0) {
+        perror("[HOST] xcore segment");
+        abort();
+    }
+
+    fflush(stdout);
+    const pid_t big = getpid();
+    const pid_t child = fork();
+    if (child < 0) {
+        perror("[HOST] xcore fork");
+        abort();
+    }
+
+    const bool little = (child == 0);
+    if (little) {
+        // The big core's run limit ends both cores.
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        if (getppid() != big) _exit(0);
+    }
+
+    transport.shared = shared;
+    transport.to_peer = little ? to_big[1] : to_little[1];
+    const int from_peer = little ? to_little[0] : to_big[0];
+    close(little ? to_big[0] : to_little[0]);
+    close(little ? to_little[1] : to_big[1]);
+
+    // A fresh anonymous mapping is already zero: neither side needs to own it.
+    attach(&transport, false);
+    std::thread(listen, from_peer).detach();
+    return little;
+}
+
+} // namespace csp::xcore
@@ -1,19 +1,14 @@
 #ifndef CSP4CMSIS_ALT_H
 #define CSP4CMSIS_ALT_H
 
-#include "FreeRTOS.h"
-#include "task.h"
-#include "timers.h"
-#include "event_groups.h"
+#include "os.h"
+#include "trace.h"
+#include "channel_base.h" // Chanin/Chanout declarations and end kinds
 #include <stddef.h> 
 #include <initializer_list>
 #include "time.h" 
 
 namespace csp {
-    // Forward declarations
-    template <typename T> class Chanin;
-    template <typename T> class Chanout;
-
     namespace internal {
         class AltScheduler; 
 
@@ -22,36 +17,45 @@ namespace csp {
          */
         class Guard {
         public:
-            virtual bool enable(AltScheduler* alt, EventBits_t bit) = 0;
+            virtual bool enable(AltScheduler* alt, os::Flags bit) = 0;
             virtual bool disable() = 0;
             virtual void activate() = 0;
             virtual ~Guard() = default;
+#if CSP4CMSIS_TRACE
+            uint16_t trace_channel = 0; // Set by the owning channel; 0 for timers
+#endif
+#if CSP4CMSIS_STATS
+            // Set by the owning channel; timers and IRQ events charge blocked time only
+            ChannelStats* stats_channel = nullptr;
+            StatsProbe::Direction stats_dir = StatsProbe::Select;
+#endif
         };
 
         class AltScheduler {
         private:
-            TaskHandle_t waiting_task_handle = nullptr;
-            EventGroupHandle_t event_group = nullptr;
+            os::ThreadId waiting_task_handle = nullptr;
+            os::EventFlags event_group = nullptr;
+            os::EventFlagsControlBlock event_block; // Lives with the ALT: on the process stack
         public:
             AltScheduler();
             ~AltScheduler(); 
             void initForCurrentTask(); 
             unsigned int select(Guard** guardArray, size_t amount, size_t offset = 0);
-            void wakeUp(EventBits_t bit); 
-            EventGroupHandle_t getEventGroupHandle() const { return event_group; }
+            void wakeUp(os::Flags bit); 
+            os::EventFlags getEventGroupHandle() const { return event_group; }
         };
 
         class TimerGuard : public Guard {
         private:
             AltScheduler* parent_alt;
-            TickType_t delay_ticks;
-            TimerHandle_t timer_handle;
-            EventBits_t assigned_bit; 
-            static void TimerCallback(TimerHandle_t xTimer);
+            os::Tick delay_ticks;
+            os::Timer timer_handle;
+            os::Flags assigned_bit; 
+            static void TimerCallback(void* arg);
         public:
             TimerGuard(csp::Time delay);
             ~TimerGuard() override;
-            bool enable(AltScheduler* alt, EventBits_t bit) override;
+            bool enable(AltScheduler* alt, os::Flags bit) override;
             bool disable() override; 
             void activate() override; 
         };
@@ -108,39 +112,42 @@ namespace csp {
 
         /**
          * @brief Variadic constructor to allow Alternative alt(in1 | msg1, timer);
+         * Taken by reference: a copied RelTimeoutGuard would delete the timer
+         * of the original when the copy is destroyed.
          */
         template <typename... Bindings>
-        Alternative(Bindings... bindings) : num_guards(0) {
+        Alternative(Bindings&&... bindings) : num_guards(0) {
             (addBinding(bindings), ...);
         }
 
         Alternative(std::initializer_list<internal::Guard*> guard_list);
         Alternative(std::initializer_list<csp::Guard*> guard_list);
+        Alternative(internal::Guard* const* guard_array, size_t count); // Guard set sized at run time
 
         int priSelect();  
         int fairSelect(); 
 
     private:
         // Binding helper for Input Channels
-        template <typename T>
-        void addBinding(const ChannelBinding<T, Chanin<T>>& b) {
+        template <typename T, typename KIND>
+        void addBinding(const ChannelBinding<T, Chanin<T, KIND>>& b) {
             if (num_guards < MAX_GUARDS) {
                 internal_guards[num_guards++] = b.getInternalGuard(); 
             }
         }
 
         // Binding helper for Output Channels
-        template <typename T>
-        void addBinding(const ChannelBinding<const T, Chanout<T>>& b) {
+        template <typename T, typename KIND>
+        void addBinding(const ChannelBinding<const T, Chanout<T, KIND>>& b) {
             if (num_guards < MAX_GUARDS) {
                 internal_guards[num_guards++] = b.getInternalGuard();
             }
         }
 
-        // Binding helper for Timers
-        void addBinding(RelTimeoutGuard& tg) {
+        // Binding helper for public guards (timers, interrupt events)
+        void addBinding(Guard& g) {
             if (num_guards < MAX_GUARDS) {
-                internal_guards[num_guards++] = tg.internal_guard_ptr;
+                internal_guards[num_guards++] = g.internal_guard_ptr;
             }
         }
         
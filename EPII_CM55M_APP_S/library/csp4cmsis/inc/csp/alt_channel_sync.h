@@ -1,9 +1,9 @@
 #ifndef ALT_CHANNEL_SYNC_H
 #define ALT_CHANNEL_SYNC_H
 
-#include "FreeRTOS.h"
-#include "semphr.h"
+#include "os.h"
 #include "alt.h"      
+#include "csp_config.h"
 #include <cstdio> 
 
 namespace csp::internal {
@@ -15,7 +15,7 @@ namespace csp::internal {
      */
     struct WaitingAlt {
         AltScheduler* alt_ptr;
-        EventBits_t assigned_bit;
+        os::Flags assigned_bit;
         void* data_ptr;
         size_t data_size;
 
@@ -24,7 +24,7 @@ namespace csp::internal {
         /**
          * @brief Atomically configure the ALT registration.
          */
-        void set(AltScheduler* a, EventBits_t b, void* d, size_t s) {
+        void set(AltScheduler* a, os::Flags b, void* d, size_t s) {
             alt_ptr = a;
             assigned_bit = b;
             data_ptr = d;
@@ -47,15 +47,17 @@ namespace csp::internal {
      */
     class AltChanSyncBase {
     protected:
-        SemaphoreHandle_t mutex; 
+        os::Mutex mutex; 
+        // Kept in the channel object, so CSP_PLACE_FAST on a channel places its lock too.
+        os::MutexControlBlock mutex_block;
         
         // Slots for processes currently blocked in an Alternative (ALT) select
         WaitingAlt waiting_in_alt;
         WaitingAlt waiting_out_alt;
 
         // Slots for standard blocking processes (input() / output())
-        TaskHandle_t waiting_in_task;
-        TaskHandle_t waiting_out_task;
+        os::ThreadId waiting_in_task;
+        os::ThreadId waiting_out_task;
         void* non_alt_in_data_ptr;
         const void* non_alt_out_data_ptr;
 
@@ -73,21 +75,37 @@ namespace csp::internal {
         void clearWaitingOut() { waiting_out_task = nullptr; non_alt_out_data_ptr = nullptr; }
 
         // Getters for thread safety and logic
-        SemaphoreHandle_t getMutex() { return mutex; }
-        TaskHandle_t getWaitingInTask() const { return waiting_in_task; }
-        TaskHandle_t getWaitingOutTask() const { return waiting_out_task; }
+        os::Mutex getMutex() { return mutex; }
+        os::ThreadId getWaitingInTask() const { return waiting_in_task; }
+        os::ThreadId getWaitingOutTask() const { return waiting_out_task; }
         void* getNonAltInDataPtr() const { return non_alt_in_data_ptr; }
         const void* getNonAltOutDataPtr() const { return non_alt_out_data_ptr; }
         
         AltScheduler* getAltInScheduler() const { return waiting_in_alt.alt_ptr; }
-        EventBits_t   getAltInBit() const       { return waiting_in_alt.assigned_bit; }
+        os::Flags     getAltInBit() const       { return waiting_in_alt.assigned_bit; }
         AltScheduler* getAltOutScheduler() const { return waiting_out_alt.alt_ptr; }
-        EventBits_t   getAltOutBit() const       { return waiting_out_alt.assigned_bit; }
+        os::Flags     getAltOutBit() const       { return waiting_out_alt.assigned_bit; }
 
         WaitingAlt& getWaitingInAlt() { return waiting_in_alt; }
         WaitingAlt& getWaitingOutAlt() { return waiting_out_alt; }
     };
 
+    /**
+     * @brief Completes a writer-side rendezvous with a woken downstream reader.
+     * With CSP4CMSIS_RENDEZVOUS_HANDOFF the writer yields so an equal-priority
+     * reader runs now instead of at the writer's next blocking call.
+     * Must be called after the channel mutex has been released.
+     */
+    inline void handOff(os::ThreadId partner) {
+#if CSP4CMSIS_RENDEZVOUS_HANDOFF
+        if (os::priority(partner) == os::priority()) {
+            os::yield();
+        }
+#else
+        (void)partner;
+#endif
+    }
+
     // =============================================================
     // Guards: Interfaces between Channels and the AltScheduler
     // =============================================================
@@ -101,7 +119,7 @@ namespace csp::internal {
         ChanInGuard(AltChanSyncBase* parent, void* dest = nullptr, size_t size = 0) 
             : parent_channel(parent), user_data_dest(dest), data_size(size) {}
         
-        bool enable(AltScheduler* alt, EventBits_t bit) override;
+        bool enable(AltScheduler* alt, os::Flags bit) override;
         bool disable() override;
         void activate() override;
         void updateBuffer(void* new_dest) { user_data_dest = new_dest; }
@@ -116,7 +134,7 @@ namespace csp::internal {
         ChanOutGuard(AltChanSyncBase* parent, const void* src = nullptr, size_t size = 0) 
             : parent_channel(parent), user_data_source(src), data_size(size) {}
         
-        bool enable(AltScheduler* alt, EventBits_t bit) override;
+        bool enable(AltScheduler* alt, os::Flags bit) override;
         bool disable() override;
         void activate() override;
         void updateBuffer(const void* new_src) { user_data_source = new_src; }
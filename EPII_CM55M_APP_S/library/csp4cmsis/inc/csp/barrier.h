@@ -2,8 +2,7 @@
 #ifndef CSP4CMSIS_BARRIER_H
 #define CSP4CMSIS_BARRIER_H
 
-#include "FreeRTOS.h"
-#include "semphr.h"
+#include "os.h"
 #include <stddef.h> // For size_t
 
 namespace csp {
@@ -19,8 +18,9 @@ namespace csp {
             const size_t max_processes;
             size_t count; // Protected by xCountMutex
             
-            SemaphoreHandle_t xCountMutex;      // Protects the 'count' variable
-            SemaphoreHandle_t xWaitSemaphore;   // Used to block and release tasks
+            os::Mutex     xCountMutex;      // Protects the 'count' variable
+            os::Semaphore xWaitSemaphore;   // Arrival turnstile: opened by the last arrival
+            os::Semaphore xLeaveSemaphore;  // Departure turnstile: opened by the last to leave
 
         public:
             /**
@@ -30,7 +30,7 @@ namespace csp {
             Barrier(size_t N);
             
             /**
-             * @brief Cleans up the FreeRTOS synchronization objects.
+             * @brief Cleans up the kernel synchronization objects.
              */
             ~Barrier();
 
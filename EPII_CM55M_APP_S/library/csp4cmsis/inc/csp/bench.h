@@ -0,0 +1,72 @@
+// --- bench.h (Micro-Benchmark Sampling and Machine-Readable Reports) ---
+#ifndef CSP4CMSIS_BENCH_H
+#define CSP4CMSIS_BENCH_H
+
+#include "csp_config.h"
+#include "cycles.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace csp::bench {
+
+    /**
+     * @brief Order statistics of one benchmark, in DWT core cycles.
+     */
+    struct Summary {
+        uint32_t samples;
+        uint32_t min;
+        uint32_t median;
+        uint32_t p99;
+        uint32_t max;
+        uint32_t mean;
+    };
+
+    /**
+     * @brief Fixed-capacity set of cycle samples; nothing is allocated.
+     * Samples beyond the capacity are dropped.
+     */
+    class Samples {
+    private:
+        uint32_t* data;
+        size_t capacity;
+        size_t count;
+    public:
+        Samples(uint32_t* storage, size_t n) : data(storage), capacity(n), count(0) {}
+
+        void reset() { count = 0; }
+        void add(uint32_t cycles) { if (count < capacity) data[count++] = cycles; }
+        size_t size() const { return count; }
+
+        /**
+         * @brief Sorts the samples in place and returns their order statistics.
+         */
+        Summary summarize();
+    };
+
+    template <size_t N>
+    class SampleBuffer : public Samples {
+    private:
+        uint32_t storage[N];
+    public:
+        SampleBuffer() : Samples(storage, N) {}
+    };
+
+    /**
+     * @brief Prints the build configuration (kernel, switches, core clock) and,
+     * for CSV output, the column header. Call once before the first report().
+     */
+    void printHeader(const char* suite);
+
+    /**
+     * @brief Emits one result in the CSP4CMSIS_BENCH_FORMAT of csp_config.h.
+     * @param bench   What is measured, e.g. "pingpong".
+     * @param variant Channel kind or configuration, e.g. "rendezvous".
+     * @param param   The swept parameter (depth, guards, capacity, parties...).
+     */
+    void report(const char* bench, const char* variant, uint32_t param, const Summary& s);
+
+    void printFooter(const char* suite);
+
+} // namespace csp::bench
+
+#endif // CSP4CMSIS_BENCH_H
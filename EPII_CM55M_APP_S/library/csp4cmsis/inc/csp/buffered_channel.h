@@ -1,11 +1,10 @@
 #ifndef CSP4CMSIS_BUFFERED_CHANNEL_H
 #define CSP4CMSIS_BUFFERED_CHANNEL_H
 
-#include "FreeRTOS.h"
-#include "task.h"
-#include "queue.h"
+#include "os.h"
 #include "channel_base.h" 
 #include "alt.h"         
+#include "footprint.h"
 #include <cstdlib> 
 
 namespace csp::internal {
@@ -17,14 +16,14 @@ namespace csp::internal {
     class BufferedChannel : public internal::BaseAltChan<T>
     {
     private:
-        QueueHandle_t queue_handle; 
+        os::Queue queue_handle; 
         
         // Use AltScheduler pointers to remain consistent with your Alt system
         AltScheduler* alt_reader = nullptr;
-        EventBits_t   read_bit = 0;
+        os::Flags     read_bit = 0;
         
         AltScheduler* alt_writer = nullptr;
-        EventBits_t   write_bit = 0;
+        os::Flags     write_bit = 0;
 
         BufferedInputGuard<T>  res_in_guard;
         BufferedOutputGuard<T> res_out_guard;
@@ -34,39 +33,73 @@ namespace csp::internal {
             : res_in_guard(this), res_out_guard(this) 
         {
             if (capacity == 0) std::abort(); 
-            queue_handle = xQueueCreate(capacity, sizeof(T));
+            queue_handle = os::queueCreate(capacity, sizeof(T));
+#if CSP4CMSIS_TRACE
+            res_in_guard.trace_channel = this->traceId();
+            res_out_guard.trace_channel = this->traceId();
+#endif
+#if CSP4CMSIS_STATS
+            res_in_guard.stats_channel = this->stats();
+            res_in_guard.stats_dir = StatsProbe::Input;
+            res_out_guard.stats_channel = this->stats();
+            res_out_guard.stats_dir = StatsProbe::Output;
+#endif
+            if (queue_handle) internal::footprintChannel(+1, sizeof(*this), capacity * sizeof(T));
         }
 
         ~BufferedChannel() override {
-            if (queue_handle) vQueueDelete(queue_handle);
+            if (queue_handle) {
+                internal::footprintChannel(-1, sizeof(*this),
+                                           (os::queueCount(queue_handle) + os::queueSpace(queue_handle)) * sizeof(T));
+                os::queueDelete(queue_handle);
+            }
         }
 
         // --- Required by BaseAltChan ---
         // Matches the signature: virtual bool pending() = 0;
         bool pending() override { 
-            return uxQueueMessagesWaiting(queue_handle) > 0; 
+            return os::queueCount(queue_handle) > 0; 
         } 
 
         bool space_available() { 
-            return uxQueueSpacesAvailable(queue_handle) > 0; 
+            return os::queueSpace(queue_handle) > 0; 
         }
 
         // --- Core I/O ---
         void input(T* const dest) override {
-            if (xQueueReceive(queue_handle, dest, portMAX_DELAY) == pdPASS) {
+#if CSP4CMSIS_TRACE
+            const bool waits = traceArmed() && !pending();
+            if (waits) CSP_TRACE(Block, this->traceId(), TraceRead);
+#endif
+            if (os::queueReceive(queue_handle, dest)) {
+#if CSP4CMSIS_TRACE
+                if (waits) CSP_TRACE(Unblock, this->traceId(), TraceRead);
+                else CSP_TRACE(Handshake, this->traceId(), TraceRead);
+#endif
                 // If a sender was ALTed waiting for space, wake them
-                taskENTER_CRITICAL();
+                os::CriticalState cs = os::criticalEnter();
                 if (alt_writer) alt_writer->wakeUp(write_bit);
-                taskEXIT_CRITICAL();
+                os::criticalExit(cs);
             }
         }
 
         void output(const T* const source) override {
-            if (xQueueSend(queue_handle, source, portMAX_DELAY) == pdPASS) {
+#if CSP4CMSIS_TRACE
+            const bool waits = traceArmed() && !space_available();
+            if (waits) CSP_TRACE(Block, this->traceId(), TraceWrite);
+#endif
+            if (os::queueSend(queue_handle, source)) {
+#if CSP4CMSIS_TRACE
+                if (waits) CSP_TRACE(Unblock, this->traceId(), TraceWrite);
+                else CSP_TRACE(Handshake, this->traceId(), TraceWrite);
+#endif
+#if CSP4CMSIS_STATS
+                statsHighWater(this->stats(), os::queueCount(queue_handle));
+#endif
                 // If a receiver was ALTed waiting for data, wake them
-                taskENTER_CRITICAL();
+                os::CriticalState cs = os::criticalEnter();
                 if (alt_reader) alt_reader->wakeUp(read_bit);
-                taskEXIT_CRITICAL();
+                os::criticalExit(cs);
             }
         }
 
@@ -84,20 +117,20 @@ namespace csp::internal {
         }
         
         // Registration Helpers
-        void registerInputAlt(AltScheduler* alt, EventBits_t b) {
-            taskENTER_CRITICAL(); alt_reader = alt; read_bit = b; taskEXIT_CRITICAL();
+        void registerInputAlt(AltScheduler* alt, os::Flags b) {
+            os::CriticalState cs = os::criticalEnter(); alt_reader = alt; read_bit = b; os::criticalExit(cs);
         }
         void unregisterInputAlt() {
-            taskENTER_CRITICAL(); alt_reader = nullptr; taskEXIT_CRITICAL();
+            os::CriticalState cs = os::criticalEnter(); alt_reader = nullptr; os::criticalExit(cs);
         }
-        void registerOutputAlt(AltScheduler* alt, EventBits_t b) {
-            taskENTER_CRITICAL(); alt_writer = alt; write_bit = b; taskEXIT_CRITICAL();
+        void registerOutputAlt(AltScheduler* alt, os::Flags b) {
+            os::CriticalState cs = os::criticalEnter(); alt_writer = alt; write_bit = b; os::criticalExit(cs);
         }
         void unregisterOutputAlt() {
-            taskENTER_CRITICAL(); alt_writer = nullptr; taskEXIT_CRITICAL();
+            os::CriticalState cs = os::criticalEnter(); alt_writer = nullptr; os::criticalExit(cs);
         }
 
-        QueueHandle_t getQueueHandle() const { return queue_handle; }
+        os::Queue getQueueHandle() const { return queue_handle; }
     };
     
     // =============================================================
@@ -112,7 +145,7 @@ namespace csp::internal {
         BufferedInputGuard(BufferedChannel<T>* chan) : channel(chan) {}
         void setTarget(T* dest) { dest_ptr = dest; }
 
-        bool enable(AltScheduler* alt, EventBits_t bit) override {
+        bool enable(AltScheduler* alt, os::Flags bit) override {
             if (channel->pending()) return true;
             channel->registerInputAlt(alt, bit);
             return false;
@@ -122,7 +155,7 @@ namespace csp::internal {
             return channel->pending();
         }
         void activate() override {
-            xQueueReceive(channel->getQueueHandle(), dest_ptr, 0);
+            os::queueReceive(channel->getQueueHandle(), dest_ptr, 0);
         }
     };
     
@@ -135,7 +168,7 @@ namespace csp::internal {
         BufferedOutputGuard(BufferedChannel<T>* chan) : channel(chan) {}
         void setTarget(const T* source) { source_ptr = source; }
 
-        bool enable(AltScheduler* alt, EventBits_t bit) override {
+        bool enable(AltScheduler* alt, os::Flags bit) override {
             if (channel->space_available()) return true;
             channel->registerOutputAlt(alt, bit);
             return false;
@@ -145,7 +178,10 @@ namespace csp::internal {
             return channel->space_available();
         }
         void activate() override {
-            xQueueSend(channel->getQueueHandle(), source_ptr, 0);
+            os::queueSend(channel->getQueueHandle(), source_ptr, 0);
+#if CSP4CMSIS_STATS
+            statsHighWater(channel->stats(), os::queueCount(channel->getQueueHandle()));
+#endif
         }
     };
 
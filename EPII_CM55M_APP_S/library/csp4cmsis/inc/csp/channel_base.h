@@ -3,10 +3,22 @@
 #define CSP4CMSIS_CHANNEL_BASE_H
 
 #include <stddef.h> 
+#include "csp_config.h"
+#include "stats.h"
+#include "trace.h"
 
 namespace csp {
-    template <typename T> class Chanin;
-    template <typename T> class Chanout;
+    /**
+     * @brief Channel-end kinds. An AnyChannel end (the default) is type-erased
+     * and fits every channel; the others name one channel implementation, so
+     * that read and write bind statically and inline (public_channel.h).
+     */
+    struct AnyChannel {};
+    struct RendezvousTag {};
+    struct BufferedTag {};
+
+    template <typename T, typename KIND = AnyChannel> class Chanin;
+    template <typename T, typename KIND = AnyChannel> class Chanout;
     class Alternative; 
 }
 
@@ -21,10 +33,10 @@ namespace csp::internal {
     class BaseChan 
     {
     public:
-        template <typename U>
+        template <typename U, typename KIND>
         friend class csp::Chanin; 
 
-        template <typename U>
+        template <typename U, typename KIND>
         friend class csp::Chanout;
         
     protected:
@@ -44,6 +56,19 @@ namespace csp::internal {
     class BaseAltChan : public BaseChan<DATA_TYPE>
     {
     public:
+#if CSP4CMSIS_STATS
+        BaseAltChan() : chan_stats(this) {}
+        ChannelStats* stats() { return &chan_stats; }
+    private:
+        ChannelStatsEntry chan_stats;
+    public:
+#endif
+#if CSP4CMSIS_TRACE
+        uint16_t traceId() const { return trace_id.value; }
+    private:
+        TraceId<TraceKind::Channel> trace_id;
+    public:
+#endif
         /**
          * @brief Polling method to check if a communication partner is ready.
          * Added to resolve 'override' errors in derived channel implementations.
@@ -5,7 +5,10 @@
 // ======================================================================
 // 1. Core Definitions (Must be available to both C and C++ sections)
 // ======================================================================
+#include "csp_config.h"
+#if !CSP4CMSIS_OS_RTOS2
 #include "FreeRTOS.h" // Assuming needed globally
+#endif
 #include "time.h"     // Defines csp::Time, etc. (Must be C++-safe)
 #include "process.h"  // Defines csp::internal::Process base (Must be C++-safe)
 
@@ -17,16 +20,27 @@
 namespace csp { /* Forward declare namespace content here if needed */ }
 // Include all C++-specific headers that define classes/templates.
 #include "alt.h"             // Required for ALT functionality
+#include "hrtime.h"          // csp::HrTime, Microseconds(), Stopwatch (DWT cycles)
 #include "channel_base.h"    // Base classes for internal channel implementations
 #include "sync_channel.h"    // Core Rendezvous/Alt implementation
 #include "buffered_channel.h"// For future implementation
 #include "barrier.h"         // Standard CSP primitive
+#include "priority.h"        // Topology-aware priority assignment
 #include "public_channel.h"  // Includes One2OneChannel<T>
+#include "deadline.h"        // FrameToken<T>, deadline channels, EDF boosting
+#include "stats.h"           // PrintStats()/ResetStats() (CSP4CMSIS_STATS)
+#include "trace.h"           // TraceStart()/TraceDump() (CSP4CMSIS_TRACE)
+#include "footprint.h"       // PrintFootprint(): stack high-water and RAM budget
+#include "xcore_channel.h"   // Cross-core channels between CM55 Big and CM55 Little
+#include "static_network.h"  // net::StaticNetwork: compile-time network description
+#include "placement.h"       // CSP_PLACE_FAST/BULK, Pinned<P>: memory placement
+#include "irq_event.h"       // IrqEvent: interrupts as ALT guards
+#include "npu.h"             // NpuInferenceProcess: Ethos-U inference behind channels
 #include "public_task.h"     // Includes CSProcess, Run() function
 #include "run.h"             // <--- NEW: Includes InParallel/InSequence helpers
 
 // Note: The file public_task.h should now contain the definition/declaration 
-// of the base Run(CSProcess&, UBaseType_t) function signature.
+// of the base Run(CSProcess&, os::Priority) function signature.
 
 #endif // __cplusplus
 
@@ -41,7 +55,7 @@ extern "C" {
 
 // 4. External Hooks (Declared for both C and C++ linkers)
 void csp_app_main_init(void);
-void ThreadFuncWrapper(void *pvParameters); // FreeRTOS Task Entry Point
+void ThreadFuncWrapper(void *pvParameters); // Kernel Thread Entry Point
 
 // 5. End of Linkage Control
 #ifdef __cplusplus
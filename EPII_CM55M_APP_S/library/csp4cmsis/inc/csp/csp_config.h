@@ -0,0 +1,216 @@
+// --- csp_config.h (Compile-Time Feature Switches) ---
+#ifndef CSP4CMSIS_CONFIG_H
+#define CSP4CMSIS_CONFIG_H
+
+// Every switch defaults to the original behaviour and can be overridden
+// from the scenario app makefile, e.g. APPL_DEFINES += -DCSP4CMSIS_RENDEZVOUS_HANDOFF=1
+
+/**
+ * Direct hand-off on rendezvous completion.
+ * 0: The writer notifies the woken reader and keeps running until its next
+ *    blocking call (time slicing is disabled, so an equal-priority reader waits).
+ * 1: The writer yields straight after the handshake when the reader runs at
+ *    the same priority, so the next pipeline stage runs immediately.
+ */
+#ifndef CSP4CMSIS_RENDEZVOUS_HANDOFF
+#define CSP4CMSIS_RENDEZVOUS_HANDOFF 0
+#endif
+
+/**
+ * Per-process and per-channel runtime statistics (stats.h).
+ * 0: No counters are compiled in; channel ends and processes are unchanged.
+ * 1: Channel operations are timed with the DWT cycle counter and the
+ *    FreeRTOS context-switch hooks accumulate per-process run time.
+ *    Must be set for C and C++ sources alike (APPL_DEFINES), since
+ *    FreeRTOSConfig.h installs the hooks from csp_trace_hooks.h.
+ */
+#ifndef CSP4CMSIS_STATS
+#define CSP4CMSIS_STATS 0
+#endif
+
+/**
+ * Channel event trace recorder (trace.h).
+ * 0: No trace points are compiled in.
+ * 1: Channel and ALT events are written to a lock-free ring of
+ *    CSP4CMSIS_TRACE_DEPTH 12-byte records (a power of two) between
+ *    TraceStart() and TraceStop(). Names are kept for the first
+ *    CSP4CMSIS_TRACE_MAX_PROCESSES processes.
+ */
+#ifndef CSP4CMSIS_TRACE
+#define CSP4CMSIS_TRACE 0
+#endif
+#ifndef CSP4CMSIS_TRACE_DEPTH
+#define CSP4CMSIS_TRACE_DEPTH 1024
+#endif
+#ifndef CSP4CMSIS_TRACE_MAX_PROCESSES
+#define CSP4CMSIS_TRACE_MAX_PROCESSES 32
+#endif
+
+/**
+ * FreeRTOS thread-local storage slot holding the CSProcess* of each task.
+ * Must be below configNUM_THREAD_LOCAL_STORAGE_POINTERS.
+ */
+#ifndef CSP4CMSIS_TLS_PROCESS_INDEX
+#define CSP4CMSIS_TLS_PROCESS_INDEX 0
+#endif
+
+/**
+ * FreeRTOS thread-local storage slot recording the stack depth each task was
+ * spawned with, for the footprint report (FreeRTOS does not keep it).
+ */
+#ifndef CSP4CMSIS_TLS_STACK_INDEX
+#define CSP4CMSIS_TLS_STACK_INDEX 1
+#endif
+
+/**
+ * Default stack depth of a process thread in 32-bit words.
+ * A process overrides CSProcess::stackWords() to get a different size;
+ * PrintFootprint() (footprint.h) shows how much of it is actually used.
+ */
+#ifndef CSP4CMSIS_PROCESS_STACK_WORDS
+#define CSP4CMSIS_PROCESS_STACK_WORDS 256
+#endif
+
+/**
+ * Stack overflow canary (footprint.h).
+ * 0: Off.
+ * N: Each process thread stamps N words at the bottom of its stack before
+ *    run(). They are checked when the process returns and by
+ *    PrintFootprint()/CheckStackCanaries(); a damaged canary is reported
+ *    as an ERROR. Needs the stack base from the kernel (not on the host).
+ */
+#ifndef CSP4CMSIS_STACK_CANARY
+#define CSP4CMSIS_STACK_CANARY 0
+#endif
+
+/**
+ * Kernel backend behind csp::os (os.h).
+ * 0: Native FreeRTOS API.
+ * 1: CMSIS-RTOS2 API. Selected automatically when the SDK builds with
+ *    OS_SEL=rtos2_rtx (RTOS2_RTX), so the same network runs on RTX5.
+ *    Per-process run time (CSP4CMSIS_STATS) is not collected on this backend.
+ */
+#ifndef CSP4CMSIS_OS_RTOS2
+#if defined(RTOS2_RTX)
+#define CSP4CMSIS_OS_RTOS2 1
+#else
+#define CSP4CMSIS_OS_RTOS2 0
+#endif
+#endif
+
+/**
+ * RTX5 static control-block pools (CSP4CMSIS_OS_RTOS2 on RTOS2_RTX only).
+ * Kernel objects are placed in these pools instead of the RTX object memory,
+ * so a network's footprint is fixed at link time. A slot returns to its pool
+ * when the object is deleted or the thread exits. FOREIGN_THREADS sizes the
+ * process-pointer table for threads not started through csp::os::spawn().
+ */
+#ifndef CSP4CMSIS_OS_MAX_THREADS
+#define CSP4CMSIS_OS_MAX_THREADS 16
+#endif
+#ifndef CSP4CMSIS_OS_FOREIGN_THREADS
+#define CSP4CMSIS_OS_FOREIGN_THREADS 4
+#endif
+#ifndef CSP4CMSIS_OS_MAX_MUTEXES
+#define CSP4CMSIS_OS_MAX_MUTEXES 32
+#endif
+#ifndef CSP4CMSIS_OS_MAX_SEMAPHORES
+#define CSP4CMSIS_OS_MAX_SEMAPHORES 16
+#endif
+#ifndef CSP4CMSIS_OS_MAX_EVENT_FLAGS
+#define CSP4CMSIS_OS_MAX_EVENT_FLAGS 16
+#endif
+#ifndef CSP4CMSIS_OS_MAX_QUEUES
+#define CSP4CMSIS_OS_MAX_QUEUES 16
+#endif
+#ifndef CSP4CMSIS_OS_MAX_TIMERS
+#define CSP4CMSIS_OS_MAX_TIMERS 8
+#endif
+
+/**
+ * Result format of the micro-benchmark reports (bench.h).
+ * 0: CSV rows, each prefixed with "csv," so they can be filtered from the UART log.
+ * 1: JSON lines, one object per result.
+ * 2: Both.
+ */
+#ifndef CSP4CMSIS_BENCH_FORMAT
+#define CSP4CMSIS_BENCH_FORMAT 0
+#endif
+
+/**
+ * Run-to-completion backend on the hxevent loop (csp/hx, no RTOS).
+ * Each running stackless process owns one hxevent event, so this bounds the
+ * processes alive at once. hxevent allows HX_EVENTQUE_MAXSIZE events in total,
+ * shared with the application's own events.
+ */
+#ifndef CSP4CMSIS_HX_MAX_PROCESSES
+#define CSP4CMSIS_HX_MAX_PROCESSES 16
+#endif
+
+/**
+ * Cross-core channels between the CM55 Big and CM55 Little (xcore.h).
+ * Every channel id owns one CSP4CMSIS_XCORE_SLOT_BYTES slot of the shared
+ * segment and one mailbox doorbell bit, (1 << (CSP4CMSIS_XCORE_DOORBELL_SHIFT + id));
+ * the bits below the shift stay with the hxmb library (VAD buffers, core ready).
+ */
+#ifndef CSP4CMSIS_XCORE_MAX_CHANNELS
+#define CSP4CMSIS_XCORE_MAX_CHANNELS 8
+#endif
+#ifndef CSP4CMSIS_XCORE_SLOT_BYTES
+#define CSP4CMSIS_XCORE_SLOT_BYTES 512
+#endif
+#ifndef CSP4CMSIS_XCORE_DOORBELL_SHIFT
+#define CSP4CMSIS_XCORE_DOORBELL_SHIFT 8
+#endif
+
+/**
+ * hxmb mailbox transport for the cross-core channels (xcore_mailbox.cpp).
+ * 0: Not compiled; the application provides its own XcoreTransport.
+ * 1: Compiled for the core named by CSP4CMSIS_XCORE_LITTLE (0: CM55 Big,
+ *    1: CM55 Little). CSP4CMSIS_XCORE_SHM_BASE is the shared segment and
+ *    must be the same address in both images, outside both linker scripts.
+ */
+#ifndef CSP4CMSIS_XCORE_MAILBOX
+#define CSP4CMSIS_XCORE_MAILBOX 0
+#endif
+#ifndef CSP4CMSIS_XCORE_LITTLE
+#define CSP4CMSIS_XCORE_LITTLE 0
+#endif
+#ifndef CSP4CMSIS_XCORE_SHM_BASE
+#define CSP4CMSIS_XCORE_SHM_BASE 0
+#endif
+
+/**
+ * Ethos-U driver OS hooks (npu.cpp).
+ * 0: Not compiled; the driver keeps its own (or the application's) hooks.
+ * 1: The driver's mutexes are kernel mutexes and its semaphores IrqEvents,
+ *    so a process waiting for the NPU blocks in an ALT on the NPU interrupt.
+ *    CSP4CMSIS_NPU_MAX_SEMAPHORES bounds the driver's semaphores (one global,
+ *    one per NPU). CSP4CMSIS_NPU_MAX_MODELS bounds the models one
+ *    NpuInferenceProcess serves.
+ */
+#ifndef CSP4CMSIS_ETHOSU
+#define CSP4CMSIS_ETHOSU 0
+#endif
+#ifndef CSP4CMSIS_NPU_MAX_SEMAPHORES
+#define CSP4CMSIS_NPU_MAX_SEMAPHORES 4
+#endif
+#ifndef CSP4CMSIS_NPU_MAX_MODELS
+#define CSP4CMSIS_NPU_MAX_MODELS 4
+#endif
+
+/**
+ * Linker sections behind CSP_PLACE_FAST and CSP_PLACE_BULK (placement.h).
+ * Both names start with ".bss." so that a linker script without its own
+ * rule files them with the rest of .bss, and so that the compiler rejects
+ * a placed object with a non-zero initialiser. The csp4cmsis_comstime
+ * scripts map the fast section to DTCM and the bulk section to system SRAM.
+ */
+#ifndef CSP4CMSIS_FAST_SECTION
+#define CSP4CMSIS_FAST_SECTION ".bss.csp_fast"
+#endif
+#ifndef CSP4CMSIS_BULK_SECTION
+#define CSP4CMSIS_BULK_SECTION ".bss.csp_bulk"
+#endif
+
+#endif // CSP4CMSIS_CONFIG_H
@@ -0,0 +1,23 @@
+/* --- csp_trace_hooks.h (FreeRTOS Trace Macros for csp4cmsis) ---
+ * Included at the end of FreeRTOSConfig.h, so it must stay plain C.
+ */
+#ifndef CSP4CMSIS_TRACE_HOOKS_H
+#define CSP4CMSIS_TRACE_HOOKS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CSP4CMSIS_STATS) && (CSP4CMSIS_STATS == 1)
+void csp_stats_task_switched_in(void);
+void csp_stats_task_switched_out(void);
+
+#define traceTASK_SWITCHED_IN()  csp_stats_task_switched_in()
+#define traceTASK_SWITCHED_OUT() csp_stats_task_switched_out()
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CSP4CMSIS_TRACE_HOOKS_H */
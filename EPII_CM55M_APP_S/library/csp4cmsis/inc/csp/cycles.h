@@ -0,0 +1,55 @@
+// --- cycles.h (DWT Cycle Counter Access) ---
+#ifndef CSP4CMSIS_CYCLES_H
+#define CSP4CMSIS_CYCLES_H
+
+#if defined(CSP4CMSIS_HOST)
+#include "FreeRTOS.h"   // Host port: ullHostCycleCount() and SystemCoreClock (1 GHz)
+#else
+#include "WE2_device.h" // CMSIS core_cm55.h: DWT and DCB register blocks
+#endif
+#include <stdint.h>
+
+namespace csp::internal {
+
+    /**
+     * @brief Enables the Cortex-M55 DWT cycle counter. Safe to call repeatedly.
+     */
+    inline void cycleCounterInit() {
+#if !defined(CSP4CMSIS_HOST)
+        if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+            DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+            DWT->CYCCNT = 0;
+            DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        }
+#endif
+    }
+
+    /**
+     * @brief Raw 32-bit core cycle count. Wraps every 2^32 cycles; differences
+     * of two readings are correct as long as the interval is shorter than that.
+     */
+    inline uint32_t cycleCount() {
+#if defined(CSP4CMSIS_HOST)
+        return (uint32_t)ullHostCycleCount(); // One "cycle" per nanosecond
+#else
+        return DWT->CYCCNT;
+#endif
+    }
+
+    /**
+     * @brief Core clock frequency in Hz, i.e. cycles per second.
+     */
+    inline uint32_t cycleFrequency() {
+        return SystemCoreClock;
+    }
+
+    /**
+     * @brief Wrap-free 64-bit cycle count (task or ISR context).
+     * The kernel tick count elapsed since the previous call resolves how many
+     * times CYCCNT wrapped in between, so no periodic polling is required.
+     */
+    uint64_t cycleCount64();
+
+} // namespace csp::internal
+
+#endif // CSP4CMSIS_CYCLES_H
@@ -0,0 +1,178 @@
+// --- deadline.h (Deadline-Aware Frame Tokens and EDF Priority Boosting) ---
+#ifndef CSP4CMSIS_DEADLINE_H
+#define CSP4CMSIS_DEADLINE_H
+
+#include "os.h"
+#include "time.h"
+#include "priority.h"
+#include "public_channel.h"
+#include <stdint.h>
+
+// Maximum number of tasks that may hold a frame token at the same time.
+#ifndef CSP_MAX_DEADLINE_HOLDERS
+#define CSP_MAX_DEADLINE_HOLDERS 16
+#endif
+
+// Priority given to the holder of the most urgent token. Defaults to the top
+// of the CSP band so the boosted process never competes with the timer task.
+#ifndef CSP_DEADLINE_BOOST_PRIORITY
+#define CSP_DEADLINE_BOOST_PRIORITY CSP_PRIORITY_BAND_HIGH
+#endif
+
+namespace csp {
+
+    /**
+     * @brief A value travelling through a frame-based network together with
+     * the absolute tick by which it must have left the network.
+     */
+    template <typename T>
+    struct FrameToken {
+        T value;
+        Time deadline;
+    };
+
+    /**
+     * @brief Creates a token whose deadline is 'budget' from now.
+     */
+    template <typename T>
+    inline FrameToken<T> MakeFrame(const T& value, Time budget) {
+        return FrameToken<T>{ value, Time(os::tickCount() + budget.to_ticks()) };
+    }
+
+    /**
+     * @brief True once the token's deadline has passed (wrap-safe tick comparison).
+     */
+    template <typename T>
+    inline bool IsStale(const FrameToken<T>& token) {
+        return (int32_t)(os::tickCount() - token.deadline.to_ticks()) > 0;
+    }
+
+    /**
+     * @brief What a deadline channel does with a token that arrives after its deadline.
+     */
+    enum class StalePolicy {
+        Deliver, // Hand it over anyway (the receiver decides)
+        Drop     // Discard it at the channel boundary and wait for the next one
+    };
+
+    /**
+     * @brief Releases the calling process' deadline boost.
+     * Sinks, which never forward their token, call this once the frame is consumed.
+     */
+    void ReleaseDeadline();
+
+} // namespace csp
+
+namespace csp::internal {
+
+    /**
+     * @brief Earliest-Deadline-First arbitration between token holders.
+     * Every task that has received a frame token is registered with the deadline
+     * it holds. The holder of the earliest deadline runs at
+     * CSP_DEADLINE_BOOST_PRIORITY, all other holders at their own base priority.
+     */
+    class DeadlineScheduler {
+    public:
+        /**
+         * @brief Registers (or updates) the calling task as holder of 'deadline'.
+         */
+        static void hold(Time deadline);
+
+        /**
+         * @brief Removes the calling task's registration and restores its base priority.
+         */
+        static void release();
+
+    private:
+        struct Holder {
+            os::ThreadId task;
+            os::Priority base_priority;
+            os::Tick     deadline;
+            bool         boosted;
+        };
+
+        static Holder holders[CSP_MAX_DEADLINE_HOLDERS];
+
+        static Holder* find(os::ThreadId task);
+        static void rebalance();
+    };
+
+    /**
+     * @brief Adds deadline handling to an existing channel implementation.
+     * BASE is RendezvousChannel<FrameToken<T>> or BufferedChannel<FrameToken<T>>.
+     * Blocking input() applies the stale policy and boosts the receiver;
+     * output() releases the sender's boost once the token has been handed on.
+     * NOTE: ALT guards use the base channel path and bypass both.
+     */
+    template <typename T, typename BASE>
+    class DeadlineChannel : public BASE {
+    private:
+        StalePolicy policy;
+        volatile uint32_t dropped_count = 0;
+
+    public:
+        template <typename... Args>
+        DeadlineChannel(StalePolicy p, Args... args) : BASE(args...), policy(p) {}
+
+        void input(FrameToken<T>* const dest) override {
+            while (true) {
+                BASE::input(dest);
+                if (policy == StalePolicy::Drop && IsStale(*dest)) {
+                    dropped_count++;
+                    continue;
+                }
+                DeadlineScheduler::hold(dest->deadline);
+                return;
+            }
+        }
+
+        void output(const FrameToken<T>* const source) override {
+            BASE::output(source);
+            DeadlineScheduler::release();
+        }
+
+        uint32_t dropped() const { return dropped_count; }
+    };
+
+} // namespace csp::internal
+
+namespace csp {
+
+    /**
+     * @brief Rendezvous channel carrying FrameToken<T> with deadline handling.
+     */
+    template <typename T>
+    class DeadlineOne2OneChannel {
+    private:
+        internal::DeadlineChannel<T, internal::RendezvousChannel<FrameToken<T>>> internal_chan;
+    public:
+        explicit DeadlineOne2OneChannel(StalePolicy policy = StalePolicy::Drop)
+            : internal_chan(policy) {}
+
+        Chanout<FrameToken<T>> writer() { return Chanout<FrameToken<T>>(&internal_chan); }
+        Chanin<FrameToken<T>> reader() { return Chanin<FrameToken<T>>(&internal_chan); }
+
+        uint32_t dropped() const { return internal_chan.dropped(); }
+    };
+
+    /**
+     * @brief Buffered channel carrying FrameToken<T> with deadline handling.
+     * Stale frames queued during overload are discarded on the reader side.
+     */
+    template <typename T, size_t SIZE>
+    class BufferedDeadlineOne2OneChannel {
+    private:
+        internal::DeadlineChannel<T, internal::BufferedChannel<FrameToken<T>>> internal_chan;
+    public:
+        explicit BufferedDeadlineOne2OneChannel(StalePolicy policy = StalePolicy::Drop)
+            : internal_chan(policy, SIZE) {}
+
+        Chanout<FrameToken<T>> writer() { return Chanout<FrameToken<T>>(&internal_chan); }
+        Chanin<FrameToken<T>> reader() { return Chanin<FrameToken<T>>(&internal_chan); }
+
+        uint32_t dropped() const { return internal_chan.dropped(); }
+    };
+
+} // namespace csp
+
+#endif // CSP4CMSIS_DEADLINE_H
@@ -0,0 +1,62 @@
+// --- footprint.h (Stack High-Water and RAM Budget Report) ---
+#ifndef CSP4CMSIS_FOOTPRINT_H
+#define CSP4CMSIS_FOOTPRINT_H
+
+#include "csp_config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace csp::internal {
+
+    /**
+     * @brief Channel ledger: every rendezvous and buffered channel adds itself
+     * on construction (delta +1) and removes itself on destruction (delta -1).
+     * @param object_bytes sizeof the channel object.
+     * @param buffer_bytes Message storage held by the kernel queue (capacity * sizeof(T)).
+     */
+    void footprintChannel(int delta, size_t object_bytes, size_t buffer_bytes);
+
+#if CSP4CMSIS_STACK_CANARY
+    // Written below the stack of every process thread; unlikely as data or as
+    // a return address (odd, and not in the Cortex-M code region).
+    const uint32_t STACK_CANARY_WORD = 0xC5A9C0DEU;
+
+    /**
+     * @brief Stamps the canary at the bottom of the calling thread's stack.
+     */
+    void stackCanaryArm();
+
+    /**
+     * @brief True while every canary word above 'base' is intact.
+     */
+    bool stackCanaryIntact(const uint32_t* base);
+#endif
+
+} // namespace csp::internal
+
+namespace csp {
+
+    /**
+     * @brief Prints the RAM footprint of the running network over the console UART:
+     * one row per kernel thread (owning process, allocated stack, peak use from
+     * the kernel's high-water mark, remaining headroom, canary state), then
+     * totals of stacks, kernel objects and channel storage against the kernel
+     * heap and the linker sections (.data, .bss, heap, main stack).
+     *
+     * Call it once the network has run through its worst-case path, e.g. after
+     * the last frame; peak values only grow. It walks the kernel's thread list
+     * with the scheduler locked, so keep it out of timed sections.
+     * On the CMSIS-RTOS2 backend the peak needs OS_STACK_WATERMARK=1 (RTX_Config.h).
+     */
+    void PrintFootprint();
+
+    /**
+     * @brief Checks the stack canary of every process thread.
+     * Prints an ERROR line per damaged canary.
+     * @return The number of damaged canaries; always 0 without CSP4CMSIS_STACK_CANARY.
+     */
+    int CheckStackCanaries();
+
+} // namespace csp
+
+#endif // CSP4CMSIS_FOOTPRINT_H
@@ -0,0 +1,128 @@
+// --- hrtime.h (Cycle-Accurate Time Based on the DWT Cycle Counter) ---
+#ifndef CSP4CMSIS_HRTIME_H
+#define CSP4CMSIS_HRTIME_H
+
+#include "os.h"
+#include "time.h"
+#include "cycles.h"
+#include <stdint.h>
+
+namespace csp {
+
+/**
+ * @brief A duration or absolute time point in core cycles.
+ * Complements csp::Time (whole RTOS ticks) for sub-tick measurements.
+ */
+struct HrTime {
+    uint64_t cycles;
+
+    HrTime() : cycles(0) {}
+    explicit HrTime(uint64_t c) : cycles(c) {}
+
+    // Whole ticks are exact multiples of the cycles per tick.
+    explicit HrTime(Time t)
+        : cycles((uint64_t)t.to_ticks() * (internal::cycleFrequency() / os::tickRate())) {}
+
+    uint64_t to_cycles() const { return cycles; }
+
+    uint64_t to_nanoseconds() const {
+        // Split to stay within 64 bits for durations of many hours.
+        uint64_t hz = internal::cycleFrequency();
+        return (cycles / hz) * 1000000000ull + ((cycles % hz) * 1000000000ull) / hz;
+    }
+
+    uint64_t to_microseconds() const {
+        uint64_t hz = internal::cycleFrequency();
+        return (cycles / hz) * 1000000ull + ((cycles % hz) * 1000000ull) / hz;
+    }
+
+    /**
+     * @brief Converts to RTOS ticks for blocking APIs, rounding up so that a
+     * delay or timeout is never shorter than requested.
+     */
+    os::Tick to_ticks() const {
+        uint64_t per_tick = internal::cycleFrequency() / os::tickRate();
+        return (os::Tick)((cycles + per_tick - 1) / per_tick);
+    }
+
+    Time to_time() const { return Time(to_ticks()); }
+
+    HrTime operator+(const HrTime& o) const { return HrTime(cycles + o.cycles); }
+    HrTime operator-(const HrTime& o) const { return HrTime(cycles - o.cycles); }
+    HrTime& operator+=(const HrTime& o) { cycles += o.cycles; return *this; }
+    bool operator<(const HrTime& o) const { return cycles < o.cycles; }
+    bool operator>(const HrTime& o) const { return cycles > o.cycles; }
+    bool operator<=(const HrTime& o) const { return cycles <= o.cycles; }
+    bool operator>=(const HrTime& o) const { return cycles >= o.cycles; }
+};
+
+// ----------------------------------------------------
+// Sub-Tick Unit Helpers
+// ----------------------------------------------------
+
+/**
+ * @brief Creates a csp::HrTime duration representing a number of microseconds.
+ */
+inline HrTime Microseconds(uint64_t us) {
+    uint64_t hz = internal::cycleFrequency();
+    return HrTime((us / 1000000ull) * hz + ((us % 1000000ull) * hz) / 1000000ull);
+}
+
+/**
+ * @brief Creates a csp::HrTime duration representing a number of nanoseconds.
+ */
+inline HrTime Nanoseconds(uint64_t ns) {
+    uint64_t hz = internal::cycleFrequency();
+    return HrTime((ns / 1000000000ull) * hz + ((ns % 1000000000ull) * hz) / 1000000000ull);
+}
+
+/**
+ * @brief Current time since boot in core cycles.
+ */
+inline HrTime HrNow() {
+    return HrTime(internal::cycleCount64());
+}
+
+/**
+ * @brief Blocks the calling process for at least 'duration' (rounded up to ticks).
+ */
+inline void SleepFor(const HrTime& duration) {
+    os::delay(duration.to_ticks());
+}
+
+/**
+ * @brief Spins until 'duration' has passed. For sub-tick delays only:
+ * the CPU is not released to other processes.
+ */
+inline void BusyWait(const HrTime& duration) {
+    uint64_t end = internal::cycleCount64() + duration.cycles;
+    while (internal::cycleCount64() < end) {}
+}
+
+/**
+ * @brief Measures elapsed time with cycle resolution.
+ */
+class Stopwatch {
+private:
+    uint64_t start_cycles;
+public:
+    Stopwatch() { start(); }
+
+    void start() { start_cycles = internal::cycleCount64(); }
+
+    HrTime elapsed() const { return HrTime(internal::cycleCount64() - start_cycles); }
+
+    /**
+     * @brief Returns the time since the last start()/lap() and restarts.
+     */
+    HrTime lap() {
+        uint64_t now = internal::cycleCount64();
+        HrTime t(now - start_cycles);
+        start_cycles = now;
+        return t;
+    }
+};
+
+} // namespace csp
+
+#endif // CSP4CMSIS_HRTIME_H
@@ -0,0 +1,207 @@
+// --- hx_channel.h (Event-Driven Channels, Signals and ALT for hx processes) ---
+#ifndef CSP4CMSIS_HX_CHANNEL_H
+#define CSP4CMSIS_HX_CHANNEL_H
+
+#include "hx_process.h"
+
+namespace csp::hx {
+
+    namespace internal {
+
+        /**
+         * @brief Readiness and wake-up state shared by every channel kind.
+         * Channels are one-to-one: one writing and one reading process.
+         * A process blocked on a channel is recorded here and woken (its hxevent
+         * event raised) when the other side makes progress.
+         */
+        class ChannelBase {
+        public:
+            /**
+             * @brief True if an input would complete now; otherwise 'reader' is
+             * registered and woken when data arrives (also used by ALT).
+             */
+            bool pollRead(CSProcess* reader);
+
+        protected:
+            void wakeReader();
+            void wakeWriter();
+
+            CSProcess* reader_ = nullptr;
+            CSProcess* writer_ = nullptr;
+            volatile uint16_t available_ = 0; // Items an input could take right now
+        };
+
+        template <typename T>
+        class ChannelIO : public ChannelBase {
+        public:
+            virtual bool tryRead(CSProcess* self, T& value) = 0;
+            virtual bool tryWrite(CSProcess* self, const T& value) = 0;
+        };
+
+    } // namespace internal
+
+    // =============================================================
+    // Channel Ends
+    // =============================================================
+
+    template <typename T>
+    class Chanin {
+    public:
+        explicit Chanin(internal::ChannelIO<T>* chan = nullptr) : chan_(chan) {}
+        bool tryRead(CSProcess* self, T& value) const { return chan_->tryRead(self, value); }
+        internal::ChannelBase* channel() const { return chan_; }
+    private:
+        internal::ChannelIO<T>* chan_;
+    };
+
+    template <typename T>
+    class Chanout {
+    public:
+        explicit Chanout(internal::ChannelIO<T>* chan = nullptr) : chan_(chan) {}
+        bool tryWrite(CSProcess* self, const T& value) const { return chan_->tryWrite(self, value); }
+    private:
+        internal::ChannelIO<T>* chan_;
+    };
+
+    // =============================================================
+    // Rendezvous Channel
+    // =============================================================
+
+    /**
+     * @brief Unbuffered channel: the writer stays blocked until the reader has
+     * taken the value. The value is copied in when offered.
+     */
+    template <typename T>
+    class Channel : public internal::ChannelIO<T> {
+    public:
+        Chanin<T> reader() { return Chanin<T>(this); }
+        Chanout<T> writer() { return Chanout<T>(this); }
+
+        bool tryWrite(CSProcess* self, const T& value) override {
+            if (!offered_) {
+                slot_ = value;
+                offered_ = true;
+                this->writer_ = self;
+                this->available_ = 1;
+                this->wakeReader();
+                return false;
+            }
+            if (this->available_) return false; // Not taken yet
+            offered_ = false;
+            return true;
+        }
+
+        bool tryRead(CSProcess* self, T& value) override {
+            if (!this->pollRead(self)) return false;
+            value = slot_;
+            this->available_ = 0;
+            this->wakeWriter();
+            return true;
+        }
+
+    private:
+        T slot_{};
+        bool offered_ = false;
+    };
+
+    // =============================================================
+    // Buffered Channel
+    // =============================================================
+
+    /**
+     * @brief FIFO channel with static capacity N: the writer only blocks when full.
+     */
+    template <typename T, size_t N>
+    class BufferedChannel : public internal::ChannelIO<T> {
+        static_assert(N > 0 && N <= 0xFFFF, "BufferedChannel capacity must be 1..65535");
+    public:
+        Chanin<T> reader() { return Chanin<T>(this); }
+        Chanout<T> writer() { return Chanout<T>(this); }
+
+        bool tryWrite(CSProcess* self, const T& value) override {
+            if (this->available_ == N) {
+                this->writer_ = self;
+                return false;
+            }
+            buffer_[tail_] = value;
+            tail_ = (tail_ + 1) % N;
+            this->available_ = this->available_ + 1;
+            this->wakeReader();
+            return true;
+        }
+
+        bool tryRead(CSProcess* self, T& value) override {
+            if (!this->pollRead(self)) return false;
+            value = buffer_[head_];
+            head_ = (head_ + 1) % N;
+            this->available_ = this->available_ - 1;
+            this->wakeWriter();
+            return true;
+        }
+
+    private:
+        T buffer_[N];
+        size_t head_ = 0;
+        size_t tail_ = 0;
+    };
+
+    // =============================================================
+    // Interrupt Signal
+    // =============================================================
+
+    /**
+     * @brief Counting event from an interrupt handler to one process.
+     * raiseFromIsr() is the bare-metal replacement for giving a semaphore;
+     * it also serves as a timeout source when raised from a hardware timer.
+     */
+    class Signal : public internal::ChannelBase {
+    public:
+        void raiseFromIsr();
+        bool tryTake(CSProcess* self);
+    };
+
+    // =============================================================
+    // ALT
+    // =============================================================
+
+    /**
+     * @brief An ALT alternative: an input channel (or signal) and its boolean precondition.
+     */
+    struct Guard {
+        internal::ChannelBase* channel;
+        bool enabled;
+
+        template <typename T>
+        Guard(const Chanin<T>& in) : channel(in.channel()), enabled(true) {}
+        Guard(Signal& signal) : channel(&signal), enabled(true) {}
+        Guard(internal::ChannelBase* c, bool e) : channel(c), enabled(e) {}
+    };
+
+    template <typename T>
+    inline Guard when(bool condition, const Chanin<T>& in) { return Guard(in.channel(), condition); }
+    inline Guard when(bool condition, Signal& signal) { return Guard(&signal, condition); }
+
+    /**
+     * @brief Prioritised selection: index of the first enabled guard that is
+     * ready, or -1 after registering 'self' on every enabled guard.
+     */
+    template <typename... Guards>
+    inline int select(CSProcess* self, Guards&&... guards) {
+        const Guard list[] = { Guard(guards)... };
+        for (size_t i = 0; i < sizeof...(guards); ++i) {
+            if (list[i].enabled && list[i].channel->pollRead(self)) return (int)i;
+        }
+        return -1;
+    }
+
+} // namespace csp::hx
+
+/**
+ * Waits until one of the guards is ready and stores its index in 'index'
+ * (a member). The body then performs the input on the selected channel,
+ * which completes without blocking.
+ */
+#define CSP_HX_ALT(index, ...) \
+    CSP_HX_WAIT_UNTIL(((index) = ::csp::hx::select(this, __VA_ARGS__)) >= 0)
+
+#endif // CSP4CMSIS_HX_CHANNEL_H
@@ -0,0 +1,162 @@
+// --- hx_process.h (Stackless Run-to-Completion Processes on hxevent) ---
+#ifndef CSP4CMSIS_HX_PROCESS_H
+#define CSP4CMSIS_HX_PROCESS_H
+
+#include "csp_config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+extern "C" {
+#include "hxevent.h"
+}
+
+/**
+ * Bare-metal CSP without an RTOS.
+ *
+ * A csp::hx::CSProcess has no stack of its own. Its body is a resumable step()
+ * function that runs on the hxevent loop until it blocks on a channel, then
+ * returns; the channel raises the process's hxevent event once the other side
+ * is ready, and the loop calls step() again at the process's hxevent priority.
+ *
+ * The body is written between CSP_HX_BEGIN() and CSP_HX_END(). Each blocking
+ * macro records a resume point, so local variables do not survive it: keep
+ * the process state in members.
+ *
+ *   Step step() override {
+ *       CSP_HX_BEGIN();
+ *       for (i = 0; i < 10; ++i) {
+ *           CSP_HX_READ(in, value);
+ *           CSP_HX_WRITE(out, value * 2);
+ *       }
+ *       CSP_HX_END();
+ *   }
+ *
+ * Blocking macros may not be used inside a nested switch statement.
+ */
+
+namespace csp::hx {
+
+    /**
+     * @brief Result of one CSProcess::step().
+     */
+    enum class Step : uint8_t {
+        Blocked, // Waiting for a channel, signal or child; woken by its event
+        Yield,   // Ready again straight away (lets other events in)
+        Done     // Body completed; the process's event slot is released
+    };
+
+    class CSProcess;
+
+    /**
+     * @brief Starts a process on the event loop (hxevent must be initialised).
+     * May be called from another process; a finished process can be spawned again.
+     * @return false if the process is already running or all
+     *         CSP4CMSIS_HX_MAX_PROCESSES slots are in use.
+     */
+    bool Spawn(CSProcess& process);
+
+    namespace internal {
+        void dispatch(size_t slot);
+    }
+
+    class CSProcess {
+    public:
+        /**
+         * @param priority hxevent priority: 0 runs first, HX_EVENT_DEFAULT_PRIORITY last.
+         */
+        explicit CSProcess(uint8_t priority = HX_EVENT_DEFAULT_PRIORITY) : priority_(priority) {}
+        virtual ~CSProcess() = default;
+
+        /**
+         * @brief Runs the body from its last resume point to the next blocking point.
+         */
+        virtual Step step() = 0;
+
+        /**
+         * @brief Makes the process runnable. Wake-ups coalesce while one is pending.
+         * ISR-safe, so interrupt handlers can drive processes directly.
+         */
+        void wake();
+
+        bool running() const { return running_; }
+        uint8_t priority() const { return priority_; }
+
+        /**
+         * @brief Join helper for CSP_HX_JOIN: true once this process is not running,
+         * otherwise 'parent' is woken when it completes.
+         */
+        bool joinedBy(CSProcess* parent);
+
+    protected:
+        // Resume point of the step() body (source line of the last blocking macro).
+        uint32_t resume_ = 0;
+
+    private:
+        friend bool Spawn(CSProcess& process);
+        friend void internal::dispatch(size_t slot);
+
+        CSProcess* joiner_ = nullptr;
+        uint8_t priority_;
+        uint8_t slot_ = 0;
+        volatile bool pending_ = false;
+        volatile bool running_ = false;
+    };
+
+    /**
+     * @brief Initialises hxevent (hx_event_init). Applications that already
+     * call event_handler_init() skip this and only Spawn() their processes.
+     */
+    void Init();
+
+    /**
+     * @brief Enters hx_eventloop_start(); returns only after hx_eventloop_stop().
+     */
+    void Start();
+
+    /**
+     * @brief Runs a network of processes in parallel on a fresh event loop.
+     */
+    template <typename... Processes>
+    inline void Run(Processes&... processes) {
+        Init();
+        (Spawn(processes), ...);
+        Start();
+    }
+
+} // namespace csp::hx
+
+// =============================================================
+// Resumable Body Macros
+// =============================================================
+
+#define CSP_HX_BEGIN() switch (this->resume_) { case 0:
+
+#define CSP_HX_END()                                            \
+    }                                                           \
+    this->resume_ = 0;                                          \
+    return ::csp::hx::Step::Done
+
+/** Blocks until 'cond' holds; 'cond' is re-evaluated on every wake-up. */
+#define CSP_HX_WAIT_UNTIL(cond)                                 \
+    do {                                                        \
+        this->resume_ = __LINE__;                               \
+        [[fallthrough]];                                        \
+    case __LINE__:                                              \
+        if (!(cond)) return ::csp::hx::Step::Blocked;           \
+    } while (0)
+
+/** Gives way to any other pending event, then carries on. */
+#define CSP_HX_YIELD()                                          \
+    do {                                                        \
+        this->resume_ = __LINE__;                               \
+        return ::csp::hx::Step::Yield;                          \
+    case __LINE__:;                                             \
+    } while (0)
+
+/** Channel input, output, signal take and child join (see hx_channel.h). */
+#define CSP_HX_READ(in, var)   CSP_HX_WAIT_UNTIL((in).tryRead(this, (var)))
+#define CSP_HX_WRITE(out, val) CSP_HX_WAIT_UNTIL((out).tryWrite(this, (val)))
+#define CSP_HX_TAKE(signal)    CSP_HX_WAIT_UNTIL((signal).tryTake(this))
+#define CSP_HX_JOIN(process)   CSP_HX_WAIT_UNTIL((process).joinedBy(this))
+
+#endif // CSP4CMSIS_HX_PROCESS_H
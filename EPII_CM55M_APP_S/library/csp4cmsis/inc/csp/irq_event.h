@@ -0,0 +1,82 @@
+// --- irq_event.h (Interrupt Events as ALT Guards) ---
+#ifndef CSP4CMSIS_IRQ_EVENT_H
+#define CSP4CMSIS_IRQ_EVENT_H
+
+#include "os.h"
+#include "alt.h"
+#include <stdint.h>
+
+/**
+ * An interrupt turned into something a process can wait on, alone or next to
+ * channels in an ALT:
+ *
+ *   static IrqEvent npu_done;                    // raise() from the IRQ handler
+ *
+ *   Alternative alt(npu_done, requests | job, timeout);
+ *   switch (alt.priSelect()) { ... }             // 0: one raise consumed
+ *
+ * Raises are counted, so none is lost when the interrupt fires before the
+ * process gets to wait, and each selection consumes exactly one. Like a
+ * channel end, an IrqEvent has one waiting process at a time.
+ */
+namespace csp {
+    namespace internal {
+
+        class IrqEventGuard : public Guard {
+        private:
+            volatile uint32_t pending = 0;
+            AltScheduler* parent_alt = nullptr;
+            os::Flags assigned_bit = 0;
+        public:
+            bool enable(AltScheduler* alt, os::Flags bit) override;
+            bool disable() override;
+            void activate() override;
+
+            void raise();
+            bool tryTake();
+            uint32_t count() const { return pending; }
+        };
+    } // namespace internal
+
+    class IrqEvent : public Guard {
+    private:
+        internal::IrqEventGuard event_storage;
+    public:
+        IrqEvent() : Guard(&event_storage) {}
+        ~IrqEvent() override = default;
+
+        IrqEvent(const IrqEvent&) = delete;
+        IrqEvent& operator=(const IrqEvent&) = delete;
+
+        /**
+         * @brief Counts one event and wakes the process waiting on it.
+         * Callable from an interrupt handler (below the kernel's syscall
+         * priority on FreeRTOS) or from another thread.
+         */
+        void raise() { event_storage.raise(); }
+
+        /**
+         * @brief Blocks the calling process until an event is pending, then consumes it.
+         */
+        void wait();
+
+        /**
+         * @brief Waits at most 'timeout' for an event.
+         * @return True if an event was consumed, false on timeout.
+         */
+        bool wait(Time timeout);
+
+        /**
+         * @brief Consumes a pending event without blocking.
+         */
+        bool tryTake() { return event_storage.tryTake(); }
+
+        /**
+         * @brief Events raised and not yet consumed.
+         */
+        uint32_t pending() const { return event_storage.count(); }
+    };
+
+} // namespace csp
+
+#endif // CSP4CMSIS_IRQ_EVENT_H
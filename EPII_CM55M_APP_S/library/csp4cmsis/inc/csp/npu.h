@@ -0,0 +1,106 @@
+// --- npu.h (Ethos-U Inference as a CSP Process) ---
+#ifndef CSP4CMSIS_NPU_H
+#define CSP4CMSIS_NPU_H
+
+#include "csp_config.h"
+#include "os.h"
+#include "process.h"
+#include "public_channel.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * One process owns the NPU and serves every model registered with it, each
+ * through its own request/response channel pair:
+ *
+ *   static BufferedOne2OneChannel<NpuJob, 1> od_req, fm_req;
+ *   static One2OneChannel<NpuJob> od_resp, fm_resp;
+ *   static Pinned<NpuInferenceProcess, 1024> npu(30);      // report every 30 jobs
+ *   npu.attach({ "yolov8_od", yolov8_invoke }, od_req.reader(), od_resp.writer());
+ *   npu.attach({ "fd_fm", fd_fm_invoke }, fm_req.reader(), fm_resp.writer());
+ *
+ *   // client: the job comes back with its status and timings filled in
+ *   od_req.writer() << NpuJob{ frame }; od_resp.reader() >> job;
+ *
+ * The process ALTs over the request channels (fair select, so no model
+ * starves another) and calls the model's invoke(), which runs the TFLM
+ * interpreter on the process' stack. With CSP4CMSIS_ETHOSU, the Ethos-U
+ * driver's OS hooks are backed by IrqEvents (irq_event.h): after the
+ * driver submits a command stream, the process sits in an ALT on the
+ * NPU-done interrupt instead of spinning on WFE, and the CPU goes to the
+ * other processes until the interrupt raises the event.
+ *
+ * Each job reports how long it took and how much of that the process spent
+ * blocked on the NPU, i.e. CPU time handed to the rest of the network.
+ */
+namespace csp {
+
+    /**
+     * @brief One inference, travelling from a client to the NPU process and back.
+     */
+    struct NpuJob {
+        void* arg = nullptr;          // Handed to the model's invoke()
+        int status = 0;               // invoke()'s result, 0 on success
+        uint64_t npu_cycles = 0;      // invoke() from start to finish
+        uint64_t released_cycles = 0; // Part of it spent blocked on the NPU interrupt
+    };
+
+    /**
+     * @brief A model served by the NPU process. invoke() runs one inference
+     * on the interpreter it owns and returns 0 on success.
+     */
+    struct NpuModel {
+        const char* name;
+        int (*invoke)(void* arg);
+    };
+
+    class NpuInferenceProcess : public CSProcess {
+    public:
+        static const size_t MAX_MODELS = CSP4CMSIS_NPU_MAX_MODELS;
+
+        /**
+         * @param report_jobs Prints each model's average timings every this
+         * many jobs (0: never).
+         */
+        explicit NpuInferenceProcess(uint32_t report_jobs = 0) : report_every(report_jobs) {}
+
+        const char* name() const override { return "npu"; }
+
+        /**
+         * @brief Registers a model and its channel pair. Call before the process runs.
+         * @return False if MAX_MODELS are already registered.
+         */
+        bool attach(const NpuModel& model, Chanin<NpuJob> requests, Chanout<NpuJob> responses);
+
+        void run() override;
+
+    private:
+        struct Entry {
+            NpuModel model{ nullptr, nullptr };
+            Chanin<NpuJob> requests{ nullptr };
+            Chanout<NpuJob> responses{ nullptr };
+            NpuJob job;
+            uint32_t jobs = 0;
+            uint64_t npu_cycles = 0;
+            uint64_t released_cycles = 0;
+        };
+
+        Entry entries[MAX_MODELS];
+        size_t num_models = 0;
+        uint32_t report_every;
+
+        void serve(Entry& e);
+        void account(Entry& e);
+    };
+
+    namespace internal {
+        /**
+         * @brief Cycles spent blocked in the Ethos-U driver's semaphore
+         * hooks since boot (0 without CSP4CMSIS_ETHOSU).
+         */
+        uint64_t npuBlockedCycles();
+    } // namespace internal
+
+} // namespace csp
+
+#endif // CSP4CMSIS_NPU_H
@@ -0,0 +1,90 @@
+// --- os.h (Kernel Abstraction Layer) ---
+#ifndef CSP4CMSIS_OS_H
+#define CSP4CMSIS_OS_H
+
+#include "csp_config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Every kernel service used by csp4cmsis goes through namespace csp::os.
+ * The backend is selected at compile time (CSP4CMSIS_OS_RTOS2, csp_config.h):
+ *
+ *   os_freertos.h  Native FreeRTOS API (default, also used by the host port)
+ *   os_rtos2.h     CMSIS-RTOS2 API; static control blocks when built on RTX5
+ *
+ * Both backends provide the same names and semantics:
+ *
+ *   Types      Tick, Priority, Flags, ThreadId, Mutex, Semaphore, EventFlags,
+ *              Queue, Timer, CriticalState, LockState
+ *   Constants  WAIT_FOREVER; CSP_OS_PRIORITY_IDLE and CSP_OS_PRIORITY_LEVELS
+ *              (abstract levels 0..LEVELS-1, mapped onto the kernel's range)
+ *   Threads    spawn, spawnStatic, self, exitSelf, yield, threadName, priority, setPriority,
+ *              localGet/localSet (one pointer per thread: the CSProcess)
+ *   Notify     notify, notifyWait, notifyClear (binary wake-up of one thread)
+ *   Objects    mutex*, sem*, flags*, queue*, timer* (create/delete/use);
+ *              mutexCreateStatic, flagsCreateStatic on caller-provided control blocks
+ *   Time       tickCount, tickRate, delay, delayUntil
+ *   Kernel     inIsr, criticalEnter/Exit (ISR-safe), schedulerLock/Unlock
+ *   Footprint  threadList, stackBase, heapUsage, objectUsage (footprint.h)
+ *
+ * A null handle returned by a create function signals failure.
+ */
+#if CSP4CMSIS_OS_RTOS2
+#include "os_rtos2.h"
+#else
+#include "os_freertos.h"
+#endif
+
+namespace csp::os {
+
+    /**
+     * @brief Snapshot of one kernel thread, filled in by threadList().
+     */
+    struct ThreadInfo {
+        ThreadId id;
+        const char* name;
+        void* local;          // localGet() of that thread: its CSProcess, if any
+        uint32_t* stack_base; // Lowest stack word, nullptr when unknown
+        size_t stack_bytes;   // Allocated stack, 0 when unknown
+        size_t stack_unused;  // Never-touched bytes (high-water mark), SIZE_MAX when unknown
+    };
+
+    /**
+     * @brief Heap the kernel and csp4cmsis allocate from.
+     * All fields are 0 when the heap is not managed by the kernel.
+     */
+    struct HeapUsage {
+        size_t total;
+        size_t free;
+        size_t min_free;      // Low-water mark since boot
+    };
+
+    /**
+     * @brief Kernel objects created through csp::os that are still alive.
+     */
+    struct ObjectUsage {
+        uint16_t threads, mutexes, semaphores, event_flags, queues, timers;
+        size_t bytes;         // Control blocks in use (stacks and queue buffers excluded)
+        size_t budget_bytes;  // Static pool size, 0 when control blocks come from the heap
+    };
+
+    /**
+     * @brief Lists up to 'max' kernel threads (idle and timer threads included).
+     * Walks the kernel's thread list with the scheduler locked: call it from
+     * a task for diagnostics, not on a hot path.
+     * @return The number of entries written.
+     */
+    size_t threadList(ThreadInfo* out, size_t max);
+
+    /**
+     * @brief Lowest stack word of the calling thread, nullptr when unknown.
+     */
+    uint32_t* stackBase();
+
+    HeapUsage heapUsage();
+    ObjectUsage objectUsage();
+
+} // namespace csp::os
+
+#endif // CSP4CMSIS_OS_H
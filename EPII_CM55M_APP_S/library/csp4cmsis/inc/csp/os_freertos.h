@@ -0,0 +1,244 @@
+// --- os_freertos.h (Kernel Abstraction: Native FreeRTOS Backend) ---
+#ifndef CSP4CMSIS_OS_FREERTOS_H
+#define CSP4CMSIS_OS_FREERTOS_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "queue.h"
+#include "event_groups.h"
+#include "timers.h"
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CSP_OS_PRIORITY_IDLE   (tskIDLE_PRIORITY)
+#define CSP_OS_PRIORITY_LEVELS (configMAX_PRIORITIES)
+
+namespace csp::os {
+
+    typedef TickType_t         Tick;
+    typedef UBaseType_t        Priority;
+    typedef EventBits_t        Flags;
+    typedef TaskHandle_t       ThreadId;
+    typedef SemaphoreHandle_t  Mutex;
+    typedef SemaphoreHandle_t  Semaphore;
+    typedef EventGroupHandle_t EventFlags;
+    typedef QueueHandle_t      Queue;
+    typedef TimerHandle_t      Timer;
+    typedef UBaseType_t        CriticalState;
+    typedef BaseType_t         LockState;
+
+    const Tick WAIT_FOREVER = portMAX_DELAY;
+
+    namespace detail {
+        // Objects created through csp::os and not yet deleted, for objectUsage().
+        // FreeRTOS allocates them from its heap and keeps no count of its own.
+        struct Census {
+            std::atomic<uint16_t> mutexes, semaphores, event_flags, queues, timers;
+        };
+        extern Census census;
+    }
+
+    // =============================================================
+    // Kernel State and Time
+    // =============================================================
+
+    inline bool inIsr() { return xPortIsInsideInterrupt() != pdFALSE; }
+
+    inline Tick tickCount() { return inIsr() ? xTaskGetTickCountFromISR() : xTaskGetTickCount(); }
+    inline uint32_t tickRate() { return configTICK_RATE_HZ; }
+
+    inline void delay(Tick ticks) { vTaskDelay(ticks); }
+    inline void delayUntil(Tick* previous_wake, Tick increment) { vTaskDelayUntil(previous_wake, increment); }
+
+    /**
+     * @brief Masks interrupts up to the kernel's syscall priority. Nests; safe from ISRs.
+     */
+    inline CriticalState criticalEnter() {
+        if (inIsr()) return taskENTER_CRITICAL_FROM_ISR();
+        taskENTER_CRITICAL();
+        return 0;
+    }
+    inline void criticalExit(CriticalState state) {
+        if (inIsr()) taskEXIT_CRITICAL_FROM_ISR(state);
+        else taskEXIT_CRITICAL();
+    }
+
+    /**
+     * @brief Stops task switching while interrupts stay enabled (task context only).
+     */
+    inline LockState schedulerLock() { vTaskSuspendAll(); return 0; }
+    inline void schedulerUnlock(LockState) { xTaskResumeAll(); }
+
+    // =============================================================
+    // Threads
+    // =============================================================
+
+    /**
+     * @brief Creates a detached thread running entry(arg).
+     * @param stack_words Stack depth in 32-bit words (FreeRTOS convention).
+     */
+    inline bool spawn(void (*entry)(void*), void* arg, const char* name,
+                      size_t stack_words, Priority priority, ThreadId* out = nullptr) {
+        TaskHandle_t handle = nullptr;
+        // Suspended so the stack depth is recorded before the new task can run.
+        vTaskSuspendAll();
+        bool ok = xTaskCreate(entry, name, (uint32_t)stack_words, arg, priority, &handle) == pdPASS;
+        if (ok) vTaskSetThreadLocalStoragePointer(handle, CSP4CMSIS_TLS_STACK_INDEX, (void*)stack_words);
+        xTaskResumeAll();
+        if (out) *out = handle;
+        return ok;
+    }
+
+    /**
+     * @brief spawn() on caller-provided memory: no heap allocation.
+     * @param stack At least stack_words words, 8-byte aligned.
+     */
+    typedef StaticTask_t ThreadControlBlock;
+    inline bool spawnStatic(void (*entry)(void*), void* arg, const char* name, uint32_t* stack,
+                            size_t stack_words, ThreadControlBlock* cb, Priority priority,
+                            ThreadId* out = nullptr) {
+        vTaskSuspendAll();
+        TaskHandle_t handle = xTaskCreateStatic(entry, name, (uint32_t)stack_words, arg, priority,
+                                                reinterpret_cast<StackType_t*>(stack), cb);
+        if (handle) vTaskSetThreadLocalStoragePointer(handle, CSP4CMSIS_TLS_STACK_INDEX, (void*)stack_words);
+        xTaskResumeAll();
+        if (out) *out = handle;
+        return handle != nullptr;
+    }
+
+    inline ThreadId self() { return xTaskGetCurrentTaskHandle(); }
+    [[noreturn]] inline void exitSelf() { vTaskDelete(NULL); for (;;) {} }
+    inline void yield() { taskYIELD(); }
+
+    inline const char* threadName(ThreadId t = nullptr) { return pcTaskGetName(t); }
+    inline Priority priority(ThreadId t = nullptr) { return uxTaskPriorityGet(t); }
+    inline void setPriority(ThreadId t, Priority p) { vTaskPrioritySet(t, p); }
+
+    inline void* localGet() {
+        return pvTaskGetThreadLocalStoragePointer(NULL, CSP4CMSIS_TLS_PROCESS_INDEX);
+    }
+    inline void localSet(void* value) {
+        vTaskSetThreadLocalStoragePointer(NULL, CSP4CMSIS_TLS_PROCESS_INDEX, value);
+    }
+
+    // Direct-to-task notifications (the rendezvous wake-up path).
+    inline void notify(ThreadId t) { xTaskNotifyGive(t); }
+    inline void notifyWait() { ulTaskNotifyTake(pdTRUE, portMAX_DELAY); }
+    inline void notifyClear() { xTaskNotifyStateClear(NULL); }
+
+    // =============================================================
+    // Mutexes and Semaphores
+    // =============================================================
+
+    inline Mutex mutexCreate() {
+        Mutex m = xSemaphoreCreateMutex();
+        if (m) detail::census.mutexes++;
+        return m;
+    }
+
+    /**
+     * @brief mutexCreate() on a caller-provided control block: the mutex
+     * lives wherever its owner lives (placement.h), not on the kernel heap.
+     */
+    typedef StaticSemaphore_t MutexControlBlock;
+    inline Mutex mutexCreateStatic(MutexControlBlock* cb) {
+        Mutex m = xSemaphoreCreateMutexStatic(cb);
+        if (m) detail::census.mutexes++;
+        return m;
+    }
+    inline void mutexDelete(Mutex m) { vSemaphoreDelete(m); detail::census.mutexes--; }
+    inline bool mutexLock(Mutex m, Tick timeout = WAIT_FOREVER) { return xSemaphoreTake(m, timeout) == pdTRUE; }
+    inline void mutexUnlock(Mutex m) { xSemaphoreGive(m); }
+
+    inline Semaphore semCreate(uint32_t max_count, uint32_t initial) {
+        Semaphore s = xSemaphoreCreateCounting(max_count, initial);
+        if (s) detail::census.semaphores++;
+        return s;
+    }
+    inline void semDelete(Semaphore s) { vSemaphoreDelete(s); detail::census.semaphores--; }
+    inline bool semTake(Semaphore s, Tick timeout = WAIT_FOREVER) { return xSemaphoreTake(s, timeout) == pdTRUE; }
+    inline void semGive(Semaphore s) { xSemaphoreGive(s); }
+
+    // =============================================================
+    // Event Flags (ALT wake-up)
+    // =============================================================
+
+    inline EventFlags flagsCreate() {
+        EventFlags f = xEventGroupCreate();
+        if (f) detail::census.event_flags++;
+        return f;
+    }
+
+    /**
+     * @brief flagsCreate() on a caller-provided control block.
+     */
+    typedef StaticEventGroup_t EventFlagsControlBlock;
+    inline EventFlags flagsCreateStatic(EventFlagsControlBlock* cb) {
+        EventFlags f = xEventGroupCreateStatic(cb);
+        if (f) detail::census.event_flags++;
+        return f;
+    }
+    inline void flagsDelete(EventFlags f) { vEventGroupDelete(f); detail::census.event_flags--; }
+    inline void flagsClear(EventFlags f, Flags bits) { xEventGroupClearBits(f, bits); }
+
+    inline void flagsSet(EventFlags f, Flags bits) {
+        if (inIsr()) {
+            BaseType_t woken = pdFALSE;
+            xEventGroupSetBitsFromISR(f, bits, &woken);
+            portYIELD_FROM_ISR(woken);
+        } else {
+            xEventGroupSetBits(f, bits);
+        }
+    }
+
+    /**
+     * @brief Waits for any bit of 'mask' and clears the waited bits on return.
+     * @return The flags at the time of wake-up (no bit of 'mask' set on timeout).
+     */
+    inline Flags flagsWaitAny(EventFlags f, Flags mask, Tick timeout = WAIT_FOREVER) {
+        return xEventGroupWaitBits(f, mask, pdTRUE, pdFALSE, timeout);
+    }
+
+    // =============================================================
+    // Message Queues (buffered channels)
+    // =============================================================
+
+    inline Queue queueCreate(size_t capacity, size_t item_size) {
+        Queue q = xQueueCreate(capacity, item_size);
+        if (q) detail::census.queues++;
+        return q;
+    }
+    inline void queueDelete(Queue q) { vQueueDelete(q); detail::census.queues--; }
+    inline bool queueSend(Queue q, const void* item, Tick timeout = WAIT_FOREVER) { return xQueueSend(q, item, timeout) == pdPASS; }
+    inline bool queueReceive(Queue q, void* item, Tick timeout = WAIT_FOREVER) { return xQueueReceive(q, item, timeout) == pdPASS; }
+    inline size_t queueCount(Queue q) { return uxQueueMessagesWaiting(q); }
+    inline size_t queueSpace(Queue q) { return uxQueueSpacesAvailable(q); }
+
+    // =============================================================
+    // One-Shot Timers (timeout guards)
+    // =============================================================
+
+    namespace detail {
+        template <void (*FN)(void*)>
+        void timerTrampoline(TimerHandle_t t) { FN(pvTimerGetTimerID(t)); }
+    }
+
+    /**
+     * @brief Creates a stopped one-shot timer that calls FN(arg) on the timer thread.
+     */
+    template <void (*FN)(void*)>
+    inline Timer timerCreate(void* arg) {
+        // FreeRTOS rejects a zero period; timerStart() sets the real one.
+        Timer t = xTimerCreate("CspTmr", 1, pdFALSE, arg, detail::timerTrampoline<FN>);
+        if (t) detail::census.timers++;
+        return t;
+    }
+    inline void timerStart(Timer t, Tick period) { xTimerChangePeriod(t, period, 0); }
+    inline void timerStop(Timer t) { xTimerStop(t, 0); }
+    inline void timerDelete(Timer t) { xTimerDelete(t, 0); detail::census.timers--; }
+
+} // namespace csp::os
+
+#endif // CSP4CMSIS_OS_FREERTOS_H
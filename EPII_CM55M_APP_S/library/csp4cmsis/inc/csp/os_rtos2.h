@@ -0,0 +1,203 @@
+// --- os_rtos2.h (Kernel Abstraction: CMSIS-RTOS2 Backend) ---
+#ifndef CSP4CMSIS_OS_RTOS2_H
+#define CSP4CMSIS_OS_RTOS2_H
+
+#include "cmsis_os2.h"
+#if defined(RTOS2_RTX)
+#include "rtx_os.h"     // osRtxThread_t: caller-provided thread control blocks
+#endif
+#include "WE2_device.h" // CMSIS core: PRIMASK and IPSR access
+#include <stddef.h>
+#include <stdint.h>
+
+// Abstract priority levels, mapped onto osPriority_t by os_rtos2.cpp:
+// 0 Low, 1 BelowNormal, 2 Normal, 3 AboveNormal, 4 High (= RTX timer thread).
+#define CSP_OS_PRIORITY_IDLE   0U
+#define CSP_OS_PRIORITY_LEVELS 5U
+
+// Thread flag used for the rendezvous wake-up. Application threads that use
+// thread flags themselves must leave this bit alone.
+#ifndef CSP_OS_NOTIFY_FLAG
+#define CSP_OS_NOTIFY_FLAG 0x00000001U
+#endif
+
+namespace csp::os {
+
+    typedef uint32_t           Tick;
+    typedef uint32_t           Priority;
+    typedef uint32_t           Flags;
+    typedef osThreadId_t       ThreadId;
+    typedef osMutexId_t        Mutex;
+    typedef osSemaphoreId_t    Semaphore;
+    typedef osEventFlagsId_t   EventFlags;
+    typedef osMessageQueueId_t Queue;
+    typedef osTimerId_t        Timer;
+    typedef uint32_t           CriticalState;
+    typedef int32_t            LockState;
+
+    const Tick WAIT_FOREVER = osWaitForever;
+
+    // =============================================================
+    // Kernel State and Time
+    // =============================================================
+
+    inline bool inIsr() { return __get_IPSR() != 0U; }
+
+    inline Tick tickCount() { return osKernelGetTickCount(); }
+    inline uint32_t tickRate() { return osKernelGetTickFreq(); }
+
+    inline void delay(Tick ticks) {
+        if (ticks == 0) osThreadYield();
+        else osDelay(ticks);
+    }
+    inline void delayUntil(Tick* previous_wake, Tick increment) {
+        *previous_wake += increment;
+        osDelayUntil(*previous_wake);
+    }
+
+    /**
+     * @brief Masks all interrupts (PRIMASK). Nests; safe from ISRs.
+     * RTX serves kernel calls made while masked through its ISR path, so
+     * osEventFlagsSet() and friends remain usable inside.
+     */
+    inline CriticalState criticalEnter() {
+        CriticalState primask = __get_PRIMASK();
+        __disable_irq();
+        return primask;
+    }
+    inline void criticalExit(CriticalState state) { __set_PRIMASK(state); }
+
+    /**
+     * @brief Stops thread switching while interrupts stay enabled (thread context only).
+     */
+    inline LockState schedulerLock() { return osKernelLock(); }
+    inline void schedulerUnlock(LockState previous) { osKernelRestoreLock(previous); }
+
+    // =============================================================
+    // Threads
+    // =============================================================
+
+    /**
+     * @brief Creates a detached thread running entry(arg).
+     * On RTX the control block comes from a static pool and the stack from the heap.
+     * @param stack_words Stack depth in 32-bit words (FreeRTOS convention).
+     */
+    bool spawn(void (*entry)(void*), void* arg, const char* name,
+               size_t stack_words, Priority priority, ThreadId* out = nullptr);
+
+    /**
+     * @brief spawn() on caller-provided memory: no heap allocation.
+     * Other CMSIS-RTOS2 kernels ignore 'stack' and 'cb' and allocate their own.
+     * @param stack At least stack_words words, 8-byte aligned.
+     */
+#if defined(RTOS2_RTX)
+    typedef osRtxThread_t ThreadControlBlock;
+#else
+    struct ThreadControlBlock {};
+#endif
+    bool spawnStatic(void (*entry)(void*), void* arg, const char* name, uint32_t* stack,
+                     size_t stack_words, ThreadControlBlock* cb, Priority priority,
+                     ThreadId* out = nullptr);
+
+    inline ThreadId self() { return osThreadGetId(); }
+    [[noreturn]] void exitSelf();
+    inline void yield() { osThreadYield(); }
+
+    inline const char* threadName(ThreadId t = nullptr) { return osThreadGetName(t ? t : osThreadGetId()); }
+    Priority priority(ThreadId t = nullptr);
+    void setPriority(ThreadId t, Priority p);
+
+    // CMSIS-RTOS2 has no thread-local storage: a small table keyed by thread id.
+    void* localGet();
+    void localSet(void* value);
+
+    // Thread flags: RTX5's cheapest wake-up path.
+    inline void notify(ThreadId t) { osThreadFlagsSet(t, CSP_OS_NOTIFY_FLAG); }
+    inline void notifyWait() { osThreadFlagsWait(CSP_OS_NOTIFY_FLAG, osFlagsWaitAny, osWaitForever); }
+    inline void notifyClear() { osThreadFlagsClear(CSP_OS_NOTIFY_FLAG); }
+
+    // =============================================================
+    // Mutexes and Semaphores
+    // =============================================================
+
+    Mutex mutexCreate();
+
+    /**
+     * @brief mutexCreate() on a caller-provided control block: the mutex
+     * lives wherever its owner lives (placement.h), not in the static pool.
+     * Other CMSIS-RTOS2 kernels ignore 'cb', as with spawnStatic().
+     */
+#if defined(RTOS2_RTX)
+    typedef osRtxMutex_t MutexControlBlock;
+#else
+    struct MutexControlBlock {};
+#endif
+    Mutex mutexCreateStatic(MutexControlBlock* cb);
+    void mutexDelete(Mutex m);
+    inline bool mutexLock(Mutex m, Tick timeout = WAIT_FOREVER) { return osMutexAcquire(m, timeout) == osOK; }
+    inline void mutexUnlock(Mutex m) { osMutexRelease(m); }
+
+    Semaphore semCreate(uint32_t max_count, uint32_t initial);
+    void semDelete(Semaphore s);
+    inline bool semTake(Semaphore s, Tick timeout = WAIT_FOREVER) { return osSemaphoreAcquire(s, timeout) == osOK; }
+    inline void semGive(Semaphore s) { osSemaphoreRelease(s); }
+
+    // =============================================================
+    // Event Flags (ALT wake-up)
+    // =============================================================
+
+    EventFlags flagsCreate();
+
+    /**
+     * @brief flagsCreate() on a caller-provided control block.
+     */
+#if defined(RTOS2_RTX)
+    typedef osRtxEventFlags_t EventFlagsControlBlock;
+#else
+    struct EventFlagsControlBlock {};
+#endif
+    EventFlags flagsCreateStatic(EventFlagsControlBlock* cb);
+    void flagsDelete(EventFlags f);
+    inline void flagsClear(EventFlags f, Flags bits) { osEventFlagsClear(f, bits); }
+    inline void flagsSet(EventFlags f, Flags bits) { osEventFlagsSet(f, bits); }
+
+    /**
+     * @brief Waits for any bit of 'mask' and clears the waited bits on return.
+     * @return The flags at the time of wake-up (0 on timeout or error).
+     */
+    inline Flags flagsWaitAny(EventFlags f, Flags mask, Tick timeout = WAIT_FOREVER) {
+        uint32_t result = osEventFlagsWait(f, mask, osFlagsWaitAny, timeout);
+        return (result & osFlagsError) ? 0U : result;
+    }
+
+    // =============================================================
+    // Message Queues (buffered channels)
+    // =============================================================
+
+    Queue queueCreate(size_t capacity, size_t item_size);
+    void queueDelete(Queue q);
+    inline bool queueSend(Queue q, const void* item, Tick timeout = WAIT_FOREVER) { return osMessageQueuePut(q, item, 0U, timeout) == osOK; }
+    inline bool queueReceive(Queue q, void* item, Tick timeout = WAIT_FOREVER) { return osMessageQueueGet(q, item, NULL, timeout) == osOK; }
+    inline size_t queueCount(Queue q) { return osMessageQueueGetCount(q); }
+    inline size_t queueSpace(Queue q) { return osMessageQueueGetSpace(q); }
+
+    // =============================================================
+    // One-Shot Timers (timeout guards)
+    // =============================================================
+
+    namespace detail {
+        Timer timerNew(osTimerFunc_t fn, void* arg);
+    }
+
+    /**
+     * @brief Creates a stopped one-shot timer that calls FN(arg) on the timer thread.
+     */
+    template <void (*FN)(void*)>
+    inline Timer timerCreate(void* arg) { return detail::timerNew(FN, arg); }
+    inline void timerStart(Timer t, Tick period) { osTimerStart(t, period); }
+    inline void timerStop(Timer t) { osTimerStop(t); }
+    void timerDelete(Timer t);
+
+} // namespace csp::os
+
+#endif // CSP4CMSIS_OS_RTOS2_H
@@ -3,8 +3,7 @@
 #define CSP4CMSIS_OVERWRITING_CHANNEL_H
 
 #include "buffered_channel.h"
-#include "FreeRTOS.h"
-#include "queue.h"
+#include "os.h"
 
 namespace csp::internal {
 
@@ -24,21 +23,25 @@ public:
      */
     virtual void output(const T* const source) override {
         // Try to send immediately (0 ticks wait)
-        if (xQueueSend(this->getQueueHandle(), source, 0) != pdPASS) {
+        if (!os::queueSend(this->getQueueHandle(), source, 0)) {
             
             // Queue is full. Initiate overwrite sequence.
             T dummy;
             
             // 1. Remove oldest item (non-blocking, zero wait).
             // This frees one slot in the queue. We don't care about the content.
-            xQueueReceive(this->getQueueHandle(), &dummy, 0);
+            os::queueReceive(this->getQueueHandle(), &dummy, 0);
             
             // 2. Send new item (non-blocking, zero wait).
             // This must succeed because we just freed a slot, unless another
             // task raced to send, which is handled gracefully by the inner queue logic.
             // Since this is CSP, we assume a safe write operation after the drop.
-            xQueueSend(this->getQueueHandle(), source, 0);
+            os::queueSend(this->getQueueHandle(), source, 0);
         }
+#if CSP4CMSIS_STATS
+        statsHighWater(this->stats(), os::queueCount(this->getQueueHandle()));
+#endif
+        CSP_TRACE(Handshake, this->traceId(), TraceWrite);
     }
 
     // NOTE: Removed the virtual bool output_with_timeout(...) override.
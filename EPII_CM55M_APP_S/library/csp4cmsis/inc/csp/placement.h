@@ -0,0 +1,83 @@
+// --- placement.h (Memory Placement of Channels, Processes and Stacks) ---
+#ifndef CSP4CMSIS_PLACEMENT_H
+#define CSP4CMSIS_PLACEMENT_H
+
+#include "csp_config.h"
+#include "os.h"
+#include "process.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+/**
+ * A rendezvous touches the channel object, its mutex, the ALT's event flags
+ * and the stacks of both processes. Where these live sets the cost of every
+ * hand-off, so each can be pinned to a memory by declaring it with a
+ * section attribute:
+ *
+ *   CSP_PLACE_FAST static Channel<int> c1, c2;                  // object and its mutex
+ *   CSP_PLACE_FAST static Pinned<Relay, 256> relay(c1.reader(), c2.writer()); // + stack, TCB
+ *   CSP_PLACE_FAST static Net network;                          // a whole net::StaticNetwork
+ *   CSP_PLACE_BULK static uint8_t frame[640 * 480];             // cold data out of the way
+ *
+ * A channel keeps its mutex control block inside the object, and an
+ * Alternative its event-flags control block, so both follow the object
+ * (an Alternative lives on the stack of the process that runs it). The
+ * queue storage of buffered channels and the kernel threads started by
+ * plain processes still come from the kernel heap.
+ *
+ * The sections are CSP4CMSIS_FAST_SECTION and CSP4CMSIS_BULK_SECTION
+ * (csp_config.h). They are .bss sections: a placed object must be zero
+ * initialised or built by a constructor at run time, which every channel
+ * and process is; the compiler rejects anything else. A linker script
+ * without a rule for them keeps them in .bss.
+ */
+#if defined(__GNUC__)
+#define CSP_PLACE_FAST __attribute__((section(CSP4CMSIS_FAST_SECTION)))
+#define CSP_PLACE_BULK __attribute__((section(CSP4CMSIS_BULK_SECTION)))
+#else
+#define CSP_PLACE_FAST
+#define CSP_PLACE_BULK
+#endif
+
+namespace csp {
+
+    /**
+     * @brief Process P with its stack and thread control block inside the
+     * object, so that placing the process places them too. Constructed with
+     * P's arguments; started by Run()/InParallel() like any other process.
+     * STACK_WORDS overrides P::stackWords().
+     *
+     * A Pinned process is started once, as a member of a StaticNetwork or of
+     * a network that is run a single time. A thread that ends is reclaimed by
+     * the kernel some time later (FreeRTOS does it in the idle task), and its
+     * stack and control block stay in use until then, so a second thread
+     * cannot be built in them: a second start is refused with an error
+     * message and the process does not run. Processes of a network
+     * that Run() starts repeatedly take their threads from the kernel heap.
+     */
+    template <typename P, size_t STACK_WORDS = CSP4CMSIS_PROCESS_STACK_WORDS>
+    class Pinned : public P {
+        static_assert(std::is_base_of<CSProcess, P>::value, "only a CSProcess can be pinned");
+
+        // RTX wants stacks in multiples of 8 bytes.
+        static constexpr size_t stack_words = (STACK_WORDS + 1) & ~(size_t)1;
+
+        alignas(8) uint32_t stack[stack_words];
+        os::ThreadControlBlock thread_block;
+        bool started = false;
+
+    public:
+        using P::P;
+
+        size_t stackWords() const override { return stack_words; }
+        CSProcess::ThreadMemory threadMemory() override {
+            if (started) return CSProcess::ThreadMemory{ nullptr, nullptr, false };
+            started = true;
+            return CSProcess::ThreadMemory{ stack, &thread_block };
+        }
+    };
+
+} // namespace csp
+
+#endif // CSP4CMSIS_PLACEMENT_H
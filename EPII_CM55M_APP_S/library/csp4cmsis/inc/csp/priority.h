@@ -0,0 +1,91 @@
+// --- priority.h (Topology-Aware Priority Assignment) ---
+#ifndef CSP4CMSIS_PRIORITY_H
+#define CSP4CMSIS_PRIORITY_H
+
+#include "os.h"
+#include "process.h"
+#include <stddef.h>
+
+// Priority band available to CSP processes. The idle task owns the lowest
+// level and the timer service task (TimerGuard callbacks) owns the highest,
+// so with CSP_OS_PRIORITY_LEVELS == 5 the band is levels 1..3.
+#ifndef CSP_PRIORITY_BAND_LOW
+#define CSP_PRIORITY_BAND_LOW  (CSP_OS_PRIORITY_IDLE + 1)
+#endif
+
+#ifndef CSP_PRIORITY_BAND_HIGH
+#define CSP_PRIORITY_BAND_HIGH (CSP_OS_PRIORITY_LEVELS - 2)
+#endif
+
+// Priority used by Run(InParallel(...)) when no policy is requested.
+#define CSP_NETWORK_DEFAULT_PRIORITY (CSP_OS_PRIORITY_IDLE + 2)
+
+namespace csp {
+
+    /**
+     * @brief How Run() distributes priorities across a process network.
+     */
+    enum class PriorityPolicy {
+        Uniform,     // Every process gets CSP_NETWORK_DEFAULT_PRIORITY (original behaviour)
+        SinkFirst,   // Processes closer to a sink run first: minimises latency
+        SourceFirst  // Processes closer to a source run first: maximises batching
+    };
+
+    /**
+     * @brief Declared channel graph of a process network.
+     * Each edge records which process writes and which process reads a channel.
+     * Like the processes themselves, a Topology is expected to be allocated statically.
+     */
+    class Topology {
+    public:
+        static const size_t MAX_EDGES = 64;
+
+        struct Edge {
+            const CSProcess* writer;
+            const CSProcess* reader;
+        };
+
+        Topology() : num_edges(0) {}
+
+        /**
+         * @brief Declares a channel from 'writer' to 'reader'.
+         * Returns *this so a network can be declared in one chained expression.
+         */
+        Topology& connect(const CSProcess& writer, const CSProcess& reader);
+
+        size_t size() const { return num_edges; }
+        const Edge& edge(size_t i) const { return edges[i]; }
+
+    private:
+        Edge edges[MAX_EDGES];
+        size_t num_edges;
+    };
+
+} // namespace csp
+
+namespace csp::internal {
+
+    /**
+     * @brief Network analysis pass run by Run() before any task is spawned.
+     * Ranks every process by its channel distance to the nearest sink (SinkFirst)
+     * or source (SourceFirst) and maps the ranks onto the CSP priority band.
+     * Processes that cannot reach a sink/source (pure cycles) are ranked after the
+     * furthest reachable one.
+     * @param procs  The processes of the network, in InParallel() order.
+     * @param count  Number of processes.
+     * @param topo   Declared channel graph (edges to processes outside 'procs' are ignored).
+     * @param policy Requested policy.
+     * @param prios  Output array of 'count' priorities.
+     */
+    void assignPriorities(CSProcess* const* procs, size_t count, const Topology& topo,
+                          PriorityPolicy policy, os::Priority* prios);
+
+    /**
+     * @brief Prints the priority plan chosen by assignPriorities() over the console UART.
+     */
+    void reportPriorities(CSProcess* const* procs, size_t count,
+                          PriorityPolicy policy, const os::Priority* prios);
+
+} // namespace csp::internal
+
+#endif // CSP4CMSIS_PRIORITY_H
@@ -3,6 +3,10 @@
 #define CSP4CMSIS_PROCESS_H
 
 #include <stddef.h> // For size_t, NULL definition
+#include <stdint.h>
+#include "csp_config.h"
+#include "stats.h"
+#include "trace.h"
 
 extern "C" {
     void ThreadFuncWrapper(void* pvParameters);
@@ -23,6 +27,10 @@ namespace csp {
      */
     class CSProcess {
     public:
+#if CSP4CMSIS_STATS
+        CSProcess() : process_stats(this) {}
+        CSProcess(const CSProcess&) : process_stats(this) {}
+#endif
         virtual ~CSProcess() = default;
 
         /**
@@ -31,6 +39,22 @@ namespace csp {
          */
         virtual const char* name() const { return "csp_task"; } // FIX: Added default name
 
+        /**
+         * @brief Stack depth of the process thread in 32-bit words.
+         * Override to right-size a process from PrintFootprint() measurements.
+         */
+        virtual size_t stackWords() const { return CSP4CMSIS_PROCESS_STACK_WORDS; }
+
+        /**
+         * @brief Stack (stackWords() long) and os::ThreadControlBlock for the
+         * process thread, asked for each time the process is started on a new
+         * thread. A null stack lets the kernel allocate both.
+         * Pinned<P> (placement.h) returns memory inside the process object,
+         * or none available when that memory still backs an earlier thread.
+         */
+        struct ThreadMemory { uint32_t* stack; void* control_block; bool available = true; };
+        virtual ThreadMemory threadMemory() { return ThreadMemory{ nullptr, nullptr }; }
+
     protected:
         // C++CSP Standard: The primary process logic.
         virtual void run() = 0; 
@@ -41,6 +65,19 @@ namespace csp {
     private:
         // The FreeRTOS wrapper function needs to access the protected run() method.
         friend void ::ThreadFuncWrapper(void* pvParameters);
+
+#if CSP4CMSIS_STATS
+    public:
+        internal::ProcessStats& stats() { return process_stats; }
+    private:
+        internal::ProcessStatsEntry process_stats;
+#endif
+#if CSP4CMSIS_TRACE
+    public:
+        uint16_t traceId() const { return trace_id.value; }
+    private:
+        internal::TraceId<internal::TraceKind::Process> trace_id;
+#endif
     };
 
 } // namespace csp
@@ -55,6 +92,13 @@ namespace csp::internal {
     
     #define NullProcessPtr (static_cast<csp::internal::ProcessPtr>(NULL))
 
+    /**
+     * @brief The CSProcess executing on the calling task (kept in the
+     * csp::os thread-local slot), or nullptr for plain kernel threads.
+     */
+    ProcessPtr currentProcess();
+    void setCurrentProcess(ProcessPtr process);
+
 } // namespace csp::internal
 
 #endif // CSP4CMSIS_PROCESS_H
\ No newline at end of file
@@ -4,42 +4,55 @@
 #include "rendezvous_channel.h"
 #include "buffered_channel.h"
 #include "overwriting_channel.h"
+#include <type_traits>
 
 namespace csp {
 
-// Forward declarations
-template <typename T> class Chanin;
-template <typename T> class Chanout;
-
 /**
  * @brief Pipe Operators for Alternative Syntax.
  * These create a ChannelBinding (defined in alt_channel_sync.h)
  * using the unified getGuard() interface.
  */
-template <typename T>
-ChannelBinding<T, Chanin<T>> operator|(Chanin<T>& chan, T& dest) {
-    return ChannelBinding<T, Chanin<T>>(chan, dest);
+template <typename T, typename KIND>
+ChannelBinding<T, Chanin<T, KIND>> operator|(Chanin<T, KIND>& chan, T& dest) {
+    return ChannelBinding<T, Chanin<T, KIND>>(chan, dest);
 }
 
-template <typename T>
-ChannelBinding<const T, Chanout<T>> operator|(Chanout<T>& chan, const T& source) {
-    return ChannelBinding<const T, Chanout<T>>(chan, source);
+template <typename T, typename KIND>
+ChannelBinding<const T, Chanout<T, KIND>> operator|(Chanout<T, KIND>& chan, const T& source) {
+    return ChannelBinding<const T, Chanout<T, KIND>>(chan, source);
+}
+
+namespace internal {
+    // The channel class behind a statically typed end.
+    template <typename T, typename KIND> struct ChannelOf;
+    template <typename T> struct ChannelOf<T, RendezvousTag> { using type = RendezvousChannel<T>; };
+    template <typename T> struct ChannelOf<T, BufferedTag>   { using type = BufferedChannel<T>; };
 }
 
 // =============================================================
 // Channel End Wrappers (Chanout / Chanin)
 // =============================================================
 
+/**
+ * @brief Type-erased channel ends: one virtual call per read or write, and
+ * any channel implementation behind them.
+ */
 template <typename T>
-class Chanout {
+class Chanout<T, AnyChannel> {
 private:
     internal::BaseAltChan<T>* internal_ptr;
 public:
     Chanout(internal::BaseAltChan<T>* ptr) : internal_ptr(ptr) {}
     
     // Blocking write
-    void operator<<(const T& data) { internal_ptr->output(&data); }
-    void write(const T& data) { internal_ptr->output(&data); }
+    void operator<<(const T& data) { write(data); }
+    void write(const T& data) {
+#if CSP4CMSIS_STATS
+        internal::StatsProbe probe(internal_ptr->stats(), internal::StatsProbe::Output);
+#endif
+        internal_ptr->output(&data);
+    }
     
     /**
      * @brief Unified Guard accessor for ChannelBinding.
@@ -50,15 +63,20 @@ public:
 };
 
 template <typename T>
-class Chanin {
+class Chanin<T, AnyChannel> {
 private:
     internal::BaseAltChan<T>* internal_ptr;
 public:
     Chanin(internal::BaseAltChan<T>* ptr) : internal_ptr(ptr) {}
     
     // Blocking read
-    void operator>>(T& dest) { internal_ptr->input(&dest); }
-    void read(T& dest) { internal_ptr->input(&dest); }
+    void operator>>(T& dest) { read(dest); }
+    void read(T& dest) {
+#if CSP4CMSIS_STATS
+        internal::StatsProbe probe(internal_ptr->stats(), internal::StatsProbe::Input);
+#endif
+        internal_ptr->input(&dest);
+    }
     
     /**
      * @brief Unified Guard accessor for ChannelBinding.
@@ -68,8 +86,66 @@ public:
     }
 };
 
+/**
+ * @brief Statically typed channel ends (KIND is RendezvousTag or BufferedTag).
+ * The calls name the channel class, so the compiler binds them without the
+ * vtable and can inline the whole fast path into a relay loop. The end must
+ * point at exactly that class (as the channel containers below hand out),
+ * not at a subclass such as a deadline channel. Converts to the type-erased
+ * end where a process or an ALT mixes channel kinds.
+ */
+template <typename T, typename KIND>
+class Chanout {
+    using Impl = typename internal::ChannelOf<T, KIND>::type;
+private:
+    Impl* internal_ptr;
+public:
+    explicit Chanout(Impl* ptr) : internal_ptr(ptr) {}
+
+    operator Chanout<T>() const { return Chanout<T>(internal_ptr); }
+
+    // Blocking write
+    void operator<<(const T& data) { write(data); }
+    void write(const T& data) {
+#if CSP4CMSIS_STATS
+        internal::StatsProbe probe(internal_ptr->stats(), internal::StatsProbe::Output);
+#endif
+        internal_ptr->Impl::output(&data);
+    }
+
+    internal::Guard* getGuard(const T& source) {
+        return internal_ptr->Impl::getOutputGuard(source);
+    }
+};
+
+template <typename T, typename KIND>
+class Chanin {
+    using Impl = typename internal::ChannelOf<T, KIND>::type;
+private:
+    Impl* internal_ptr;
+public:
+    explicit Chanin(Impl* ptr) : internal_ptr(ptr) {}
+
+    operator Chanin<T>() const { return Chanin<T>(internal_ptr); }
+
+    // Blocking read
+    void operator>>(T& dest) { read(dest); }
+    void read(T& dest) {
+#if CSP4CMSIS_STATS
+        internal::StatsProbe probe(internal_ptr->stats(), internal::StatsProbe::Input);
+#endif
+        internal_ptr->Impl::input(&dest);
+    }
+
+    internal::Guard* getGuard(T& dest) {
+        return internal_ptr->Impl::getInputGuard(dest);
+    }
+};
+
 // =============================================================
 // Static Channel Containers
+// writer()/reader() hand out type-erased ends; writer<RendezvousTag>()
+// (or <BufferedTag> on a buffered channel) statically typed ones.
 // =============================================================
 
 /**
@@ -82,8 +158,18 @@ private:
 public:
     One2OneChannel() = default;
     
-    Chanout<T> writer() { return Chanout<T>(&internal_chan); }
-    Chanin<T> reader() { return Chanin<T>(&internal_chan); }
+    template <typename KIND = AnyChannel>
+    Chanout<T, KIND> writer() {
+        static_assert(std::is_same<KIND, AnyChannel>::value || std::is_same<KIND, RendezvousTag>::value,
+                      "a One2OneChannel has rendezvous ends");
+        return Chanout<T, KIND>(&internal_chan);
+    }
+    template <typename KIND = AnyChannel>
+    Chanin<T, KIND> reader() {
+        static_assert(std::is_same<KIND, AnyChannel>::value || std::is_same<KIND, RendezvousTag>::value,
+                      "a One2OneChannel has rendezvous ends");
+        return Chanin<T, KIND>(&internal_chan);
+    }
 };
 
 template <typename T>
@@ -99,8 +185,18 @@ private:
 public:
     BufferedOne2OneChannel() : internal_chan(SIZE) {}
     
-    Chanout<T> writer() { return Chanout<T>(&internal_chan); }
-    Chanin<T> reader() { return Chanin<T>(&internal_chan); }
+    template <typename KIND = AnyChannel>
+    Chanout<T, KIND> writer() {
+        static_assert(std::is_same<KIND, AnyChannel>::value || std::is_same<KIND, BufferedTag>::value,
+                      "a BufferedOne2OneChannel has buffered ends");
+        return Chanout<T, KIND>(&internal_chan);
+    }
+    template <typename KIND = AnyChannel>
+    Chanin<T, KIND> reader() {
+        static_assert(std::is_same<KIND, AnyChannel>::value || std::is_same<KIND, BufferedTag>::value,
+                      "a BufferedOne2OneChannel has buffered ends");
+        return Chanin<T, KIND>(&internal_chan);
+    }
 };
 
 // --- Standard CSP Aliases ---
@@ -3,8 +3,8 @@
 
 #include "channel_base.h"       
 #include "alt_channel_sync.h"   
-#include "FreeRTOS.h"
-#include "task.h"               
+#include "os.h"
+#include "footprint.h"
 #include <cstring>    
 #include <cstdio>  
 
@@ -20,18 +20,31 @@ private:
 public:
     RendezvousChannel() 
         : res_in_guard(&sync_base, nullptr, sizeof(T)),
-          res_out_guard(&sync_base, nullptr, sizeof(T)) {}
+          res_out_guard(&sync_base, nullptr, sizeof(T)) {
+#if CSP4CMSIS_TRACE
+        res_in_guard.trace_channel = this->traceId();
+        res_out_guard.trace_channel = this->traceId();
+#endif
+#if CSP4CMSIS_STATS
+        res_in_guard.stats_channel = this->stats();
+        res_in_guard.stats_dir = StatsProbe::Input;
+        res_out_guard.stats_channel = this->stats();
+        res_out_guard.stats_dir = StatsProbe::Output;
+#endif
+        footprintChannel(+1, sizeof(*this), 0);
+    }
 
-    virtual ~RendezvousChannel() override = default;
+    virtual ~RendezvousChannel() override { footprintChannel(-1, sizeof(*this), 0); }
 
     // --- Blocking Input (Receiver) ---
     virtual void input(T* const dest) override {
-        xTaskNotifyStateClear(NULL);
+        os::notifyClear();
 
-        if (xSemaphoreTake(sync_base.getMutex(), portMAX_DELAY) == pdTRUE) {
+        if (os::mutexLock(sync_base.getMutex())) {
             // 1. Check if a standard sender is already waiting
             if (sync_base.tryHandshake((void*)dest, sizeof(T), false)) {
-                xSemaphoreGive(sync_base.getMutex());
+                os::mutexUnlock(sync_base.getMutex());
+                CSP_TRACE(Handshake, this->traceId(), TraceRead);
                 return; 
             }
 
@@ -43,43 +56,42 @@ public:
 
             // 3. No partner ready yet: Register and block
             sync_base.registerWaitingTask((void*)dest, false);
-            xSemaphoreGive(sync_base.getMutex());
+            os::mutexUnlock(sync_base.getMutex());
         }
 
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        CSP_TRACE(Block, this->traceId(), TraceRead);
+        os::notifyWait();
+        CSP_TRACE(Unblock, this->traceId(), TraceRead);
     }
 
     // --- Blocking Output (Sender) ---
     virtual void output(const T* const source) override {
-        xTaskNotifyStateClear(NULL);
-        // printf("[Producer] Channel %p: Entering output()\n", (void*)this);
+        os::notifyClear();
 
-        if (xSemaphoreTake(sync_base.getMutex(), portMAX_DELAY) == pdTRUE) {
+        if (os::mutexLock(sync_base.getMutex())) {
             // 1. Check for standard waiter
-            if (sync_base.getWaitingInTask() != nullptr) {
-                // printf("[Producer] Channel %p: Found standard blocking receiver.\r\n", (void*)this);
+            os::ThreadId receiver = sync_base.getWaitingInTask();
+            if (receiver != nullptr) {
                 sync_base.tryHandshake((void*)const_cast<T*>(source), sizeof(T), true);
-                xSemaphoreGive(sync_base.getMutex());
+                os::mutexUnlock(sync_base.getMutex());
+                CSP_TRACE(Handshake, this->traceId(), TraceWrite);
+                handOff(receiver);
                 return; 
             }
 
             // 2. Check for ALT waiter (The Critical Path)
             if (sync_base.getAltInScheduler() != nullptr) {
-                // printf("[Producer] Channel %p: FOUND ALTed receiver! Waking bit %lu\r\n", (void*)this, (unsigned long)sync_base.getAltInBit());
-                
                 sync_base.getAltInScheduler()->wakeUp(sync_base.getAltInBit());
                 
                 // Note: In Rendezvous, we must still block until the receiver calls activate()
-                // printf("[Producer] Channel %p: Partner signaled. Registering to block...\r\n", (void*)this);
-            } else {
-                // printf("[Producer] Channel %p: No receiver found. Registering and blocking.\r\n", (void*)this);
             }
 
             sync_base.registerWaitingTask((void*)const_cast<T*>(source), true);
-            xSemaphoreGive(sync_base.getMutex());
+            os::mutexUnlock(sync_base.getMutex());
         }
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        // printf("[Producer] Channel %p: Output complete.\n", (void*)this);
+        CSP_TRACE(Block, this->traceId(), TraceWrite);
+        os::notifyWait();
+        CSP_TRACE(Unblock, this->traceId(), TraceWrite);
     }
 
     // --- Resident Guard Implementation ---
@@ -95,13 +107,13 @@ public:
     
     virtual bool pending() override {
         bool has_partner = false;
-        if (xSemaphoreTake(sync_base.getMutex(), 0) == pdTRUE) {
+        if (os::mutexLock(sync_base.getMutex(), 0)) {
             // Pending is true if someone is waiting to block OR someone is ALTing
             has_partner = (sync_base.getWaitingInTask() != nullptr) || 
                           (sync_base.getWaitingOutTask() != nullptr) ||
                           (sync_base.getAltInScheduler() != nullptr) ||
                           (sync_base.getAltOutScheduler() != nullptr);
-            xSemaphoreGive(sync_base.getMutex());
+            os::mutexUnlock(sync_base.getMutex());
         }
         return has_partner;
     }
@@ -1,12 +1,10 @@
 #ifndef CSP_WRAPPER_H
 #define CSP_WRAPPER_H
 
-#include "FreeRTOS.h"
-#include "task.h"
-#include "semphr.h"
+#include "os.h"
+#include <cstdio>
 #include <tuple>
 #include <vector>
-#include "csp4cmsis.h" 
 
 // --- 1. START CSP NAMESPACE (For Definitions) ---
 namespace csp {
@@ -21,10 +19,15 @@ namespace csp {
     // --- Internal Task Context DEFINITION ---
     struct TaskCtx {
         CSProcess* process;
-        SemaphoreHandle_t completion_sem;
+        os::Semaphore completion_sem;
+        bool preallocated = false; // Lives in a StaticNetwork: not deleted on exit
     };
 } // end namespace csp definition block
 
+// After TaskCtx: static_network.h, pulled in here, stores TaskCtx by value.
+#include "csp4cmsis.h" 
+#include "priority.h"
+
 // --- 2. The Globally Friended Task Wrapper (DECLARATION ONLY) ---
 extern "C" {
     void ThreadFuncWrapper(void* pvParameters);
@@ -40,83 +43,124 @@ class ParallelHelper {
 private:
     std::tuple<Processes&...> procs;
 
+    static constexpr size_t num_procs = sizeof...(Processes);
+
     // Helper to spawn a task for a specific process index
     template <std::size_t I>
-    void spawn_task(SemaphoreHandle_t sem, UBaseType_t priority) {
+    void spawn_task(os::Semaphore sem, os::Priority priority) {
+        CSProcess::ThreadMemory memory = std::get<I>(procs).threadMemory();
+        if (!memory.available) {
+            printf("FATAL ERROR: Pinned process '%s' started twice: its stack still backs the first thread.\r\n",
+                   std::get<I>(procs).name());
+            if (sem) os::semGive(sem); // Not started: a terminating network does not wait for it
+            return;
+        }
+
         // Uses the now-defined TaskCtx
         TaskCtx* ctx = new TaskCtx{ &std::get<I>(procs), sem };
+
+        if (memory.stack != nullptr) {
+            os::spawnStatic(ThreadFuncWrapper, ctx, std::get<I>(procs).name(), memory.stack,
+                            std::get<I>(procs).stackWords(),
+                            static_cast<os::ThreadControlBlock*>(memory.control_block), priority);
+            return;
+        }
         
-        xTaskCreate(
-            (TaskFunction_t)ThreadFuncWrapper, 
-            std::get<I>(procs).name(),
-            256, 
+        os::spawn(
+            ThreadFuncWrapper, 
             ctx,
-            priority,
-            NULL
+            std::get<I>(procs).name(),
+            std::get<I>(procs).stackWords(),
+            priority
         );
     }
 
     // Recursive spawner: Spawns tasks for indices 1 to N (skipping 0)
     template <std::size_t I>
-    void spawn_others(SemaphoreHandle_t sem, UBaseType_t priority) {
+    void spawn_others(os::Semaphore sem, const os::Priority* prios) {
         if constexpr (I < sizeof...(Processes)) {
-            spawn_task<I>(sem, priority);
-            spawn_others<I + 1>(sem, priority);
+            spawn_task<I>(sem, prios[I]);
+            spawn_others<I + 1>(sem, prios);
         }
     }
     
     // *** Spawns ALL processes (for non-blocking SPN launch) ***
     template <std::size_t I>
-    void spawn_all(SemaphoreHandle_t sem, UBaseType_t priority) {
+    void spawn_all(os::Semaphore sem, const os::Priority* prios) {
         if constexpr (I < sizeof...(Processes)) {
-            spawn_task<I>(sem, priority);
-            spawn_all<I + 1>(sem, priority);
+            spawn_task<I>(sem, prios[I]);
+            spawn_all<I + 1>(sem, prios);
         }
     }
 
+    // Runs the first process on the current stack at its planned priority.
+    void run_first(os::Priority priority) {
+        os::Priority caller_priority = os::priority();
+        internal::ProcessPtr caller_process = internal::currentProcess();
+        if (priority != caller_priority) os::setPriority(nullptr, priority);
+        internal::setCurrentProcess(&std::get<0>(procs));
+
+        std::get<0>(procs).run();
+
+        internal::setCurrentProcess(caller_process);
+        if (priority != caller_priority) os::setPriority(nullptr, caller_priority);
+    }
+
 public:
     explicit ParallelHelper(Processes&... p) : procs(p...) {}
 
+    /**
+     * @brief Collects the process pointers in InParallel() order for the analysis pass.
+     */
+    void collect(CSProcess** out) {
+        size_t i = 0;
+        std::apply([&](auto&... p) { ((out[i++] = &p), ...); }, procs);
+    }
+
     // 1. *** Renamed/Modified: Standard Blocking Run (ExecutionMode::TerminatingNetwork) ***
-    void execute_terminating(UBaseType_t priority) {
-        constexpr size_t num_procs = sizeof...(Processes);
-        
-        SemaphoreHandle_t done_sem = NULL;
+    void execute_terminating(const os::Priority* prios) {
+        os::Semaphore done_sem = NULL;
         if constexpr (num_procs > 1) {
-             done_sem = xSemaphoreCreateCounting(num_procs - 1, 0);
-             spawn_others<1>(done_sem, priority);
+             done_sem = os::semCreate(num_procs - 1, 0);
+             spawn_others<1>(done_sem, prios);
         }
 
         // Run the first process on the current stack
-        std::get<0>(procs).run(); 
+        run_first(prios[0]);
 
         if (done_sem) {
             for (size_t i = 1; i < num_procs; ++i) {
-                xSemaphoreTake(done_sem, portMAX_DELAY);
+                os::semTake(done_sem);
             }
-            vSemaphoreDelete(done_sem);
+            os::semDelete(done_sem);
         }
     }
 
     // 2. *** MODIFIED: Non-Blocking Run (ExecutionMode::StaticNetwork) ***
-    void execute_static(UBaseType_t priority) {
-        constexpr size_t num_procs = sizeof...(Processes);
-        
-        // 1. Spawn all processes *except* the first one (the intended orchestrator)
-        if constexpr (num_procs > 1) {
-             // Use spawn_others to launch w1, w2, w3, c1. 
-             // Pass NULL for the semaphore since these tasks are perpetual and won't signal completion.
-             spawn_others<1>(NULL, priority); 
+    void execute_static(const os::Priority* prios) {
+        // Every process gets its own thread, the first one included: it
+        // must not take over the caller, which may be main() before the
+        // scheduler starts, and a Pinned process must run on its own stack.
+        // Pass NULL for the semaphore since these tasks are perpetual and won't signal completion.
+        spawn_all<0>(NULL, prios);
+
+        // NOTE: There is no blocking wait for the spawned tasks
+        // because they are perpetual SPN elements.
+    }
+
+    void execute(ExecutionMode mode, const os::Priority* prios) {
+        if (mode == ExecutionMode::StaticNetwork) {
+            execute_static(prios);
+        } else {
+            // Fallback or explicit selection of TerminatingNetwork
+            execute_terminating(prios);
         }
+    }
 
-        // 2. Run the first process (f1) on the current stack. 
-        // This thread (MainApp_Task) will be BLOCKED until f1.run() returns.
-        std::get<0>(procs).run(); 
-        
-        // 3. The current thread (MainApp_Task) unblocks here when f1 finishes.
-        
-        // NOTE: There is no blocking wait for the spawned tasks (w1, w2, w3, c1) 
-        // because they are perpetual SPN elements.
+    void execute(ExecutionMode mode, os::Priority priority) {
+        os::Priority prios[num_procs];
+        for (size_t i = 0; i < num_procs; ++i) prios[i] = priority;
+        execute(mode, prios);
     }
 };
 
@@ -130,18 +174,30 @@ ParallelHelper<Processes...> InParallel(Processes&... procs) {
 // 1. Overloaded Run for Terminating Networks (Original behavior, implicitly uses TerminatingNetwork mode)
 template <typename... Processes>
 void Run(ParallelHelper<Processes...> helper) {
-    helper.execute_terminating(tskIDLE_PRIORITY + 2);
+    helper.execute(ExecutionMode::TerminatingNetwork, CSP_NETWORK_DEFAULT_PRIORITY);
 }
 
 // 2. *** NEW Overloaded Run (The requested change) ***
 template <typename... Processes>
 void Run(ParallelHelper<Processes...> helper, ExecutionMode mode) {
-    if (mode == ExecutionMode::StaticNetwork) {
-        helper.execute_static(tskIDLE_PRIORITY + 2);
-    } else {
-        // Fallback or explicit selection of TerminatingNetwork
-        helper.execute_terminating(tskIDLE_PRIORITY + 2);
-    }
+    helper.execute(mode, CSP_NETWORK_DEFAULT_PRIORITY);
+}
+
+// 3. Overloaded Run with topology-aware priority assignment.
+// The analysis pass ranks the processes over the declared channel graph,
+// reports the chosen plan and launches the network in the requested mode.
+template <typename... Processes>
+void Run(ParallelHelper<Processes...> helper, ExecutionMode mode,
+         PriorityPolicy policy, const Topology& topology) {
+    constexpr size_t num_procs = sizeof...(Processes);
+    CSProcess* members[num_procs];
+    os::Priority prios[num_procs];
+
+    helper.collect(members);
+    internal::assignPriorities(members, num_procs, topology, policy, prios);
+    internal::reportPriorities(members, num_procs, policy, prios);
+
+    helper.execute(mode, prios);
 }
 
 } // namespace csp
@@ -0,0 +1,266 @@
+// --- static_network.h (Compile-Time Process Network Description) ---
+#ifndef CSP4CMSIS_STATIC_NETWORK_H
+#define CSP4CMSIS_STATIC_NETWORK_H
+
+#include "os.h"
+#include "process.h"
+#include "priority.h"
+#include "public_channel.h"
+#include "run.h"
+#include <cstdio>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * A process network declared as a type instead of being wired by hand:
+ *
+ *   using Net = csp::net::StaticNetwork<
+ *       csp::net::Channels<csp::net::Edge<0, int>,          // rendezvous
+ *                          csp::net::Edge<1, int, 8>>,      // buffered, 8 deep
+ *       csp::net::Processes<
+ *           csp::net::Node<Source, csp::net::Reads<>,  csp::net::Writes<0>>,
+ *           csp::net::Node<Relay,  csp::net::Reads<0>, csp::net::Writes<1>>,
+ *           csp::net::Node<Sink,   csp::net::Reads<1>, csp::net::Writes<>, csp::net::Args<42>, 512>>>;
+ *
+ *   static Net network;            // zero-initialised .bss: no constructor runs
+ *   network.start();               // builds channels and processes in place, spawns all
+ *
+ * A process is constructed from Chanin<T> for each id in Reads (in order),
+ * then Chanout<T> for each id in Writes, then the Args values. Mis-wiring is a
+ * compile error: every channel needs exactly one writer and one reader, and
+ * every id must be declared. The channel graph also feeds the priority
+ * analysis, so no Topology has to be written either.
+ *
+ * Channels, processes, stacks and thread control blocks all live inside the
+ * one StaticNetwork object, whose size is known at compile time (ramBytes()).
+ * Only the kernel objects behind the channels (and the queue storage of
+ * buffered channels) still come from the kernel when start() runs.
+ */
+namespace csp::net {
+
+    /**
+     * @brief Channel 'ID' carrying T. CAPACITY 0 is a rendezvous channel,
+     * anything else a buffered channel of that depth.
+     */
+    template <size_t ID, typename T, size_t CAPACITY = 0>
+    struct Edge {
+        static constexpr size_t id = ID;
+        static constexpr size_t capacity = CAPACITY;
+        static constexpr size_t queue_bytes = CAPACITY * sizeof(T);
+        using Type = T;
+        using Storage = std::conditional_t<CAPACITY == 0, internal::RendezvousChannel<T>,
+                                           internal::BufferedChannel<T>>;
+    };
+
+    template <size_t... IDS> struct Reads {};
+    template <size_t... IDS> struct Writes {};
+    template <auto... VALUES> struct Args {};
+
+    template <typename... Edges> struct Channels {};
+    template <typename... Nodes> struct Processes {};
+
+    /**
+     * @brief Process P, reading and writing the listed channel ids, built with
+     * the extra constructor arguments Args and given STACK_WORDS of stack
+     * (this value, not P::stackWords(), sizes the static stack).
+     */
+    template <typename P, typename R = Reads<>, typename W = Writes<>, typename A = Args<>,
+              size_t STACK_WORDS = CSP4CMSIS_PROCESS_STACK_WORDS>
+    struct Node;
+
+    template <typename P, size_t... R, size_t... W, auto... A, size_t STACK_WORDS>
+    struct Node<P, Reads<R...>, Writes<W...>, Args<A...>, STACK_WORDS> {
+        static_assert(std::is_base_of<CSProcess, P>::value, "a network node must derive from CSProcess");
+
+        using Process = P;
+        // RTX wants stacks in multiples of 8 bytes.
+        static constexpr size_t stack_words = (STACK_WORDS + 1) & ~(size_t)1;
+
+        template <size_t ID> static constexpr size_t reads() { return ((size_t)(R == ID) + ... + 0); }
+        template <size_t ID> static constexpr size_t writes() { return ((size_t)(W == ID) + ... + 0); }
+
+        template <typename Net>
+        static constexpr bool wiredTo() { return (Net::template declared<R>() && ... && true)
+                                              && (Net::template declared<W>() && ... && true); }
+
+        template <typename Net>
+        static constexpr bool constructible() {
+            return std::is_constructible<P, Chanin<typename Net::template TypeOf<R>>...,
+                                         Chanout<typename Net::template TypeOf<W>>...,
+                                         decltype(A)...>::value;
+        }
+
+        template <typename Net>
+        static P* construct(void* mem, Net& net) {
+            return new (mem) P(net.template reader<R>()..., net.template writer<W>()..., A...);
+        }
+    };
+
+    template <typename C, typename P> class StaticNetwork;
+
+    template <typename... E, typename... N>
+    class StaticNetwork<Channels<E...>, Processes<N...>> {
+    public:
+        static constexpr size_t NUM_CHANNELS = sizeof...(E);
+        static constexpr size_t NUM_PROCESSES = sizeof...(N);
+
+        static_assert(NUM_PROCESSES > 0, "a network needs at least one process");
+        static_assert(NUM_CHANNELS <= Topology::MAX_EDGES, "more channels than Topology::MAX_EDGES");
+
+        // --- Compile-time lookup ---
+        template <size_t ID>
+        static constexpr size_t indexOf() {
+            constexpr size_t ids[] = { E::id..., 0 };
+            for (size_t i = 0; i < NUM_CHANNELS; ++i) {
+                if (ids[i] == ID) return i;
+            }
+            return NUM_CHANNELS;
+        }
+        template <size_t ID> static constexpr bool declared() { return indexOf<ID>() < NUM_CHANNELS; }
+        template <size_t ID> using EdgeOf = std::tuple_element_t<indexOf<ID>(), std::tuple<E...>>;
+        template <size_t ID> using TypeOf = typename EdgeOf<ID>::Type;
+
+        // --- Memory accounting (bytes) ---
+        static constexpr size_t STACK_BYTES = (N::stack_words + ... + 0) * sizeof(uint32_t);
+        static constexpr size_t CHANNEL_BYTES = (sizeof(typename E::Storage) + ... + 0);
+        static constexpr size_t PROCESS_BYTES = (sizeof(typename N::Process) + ... + 0);
+        static constexpr size_t QUEUE_BYTES = (E::queue_bytes + ... + 0); // Kernel heap, at start()
+
+        /**
+         * @brief RAM the network occupies: the object itself (channels,
+         * processes, stacks, thread control blocks) plus buffered-channel storage.
+         */
+        static constexpr size_t ramBytes() { return sizeof(StaticNetwork) + QUEUE_BYTES; }
+
+    private:
+        template <size_t ID> static constexpr size_t writers() { return (N::template writes<ID>() + ... + 0); }
+        template <size_t ID> static constexpr size_t readers() { return (N::template reads<ID>() + ... + 0); }
+
+        static constexpr bool uniqueIds() {
+            constexpr size_t ids[] = { E::id..., 0 };
+            for (size_t i = 0; i < NUM_CHANNELS; ++i) {
+                for (size_t j = i + 1; j < NUM_CHANNELS; ++j) {
+                    if (ids[i] == ids[j]) return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename T>
+        struct Slot {
+            alignas(T) unsigned char bytes[sizeof(T)];
+            T* get() { return std::launder(reinterpret_cast<T*>(bytes)); }
+        };
+
+        static constexpr size_t stackOffset(size_t node) {
+            constexpr size_t words[] = { N::stack_words... };
+            size_t offset = 0;
+            for (size_t i = 0; i < node; ++i) offset += words[i];
+            return offset;
+        }
+
+        std::tuple<Slot<typename E::Storage>...> channels;
+        std::tuple<Slot<typename N::Process>...> processes;
+        Slot<Topology> topology;
+        alignas(8) uint32_t stacks[STACK_BYTES / sizeof(uint32_t)];
+        os::ThreadControlBlock thread_blocks[NUM_PROCESSES];
+        TaskCtx contexts[NUM_PROCESSES];
+        bool started;
+
+        template <size_t... I>
+        void constructChannels(std::index_sequence<I...>) {
+            ((constructChannel<std::tuple_element_t<I, std::tuple<E...>>>(std::get<I>(channels).bytes)), ...);
+        }
+
+        template <typename Edge>
+        static void constructChannel(void* mem) {
+            if constexpr (Edge::capacity == 0) new (mem) typename Edge::Storage();
+            else new (mem) typename Edge::Storage(Edge::capacity);
+        }
+
+        template <size_t... I>
+        void constructProcesses(std::index_sequence<I...>, CSProcess** members) {
+            ((members[I] = std::tuple_element_t<I, std::tuple<N...>>::construct(std::get<I>(processes).bytes, *this)), ...);
+        }
+
+        template <size_t ID>
+        static void connect(Topology& topo, CSProcess* const* members) {
+            constexpr size_t writes[] = { N::template writes<ID>()... };
+            constexpr size_t reads[] = { N::template reads<ID>()... };
+            size_t w = 0, r = 0;
+            for (size_t i = 0; i < NUM_PROCESSES; ++i) {
+                if (writes[i]) w = i;
+                if (reads[i]) r = i;
+            }
+            topo.connect(*members[w], *members[r]);
+        }
+
+    public:
+        // --- Channel ends, by id ---
+        template <size_t ID>
+        Chanin<TypeOf<ID>> reader() { return Chanin<TypeOf<ID>>(std::get<indexOf<ID>()>(channels).get()); }
+
+        template <size_t ID>
+        Chanout<TypeOf<ID>> writer() { return Chanout<TypeOf<ID>>(std::get<indexOf<ID>()>(channels).get()); }
+
+        /**
+         * @brief Node I, once start() has built it.
+         */
+        template <size_t I>
+        typename std::tuple_element_t<I, std::tuple<N...>>::Process& process() { return *std::get<I>(processes).get(); }
+
+        /**
+         * @brief Builds every channel and process in place and spawns one
+         * thread per process on its static stack (StaticNetwork mode: returns
+         * at once). The object must be static; start() runs once.
+         * @param policy Priority plan, computed over the declared channel graph.
+         * @return False if a thread could not be created.
+         */
+        bool start(PriorityPolicy policy = PriorityPolicy::Uniform) {
+            // Checked here, where the class is complete.
+            static_assert(uniqueIds(), "two channels share an id");
+            static_assert(((writers<E::id>() == 1) && ... && true),
+                          "every One2One channel needs exactly one writing process");
+            static_assert(((readers<E::id>() == 1) && ... && true),
+                          "every One2One channel needs exactly one reading process");
+            static_assert((N::template wiredTo<StaticNetwork>() && ...),
+                          "a process reads or writes a channel id that is not declared");
+            static_assert((N::template constructible<StaticNetwork>() && ...),
+                          "a process has no constructor (Chanin<T>... reads, Chanout<T>... writes, Args...)");
+
+            if (started) {
+                printf("ERROR: StaticNetwork started twice.\r\n");
+                return false;
+            }
+            started = true;
+
+            CSProcess* members[NUM_PROCESSES];
+            constructChannels(std::index_sequence_for<E...>{});
+            constructProcesses(std::index_sequence_for<N...>{}, members);
+
+            Topology* topo = new (topology.bytes) Topology();
+            (connect<E::id>(*topo, members), ...);
+
+            os::Priority prios[NUM_PROCESSES];
+            internal::assignPriorities(members, NUM_PROCESSES, *topo, policy, prios);
+            if (policy != PriorityPolicy::Uniform) internal::reportPriorities(members, NUM_PROCESSES, policy, prios);
+
+            constexpr size_t words[] = { N::stack_words... };
+            bool ok = true;
+            for (size_t i = 0; i < NUM_PROCESSES; ++i) {
+                contexts[i] = TaskCtx{ members[i], nullptr, true };
+                if (!os::spawnStatic(ThreadFuncWrapper, &contexts[i], members[i]->name(),
+                                     stacks + stackOffset(i), words[i], &thread_blocks[i], prios[i])) {
+                    printf("FATAL ERROR: Failed to create the thread of process '%s'.\r\n", members[i]->name());
+                    ok = false;
+                }
+            }
+            return ok;
+        }
+    };
+
+} // namespace csp::net
+
+#endif // CSP4CMSIS_STATIC_NETWORK_H
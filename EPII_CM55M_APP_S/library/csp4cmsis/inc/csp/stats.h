@@ -0,0 +1,145 @@
+// --- stats.h (Opt-In Process and Channel Runtime Statistics) ---
+#ifndef CSP4CMSIS_STATS_H
+#define CSP4CMSIS_STATS_H
+
+#include "csp_config.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace csp {
+    class CSProcess;
+}
+
+namespace csp::internal {
+
+    /**
+     * @brief Counters kept per CSProcess. All times are DWT core cycles.
+     * Run time is accumulated by the FreeRTOS context-switch hooks (not
+     * available on the CMSIS-RTOS2 backend, where it stays zero); blocked
+     * times cover the whole channel operation, i.e. waiting plus the copy.
+     */
+    struct ProcessStats {
+        const CSProcess* owner = nullptr;
+        uint64_t run_cycles = 0;
+        uint64_t blocked_in_cycles = 0;   // Chanin reads and ALT selects
+        uint64_t blocked_out_cycles = 0;  // Chanout writes
+        uint32_t msgs_sent = 0;
+        uint32_t msgs_received = 0;
+        uint32_t switched_in_at = 0;
+        ProcessStats* next = nullptr;
+    };
+
+    /**
+     * @brief Counters kept per channel. Transfers are counted on the reader side,
+     * writes on the writer side, whether the end is used directly or through an ALT.
+     */
+    struct ChannelStats {
+        const void* channel = nullptr;
+        uint32_t transfers = 0;
+        uint32_t writes = 0;
+        uint64_t in_wait_cycles = 0;
+        uint32_t in_wait_max = 0;
+        uint64_t out_wait_cycles = 0;
+        uint32_t out_wait_max = 0;
+        uint32_t high_water = 0;          // Buffered channels only
+        ChannelStats* next = nullptr;
+    };
+
+#if CSP4CMSIS_STATS
+
+    /**
+     * @brief Global lists of every live ProcessStats / ChannelStats.
+     * Entries link themselves in on construction; static SPN objects never leave.
+     */
+    class StatsRegistry {
+    public:
+        static void add(ProcessStats* s);
+        static void remove(ProcessStats* s);
+        static void add(ChannelStats* s);
+        static void remove(ChannelStats* s);
+
+        static ProcessStats* processes() { return process_head; }
+        static ChannelStats* channels() { return channel_head; }
+
+        // Stats of the CSProcess running on the calling task, or nullptr.
+        static ProcessStats* current();
+
+        // 64-bit cycle count at the last reset; the base for CPU share.
+        static uint64_t epoch() { return epoch_cycles; }
+        static void reset();
+
+    private:
+        static ProcessStats* process_head;
+        static ChannelStats* channel_head;
+        static uint64_t epoch_cycles;
+    };
+
+    /**
+     * @brief Registering holders, embedded in CSProcess and BaseAltChan.
+     */
+    struct ProcessStatsEntry : ProcessStats {
+        explicit ProcessStatsEntry(const CSProcess* p) { owner = p; StatsRegistry::add(this); }
+        ~ProcessStatsEntry() { StatsRegistry::remove(this); }
+        // Counters belong to one object: copies start empty, assignment keeps them.
+        ProcessStatsEntry(const ProcessStatsEntry&) = delete;
+        ProcessStatsEntry& operator=(const ProcessStatsEntry&) { return *this; }
+    };
+
+    struct ChannelStatsEntry : ChannelStats {
+        explicit ChannelStatsEntry(const void* c) { channel = c; StatsRegistry::add(this); }
+        ~ChannelStatsEntry() { StatsRegistry::remove(this); }
+        ChannelStatsEntry(const ChannelStatsEntry&) = delete;
+        ChannelStatsEntry& operator=(const ChannelStatsEntry&) { return *this; }
+    };
+
+    /**
+     * @brief Scoped timer around one channel operation.
+     * Charges the elapsed cycles to the channel and to the calling process.
+     */
+    class StatsProbe {
+    public:
+        enum Direction {
+            Input,  // Chanin read: one transfer, one message received
+            Output, // Chanout write: one message sent
+            Select  // ALT select: blocked time only, until a channel guard is bound
+        };
+
+        StatsProbe(ChannelStats* chan, Direction dir);
+        ~StatsProbe();
+
+        // Charges the operation to the channel end an ALT selected.
+        void bind(ChannelStats* c, Direction d) { chan = c; dir = d; }
+
+    private:
+        ChannelStats* chan;
+        Direction dir;
+        uint32_t start;
+    };
+
+    /**
+     * @brief Records the fill level of a buffered channel after a write.
+     */
+    inline void statsHighWater(ChannelStats* chan, uint32_t level) {
+        if (level > chan->high_water) chan->high_water = level;
+    }
+
+#endif // CSP4CMSIS_STATS
+
+} // namespace csp::internal
+
+namespace csp {
+
+    /**
+     * @brief Prints the process and channel tables over the console UART.
+     * Callable from any task. Without CSP4CMSIS_STATS it prints a one-line notice.
+     */
+    void PrintStats();
+
+    /**
+     * @brief Zeroes every counter and restarts the CPU-share epoch.
+     */
+    void ResetStats();
+
+} // namespace csp
+
+#endif // CSP4CMSIS_STATS_H
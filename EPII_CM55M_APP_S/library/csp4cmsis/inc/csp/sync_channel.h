@@ -3,9 +3,7 @@
 
 #include "channel_base.h"
 #include "alt.h"
-#include "FreeRTOS.h"
-#include "semphr.h"
-#include "queue.h"
+#include "os.h"
 
 namespace csp::internal {
 
@@ -20,7 +18,7 @@ namespace csp::internal {
     public:
         SyncChannelInputGuard(SyncChannel* chan) : channel(chan) {}
         void bind(void* dest, size_t size) { user_data_dest = dest; data_size = size; }
-        bool enable(AltScheduler* alt, EventBits_t bit) override; 
+        bool enable(AltScheduler* alt, os::Flags bit) override; 
         bool disable() override;
         void activate() override;
     };
@@ -34,7 +32,7 @@ namespace csp::internal {
     public:
         SyncChannelOutputGuard(SyncChannel* chan) : channel(chan) {}
         void bind(const void* src, size_t size) { user_data_source = src; data_size = size; }
-        bool enable(AltScheduler* alt, EventBits_t bit) override;
+        bool enable(AltScheduler* alt, os::Flags bit) override;
         bool disable() override;
         void activate() override;
     };
@@ -43,21 +41,22 @@ namespace csp::internal {
     public:
         enum State { IDLE, SENDER_WAITING, RECEIVER_WAITING };
     private:
-        SemaphoreHandle_t mutex;
+        os::Mutex mutex;
         State state;
         const void* data_ptr = nullptr;
         size_t data_len = 0;
         
         AltScheduler* waiting_alt_in = nullptr;
-        EventBits_t waiting_alt_bit_in = 0;
+        os::Flags waiting_alt_bit_in = 0;
         SyncChannelInputGuard* waiting_guard_in = nullptr; // ADDED
 
         AltScheduler* waiting_alt_out = nullptr;
-        EventBits_t waiting_alt_bit_out = 0;
+        os::Flags waiting_alt_bit_out = 0;
         SyncChannelOutputGuard* waiting_guard_out = nullptr; // ADDED
         
-        QueueHandle_t sender_queue; 
-        QueueHandle_t receiver_queue; 
+        // Binary hand-shake signals (count 1, initially empty)
+        os::Semaphore sender_queue; 
+        os::Semaphore receiver_queue; 
 
         SyncChannelInputGuard  res_in_guard;
         SyncChannelOutputGuard res_out_guard;
@@ -75,16 +74,16 @@ namespace csp::internal {
         void beginExtInput(void* const dest) override { input(dest); }
         void endExtInput() override {}
 
-        bool registerAltIn(AltScheduler* alt, EventBits_t bit, SyncChannelInputGuard* guard);
+        bool registerAltIn(AltScheduler* alt, os::Flags bit, SyncChannelInputGuard* guard);
         bool unregisterAltIn(AltScheduler* alt);
-        bool registerAltOut(AltScheduler* alt, EventBits_t bit, SyncChannelOutputGuard* guard);
+        bool registerAltOut(AltScheduler* alt, os::Flags bit, SyncChannelOutputGuard* guard);
         bool unregisterAltOut(AltScheduler* alt);
 
-        SemaphoreHandle_t getMutex() { return mutex; }
+        os::Mutex getMutex() { return mutex; }
         State getState() { return state; }
         const void* getDataPtr() { return data_ptr; }
-        QueueHandle_t getSenderQueue() { return sender_queue; }
-        QueueHandle_t getReceiverQueue() { return receiver_queue; }
+        os::Semaphore getSenderQueue() { return sender_queue; }
+        os::Semaphore getReceiverQueue() { return receiver_queue; }
         void setChannelData(const void* ptr, size_t len) { data_ptr = ptr; data_len = len; }
     };
 }
@@ -0,0 +1,129 @@
+// --- trace.h (Opt-In Channel Event Trace Recorder) ---
+#ifndef CSP4CMSIS_TRACE_H
+#define CSP4CMSIS_TRACE_H
+
+#include "csp_config.h"
+#include <stdint.h>
+#if CSP4CMSIS_TRACE
+#include <atomic>
+#endif
+
+namespace csp::internal {
+
+    /**
+     * @brief What a trace record marks. The numeric values are part of the
+     * dump format read by tools/csp_trace_to_chrome.py.
+     */
+    enum class TraceEvent : uint8_t {
+        Block = 0,      // The process is about to wait on a channel or ALT
+        Unblock = 1,    // ...and has been woken again
+        Handshake = 2,  // A channel operation completed without waiting
+        AltEnable = 3,  // An ALT guard was enabled (arg: guard index)
+        AltFire = 4     // An ALT selected a guard (arg: guard index)
+    };
+
+    /**
+     * @brief arg of Block, Unblock and Handshake records.
+     */
+    enum TraceOp : uint8_t {
+        TraceRead = 0,
+        TraceWrite = 1,
+        TraceAlt = 2
+    };
+
+    /**
+     * @brief One ring entry. Process and channel ids start at 1; 0 means a
+     * plain kernel thread, or a guard without a channel (timers), and
+     * TraceProcessIsr a record made in interrupt context.
+     */
+    struct TraceRecord {
+        uint32_t cycles;   // DWT CYCCNT, wraps every 2^32 cycles
+        uint16_t process;
+        uint16_t channel;
+        uint8_t event;     // TraceEvent
+        uint8_t arg;
+        uint16_t reserved;
+    };
+
+    static_assert(sizeof(TraceRecord) == 12, "trace dump format expects 12-byte records");
+
+    // Process id of records made from an ISR, whichever task it interrupted.
+    constexpr uint16_t TraceProcessIsr = 0xFFFF;
+
+#if CSP4CMSIS_TRACE
+
+    static_assert((CSP4CMSIS_TRACE_DEPTH & (CSP4CMSIS_TRACE_DEPTH - 1)) == 0,
+                  "CSP4CMSIS_TRACE_DEPTH must be a power of two");
+
+    enum class TraceKind { Process, Channel };
+
+    extern std::atomic<bool> trace_armed;
+
+    uint16_t traceNewId(TraceKind kind);
+    void traceNameProcess(uint16_t id, const char* name);
+    void traceWrite(TraceEvent event, uint16_t channel, uint8_t arg);
+
+    /**
+     * @brief Appends one record when tracing is armed. Lock-free: the slot is
+     * claimed with one atomic increment, so it is safe from any task or ISR
+     * (an ISR's records carry TraceProcessIsr).
+     */
+    inline void traceRecord(TraceEvent event, uint16_t channel, uint8_t arg) {
+        if (trace_armed.load(std::memory_order_relaxed)) traceWrite(event, channel, arg);
+    }
+
+    inline bool traceArmed() {
+        return trace_armed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Trace id holder, embedded in CSProcess and BaseAltChan.
+     * A copy is a different object and draws a fresh id.
+     */
+    template <TraceKind K>
+    struct TraceId {
+        uint16_t value = traceNewId(K);
+        TraceId() = default;
+        TraceId(const TraceId&) : value(traceNewId(K)) {}
+        TraceId& operator=(const TraceId&) { return *this; }
+    };
+
+#define CSP_TRACE(event, channel, arg) \
+    ::csp::internal::traceRecord(::csp::internal::TraceEvent::event, (channel), (arg))
+
+#else
+
+#define CSP_TRACE(event, channel, arg) ((void)0)
+
+#endif // CSP4CMSIS_TRACE
+
+} // namespace csp::internal
+
+namespace csp {
+
+    enum class TraceMode {
+        OneShot, // Stop recording when the ring is full: keeps the first records
+        Wrap     // Overwrite the oldest records: keeps the last records
+    };
+
+    /**
+     * @brief Empties the ring and starts recording, e.g. at the top of a frame.
+     */
+    void TraceStart(TraceMode mode = TraceMode::OneShot);
+
+    /**
+     * @brief Stops recording. Records already claimed by a running operation
+     * may still land; dump once the traced processes have gone quiet.
+     */
+    void TraceStop();
+
+    /**
+     * @brief Stops recording and prints the ring over the console UART as
+     * "trace," lines, oldest first, for tools/csp_trace_to_chrome.py.
+     * Without CSP4CMSIS_TRACE it prints a one-line notice.
+     */
+    void TraceDump();
+
+} // namespace csp
+
+#endif // CSP4CMSIS_TRACE_H
@@ -0,0 +1,120 @@
+// --- xcore.h (Cross-Core Channel Transport: CM55 Big <-> CM55 Little) ---
+#ifndef CSP4CMSIS_XCORE_H
+#define CSP4CMSIS_XCORE_H
+
+#include "csp_config.h"
+#include "os.h"
+#include <stddef.h>
+#include <stdint.h>
+
+static_assert(CSP4CMSIS_XCORE_MAX_CHANNELS <= 24,
+              "one event-flag bit per cross-core channel: FreeRTOS event groups hold 24");
+static_assert(CSP4CMSIS_XCORE_DOORBELL_SHIFT + CSP4CMSIS_XCORE_MAX_CHANNELS <= 31,
+              "cross-core doorbells must fit the mailbox interrupt status word");
+static_assert(CSP4CMSIS_XCORE_SLOT_BYTES % 32 == 0,
+              "cross-core slots must start on a data cache line");
+
+namespace csp {
+
+    /**
+     * @brief What a cross-core channel needs from the hardware.
+     *
+     * Both cores see one shared segment of CSP4CMSIS_XCORE_MAX_CHANNELS
+     * slots of CSP4CMSIS_XCORE_SLOT_BYTES each, at the same address or not.
+     * signal() raises a doorbell interrupt on the other core, whose handler
+     * passes the channel mask on to xcore::deliver(). clean() and
+     * invalidate() keep the data cache coherent with the other core; each is
+     * called on whole 32-byte lines only.
+     *
+     * MailboxTransport (hxmb mailbox, CSP4CMSIS_XCORE_MAILBOX) is the WE2
+     * implementation. The host build forks a second process instead
+     * (xcore::hostForkCores()).
+     */
+    class XcoreTransport {
+    public:
+        virtual ~XcoreTransport() = default;
+
+        virtual void* segment() = 0;
+        virtual void signal(uint32_t channel_mask) = 0;
+        virtual void clean(const void* addr, size_t bytes) { (void)addr; (void)bytes; }
+        virtual void invalidate(const void* addr, size_t bytes) { (void)addr; (void)bytes; }
+    };
+
+} // namespace csp
+
+namespace csp::xcore {
+
+    /**
+     * @brief Installs the transport on this core. Call once per core, before
+     * the scheduler starts and before the other core uses a channel.
+     * @param owner True on exactly one core (the one that boots first, i.e.
+     *        the CM55 Big): it zeroes the shared segment.
+     */
+    void attach(XcoreTransport* transport, bool owner);
+
+    /**
+     * @brief Called by the transport when the other core rang doorbells:
+     * wakes the processes waiting on those channels. ISR-safe.
+     * @param channel_mask Bit n set for channel id n.
+     */
+    void deliver(uint32_t channel_mask);
+
+#if CSP4CMSIS_XCORE_MAILBOX && !defined(CSP4CMSIS_HOST)
+    /**
+     * @brief Attaches the hxmb mailbox transport (doorbells 1 << (SHIFT + id),
+     * shared segment at CSP4CMSIS_XCORE_SHM_BASE). The CM55 Big owns the
+     * segment. It takes over this core's mailbox callback: an app that also
+     * uses the hxmb library passes its own callback here, instead of
+     * registering it, and receives every interrupt bit below the doorbells.
+     * Call after hx_drv_mb_init() (platform_driver_init() on the big core).
+     */
+    void attachMailbox(void (*forward)(uint32_t event) = nullptr);
+#endif
+
+#if defined(CSP4CMSIS_HOST)
+    /**
+     * @brief Host stand-in for the second core: forks the process after
+     * mapping an anonymous shared segment, and connects both halves with a
+     * pipe per direction that plays the mailbox interrupt. Call from
+     * csp_app_main_init() before any task is created; both processes then
+     * attach the transport and carry on.
+     * @return True in the child, which plays the CM55 Little.
+     */
+    bool hostForkCores();
+#endif
+
+} // namespace csp::xcore
+
+namespace csp::internal {
+
+    class AltScheduler;
+
+    // CM55 data cache line. Every field written by one core, and every
+    // message slot, starts on its own line.
+    const size_t XCORE_CACHE_LINE = 32;
+
+    /**
+     * @brief Start of a channel slot in the shared segment: the SPSC ring
+     * indices, followed by the message entries.
+     */
+    struct XcoreRing {
+        uint32_t head;                                  // Messages published (writer core only)
+        uint8_t head_line[XCORE_CACHE_LINE - sizeof(uint32_t)];
+        uint32_t tail;                                  // Messages consumed (reader core only)
+        uint8_t tail_line[XCORE_CACHE_LINE - sizeof(uint32_t)];
+    };
+
+    XcoreRing* xcoreRing(uint32_t id);
+    XcoreTransport* xcoreTransport();
+
+    // Waits for the doorbell of channel 'id'; may return early, callers re-check.
+    void xcoreWait(uint32_t id);
+    void xcoreSignal(uint32_t id);
+
+    // ALT registration of the local end of channel 'id'.
+    void xcoreRegisterAlt(uint32_t id, AltScheduler* alt, os::Flags bit);
+    void xcoreUnregisterAlt(uint32_t id);
+
+} // namespace csp::internal
+
+#endif // CSP4CMSIS_XCORE_H
@@ -0,0 +1,276 @@
+// --- xcore_channel.h (Cross-Core Rendezvous and Buffered Channels) ---
+#ifndef CSP4CMSIS_XCORE_CHANNEL_H
+#define CSP4CMSIS_XCORE_CHANNEL_H
+
+#include "xcore.h"
+#include "channel_base.h"
+#include "alt.h"
+#include "footprint.h"
+#include "public_channel.h"
+#include <cstring>
+#include <type_traits>
+
+namespace csp::internal {
+
+    template <typename T, size_t N, bool RENDEZVOUS> class XcoreInputGuard;
+    template <typename T, size_t N, bool RENDEZVOUS> class XcoreOutputGuard;
+
+    /**
+     * @brief One end of a single-producer/single-consumer ring in the shared
+     * slot of channel 'id'; the other end lives in the other core's image.
+     *
+     * The writer core owns 'head', the reader core owns 'tail'; both are free
+     * running and each sits on its own cache line, so neither core ever
+     * writes back a line the other one wrote. A message is copied into its
+     * line-aligned entry and cleaned before 'head' is published, and each
+     * side rings the other's doorbell after moving its index.
+     *
+     * RENDEZVOUS: output() also waits until the reader has taken the message
+     * (tail caught up), which gives the synchronisation of One2OneChannel.
+     */
+    template <typename T, size_t N, bool RENDEZVOUS>
+    class XcoreChannel : public BaseAltChan<T>
+    {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "cross-core messages are copied bytewise into shared memory");
+        static_assert(N > 0, "cross-core channel needs at least one entry");
+
+    public:
+        static const size_t STRIDE = (sizeof(T) + XCORE_CACHE_LINE - 1) / XCORE_CACHE_LINE * XCORE_CACHE_LINE;
+        static_assert(sizeof(XcoreRing) + N * STRIDE <= CSP4CMSIS_XCORE_SLOT_BYTES,
+                      "message entries exceed CSP4CMSIS_XCORE_SLOT_BYTES");
+
+    private:
+        const uint32_t id;
+
+        XcoreInputGuard<T, N, RENDEZVOUS>  res_in_guard;
+        XcoreOutputGuard<T, N, RENDEZVOUS> res_out_guard;
+
+        uint8_t* entry(XcoreRing* ring, uint32_t index) {
+            return reinterpret_cast<uint8_t*>(ring + 1) + (index % N) * STRIDE;
+        }
+
+        // The other core's index: drop our stale copy of its line first.
+        static uint32_t loadHead(XcoreRing* ring) {
+            xcoreTransport()->invalidate(&ring->head, XCORE_CACHE_LINE);
+            return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        }
+        static uint32_t loadTail(XcoreRing* ring) {
+            xcoreTransport()->invalidate(&ring->tail, XCORE_CACHE_LINE);
+            return __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        }
+
+        void publishHead(XcoreRing* ring, uint32_t head) {
+            __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+            xcoreTransport()->clean(&ring->head, XCORE_CACHE_LINE);
+            xcoreSignal(id);
+        }
+        void publishTail(XcoreRing* ring, uint32_t tail) {
+            __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+            xcoreTransport()->clean(&ring->tail, XCORE_CACHE_LINE);
+            xcoreSignal(id);
+        }
+
+    public:
+        explicit XcoreChannel(uint32_t channel_id)
+            : id(channel_id), res_in_guard(this), res_out_guard(this)
+        {
+#if CSP4CMSIS_TRACE
+            res_in_guard.trace_channel = this->traceId();
+            res_out_guard.trace_channel = this->traceId();
+#endif
+#if CSP4CMSIS_STATS
+            res_in_guard.stats_channel = this->stats();
+            res_in_guard.stats_dir = StatsProbe::Input;
+            res_out_guard.stats_channel = this->stats();
+            res_out_guard.stats_dir = StatsProbe::Output;
+#endif
+            // The ring lives in the shared segment, not on the kernel heap.
+            internal::footprintChannel(+1, sizeof(*this), 0);
+        }
+
+        ~XcoreChannel() override { internal::footprintChannel(-1, sizeof(*this), 0); }
+
+        // --- Reader side ---
+        bool pending() override {
+            XcoreRing* ring = xcoreRing(id);
+            return loadHead(ring) != ring->tail;
+        }
+
+        // Copies the oldest message out; the caller has seen pending().
+        void take(T* const dest) {
+            XcoreRing* ring = xcoreRing(id);
+            const uint32_t tail = ring->tail;
+            uint8_t* e = entry(ring, tail);
+            xcoreTransport()->invalidate(e, STRIDE);
+            memcpy(dest, e, sizeof(T));
+            publishTail(ring, tail + 1);
+        }
+
+        // --- Writer side ---
+        bool space_available() {
+            XcoreRing* ring = xcoreRing(id);
+            return ring->head - loadTail(ring) < N;
+        }
+
+        // Copies 'source' into the next entry; the caller has seen space_available().
+        // Returns the tail value that acknowledges this message.
+        uint32_t put(const T* const source) {
+            XcoreRing* ring = xcoreRing(id);
+            const uint32_t head = ring->head;
+            uint8_t* e = entry(ring, head);
+            memcpy(e, source, sizeof(T));
+            xcoreTransport()->clean(e, STRIDE);
+#if CSP4CMSIS_STATS
+            statsHighWater(this->stats(), head + 1 - loadTail(ring));
+#endif
+            publishHead(ring, head + 1);
+            return head + 1;
+        }
+
+        // Rendezvous completion: blocks until the reader took message 'ack'-1.
+        void awaitTaken(uint32_t ack) {
+            XcoreRing* ring = xcoreRing(id);
+            while ((int32_t)(loadTail(ring) - ack) < 0) xcoreWait(id);
+        }
+
+        // --- Core I/O ---
+        void input(T* const dest) override {
+#if CSP4CMSIS_TRACE
+            const bool waits = traceArmed() && !pending();
+            if (waits) CSP_TRACE(Block, this->traceId(), TraceRead);
+#endif
+            while (!pending()) xcoreWait(id);
+            take(dest);
+#if CSP4CMSIS_TRACE
+            if (waits) CSP_TRACE(Unblock, this->traceId(), TraceRead);
+            else CSP_TRACE(Handshake, this->traceId(), TraceRead);
+#endif
+        }
+
+        void output(const T* const source) override {
+#if CSP4CMSIS_TRACE
+            const bool waits = traceArmed() && (RENDEZVOUS || !space_available());
+            if (waits) CSP_TRACE(Block, this->traceId(), TraceWrite);
+#endif
+            while (!space_available()) xcoreWait(id);
+            const uint32_t ack = put(source);
+            if (RENDEZVOUS) awaitTaken(ack);
+#if CSP4CMSIS_TRACE
+            if (waits) CSP_TRACE(Unblock, this->traceId(), TraceWrite);
+            else CSP_TRACE(Handshake, this->traceId(), TraceWrite);
+#endif
+        }
+
+        void beginExtInput(T* const dest) override { this->input(dest); }
+        void endExtInput() override { }
+
+        Guard* getInputGuard(T& dest) override {
+            res_in_guard.setTarget(&dest);
+            return &res_in_guard;
+        }
+
+        Guard* getOutputGuard(const T& source) override {
+            res_out_guard.setTarget(&source);
+            return &res_out_guard;
+        }
+
+        // Only one end of a channel lives on each core, so one ALT slot per id.
+        void registerAlt(AltScheduler* alt, os::Flags b) { xcoreRegisterAlt(id, alt, b); }
+        void unregisterAlt() { xcoreUnregisterAlt(id); }
+    };
+
+    // =============================================================
+    // Guards
+    // Registration comes before the readiness check: a doorbell that
+    // arrives in between still reaches the ALT. The ALT disables every
+    // guard afterwards, enabled-and-ready ones included.
+    // =============================================================
+    template <typename T, size_t N, bool RENDEZVOUS>
+    class XcoreInputGuard : public Guard {
+    private:
+        XcoreChannel<T, N, RENDEZVOUS>* channel;
+        T* dest_ptr = nullptr;
+    public:
+        XcoreInputGuard(XcoreChannel<T, N, RENDEZVOUS>* chan) : channel(chan) {}
+        void setTarget(T* dest) { dest_ptr = dest; }
+
+        bool enable(AltScheduler* alt, os::Flags bit) override {
+            channel->registerAlt(alt, bit);
+            return channel->pending();
+        }
+        bool disable() override {
+            channel->unregisterAlt();
+            return channel->pending();
+        }
+        void activate() override {
+            channel->take(dest_ptr);
+        }
+    };
+
+    /**
+     * On a rendezvous channel the output guard is ready when the ring has
+     * room, not when the reader is waiting (the other core cannot be asked);
+     * activate() then blocks until the reader takes the message.
+     */
+    template <typename T, size_t N, bool RENDEZVOUS>
+    class XcoreOutputGuard : public Guard {
+    private:
+        XcoreChannel<T, N, RENDEZVOUS>* channel;
+        const T* source_ptr = nullptr;
+    public:
+        XcoreOutputGuard(XcoreChannel<T, N, RENDEZVOUS>* chan) : channel(chan) {}
+        void setTarget(const T* source) { source_ptr = source; }
+
+        bool enable(AltScheduler* alt, os::Flags bit) override {
+            channel->registerAlt(alt, bit);
+            return channel->space_available();
+        }
+        bool disable() override {
+            channel->unregisterAlt();
+            return channel->space_available();
+        }
+        void activate() override {
+            const uint32_t ack = channel->put(source_ptr);
+            if (RENDEZVOUS) channel->awaitTaken(ack);
+        }
+    };
+
+} // namespace csp::internal
+
+namespace csp {
+
+/**
+ * @brief Rendezvous channel to or from the other CM55 core.
+ * Declare it with the same id in both images; use only reader() on one core
+ * and only writer() on the other. Requires xcore::attach() on both cores.
+ */
+template <typename T>
+class XcoreOne2OneChannel {
+private:
+    internal::XcoreChannel<T, 1, true> internal_chan;
+public:
+    explicit XcoreOne2OneChannel(uint32_t id) : internal_chan(id) {}
+
+    Chanout<T> writer() { return Chanout<T>(&internal_chan); }
+    Chanin<T> reader() { return Chanin<T>(&internal_chan); }
+};
+
+/**
+ * @brief Buffered channel to or from the other CM55 core, holding up to SIZE
+ * messages in its shared slot. Same rules as XcoreOne2OneChannel.
+ */
+template <typename T, size_t SIZE>
+class XcoreBufferedOne2OneChannel {
+private:
+    internal::XcoreChannel<T, SIZE, false> internal_chan;
+public:
+    explicit XcoreBufferedOne2OneChannel(uint32_t id) : internal_chan(id) {}
+
+    Chanout<T> writer() { return Chanout<T>(&internal_chan); }
+    Chanin<T> reader() { return Chanin<T>(&internal_chan); }
+};
+
+} // namespace csp
+
+#endif // CSP4CMSIS_XCORE_CHANNEL_H
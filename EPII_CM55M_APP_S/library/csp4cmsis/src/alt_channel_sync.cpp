@@ -8,11 +8,11 @@ AltChanSyncBase::AltChanSyncBase() :
     mutex(nullptr), waiting_in_task(nullptr), waiting_out_task(nullptr),
     non_alt_in_data_ptr(nullptr), non_alt_out_data_ptr(nullptr) 
 {
-    mutex = xSemaphoreCreateMutex();
+    mutex = os::mutexCreateStatic(&mutex_block);
 }
 
 AltChanSyncBase::~AltChanSyncBase() {
-    if (mutex != nullptr) vSemaphoreDelete(mutex);
+    if (mutex != nullptr) os::mutexDelete(mutex);
 }
 
 bool AltChanSyncBase::tryHandshake(void* data_ptr, size_t size, bool is_writer) {
@@ -20,9 +20,9 @@ bool AltChanSyncBase::tryHandshake(void* data_ptr, size_t size, bool is_writer)
         // 1. Check for a standard blocking receiver
         if (waiting_in_task != nullptr) {
             if (non_alt_in_data_ptr && data_ptr) memcpy(non_alt_in_data_ptr, data_ptr, size);
-            TaskHandle_t t = waiting_in_task;
+            os::ThreadId t = waiting_in_task;
             clearWaitingIn();
-            xTaskNotifyGive(t);
+            os::notify(t);
             return true; 
         }
         // 2. Check for a receiver waiting in an ALT
@@ -35,9 +35,9 @@ bool AltChanSyncBase::tryHandshake(void* data_ptr, size_t size, bool is_writer)
         // 1. Check for a standard blocking sender
         if (waiting_out_task != nullptr) {
             if (data_ptr && non_alt_out_data_ptr) memcpy(data_ptr, non_alt_out_data_ptr, size);
-            TaskHandle_t t = waiting_out_task;
+            os::ThreadId t = waiting_out_task;
             clearWaitingOut();
-            xTaskNotifyGive(t);
+            os::notify(t);
             return true;
         }
         // 2. Check for a sender waiting in an ALT
@@ -51,90 +51,91 @@ bool AltChanSyncBase::tryHandshake(void* data_ptr, size_t size, bool is_writer)
 
 void AltChanSyncBase::registerWaitingTask(void* data_ptr, bool is_writer) {
     if (is_writer) {
-        waiting_out_task = xTaskGetCurrentTaskHandle();
+        waiting_out_task = os::self();
         non_alt_out_data_ptr = data_ptr;
     } else {
-        waiting_in_task = xTaskGetCurrentTaskHandle();
+        waiting_in_task = os::self();
         non_alt_in_data_ptr = data_ptr;
     }
 }
 
 // --- ChanInGuard Implementation ---
-bool ChanInGuard::enable(AltScheduler* alt, EventBits_t bit) {
-    if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return false;
+bool ChanInGuard::enable(AltScheduler* alt, os::Flags bit) {
+    if (!os::mutexLock(parent_channel->getMutex())) return false;
 
     // Check if a sender is already waiting (Standard output() call)
     if (parent_channel->getWaitingOutTask() != nullptr) {
-        xSemaphoreGive(parent_channel->getMutex());
+        os::mutexUnlock(parent_channel->getMutex());
         return true; 
     }
 
     // Register our AltScheduler for wake-up
     parent_channel->getWaitingInAlt().set(alt, bit, user_data_dest, data_size);
     
-    xSemaphoreGive(parent_channel->getMutex());
+    os::mutexUnlock(parent_channel->getMutex());
     return false;
 }
 
 void ChanInGuard::activate() {
-    if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return;
+    if (!os::mutexLock(parent_channel->getMutex())) return;
     
-    TaskHandle_t sender = parent_channel->getWaitingOutTask();
+    os::ThreadId sender = parent_channel->getWaitingOutTask();
     if (sender != nullptr) {
         if (user_data_dest && parent_channel->getNonAltOutDataPtr()) 
             memcpy(user_data_dest, parent_channel->getNonAltOutDataPtr(), data_size);
         parent_channel->clearWaitingOut();
-        xSemaphoreGive(parent_channel->getMutex());
-        xTaskNotifyGive(sender);
+        os::mutexUnlock(parent_channel->getMutex());
+        os::notify(sender);
     } else {
         // Data was already copied during tryHandshake in output()
-        xSemaphoreGive(parent_channel->getMutex());
+        os::mutexUnlock(parent_channel->getMutex());
     }
 }
 
 bool ChanInGuard::disable() {
-    if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return false;
+    if (!os::mutexLock(parent_channel->getMutex())) return false;
     bool was_ready = (parent_channel->getWaitingOutTask() != nullptr);
     parent_channel->getWaitingInAlt().clear();
-    xSemaphoreGive(parent_channel->getMutex());
+    os::mutexUnlock(parent_channel->getMutex());
     return was_ready;
 }
 
 // --- ChanOutGuard Implementation ---
-bool ChanOutGuard::enable(AltScheduler* alt, EventBits_t bit) {
-    if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return false;
+bool ChanOutGuard::enable(AltScheduler* alt, os::Flags bit) {
+    if (!os::mutexLock(parent_channel->getMutex())) return false;
 
     if (parent_channel->getWaitingInTask() != nullptr) {
-        xSemaphoreGive(parent_channel->getMutex());
+        os::mutexUnlock(parent_channel->getMutex());
         return true;
     }
 
     parent_channel->getWaitingOutAlt().set(alt, bit, const_cast<void*>(user_data_source), data_size);
     
-    xSemaphoreGive(parent_channel->getMutex());
+    os::mutexUnlock(parent_channel->getMutex());
     return false;
 }
 
 void ChanOutGuard::activate() {
-    if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return;
+    if (!os::mutexLock(parent_channel->getMutex())) return;
     
-    TaskHandle_t receiver = parent_channel->getWaitingInTask();
+    os::ThreadId receiver = parent_channel->getWaitingInTask();
     if (receiver != nullptr) {
         if (parent_channel->getNonAltInDataPtr() && user_data_source)
             memcpy(parent_channel->getNonAltInDataPtr(), user_data_source, data_size);
         parent_channel->clearWaitingIn();
-        xSemaphoreGive(parent_channel->getMutex());
-        xTaskNotifyGive(receiver);
+        os::mutexUnlock(parent_channel->getMutex());
+        os::notify(receiver);
+        handOff(receiver);
     } else {
-        xSemaphoreGive(parent_channel->getMutex());
+        os::mutexUnlock(parent_channel->getMutex());
     }
 }
 
 bool ChanOutGuard::disable() {
-    if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return false;
+    if (!os::mutexLock(parent_channel->getMutex())) return false;
     bool was_ready = (parent_channel->getWaitingInTask() != nullptr);
     parent_channel->getWaitingOutAlt().clear();
-    xSemaphoreGive(parent_channel->getMutex());
+    os::mutexUnlock(parent_channel->getMutex());
     return was_ready;
 }
 
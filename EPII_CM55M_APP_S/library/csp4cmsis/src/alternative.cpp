@@ -1,4 +1,5 @@
 #include "alt.h"
+#include "stats.h"
 #include <cstdio>
 
 namespace csp::internal {
@@ -11,47 +12,45 @@ AltScheduler::AltScheduler() {
 }
 
 AltScheduler::~AltScheduler() { 
-    if (event_group) vEventGroupDelete(event_group); 
+    if (event_group) os::flagsDelete(event_group); 
 }
 
 void AltScheduler::initForCurrentTask() {
-    waiting_task_handle = xTaskGetCurrentTaskHandle();
-    // Using standard FreeRTOS event group creation
-    event_group = xEventGroupCreate();
+    waiting_task_handle = os::self();
+    event_group = os::flagsCreateStatic(&event_block);
 }
 
 unsigned int AltScheduler::select(Guard** guardArray, size_t amount, size_t offset) {
     if (amount == 0) return 0;
 
-    const char* tname = pcTaskGetName(NULL);
-    // printf("[%s] ALT: select start (guards: %u, offset: %u)\r\n", tname, amount, offset);
-
-    EventBits_t wait_mask = 0;
+#if CSP4CMSIS_STATS
+    StatsProbe probe(nullptr, StatsProbe::Select);
+#endif
+    os::Flags wait_mask = 0;
     for(size_t i = 0; i < amount; ++i) wait_mask |= (1 << i);
     
-    xEventGroupClearBits(event_group, wait_mask); 
+    os::flagsClear(event_group, wait_mask); 
 
     int ready_idx = -1;
     // Phase 1: Enable
     for(size_t i = 0; i < amount; ++i) {
         size_t idx = (i + offset) % amount; 
-        // printf("[%s] ALT: Enabling guard %u...\r\n", tname, idx);
+        CSP_TRACE(AltEnable, guardArray[idx]->trace_channel, (uint8_t)idx);
         
         if(guardArray[idx]->enable(this, (1 << idx))) { 
-            // printf("[%s] ALT: Guard %u was ALREADY ready.\r\n", tname, idx);
             ready_idx = (int)idx; 
             break; 
         }
     }
 
     // Phase 2: Wait
-    EventBits_t fired = 0;
+    os::Flags fired = 0;
     if (ready_idx != -1) {
         fired = (1 << ready_idx);
     } else {
-        // printf("[%s] ALT: No guard ready. Sleeping on event group...\r\n", tname);
-        fired = xEventGroupWaitBits(event_group, wait_mask, pdTRUE, pdFALSE, portMAX_DELAY);
-        // printf("[%s] ALT: Woke up! Fired bits: 0x%lx\r\n", tname, fired);
+        CSP_TRACE(Block, 0, TraceAlt);
+        fired = os::flagsWaitAny(event_group, wait_mask);
+        CSP_TRACE(Unblock, 0, TraceAlt);
     }
 
     // Identify which guard fired
@@ -64,28 +63,23 @@ unsigned int AltScheduler::select(Guard** guardArray, size_t amount, size_t offs
     }
 
     // Phase 3: Disable
-    // printf("[%s] ALT: Disabling all guards.\r\n", tname);
     for(size_t i = 0; i < amount; ++i) {
         guardArray[i]->disable();
     }
 
     // Phase 4: Activate
-    // printf("[%s] ALT: Activating guard %u.\r\n", tname, selected);
+    CSP_TRACE(AltFire, guardArray[selected]->trace_channel, (uint8_t)selected);
     guardArray[selected]->activate();
+#if CSP4CMSIS_STATS
+    probe.bind(guardArray[selected]->stats_channel, guardArray[selected]->stats_dir);
+#endif
     
     return (unsigned int)selected;
 }
 
-void AltScheduler::wakeUp(EventBits_t bit) {
+void AltScheduler::wakeUp(os::Flags bit) {
     if(!event_group) return;
-    // printf("[%s] ALT: wakeUp called for bit 0x%lx\r\n", pcTaskGetName(NULL), bit);
-    if (xPortIsInsideInterrupt()) {
-        BaseType_t woken = pdFALSE;
-        xEventGroupSetBitsFromISR(event_group, bit, &woken);
-        portYIELD_FROM_ISR(woken);
-    } else {
-        xEventGroupSetBits(event_group, bit);
-    }
+    os::flagsSet(event_group, bit); // ISR-safe
 }
 // =============================================================
 // TimerGuard Implementation
@@ -93,29 +87,29 @@ void AltScheduler::wakeUp(EventBits_t bit) {
 TimerGuard::TimerGuard(csp::Time delay) 
     : parent_alt(nullptr), delay_ticks(delay.to_ticks()), assigned_bit(0) 
 {
-    timer_handle = xTimerCreate("CspTmr", delay_ticks, pdFALSE, this, TimerCallback);
+    timer_handle = os::timerCreate<&TimerGuard::TimerCallback>(this);
 }
 
 TimerGuard::~TimerGuard() { 
-    if (timer_handle) xTimerDelete(timer_handle, 0); 
+    if (timer_handle) os::timerDelete(timer_handle); 
 }
 
-void TimerGuard::TimerCallback(TimerHandle_t x) {
-    auto* s = static_cast<TimerGuard*>(pvTimerGetTimerID(x));
+void TimerGuard::TimerCallback(void* arg) {
+    auto* s = static_cast<TimerGuard*>(arg);
     if(s && s->parent_alt) {
         s->parent_alt->wakeUp(s->assigned_bit);
     }
 }
 
-bool TimerGuard::enable(AltScheduler* a, EventBits_t b) {
+bool TimerGuard::enable(AltScheduler* a, os::Flags b) {
     parent_alt = a; 
     assigned_bit = b;
-    xTimerStart(timer_handle, 0);
+    os::timerStart(timer_handle, delay_ticks);
     return false; 
 }
 
 bool TimerGuard::disable() { 
-    if (timer_handle) xTimerStop(timer_handle, 0); 
+    if (timer_handle) os::timerStop(timer_handle); 
     return true; 
 }
 
@@ -143,6 +137,13 @@ Alternative::Alternative(std::initializer_list<Guard*> list) {
     }
 }
 
+Alternative::Alternative(internal::Guard* const* guard_array, size_t count) {
+    num_guards = 0;
+    for (size_t i = 0; i < count && num_guards < MAX_GUARDS; ++i) {
+        internal_guards[num_guards++] = guard_array[i];
+    }
+}
+
 int Alternative::priSelect() {
     return (int)internal_alt.select(internal_guards, num_guards);
 }
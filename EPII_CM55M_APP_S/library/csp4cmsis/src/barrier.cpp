@@ -1,8 +1,6 @@
 // --- barrier.cpp ---
 
 #include "barrier.h" // Barrier definition
-#include "FreeRTOS.h"
-#include "semphr.h"
 #include <cstdio>
 
 namespace csp::internal {
@@ -20,13 +18,14 @@ Barrier::Barrier(size_t N)
     : max_processes(N), count(0)
 {
     // Create the Mutex to protect the shared counter
-    xCountMutex = xSemaphoreCreateMutex();
+    xCountMutex = os::mutexCreate();
     
     // Create the Semaphore used for blocking and release.
     // Initial count is 0 (all tasks block). Max count is N (allows N tasks to be released).
-    xWaitSemaphore = xSemaphoreCreateCounting(N, 0); 
+    xWaitSemaphore = os::semCreate(N, 0); 
+    xLeaveSemaphore = os::semCreate(N, 0);
 
-    if (xCountMutex == nullptr || xWaitSemaphore == nullptr) {
+    if (xCountMutex == nullptr || xWaitSemaphore == nullptr || xLeaveSemaphore == nullptr) {
         printf("ERROR: Barrier synchronization object creation failed!\r\n");
     }
 }
@@ -34,49 +33,44 @@ Barrier::Barrier(size_t N)
 Barrier::~Barrier() {
     // 1. Check and delete the counting semaphore used for blocking/releasing
     if (xWaitSemaphore) { 
-        vSemaphoreDelete(xWaitSemaphore);
+        os::semDelete(xWaitSemaphore);
+    }
+    if (xLeaveSemaphore) {
+        os::semDelete(xLeaveSemaphore);
     }
     // 2. Check and delete the mutex used for protecting the count variable
     if (xCountMutex) { 
-        vSemaphoreDelete(xCountMutex);
+        os::mutexDelete(xCountMutex);
     }
 }
 
 /**
  * @brief Blocks the calling task until all N processes have reached the barrier.
+ *
+ * Two turnstiles make the barrier reusable: a process released from one phase
+ * cannot arrive at the next (and take a token meant for a slower process of
+ * this phase) until every process has left the current one.
  */
 void Barrier::sync() {
-    // 1. Acquire the mutex to safely update the count
-    xSemaphoreTake(xCountMutex, portMAX_DELAY);
-    
-    // Increment the arrival count
-    count++;
-    
-    bool last_arrival = (count == max_processes);
-    
-    // Release the mutex
-    xSemaphoreGive(xCountMutex);
-    
-    if (last_arrival) {
-        // Last one in: Release all waiting tasks and reset the barrier.
-        
-        // Release N tasks
+    // 1. Arrival: the last process in opens the first turnstile for all N.
+    os::mutexLock(xCountMutex);
+    if (++count == max_processes) {
+        for (size_t i = 0; i < max_processes; ++i) {
+            os::semGive(xWaitSemaphore);
+        }
+    }
+    os::mutexUnlock(xCountMutex);
+    os::semTake(xWaitSemaphore);
+
+    // 2. Departure: the last process out opens the second turnstile for all N.
+    os::mutexLock(xCountMutex);
+    if (--count == 0) {
         for (size_t i = 0; i < max_processes; ++i) {
-            // Give the semaphore N times to unblock all tasks blocked on xSemaphoreTake
-            xSemaphoreGive(xWaitSemaphore); 
+            os::semGive(xLeaveSemaphore);
         }
-        
-        // Reset the counter for the next phase
-        // NOTE: No mutex needed here as no other task is competing for the count yet.
-        count = 0; 
-        
-    } else {
-        // Not the last one in: Block and wait for the last arrival to release us.
-        
-        // Block until the xWaitSemaphore is available (given by the last arrival).
-        // portMAX_DELAY ensures we wait indefinitely.
-        xSemaphoreTake(xWaitSemaphore, portMAX_DELAY); 
     }
+    os::mutexUnlock(xCountMutex);
+    os::semTake(xLeaveSemaphore);
 }
 
 // Add the default destructor implementation if necessary to make the class concrete
@@ -0,0 +1,76 @@
+// --- bench.cpp (Micro-Benchmark Sampling and Machine-Readable Reports) ---
+#include "bench.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace csp::bench {
+
+#if CSP4CMSIS_OS_RTOS2
+static const char* const KERNEL_NAME = "CMSIS-RTOS2 (RTX5)";
+#elif defined(CSP4CMSIS_HOST)
+static const char* const KERNEL_NAME = "FreeRTOS API (host)";
+#else
+static const char* const KERNEL_NAME = "FreeRTOS";
+#endif
+
+static const bool EMIT_CSV  = CSP4CMSIS_BENCH_FORMAT != 1;
+static const bool EMIT_JSON = CSP4CMSIS_BENCH_FORMAT != 0;
+
+Summary Samples::summarize() {
+    Summary s = {};
+    s.samples = (uint32_t)count;
+    if (count == 0) return s;
+
+    std::sort(data, data + count);
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < count; ++i) total += data[i];
+
+    // Nearest-rank percentiles.
+    s.min = data[0];
+    s.median = data[(count - 1) / 2];
+    s.p99 = data[(count * 99 + 99) / 100 - 1];
+    s.max = data[count - 1];
+    s.mean = (uint32_t)(total / count);
+    return s;
+}
+
+void printHeader(const char* suite) {
+    internal::cycleCounterInit();
+
+    printf("--- %s ---\r\n", suite);
+    printf("Kernel: %s, core clock %lu Hz, hand-off %s, stats %s\r\n",
+           KERNEL_NAME, (unsigned long)internal::cycleFrequency(),
+           CSP4CMSIS_RENDEZVOUS_HANDOFF ? "ON" : "OFF", CSP4CMSIS_STATS ? "ON" : "OFF");
+
+    if (EMIT_CSV) {
+        printf("csv,bench,variant,param,samples,min,median,p99,max,mean\r\n");
+    }
+    if (EMIT_JSON) {
+        printf("{\"suite\":\"%s\",\"kernel\":\"%s\",\"core_hz\":%lu,\"handoff\":%d,\"stats\":%d,\"unit\":\"cycles\"}\r\n",
+               suite, KERNEL_NAME, (unsigned long)internal::cycleFrequency(),
+               CSP4CMSIS_RENDEZVOUS_HANDOFF, CSP4CMSIS_STATS);
+    }
+}
+
+void report(const char* bench, const char* variant, uint32_t param, const Summary& s) {
+    if (EMIT_CSV) {
+        printf("csv,%s,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu\r\n",
+               bench, variant, (unsigned long)param, (unsigned long)s.samples,
+               (unsigned long)s.min, (unsigned long)s.median, (unsigned long)s.p99,
+               (unsigned long)s.max, (unsigned long)s.mean);
+    }
+    if (EMIT_JSON) {
+        printf("{\"bench\":\"%s\",\"variant\":\"%s\",\"param\":%lu,\"samples\":%lu,"
+               "\"min\":%lu,\"median\":%lu,\"p99\":%lu,\"max\":%lu,\"mean\":%lu}\r\n",
+               bench, variant, (unsigned long)param, (unsigned long)s.samples,
+               (unsigned long)s.min, (unsigned long)s.median, (unsigned long)s.p99,
+               (unsigned long)s.max, (unsigned long)s.mean);
+    }
+}
+
+void printFooter(const char* suite) {
+    printf("--- %s complete ---\r\n", suite);
+}
+
+} // namespace csp::bench
@@ -1,7 +1,5 @@
 // --- channel_sync.cpp (Final Corrected Signatures) ---
-#include "FreeRTOS.h"
-#include "task.h"
-#include "semphr.h"
+#include "os.h"
 #include <cstdio>
 
 // This file previously contained conflicting definitions for AltChanSyncBase.
@@ -1,8 +1,35 @@
 // --- csp_wrapper.cpp (New Source File) ---
 
 #include "run.h" // Includes the declaration of ThreadFuncWrapper and the definition of csp::TaskCtx
-#include "FreeRTOS.h" // May be needed if run.h doesn't include it implicitly
-#include "task.h"
+#include "os.h"
+#include "footprint.h"
+#include <cstdio>
+#if CSP4CMSIS_STATS
+#include "cycles.h"
+#endif
+
+namespace csp::internal {
+
+    ProcessPtr currentProcess() {
+        return static_cast<ProcessPtr>(os::localGet());
+    }
+
+    void setCurrentProcess(ProcessPtr process) {
+#if CSP4CMSIS_STATS
+        // The task is already running: open its first run-time slice now.
+        if (process) process->stats().switched_in_at = cycleCount();
+#endif
+#if CSP4CMSIS_TRACE
+        if (process) traceNameProcess(process->traceId(), process->name());
+#endif
+#if CSP4CMSIS_STACK_CANARY
+        // A thread stamps its canary when it first takes on a process.
+        if (process && currentProcess() == nullptr) stackCanaryArm();
+#endif
+        os::localSet(process);
+    }
+
+} // namespace csp::internal
 
 // Define the function using the definition that was removed from the header.
 extern "C" {
@@ -11,17 +38,25 @@ extern "C" {
         csp::TaskCtx* ctx = static_cast<csp::TaskCtx*>(pvParameters); 
         
         // 1. Run the process logic 
+        csp::internal::setCurrentProcess(ctx->process);
         ctx->process->run();
+
+#if CSP4CMSIS_STACK_CANARY
+        if (!csp::internal::stackCanaryIntact(csp::os::stackBase())) {
+            printf("ERROR: Stack overflow in process '%s': canary overwritten (stack %lu words).\r\n",
+                   ctx->process->name(), (unsigned long)ctx->process->stackWords());
+        }
+#endif
         
         // 2. Signal completion
         if (ctx->completion_sem) {
-            xSemaphoreGive(ctx->completion_sem);
+            csp::os::semGive(ctx->completion_sem);
         }
         
         // 3. Clean up generic wrapper info
-        delete ctx;
+        if (!ctx->preallocated) delete ctx;
         
-        // 4. Delete this FreeRTOS task
-        vTaskDelete(NULL);
+        // 4. Delete this task (also releases its process-pointer slot)
+        csp::os::exitSelf();
     }
 }
@@ -0,0 +1,87 @@
+// --- deadline.cpp ---
+#include "deadline.h"
+
+namespace csp::internal {
+
+// =============================================================
+// DeadlineScheduler Implementation
+// =============================================================
+
+DeadlineScheduler::Holder DeadlineScheduler::holders[CSP_MAX_DEADLINE_HOLDERS] = {};
+
+DeadlineScheduler::Holder* DeadlineScheduler::find(os::ThreadId task) {
+    for (size_t i = 0; i < CSP_MAX_DEADLINE_HOLDERS; ++i) {
+        if (holders[i].task == task) return &holders[i];
+    }
+    return nullptr;
+}
+
+void DeadlineScheduler::rebalance() {
+    // 1. Find the holder of the earliest deadline (wrap-safe comparison).
+    Holder* urgent = nullptr;
+    for (size_t i = 0; i < CSP_MAX_DEADLINE_HOLDERS; ++i) {
+        Holder& h = holders[i];
+        if (h.task == nullptr) continue;
+        if (urgent == nullptr || (int32_t)(h.deadline - urgent->deadline) < 0) {
+            urgent = &h;
+        }
+    }
+
+    // 2. Boost the urgent holder, drop every other holder back to its base priority.
+    for (size_t i = 0; i < CSP_MAX_DEADLINE_HOLDERS; ++i) {
+        Holder& h = holders[i];
+        if (h.task == nullptr) continue;
+
+        bool boost = (&h == urgent) && (h.base_priority < CSP_DEADLINE_BOOST_PRIORITY);
+        if (boost != h.boosted) {
+            os::setPriority(h.task, boost ? CSP_DEADLINE_BOOST_PRIORITY : h.base_priority);
+            h.boosted = boost;
+        }
+    }
+}
+
+void DeadlineScheduler::hold(Time deadline) {
+    os::ThreadId self = os::self();
+
+    // Suspend the scheduler rather than take a mutex: a mutex would apply its
+    // own priority inheritance on top of the priorities set here.
+    os::LockState lock = os::schedulerLock();
+    Holder* h = find(self);
+    if (h == nullptr) {
+        h = find(nullptr);
+        if (h != nullptr) {
+            h->task = self;
+            h->base_priority = os::priority(self);
+            h->boosted = false;
+        }
+    }
+    if (h != nullptr) {
+        h->deadline = deadline.to_ticks();
+        rebalance();
+    }
+    os::schedulerUnlock(lock);
+}
+
+void DeadlineScheduler::release() {
+    os::ThreadId self = os::self();
+
+    os::LockState lock = os::schedulerLock();
+    Holder* h = find(self);
+    if (h != nullptr) {
+        if (h->boosted) os::setPriority(self, h->base_priority);
+        h->task = nullptr;
+        h->boosted = false;
+        rebalance();
+    }
+    os::schedulerUnlock(lock);
+}
+
+} // namespace csp::internal
+
+namespace csp {
+
+void ReleaseDeadline() {
+    internal::DeadlineScheduler::release();
+}
+
+} // namespace csp
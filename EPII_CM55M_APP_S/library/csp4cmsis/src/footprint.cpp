@@ -0,0 +1,181 @@
+// --- footprint.cpp (Stack High-Water and RAM Budget Report) ---
+#include "footprint.h"
+#include "os.h"
+#include "process.h"
+#include <atomic>
+#include <cstdio>
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) && !defined(CSP4CMSIS_HOST)
+#define CSP4CMSIS_FOOTPRINT_SECTIONS 1
+// Section boundaries from the scenario app's .ld (GCC builds only).
+extern "C" char __data_start__[], __data_end__[], __bss_start__[], __bss_end__[];
+extern "C" char __HeapBase[], __HeapLimit[], __StackLimit[], __StackTop[];
+#else
+#define CSP4CMSIS_FOOTPRINT_SECTIONS 0
+#endif
+
+namespace csp::internal {
+
+static std::atomic<uint32_t> channel_count{0};
+static std::atomic<uint32_t> channel_object_bytes{0};
+static std::atomic<uint32_t> channel_buffer_bytes{0};
+
+void footprintChannel(int delta, size_t object_bytes, size_t buffer_bytes) {
+    channel_count.fetch_add((uint32_t)delta, std::memory_order_relaxed);
+    channel_object_bytes.fetch_add((uint32_t)(delta * (int)object_bytes), std::memory_order_relaxed);
+    channel_buffer_bytes.fetch_add((uint32_t)(delta * (int)buffer_bytes), std::memory_order_relaxed);
+}
+
+#if CSP4CMSIS_STACK_CANARY
+
+// Stack bottom layout: RTX keeps its magic word in the first word.
+static const size_t CANARY_OFFSET = CSP4CMSIS_OS_RTOS2 ? 1 : 0;
+
+void stackCanaryArm() {
+    uint32_t* base = os::stackBase();
+    if (base == nullptr) return;
+    for (size_t i = 0; i < CSP4CMSIS_STACK_CANARY; ++i) base[CANARY_OFFSET + i] = STACK_CANARY_WORD;
+}
+
+bool stackCanaryIntact(const uint32_t* base) {
+    if (base == nullptr) return true;
+    for (size_t i = 0; i < CSP4CMSIS_STACK_CANARY; ++i) {
+        if (base[CANARY_OFFSET + i] != STACK_CANARY_WORD) return false;
+    }
+    return true;
+}
+
+#if CSP4CMSIS_OS_RTOS2
+static const uint32_t STACK_FILL_WORD = 0xCCCCCCCCU; // osRtxStackFillPattern
+#else
+static const uint32_t STACK_FILL_WORD = 0xA5A5A5A5U; // tskSTACK_FILL_BYTE
+#endif
+
+// The canary ends the kernel's own high-water scan, which starts at the stack
+// bottom: count the untouched words above it instead.
+static size_t unusedAboveCanary(const os::ThreadInfo& t) {
+    const size_t first = CANARY_OFFSET + CSP4CMSIS_STACK_CANARY;
+    const size_t words = t.stack_bytes / sizeof(uint32_t);
+    size_t i = first;
+    while (i < words && t.stack_base[i] == STACK_FILL_WORD) ++i;
+    return (i - first) * sizeof(uint32_t);
+}
+
+#endif // CSP4CMSIS_STACK_CANARY
+
+} // namespace csp::internal
+
+namespace csp {
+
+using namespace csp::internal;
+
+// Threads listed by one report, the kernel's idle and timer threads included.
+// Static: the report may run on a process thread with a tight stack.
+static const size_t MAX_LISTED_THREADS = 32;
+static os::ThreadInfo threads[MAX_LISTED_THREADS];
+
+static const char* processName(const os::ThreadInfo& t) {
+    return t.local ? static_cast<ProcessPtr>(t.local)->name() : "-";
+}
+
+static bool canaryArmed(const os::ThreadInfo& t) {
+    // Process threads stamp their canary when they first take on a process.
+    return CSP4CMSIS_STACK_CANARY && t.local != nullptr && t.stack_base != nullptr;
+}
+
+static bool canaryIntact(const os::ThreadInfo& t) {
+#if CSP4CMSIS_STACK_CANARY
+    return stackCanaryIntact(t.stack_base);
+#else
+    (void)t;
+    return true;
+#endif
+}
+
+static void printBytes(size_t bytes, bool known) {
+    if (known) printf(" %8lu", (unsigned long)bytes);
+    else printf(" %8s", "n/a");
+}
+
+static int reportBrokenCanaries(size_t n) {
+    int damaged = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (canaryArmed(threads[i]) && !canaryIntact(threads[i])) {
+            printf("ERROR: Stack overflow in thread '%s' (process '%s'): canary overwritten.\r\n",
+                   threads[i].name, processName(threads[i]));
+            damaged++;
+        }
+    }
+    return damaged;
+}
+
+int CheckStackCanaries() {
+    if (!CSP4CMSIS_STACK_CANARY) return 0;
+    return reportBrokenCanaries(os::threadList(threads, MAX_LISTED_THREADS));
+}
+
+void PrintFootprint() {
+    size_t n = os::threadList(threads, MAX_LISTED_THREADS);
+
+    printf("--- CSP RAM Footprint ---\r\n");
+    printf("%-16s %-16s %8s %8s %8s %7s\r\n", "Thread", "Process", "Stack B", "Peak B", "Free B", "Canary");
+
+    size_t stack_total = 0, stack_peak = 0, measured_threads = 0;
+    for (size_t i = 0; i < n; ++i) {
+        const os::ThreadInfo& t = threads[i];
+        size_t unused = t.stack_unused;
+#if CSP4CMSIS_STACK_CANARY
+        if (canaryArmed(t) && unused != SIZE_MAX) unused = unusedAboveCanary(t);
+#endif
+        // Kernel and foreign threads have no recorded size; the host no stack at all.
+        const bool sized = t.stack_bytes != 0;
+        const bool measured = unused != SIZE_MAX;
+
+        printf("%-16.16s %-16.16s", t.name ? t.name : "?", processName(t));
+        printBytes(t.stack_bytes, sized);
+        printBytes(sized ? t.stack_bytes - unused : 0, sized && measured);
+        printBytes(unused, measured);
+        printf(" %7s\r\n", !canaryArmed(t) ? "-" : (canaryIntact(t) ? "ok" : "BROKEN"));
+
+        if (sized) stack_total += t.stack_bytes;
+        if (sized && measured) {
+            stack_peak += t.stack_bytes - unused;
+            measured_threads++;
+        }
+    }
+    if (n == MAX_LISTED_THREADS) printf("(list truncated at %u threads)\r\n", (unsigned)MAX_LISTED_THREADS);
+
+    os::ObjectUsage objects = os::objectUsage();
+    os::HeapUsage heap = os::heapUsage();
+
+    printf("Stacks:      %lu B allocated", (unsigned long)stack_total);
+    if (measured_threads) printf(", %lu B peak over %u threads", (unsigned long)stack_peak, (unsigned)measured_threads);
+    printf("\r\n");
+    printf("Objects:     %u threads, %u mutexes, %u semaphores, %u event flags, %u queues, %u timers: %lu B",
+           objects.threads, objects.mutexes, objects.semaphores, objects.event_flags, objects.queues,
+           objects.timers, (unsigned long)objects.bytes);
+    if (objects.budget_bytes) printf(" of %lu B static pools", (unsigned long)objects.budget_bytes);
+    printf("\r\n");
+    printf("Channels:    %lu live, %lu B objects, %lu B queue storage\r\n",
+           (unsigned long)channel_count.load(std::memory_order_relaxed),
+           (unsigned long)channel_object_bytes.load(std::memory_order_relaxed),
+           (unsigned long)channel_buffer_bytes.load(std::memory_order_relaxed));
+    if (heap.total) {
+        printf("Kernel heap: %lu B, %lu B free, %lu B minimum ever free\r\n",
+               (unsigned long)heap.total, (unsigned long)heap.free, (unsigned long)heap.min_free);
+    } else {
+        printf("Kernel heap: n/a (stacks and queues come from the C heap)\r\n");
+    }
+
+#if CSP4CMSIS_FOOTPRINT_SECTIONS
+    printf("Sections:    .data %lu B, .bss %lu B, heap %lu B, main stack %lu B, unused %lu B of %lu B\r\n",
+           (unsigned long)(__data_end__ - __data_start__), (unsigned long)(__bss_end__ - __bss_start__),
+           (unsigned long)(__HeapLimit - __HeapBase), (unsigned long)(__StackTop - __StackLimit),
+           (unsigned long)(__StackLimit - __HeapLimit), (unsigned long)(__StackTop - __data_start__));
+#endif
+    printf("-------------------------\r\n");
+
+    if (CSP4CMSIS_STACK_CANARY) reportBrokenCanaries(n);
+}
+
+} // namespace csp
@@ -1,13 +1,16 @@
 // --- glue.cpp ---
 #include "process.h" // For csp::internal::Process, ThreadFuncWrapper usage
 #include "time.h"    // For csp::Time, CurrentTime, SleepFor, SleepUntil
-#include "FreeRTOS.h"
-#include "task.h"
+#include "os.h"
 #include <cstdio>       // For printf
 
 // =============================================================
 //  C++ Memory Allocation Overrides (pvPortMalloc/vPortFree)
 // =============================================================
+// FreeRTOS backend only: with CMSIS-RTOS2 the default operators use the
+// newlib heap, serialised by the __malloc_lock hooks in os_rtos2.cpp.
+
+#if !CSP4CMSIS_OS_RTOS2
 
 extern "C" {
     // These functions must be linked from your FreeRTOS port
@@ -24,28 +27,47 @@ void operator delete(void* ptr) noexcept {
     vPortFree(ptr); 
 }
 
+// The array and sized forms default to the runtime's malloc/free, not to
+// the two above: every one must reach the FreeRTOS heap.
+void* operator new[](size_t size) {
+    return pvPortMalloc(size);
+}
+
+void operator delete[](void* ptr) noexcept {
+    vPortFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    vPortFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    vPortFree(ptr);
+}
+#endif
+
 // =============================================================
 //  Global Time Functions (Defined in csp namespace)
 // =============================================================
 
 csp::Time CurrentTime() {
-    return csp::Time(xTaskGetTickCount());
+    return csp::Time(csp::os::tickCount());
 }
 
 void SleepFor(const csp::Time time) {
-    vTaskDelay(time.to_ticks());
+    csp::os::delay(time.to_ticks());
 }
 
 void SleepUntil(const csp::Time time) {
     // Use the to_ticks() conversion method for raw tick calculations
-    csp::Time last = csp::Time(xTaskGetTickCount());
+    csp::Time last = csp::Time(csp::os::tickCount());
 
-    // Calculate remaining delay and use to_ticks() for the FreeRTOS API
-    TickType_t delay = time.to_ticks() - last.to_ticks();
+    // Calculate remaining delay and use to_ticks() for the kernel API
+    csp::os::Tick delay = time.to_ticks() - last.to_ticks();
 
     // vTaskDelayUntil requires a modifiable pointer to the *previous* wake time.
-    // We must pass a TickType_t variable by reference to the API.
-    TickType_t previous_wake_time = last.to_ticks();
+    // We must pass a tick variable by reference to the API.
+    csp::os::Tick previous_wake_time = last.to_ticks();
     
     // vTaskDelayUntil(&previous_wake_time, delay);
     // Wait, the API documentation for vTaskDelayUntil uses absolute time, not delta.
@@ -55,7 +77,7 @@ void SleepUntil(const csp::Time time) {
     // let's stick to the common CSP pattern of blocking until an absolute time:
     
     // We will use the common approach to reflect the goal of 'SleepUntil(absolute_time)':
-    vTaskDelayUntil(&previous_wake_time, time.to_ticks());
+    csp::os::delayUntil(&previous_wake_time, time.to_ticks());
 }
 
 // --- End of glue.cpp ---
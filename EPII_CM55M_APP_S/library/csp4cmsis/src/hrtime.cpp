@@ -0,0 +1,41 @@
+// --- hrtime.cpp ---
+#include "hrtime.h"
+
+namespace csp::internal {
+
+// =============================================================
+// 64-Bit Cycle Counter Extension
+// =============================================================
+
+static uint32_t last_low = 0;
+static os::Tick last_tick = 0;
+static uint64_t total = 0;
+
+uint64_t cycleCount64() {
+    os::CriticalState saved = os::criticalEnter();
+
+    cycleCounterInit();
+    uint32_t low = cycleCount();
+    os::Tick tick = os::tickCount();
+
+    // CYCCNT only tells the elapsed cycles modulo 2^32. The elapsed ticks give
+    // a coarse estimate (+/- one tick) that selects the number of wraps.
+    uint32_t delta_low = low - last_low;
+    uint64_t estimate = (uint64_t)(os::Tick)(tick - last_tick)
+                      * (cycleFrequency() / os::tickRate());
+    uint64_t wraps = 0;
+    if (estimate > delta_low) {
+        wraps = (estimate - delta_low + 0x80000000ull) >> 32;
+    }
+
+    total += delta_low + (wraps << 32);
+    last_low = low;
+    last_tick = tick;
+    uint64_t result = total;
+
+    os::criticalExit(saved);
+
+    return result;
+}
+
+} // namespace csp::internal
@@ -0,0 +1,202 @@
+// --- hx_kernel.cpp (Run-to-Completion Scheduler on hxevent) ---
+#include "csp/hx/hx_process.h"
+#include "csp/hx/hx_channel.h"
+#include <cstdio>
+#include <utility>
+
+#if !defined(CSP4CMSIS_HOST)
+#include "WE2_device.h" // CMSIS core: PRIMASK access
+#endif
+
+static_assert(CSP4CMSIS_HX_MAX_PROCESSES <= HX_EVENTQUE_MAXSIZE,
+              "CSP4CMSIS_HX_MAX_PROCESSES exceeds the hxevent event table");
+
+namespace csp::hx {
+
+namespace internal {
+
+    // =============================================================
+    // Interrupt Masking
+    // =============================================================
+    //
+    // Only Signal and wake() are touched from interrupt handlers; everything
+    // else runs on the event loop. The host build has no interrupts.
+
+    static inline uint32_t criticalEnter() {
+#if defined(CSP4CMSIS_HOST)
+        return 0;
+#else
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        return primask;
+#endif
+    }
+
+    static inline void criticalExit(uint32_t state) {
+#if defined(CSP4CMSIS_HOST)
+        (void)state;
+#else
+        __set_PRIMASK(state);
+#endif
+    }
+
+    // =============================================================
+    // Event Slots
+    // =============================================================
+    //
+    // hxevent callbacks take no argument, so every slot gets its own thunk.
+    // An hxevent event cannot be deleted: a slot keeps its event once created
+    // and hands it to the next process spawned into it.
+
+    static CSProcess* slot_process[CSP4CMSIS_HX_MAX_PROCESSES];
+    static hx_event_t slot_event[CSP4CMSIS_HX_MAX_PROCESSES];
+    static bool slot_created[CSP4CMSIS_HX_MAX_PROCESSES];
+
+    template <size_t I>
+    static uint8_t eventThunk() {
+        dispatch(I);
+        return HX_EVENT_RETURN_DONE;
+    }
+
+    template <size_t... I>
+    static const hx_event_cbfunc_t* thunkTable(std::index_sequence<I...>) {
+        static const hx_event_cbfunc_t table[] = { &eventThunk<I>... };
+        return table;
+    }
+
+    static const hx_event_cbfunc_t* const slot_thunk =
+        thunkTable(std::make_index_sequence<CSP4CMSIS_HX_MAX_PROCESSES>{});
+
+    void dispatch(size_t slot) {
+        CSProcess* p = slot_process[slot];
+        if (p == nullptr) return;
+
+        p->pending_ = false;
+
+        switch (p->step()) {
+            case Step::Blocked:
+                break;
+            case Step::Yield:
+                p->wake();
+                break;
+            case Step::Done: {
+                p->running_ = false;
+                slot_process[slot] = nullptr;
+                CSProcess* parent = p->joiner_;
+                p->joiner_ = nullptr;
+                if (parent) parent->wake();
+                break;
+            }
+        }
+    }
+
+    // =============================================================
+    // Channel Wake-Ups
+    // =============================================================
+
+    bool ChannelBase::pollRead(CSProcess* reader) {
+        uint32_t state = criticalEnter();
+        bool ready = available_ != 0;
+        if (!ready) reader_ = reader;
+        criticalExit(state);
+        return ready;
+    }
+
+    void ChannelBase::wakeReader() {
+        CSProcess* p = reader_;
+        reader_ = nullptr;
+        if (p) p->wake();
+    }
+
+    void ChannelBase::wakeWriter() {
+        CSProcess* p = writer_;
+        writer_ = nullptr;
+        if (p) p->wake();
+    }
+
+} // namespace internal
+
+// =============================================================
+// Processes
+// =============================================================
+
+void CSProcess::wake() {
+    uint32_t state = internal::criticalEnter();
+    if (running_ && !pending_) {
+        pending_ = true;
+        hx_event_activate_ISR(internal::slot_event[slot_]);
+    }
+    internal::criticalExit(state);
+}
+
+bool CSProcess::joinedBy(CSProcess* parent) {
+    if (!running_) return true;
+    joiner_ = parent;
+    return false;
+}
+
+bool Spawn(CSProcess& process) {
+    using namespace internal;
+
+    if (process.running_) {
+        printf("ERROR: csp::hx process is already running.\r\n");
+        return false;
+    }
+
+    for (size_t i = 0; i < CSP4CMSIS_HX_MAX_PROCESSES; ++i) {
+        if (slot_process[i] != nullptr) continue;
+
+        if (!slot_created[i]) {
+            hx_event_create(&slot_event[i]);
+            hx_event_set_callback(slot_event[i], slot_thunk[i]);
+            slot_created[i] = true;
+        }
+        hx_event_set_priority(slot_event[i], process.priority_);
+
+        slot_process[i] = &process;
+        process.slot_ = (uint8_t)i;
+        process.resume_ = 0;
+        process.joiner_ = nullptr;
+        process.pending_ = false;
+        process.running_ = true;
+        process.wake();
+        return true;
+    }
+
+    printf("ERROR: csp::hx process table full (see CSP4CMSIS_HX_MAX_PROCESSES).\r\n");
+    return false;
+}
+
+void Init() {
+    hx_event_init();
+    for (size_t i = 0; i < CSP4CMSIS_HX_MAX_PROCESSES; ++i) {
+        internal::slot_process[i] = nullptr;
+        internal::slot_created[i] = false;
+    }
+}
+
+void Start() {
+    hx_eventloop_start();
+}
+
+// =============================================================
+// Signals
+// =============================================================
+
+void Signal::raiseFromIsr() {
+    uint32_t state = internal::criticalEnter();
+    if (available_ != 0xFFFF) available_ = available_ + 1;
+    wakeReader();
+    internal::criticalExit(state);
+}
+
+bool Signal::tryTake(CSProcess* self) {
+    uint32_t state = internal::criticalEnter();
+    bool taken = available_ != 0;
+    if (taken) available_ = available_ - 1;
+    else reader_ = self;
+    internal::criticalExit(state);
+    return taken;
+}
+
+} // namespace csp::hx
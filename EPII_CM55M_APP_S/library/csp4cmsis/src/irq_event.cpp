@@ -0,0 +1,78 @@
+#include "irq_event.h"
+
+namespace csp::internal {
+
+// =============================================================
+// IrqEventGuard Implementation
+// =============================================================
+bool IrqEventGuard::enable(AltScheduler* a, os::Flags b) {
+    os::CriticalState s = os::criticalEnter();
+    bool ready = (pending != 0);
+    if (!ready) {
+        parent_alt = a;
+        assigned_bit = b;
+    }
+    os::criticalExit(s);
+    return ready;
+}
+
+bool IrqEventGuard::disable() {
+    os::CriticalState s = os::criticalEnter();
+    parent_alt = nullptr;
+    bool ready = (pending != 0);
+    os::criticalExit(s);
+    return ready;
+}
+
+void IrqEventGuard::activate() {
+    tryTake();
+}
+
+bool IrqEventGuard::tryTake() {
+    os::CriticalState s = os::criticalEnter();
+    bool taken = (pending != 0);
+    if (taken) pending = pending - 1;
+    os::criticalExit(s);
+    return taken;
+}
+
+void IrqEventGuard::raise() {
+    // From a thread, the waiter could otherwise finish its select() and drop
+    // its Alternative between the hand-over below and wakeUp(). An interrupt
+    // handler runs to completion, so it needs no lock.
+    bool in_isr = os::inIsr();
+    os::LockState lock{};
+    if (!in_isr) lock = os::schedulerLock();
+
+    os::CriticalState s = os::criticalEnter();
+    pending = pending + 1;
+    AltScheduler* alt = parent_alt;
+    os::Flags bit = assigned_bit;
+    parent_alt = nullptr; // One wake-up per enable
+    os::criticalExit(s);
+
+    if (alt) alt->wakeUp(bit); // ISR-safe
+
+    if (!in_isr) os::schedulerUnlock(lock);
+}
+
+} // namespace csp::internal
+
+namespace csp {
+
+// =============================================================
+// IrqEvent Implementation
+// =============================================================
+void IrqEvent::wait() {
+    Alternative alt(*this);
+    alt.priSelect();
+}
+
+bool IrqEvent::wait(Time timeout) {
+    if (tryTake()) return true;
+    RelTimeoutGuard timer(timeout);
+    Alternative alt(*this, timer);
+    return alt.priSelect() == 0;
+}
+
+} // namespace csp
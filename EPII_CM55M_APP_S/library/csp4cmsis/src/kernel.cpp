@@ -1,7 +1,6 @@
 // Required headers for CMSIS-RTOS V2 and FreeRTOS
 //#include "cmsis_os2.h" 
-#include "FreeRTOS.h"
-#include "task.h" 
+#include "os.h"
 
 // --- Conceptual CSP Classes (Forward Declarations) ---
 // These declarations allow the wrapper to interact with the C++ objects.
@@ -0,0 +1,146 @@
+#include "npu.h"
+#include "alt.h"
+#include "hrtime.h"
+#include "irq_event.h"
+#include <cstdio>
+
+#if CSP4CMSIS_ETHOSU
+#include "ethosu_driver.h"
+#endif
+
+namespace csp::internal {
+
+static uint64_t npu_blocked_cycles = 0; // Written by the NPU process only
+
+uint64_t npuBlockedCycles() { return npu_blocked_cycles; }
+
+} // namespace csp::internal
+
+namespace csp {
+
+// =============================================================
+// NpuInferenceProcess Implementation
+// =============================================================
+bool NpuInferenceProcess::attach(const NpuModel& model, Chanin<NpuJob> requests, Chanout<NpuJob> responses) {
+    if (num_models >= MAX_MODELS) {
+        printf("ERROR: NpuInferenceProcess: more than %u models.\r\n", (unsigned)MAX_MODELS);
+        return false;
+    }
+    Entry& e = entries[num_models++];
+    e.model = model;
+    e.requests = requests;
+    e.responses = responses;
+    return true;
+}
+
+void NpuInferenceProcess::serve(Entry& e) {
+    NpuJob& job = e.job;
+    uint64_t blocked = internal::npuBlockedCycles();
+    Stopwatch watch;
+    job.status = e.model.invoke(job.arg);
+    job.npu_cycles = watch.lap().to_cycles();
+    job.released_cycles = internal::npuBlockedCycles() - blocked;
+    account(e);
+    e.responses << job;
+}
+
+void NpuInferenceProcess::account(Entry& e) {
+    e.npu_cycles += e.job.npu_cycles;
+    e.released_cycles += e.job.released_cycles;
+    if (report_every == 0 || ++e.jobs < report_every) return;
+
+    uint64_t npu_us = HrTime(e.npu_cycles / e.jobs).to_microseconds();
+    uint64_t released_us = HrTime(e.released_cycles / e.jobs).to_microseconds();
+    unsigned percent = (e.npu_cycles != 0) ? (unsigned)(e.released_cycles * 100 / e.npu_cycles) : 0;
+    printf("[npu] %s: %lu jobs, avg %lu us per invoke, %lu us (%u%%) released to other processes\r\n",
+           e.model.name, (unsigned long)e.jobs, (unsigned long)npu_us, (unsigned long)released_us, percent);
+    e.jobs = 0;
+    e.npu_cycles = 0;
+    e.released_cycles = 0;
+}
+
+void NpuInferenceProcess::run() {
+    if (num_models == 0) {
+        printf("ERROR: NpuInferenceProcess started without a model.\r\n");
+        return;
+    }
+
+    internal::Guard* guards[MAX_MODELS];
+    for (size_t i = 0; i < num_models; ++i) {
+        guards[i] = entries[i].requests.getGuard(entries[i].job);
+    }
+    Alternative alt(static_cast<internal::Guard* const*>(guards), num_models);
+
+    while (true) {
+        serve(entries[alt.fairSelect()]);
+    }
+}
+
+} // namespace csp
+
+#if CSP4CMSIS_ETHOSU
+// =============================================================
+// Ethos-U Driver OS Hooks (override the driver's weak defaults)
+// =============================================================
+// The driver takes its per-NPU semaphore right after it has started a
+// command stream and the NPU interrupt handler gives it. As an IrqEvent,
+// that take is an ALT: the calling process blocks and every other process
+// gets the CPU until the interrupt fires. The NPU interrupt must be
+// allowed to call the kernel (configMAX_SYSCALL_INTERRUPT_PRIORITY or
+// lower urgency on FreeRTOS).
+using csp::IrqEvent;
+
+static IrqEvent npu_events[CSP4CMSIS_NPU_MAX_SEMAPHORES];
+static size_t npu_events_used = 0;
+
+extern "C" {
+
+void* ethosu_mutex_create(void) {
+    return (void*)csp::os::mutexCreate();
+}
+
+void ethosu_mutex_destroy(void* mutex) {
+    csp::os::mutexDelete((csp::os::Mutex)mutex);
+}
+
+int ethosu_mutex_lock(void* mutex) {
+    return csp::os::mutexLock((csp::os::Mutex)mutex) ? 0 : -1;
+}
+
+int ethosu_mutex_unlock(void* mutex) {
+    csp::os::mutexUnlock((csp::os::Mutex)mutex);
+    return 0;
+}
+
+void* ethosu_semaphore_create(void) {
+    // Created at driver init and never freed in practice: a fixed pool.
+    csp::os::CriticalState s = csp::os::criticalEnter();
+    IrqEvent* ev = (npu_events_used < CSP4CMSIS_NPU_MAX_SEMAPHORES) ? &npu_events[npu_events_used++] : nullptr;
+    csp::os::criticalExit(s);
+    if (!ev) printf("ERROR: more than %d Ethos-U semaphores.\r\n", CSP4CMSIS_NPU_MAX_SEMAPHORES);
+    return ev;
+}
+
+void ethosu_semaphore_destroy(void* sem) {
+    (void)sem;
+}
+
+int ethosu_semaphore_take(void* sem, uint64_t timeout) {
+    IrqEvent* ev = static_cast<IrqEvent*>(sem);
+    if (ev->tryTake()) return 0;
+
+    csp::Stopwatch watch;
+    bool taken = true;
+    if (timeout == ETHOSU_SEMAPHORE_WAIT_FOREVER) ev->wait();
+    else taken = ev->wait(csp::Time((csp::os::Tick)timeout));
+    csp::internal::npu_blocked_cycles += watch.lap().to_cycles();
+    return taken ? 0 : -1;
+}
+
+int ethosu_semaphore_give(void* sem) {
+    static_cast<IrqEvent*>(sem)->raise(); // From the NPU interrupt handler
+    return 0;
+}
+
+} // extern "C"
+#endif // CSP4CMSIS_ETHOSU
@@ -0,0 +1,84 @@
+// --- os_freertos.cpp (Native FreeRTOS Backend: Footprint Queries) ---
+#include "os.h"
+
+#if !CSP4CMSIS_OS_RTOS2
+
+namespace csp::os {
+
+namespace detail {
+    Census census;
+}
+
+size_t threadList(ThreadInfo* out, size_t max) {
+    // uxTaskGetSystemState() fills nothing unless the array holds every task;
+    // leave room for tasks created while the array is allocated.
+    UBaseType_t capacity = uxTaskGetNumberOfTasks() + 2;
+    TaskStatus_t* status = static_cast<TaskStatus_t*>(pvPortMalloc(capacity * sizeof(TaskStatus_t)));
+    if (status == nullptr) return 0;
+
+    size_t count = 0;
+    vTaskSuspendAll();
+    UBaseType_t n = uxTaskGetSystemState(status, capacity, NULL);
+    for (UBaseType_t i = 0; i < n && count < max; ++i) {
+        ThreadInfo& info = out[count++];
+        info.id = status[i].xHandle;
+        info.name = status[i].pcTaskName;
+        info.local = pvTaskGetThreadLocalStoragePointer(status[i].xHandle, CSP4CMSIS_TLS_PROCESS_INDEX);
+        // Depth recorded by spawn(); idle, timer and foreign tasks have none.
+        size_t words = (size_t)pvTaskGetThreadLocalStoragePointer(status[i].xHandle, CSP4CMSIS_TLS_STACK_INDEX);
+        info.stack_bytes = words * sizeof(StackType_t);
+#if defined(CSP4CMSIS_HOST)
+        // Host tasks are pthreads: no stack to inspect.
+        info.stack_base = nullptr;
+        info.stack_unused = SIZE_MAX;
+#else
+        info.stack_base = reinterpret_cast<uint32_t*>(status[i].pxStackBase);
+        info.stack_unused = (size_t)status[i].usStackHighWaterMark * sizeof(StackType_t);
+#endif
+    }
+    xTaskResumeAll();
+
+    vPortFree(status);
+    return count;
+}
+
+uint32_t* stackBase() {
+#if defined(CSP4CMSIS_HOST)
+    return nullptr;
+#else
+    TaskStatus_t status;
+    // pdFALSE: skip the high-water scan, only the stack base is wanted.
+    vTaskGetInfo(NULL, &status, pdFALSE, eRunning);
+    return reinterpret_cast<uint32_t*>(status.pxStackBase);
+#endif
+}
+
+HeapUsage heapUsage() {
+#if defined(CSP4CMSIS_HOST)
+    return HeapUsage{};
+#else
+    return HeapUsage{ configTOTAL_HEAP_SIZE, xPortGetFreeHeapSize(), xPortGetMinimumEverFreeHeapSize() };
+#endif
+}
+
+ObjectUsage objectUsage() {
+    ObjectUsage u = {};
+    u.threads = (uint16_t)uxTaskGetNumberOfTasks();
+    u.mutexes = detail::census.mutexes;
+    u.semaphores = detail::census.semaphores;
+    u.event_flags = detail::census.event_flags;
+    u.queues = detail::census.queues;
+    u.timers = detail::census.timers;
+    // The static buffer types have the size of the kernel's control blocks.
+    u.bytes = u.threads * sizeof(StaticTask_t)
+            + (u.mutexes + u.semaphores) * sizeof(StaticSemaphore_t)
+            + u.event_flags * sizeof(StaticEventGroup_t)
+            + u.queues * sizeof(StaticQueue_t)
+            + u.timers * sizeof(StaticTimer_t);
+    u.budget_bytes = 0;
+    return u;
+}
+
+} // namespace csp::os
+
+#endif // !CSP4CMSIS_OS_RTOS2
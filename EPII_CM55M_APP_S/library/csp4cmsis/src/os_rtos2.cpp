@@ -0,0 +1,478 @@
+// --- os_rtos2.cpp (CMSIS-RTOS2 Backend) ---
+#include "os.h"
+
+#if CSP4CMSIS_OS_RTOS2
+
+#include <cstdio>
+#include <cstdlib>
+#if defined(RTOS2_RTX)
+#include "rtx_os.h"
+#endif
+
+namespace csp::os {
+
+// =============================================================
+// Static Control Block Pools (RTX5)
+// =============================================================
+//
+// RTX5 leaves a user-supplied control block alone once the object is deleted,
+// apart from resetting its id to osRtxIdInvalid. A zero id therefore marks a
+// free slot, and a zero-initialised pool starts out empty. Pools are searched
+// and claimed with the scheduler locked; objects are never created from ISRs.
+// Other CMSIS-RTOS2 kernels allocate their own control blocks.
+
+#if defined(RTOS2_RTX)
+
+template <typename CB, size_t N>
+struct CbPool {
+    CB blocks[N];
+
+    CB* claim() {
+        for (size_t i = 0; i < N; ++i) {
+            if (blocks[i].id == osRtxIdInvalid) return &blocks[i];
+        }
+        return nullptr;
+    }
+    size_t index(const CB* cb) const { return (size_t)(cb - blocks); }
+    bool owns(const void* p) const {
+        return p >= (const void*)&blocks[0] && p < (const void*)&blocks[N];
+    }
+    uint16_t used() const {
+        uint16_t n = 0;
+        for (size_t i = 0; i < N; ++i) {
+            if (blocks[i].id != osRtxIdInvalid) n++;
+        }
+        return n;
+    }
+};
+
+static CbPool<osRtxThread_t,       CSP4CMSIS_OS_MAX_THREADS>    thread_pool;
+static CbPool<osRtxMutex_t,        CSP4CMSIS_OS_MAX_MUTEXES>    mutex_pool;
+static CbPool<osRtxSemaphore_t,    CSP4CMSIS_OS_MAX_SEMAPHORES> semaphore_pool;
+static CbPool<osRtxEventFlags_t,   CSP4CMSIS_OS_MAX_EVENT_FLAGS> flags_pool;
+static CbPool<osRtxMessageQueue_t, CSP4CMSIS_OS_MAX_QUEUES>     queue_pool;
+static CbPool<osRtxTimer_t,        CSP4CMSIS_OS_MAX_TIMERS>     timer_pool;
+
+// Heap memory owned by pool slots. A thread cannot free its own stack, so a
+// stack is released when its slot is claimed again after the thread exited.
+static uint64_t* thread_stacks[CSP4CMSIS_OS_MAX_THREADS];
+static uint32_t* queue_storage[CSP4CMSIS_OS_MAX_QUEUES];
+
+// Live objects on caller-provided control blocks, outside the pools.
+static uint16_t embedded_mutexes, embedded_flags;
+
+#define CSP_OS_CB(pool, cb) cb, sizeof(*(cb))
+
+static void poolExhausted(const char* kind) {
+    printf("ERROR: csp::os %s pool exhausted (see CSP4CMSIS_OS_MAX_* in csp_config.h).\r\n", kind);
+}
+
+#else
+
+#define CSP_OS_CB(pool, cb) NULL, 0U
+
+#endif // RTOS2_RTX
+
+// =============================================================
+// Priorities
+// =============================================================
+
+static const osPriority_t level_map[CSP_OS_PRIORITY_LEVELS] = {
+    osPriorityLow, osPriorityBelowNormal, osPriorityNormal, osPriorityAboveNormal, osPriorityHigh
+};
+
+static osPriority_t toNative(Priority p) {
+    return level_map[p < CSP_OS_PRIORITY_LEVELS ? p : CSP_OS_PRIORITY_LEVELS - 1];
+}
+
+Priority priority(ThreadId t) {
+    osPriority_t native = osThreadGetPriority(t ? t : osThreadGetId());
+    Priority level = 0;
+    for (Priority i = 0; i < CSP_OS_PRIORITY_LEVELS; ++i) {
+        if (level_map[i] <= native) level = i;
+    }
+    return level;
+}
+
+void setPriority(ThreadId t, Priority p) {
+    osThreadSetPriority(t ? t : osThreadGetId(), toNative(p));
+}
+
+// =============================================================
+// Thread-Local Process Pointer
+// =============================================================
+
+struct LocalSlot {
+    ThreadId thread;
+    void* value;
+};
+
+static LocalSlot local_slots[CSP4CMSIS_OS_MAX_THREADS + CSP4CMSIS_OS_FOREIGN_THREADS];
+static const size_t NUM_LOCAL_SLOTS = sizeof(local_slots) / sizeof(local_slots[0]);
+
+void* localGet() {
+    ThreadId me = osThreadGetId();
+    for (size_t i = 0; i < NUM_LOCAL_SLOTS; ++i) {
+        if (local_slots[i].thread == me) return local_slots[i].value;
+    }
+    return nullptr;
+}
+
+void localSet(void* value) {
+    ThreadId me = osThreadGetId();
+    LocalSlot* free_slot = nullptr;
+
+    LockState lock = schedulerLock();
+    for (size_t i = 0; i < NUM_LOCAL_SLOTS; ++i) {
+        if (local_slots[i].thread == me) {
+            local_slots[i].value = value;
+            if (value == nullptr) local_slots[i].thread = nullptr;
+            schedulerUnlock(lock);
+            return;
+        }
+        if (free_slot == nullptr && local_slots[i].thread == nullptr) free_slot = &local_slots[i];
+    }
+    if (value != nullptr && free_slot != nullptr) {
+        free_slot->thread = me;
+        free_slot->value = value;
+    }
+    schedulerUnlock(lock);
+
+    if (value != nullptr && free_slot == nullptr) {
+        printf("ERROR: csp::os local storage table full.\r\n");
+    }
+}
+
+// =============================================================
+// Threads
+// =============================================================
+
+bool spawn(void (*entry)(void*), void* arg, const char* name,
+           size_t stack_words, Priority priority, ThreadId* out) {
+    osThreadAttr_t attr = {};
+    attr.name = name;
+    attr.priority = toNative(priority);
+    attr.stack_size = (uint32_t)(((stack_words * 4U) + 7U) & ~7U);
+
+    ThreadId id;
+#if defined(RTOS2_RTX)
+    // RTX needs an 8-byte aligned stack whose size is a multiple of 8.
+    uint64_t* stack = new uint64_t[attr.stack_size / 8U];
+
+    LockState lock = schedulerLock();
+    osRtxThread_t* cb = thread_pool.claim();
+    if (cb == nullptr) {
+        schedulerUnlock(lock);
+        delete[] stack;
+        poolExhausted("thread");
+        return false;
+    }
+    size_t slot = thread_pool.index(cb);
+    delete[] thread_stacks[slot]; // Left behind by the thread that used the slot last
+    thread_stacks[slot] = stack;
+
+    attr.cb_mem = cb;
+    attr.cb_size = sizeof(*cb);
+    attr.stack_mem = stack;
+    id = osThreadNew(entry, arg, &attr);
+    schedulerUnlock(lock);
+#else
+    id = osThreadNew(entry, arg, &attr);
+#endif
+
+    if (out) *out = id;
+    return id != nullptr;
+}
+
+bool spawnStatic(void (*entry)(void*), void* arg, const char* name, uint32_t* stack,
+                 size_t stack_words, ThreadControlBlock* cb, Priority priority, ThreadId* out) {
+#if defined(RTOS2_RTX)
+    osThreadAttr_t attr = {};
+    attr.name = name;
+    attr.priority = toNative(priority);
+    attr.cb_mem = cb;
+    attr.cb_size = sizeof(*cb);
+    attr.stack_mem = stack;
+    attr.stack_size = (uint32_t)((stack_words * 4U) & ~7U);
+
+    ThreadId id = osThreadNew(entry, arg, &attr);
+    if (out) *out = id;
+    return id != nullptr;
+#else
+    (void)stack;
+    (void)cb;
+    return spawn(entry, arg, name, stack_words, priority, out);
+#endif
+}
+
+void exitSelf() {
+    localSet(nullptr);
+    osThreadExit();
+}
+
+// =============================================================
+// Mutexes, Semaphores, Event Flags
+// =============================================================
+
+#if defined(RTOS2_RTX)
+#define CSP_OS_CLAIM(pool, cb, kind)                          \
+    LockState lock = schedulerLock();                         \
+    auto* cb = pool.claim();                                  \
+    if (cb == nullptr) { schedulerUnlock(lock); poolExhausted(kind); return nullptr; }
+#define CSP_OS_RELEASE() schedulerUnlock(lock)
+#else
+#define CSP_OS_CLAIM(pool, cb, kind)
+#define CSP_OS_RELEASE()
+#endif
+
+Mutex mutexCreate() {
+    CSP_OS_CLAIM(mutex_pool, cb, "mutex");
+    // Priority inheritance, as with FreeRTOS mutexes.
+    const osMutexAttr_t attr = { "CspMtx", osMutexPrioInherit, CSP_OS_CB(mutex_pool, cb) };
+    Mutex m = osMutexNew(&attr);
+    CSP_OS_RELEASE();
+    return m;
+}
+
+Mutex mutexCreateStatic(MutexControlBlock* cb) {
+#if defined(RTOS2_RTX)
+    const osMutexAttr_t attr = { "CspMtx", osMutexPrioInherit, cb, sizeof(*cb) };
+    Mutex m = osMutexNew(&attr);
+    if (m) {
+        LockState lock = schedulerLock();
+        embedded_mutexes++;
+        schedulerUnlock(lock);
+    }
+    return m;
+#else
+    (void)cb;
+    return mutexCreate();
+#endif
+}
+
+void mutexDelete(Mutex m) {
+#if defined(RTOS2_RTX)
+    if (!mutex_pool.owns(m)) {
+        LockState lock = schedulerLock();
+        embedded_mutexes--;
+        schedulerUnlock(lock);
+    }
+#endif
+    osMutexDelete(m);
+}
+
+Semaphore semCreate(uint32_t max_count, uint32_t initial) {
+    CSP_OS_CLAIM(semaphore_pool, cb, "semaphore");
+    const osSemaphoreAttr_t attr = { "CspSem", 0U, CSP_OS_CB(semaphore_pool, cb) };
+    Semaphore s = osSemaphoreNew(max_count, initial, &attr);
+    CSP_OS_RELEASE();
+    return s;
+}
+
+void semDelete(Semaphore s) { osSemaphoreDelete(s); }
+
+EventFlags flagsCreate() {
+    CSP_OS_CLAIM(flags_pool, cb, "event flags");
+    const osEventFlagsAttr_t attr = { "CspAlt", 0U, CSP_OS_CB(flags_pool, cb) };
+    EventFlags f = osEventFlagsNew(&attr);
+    CSP_OS_RELEASE();
+    return f;
+}
+
+EventFlags flagsCreateStatic(EventFlagsControlBlock* cb) {
+#if defined(RTOS2_RTX)
+    const osEventFlagsAttr_t attr = { "CspAlt", 0U, cb, sizeof(*cb) };
+    EventFlags f = osEventFlagsNew(&attr);
+    if (f) {
+        LockState lock = schedulerLock();
+        embedded_flags++;
+        schedulerUnlock(lock);
+    }
+    return f;
+#else
+    (void)cb;
+    return flagsCreate();
+#endif
+}
+
+void flagsDelete(EventFlags f) {
+#if defined(RTOS2_RTX)
+    if (!flags_pool.owns(f)) {
+        LockState lock = schedulerLock();
+        embedded_flags--;
+        schedulerUnlock(lock);
+    }
+#endif
+    osEventFlagsDelete(f);
+}
+
+// =============================================================
+// Message Queues
+// =============================================================
+
+Queue queueCreate(size_t capacity, size_t item_size) {
+    osMessageQueueAttr_t attr = {};
+    attr.name = "CspQueue";
+#if defined(RTOS2_RTX)
+    uint32_t bytes = osRtxMessageQueueMemSize(capacity, item_size);
+    uint32_t* storage = new uint32_t[bytes / 4U];
+
+    LockState lock = schedulerLock();
+    osRtxMessageQueue_t* cb = queue_pool.claim();
+    if (cb == nullptr) {
+        schedulerUnlock(lock);
+        delete[] storage;
+        poolExhausted("message queue");
+        return nullptr;
+    }
+    size_t slot = queue_pool.index(cb);
+    attr.cb_mem = cb;
+    attr.cb_size = sizeof(*cb);
+    attr.mq_mem = storage;
+    attr.mq_size = bytes;
+    Queue q = osMessageQueueNew((uint32_t)capacity, (uint32_t)item_size, &attr);
+    queue_storage[slot] = q ? storage : nullptr;
+    schedulerUnlock(lock);
+    if (q == nullptr) delete[] storage;
+    return q;
+#else
+    return osMessageQueueNew((uint32_t)capacity, (uint32_t)item_size, &attr);
+#endif
+}
+
+void queueDelete(Queue q) {
+    osMessageQueueDelete(q);
+#if defined(RTOS2_RTX)
+    if (queue_pool.owns(q)) {
+        size_t slot = queue_pool.index(static_cast<osRtxMessageQueue_t*>(q));
+        delete[] queue_storage[slot];
+        queue_storage[slot] = nullptr;
+    }
+#endif
+}
+
+// =============================================================
+// Timers
+// =============================================================
+
+namespace detail {
+    Timer timerNew(osTimerFunc_t fn, void* arg) {
+        CSP_OS_CLAIM(timer_pool, cb, "timer");
+        const osTimerAttr_t attr = { "CspTmr", 0U, CSP_OS_CB(timer_pool, cb) };
+        Timer t = osTimerNew(fn, osTimerOnce, arg, &attr);
+        CSP_OS_RELEASE();
+        return t;
+    }
+}
+
+void timerDelete(Timer t) { osTimerDelete(t); }
+
+// =============================================================
+// Footprint Queries
+// =============================================================
+
+static void* localOf(ThreadId t) {
+    for (size_t i = 0; i < NUM_LOCAL_SLOTS; ++i) {
+        if (local_slots[i].thread == t) return local_slots[i].value;
+    }
+    return nullptr;
+}
+
+size_t threadList(ThreadInfo* out, size_t max) {
+    ThreadId* ids = new ThreadId[max];
+#if defined(RTOS2_RTX)
+    // Without the watermark RTX reports no free stack at all.
+    const bool watermark = (osRtxConfig.flags & osRtxConfigStackWatermark) != 0U;
+#endif
+
+    LockState lock = schedulerLock();
+    size_t count = osThreadEnumerate(ids, (uint32_t)max);
+    for (size_t i = 0; i < count; ++i) {
+        ThreadInfo& info = out[i];
+        info.id = ids[i];
+        info.name = osThreadGetName(ids[i]);
+        info.local = localOf(ids[i]);
+        info.stack_bytes = osThreadGetStackSize(ids[i]);
+#if defined(RTOS2_RTX)
+        info.stack_base = static_cast<uint32_t*>(static_cast<osRtxThread_t*>(ids[i])->stack_mem);
+        info.stack_unused = watermark ? osThreadGetStackSpace(ids[i]) : SIZE_MAX;
+#else
+        info.stack_base = nullptr;
+        info.stack_unused = SIZE_MAX;
+#endif
+    }
+    schedulerUnlock(lock);
+
+    delete[] ids;
+    return count;
+}
+
+uint32_t* stackBase() {
+#if defined(RTOS2_RTX)
+    return static_cast<uint32_t*>(static_cast<osRtxThread_t*>(osThreadGetId())->stack_mem);
+#else
+    return nullptr;
+#endif
+}
+
+HeapUsage heapUsage() {
+    // Stacks and queue buffers come from the C heap (operator new), not from
+    // kernel memory; footprint.cpp reports the linker's heap region instead.
+    return HeapUsage{};
+}
+
+ObjectUsage objectUsage() {
+    ObjectUsage u = {};
+#if defined(RTOS2_RTX)
+    LockState lock = schedulerLock();
+    u.threads = thread_pool.used();
+    u.mutexes = mutex_pool.used() + embedded_mutexes;
+    u.semaphores = semaphore_pool.used();
+    u.event_flags = flags_pool.used() + embedded_flags;
+    u.queues = queue_pool.used();
+    u.timers = timer_pool.used();
+    schedulerUnlock(lock);
+
+    u.bytes = u.threads * sizeof(osRtxThread_t)
+            + u.mutexes * sizeof(osRtxMutex_t)
+            + u.semaphores * sizeof(osRtxSemaphore_t)
+            + u.event_flags * sizeof(osRtxEventFlags_t)
+            + u.queues * sizeof(osRtxMessageQueue_t)
+            + u.timers * sizeof(osRtxTimer_t);
+    u.budget_bytes = sizeof(thread_pool) + sizeof(mutex_pool) + sizeof(semaphore_pool)
+                   + sizeof(flags_pool) + sizeof(queue_pool) + sizeof(timer_pool);
+#else
+    u.threads = (uint16_t)osThreadGetCount();
+#endif
+    return u;
+}
+
+} // namespace csp::os
+
+// =============================================================
+// newlib Heap Lock
+// =============================================================
+//
+// Without FreeRTOS, operator new falls through to newlib malloc, which is only
+// thread-safe with these hooks. Locking the scheduler is enough because the
+// heap is never touched from interrupt handlers.
+
+#if defined(__NEWLIB__)
+struct _reent;
+
+static volatile uint32_t malloc_depth = 0;
+static int32_t malloc_saved_lock = 0;
+
+extern "C" void __malloc_lock(struct _reent*) {
+    if (osKernelGetState() != osKernelRunning && osKernelGetState() != osKernelLocked) return;
+    int32_t previous = osKernelLock();
+    if (malloc_depth++ == 0) malloc_saved_lock = previous;
+}
+
+extern "C" void __malloc_unlock(struct _reent*) {
+    if (malloc_depth == 0) return;
+    if (--malloc_depth == 0) osKernelRestoreLock(malloc_saved_lock);
+}
+#endif
+
+#endif // CSP4CMSIS_OS_RTOS2
@@ -0,0 +1,128 @@
+// --- priority.cpp ---
+#include "priority.h"
+#include <cstdio>
+
+namespace csp {
+
+// =============================================================
+// Topology Implementation
+// =============================================================
+
+Topology& Topology::connect(const CSProcess& writer, const CSProcess& reader) {
+    if (num_edges < MAX_EDGES) {
+        edges[num_edges++] = Edge{ &writer, &reader };
+    } else {
+        printf("ERROR: Topology edge limit (%u) reached, edge ignored.\r\n", (unsigned)MAX_EDGES);
+    }
+    return *this;
+}
+
+} // namespace csp
+
+namespace csp::internal {
+
+// Upper bound on the number of processes the analysis pass can rank.
+// Larger networks fall back to the uniform default priority.
+#define CSP_MAX_ANALYSED_PROCESSES 32
+
+#define UNREACHED ((size_t)-1)
+
+static int indexOf(CSProcess* const* procs, size_t count, const CSProcess* p) {
+    for (size_t i = 0; i < count; ++i) {
+        if (procs[i] == p) return (int)i;
+    }
+    return -1;
+}
+
+static const char* policyName(PriorityPolicy policy) {
+    switch (policy) {
+        case PriorityPolicy::SinkFirst:   return "SinkFirst";
+        case PriorityPolicy::SourceFirst: return "SourceFirst";
+        default:                          return "Uniform";
+    }
+}
+
+void assignPriorities(CSProcess* const* procs, size_t count, const Topology& topo,
+                      PriorityPolicy policy, os::Priority* prios) {
+    for (size_t i = 0; i < count; ++i) prios[i] = CSP_NETWORK_DEFAULT_PRIORITY;
+
+    if (policy == PriorityPolicy::Uniform || topo.size() == 0) return;
+    if (count > CSP_MAX_ANALYSED_PROCESSES) {
+        printf("WARNING: %u processes exceed the priority analysis limit, using uniform priority.\r\n",
+               (unsigned)count);
+        return;
+    }
+
+    // SinkFirst walks the graph backwards from the sinks, SourceFirst forwards
+    // from the sources.
+    const bool from_sinks = (policy == PriorityPolicy::SinkFirst);
+
+    size_t dist[CSP_MAX_ANALYSED_PROCESSES];
+    size_t degree[CSP_MAX_ANALYSED_PROCESSES] = {0};
+    size_t queue[CSP_MAX_ANALYSED_PROCESSES];
+    size_t head = 0, tail = 0;
+
+    // 1. Count, per process, the edges leaving it against the walk direction.
+    //    A process with none is a sink (or source) and seeds the walk.
+    for (size_t e = 0; e < topo.size(); ++e) {
+        int w = indexOf(procs, count, topo.edge(e).writer);
+        int r = indexOf(procs, count, topo.edge(e).reader);
+        if (w < 0 || r < 0) continue;
+        degree[from_sinks ? w : r]++;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (degree[i] == 0) {
+            dist[i] = 0;
+            queue[tail++] = i;
+        } else {
+            dist[i] = UNREACHED;
+        }
+    }
+
+    // 2. Breadth-first walk: distance in channel hops to the nearest seed.
+    while (head < tail) {
+        size_t cur = queue[head++];
+        for (size_t e = 0; e < topo.size(); ++e) {
+            int w = indexOf(procs, count, topo.edge(e).writer);
+            int r = indexOf(procs, count, topo.edge(e).reader);
+            if (w < 0 || r < 0) continue;
+
+            int next = from_sinks ? (r == (int)cur ? w : -1) : (w == (int)cur ? r : -1);
+            if (next >= 0 && dist[next] == UNREACHED) {
+                dist[next] = dist[cur] + 1;
+                queue[tail++] = (size_t)next;
+            }
+        }
+    }
+
+    // 3. Pure cycles never reach a seed: rank them just after the furthest process.
+    size_t max_dist = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (dist[i] != UNREACHED && dist[i] > max_dist) max_dist = dist[i];
+    }
+    bool has_unreached = false;
+    for (size_t i = 0; i < count; ++i) {
+        if (dist[i] == UNREACHED) { dist[i] = max_dist + 1; has_unreached = true; }
+    }
+    if (has_unreached) max_dist++;
+    if (max_dist == 0) return; // Flat network: nothing to rank
+
+    // 4. Map distances onto the band: distance 0 gets the highest level.
+    const os::Priority levels = CSP_PRIORITY_BAND_HIGH - CSP_PRIORITY_BAND_LOW;
+    for (size_t i = 0; i < count; ++i) {
+        os::Priority drop = (os::Priority)((dist[i] * levels + max_dist / 2) / max_dist);
+        prios[i] = CSP_PRIORITY_BAND_HIGH - drop;
+    }
+}
+
+void reportPriorities(CSProcess* const* procs, size_t count,
+                      PriorityPolicy policy, const os::Priority* prios) {
+    printf("[CSP] Priority plan (%s, band %u..%u):\r\n", policyName(policy),
+           (unsigned)CSP_PRIORITY_BAND_LOW, (unsigned)CSP_PRIORITY_BAND_HIGH);
+    for (size_t i = 0; i < count; ++i) {
+        printf("[CSP]   #%-2u %-16s -> %u\r\n", (unsigned)i, procs[i]->name(), (unsigned)prios[i]);
+    }
+}
+
+} // namespace csp::internal
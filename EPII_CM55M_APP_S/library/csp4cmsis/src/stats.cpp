@@ -0,0 +1,201 @@
+// --- stats.cpp ---
+#include "stats.h"
+#include "process.h"
+#include "os.h"
+#include <cstdio>
+
+#if CSP4CMSIS_STATS
+#include "cycles.h"
+#include "hrtime.h"
+
+namespace csp::internal {
+
+// =============================================================
+// StatsRegistry Implementation
+// =============================================================
+
+ProcessStats* StatsRegistry::process_head = nullptr;
+ChannelStats* StatsRegistry::channel_head = nullptr;
+uint64_t StatsRegistry::epoch_cycles = 0;
+
+void StatsRegistry::add(ProcessStats* s) {
+    cycleCounterInit();
+    os::CriticalState cs = os::criticalEnter();
+    s->next = process_head;
+    process_head = s;
+    os::criticalExit(cs);
+}
+
+void StatsRegistry::remove(ProcessStats* s) {
+    os::CriticalState cs = os::criticalEnter();
+    for (ProcessStats** p = &process_head; *p != nullptr; p = &(*p)->next) {
+        if (*p == s) { *p = s->next; break; }
+    }
+    os::criticalExit(cs);
+}
+
+void StatsRegistry::add(ChannelStats* s) {
+    cycleCounterInit();
+    os::CriticalState cs = os::criticalEnter();
+    s->next = channel_head;
+    channel_head = s;
+    os::criticalExit(cs);
+}
+
+void StatsRegistry::remove(ChannelStats* s) {
+    os::CriticalState cs = os::criticalEnter();
+    for (ChannelStats** p = &channel_head; *p != nullptr; p = &(*p)->next) {
+        if (*p == s) { *p = s->next; break; }
+    }
+    os::criticalExit(cs);
+}
+
+ProcessStats* StatsRegistry::current() {
+    ProcessPtr p = currentProcess();
+    return p ? &p->stats() : nullptr;
+}
+
+void StatsRegistry::reset() {
+    uint64_t epoch_now = cycleCount64();
+    os::CriticalState cs = os::criticalEnter();
+    uint32_t now = cycleCount();
+    for (ProcessStats* s = process_head; s != nullptr; s = s->next) {
+        s->run_cycles = 0;
+        s->blocked_in_cycles = 0;
+        s->blocked_out_cycles = 0;
+        s->msgs_sent = 0;
+        s->msgs_received = 0;
+        s->switched_in_at = now;
+    }
+    for (ChannelStats* s = channel_head; s != nullptr; s = s->next) {
+        s->transfers = 0;
+        s->writes = 0;
+        s->in_wait_cycles = 0;
+        s->in_wait_max = 0;
+        s->out_wait_cycles = 0;
+        s->out_wait_max = 0;
+        s->high_water = 0;
+    }
+    epoch_cycles = epoch_now;
+    os::criticalExit(cs);
+}
+
+// =============================================================
+// StatsProbe Implementation
+// =============================================================
+
+StatsProbe::StatsProbe(ChannelStats* c, Direction d)
+    : chan(c), dir(d), start(cycleCount()) {}
+
+StatsProbe::~StatsProbe() {
+    uint32_t elapsed = cycleCount() - start;
+    ProcessStats* proc = StatsRegistry::current();
+
+    os::CriticalState cs = os::criticalEnter();
+    if (dir == Input) {
+        if (chan) {
+            chan->transfers++;
+            chan->in_wait_cycles += elapsed;
+            if (elapsed > chan->in_wait_max) chan->in_wait_max = elapsed;
+        }
+        if (proc) {
+            proc->blocked_in_cycles += elapsed;
+            proc->msgs_received++;
+        }
+    } else if (dir == Output) {
+        if (chan) {
+            chan->writes++;
+            chan->out_wait_cycles += elapsed;
+            if (elapsed > chan->out_wait_max) chan->out_wait_max = elapsed;
+        }
+        if (proc) {
+            proc->blocked_out_cycles += elapsed;
+            proc->msgs_sent++;
+        }
+    } else if (proc) {
+        proc->blocked_in_cycles += elapsed;
+    }
+    os::criticalExit(cs);
+}
+
+} // namespace csp::internal
+
+// =============================================================
+// FreeRTOS Context-Switch Hooks (called from vTaskSwitchContext)
+// =============================================================
+// RTX has no equivalent hook, so run time stays zero on the RTOS2 backend.
+
+#if !CSP4CMSIS_OS_RTOS2
+extern "C" void csp_stats_task_switched_in(void) {
+    auto* p = static_cast<csp::internal::ProcessPtr>(csp::os::localGet());
+    if (p) p->stats().switched_in_at = csp::internal::cycleCount();
+}
+
+extern "C" void csp_stats_task_switched_out(void) {
+    auto* p = static_cast<csp::internal::ProcessPtr>(csp::os::localGet());
+    if (p) p->stats().run_cycles += csp::internal::cycleCount() - p->stats().switched_in_at;
+}
+#endif
+
+#endif // CSP4CMSIS_STATS
+
+namespace csp {
+
+#if CSP4CMSIS_STATS
+
+static uint32_t percentOf(uint64_t part, uint64_t whole) {
+    return whole ? (uint32_t)((part * 100u) / whole) : 0;
+}
+
+void PrintStats() {
+    using namespace csp::internal;
+
+    HrTime elapsed = HrNow() - HrTime(StatsRegistry::epoch());
+
+    printf("--- CSP Process Stats (%lu us) ---\r\n", (unsigned long)elapsed.to_microseconds());
+    printf("%-16s %5s %12s %12s %12s %8s %8s\r\n",
+           "process", "cpu%", "run_cyc", "blk_in_cyc", "blk_out_cyc", "sent", "recv");
+    for (ProcessStats* s = StatsRegistry::processes(); s != nullptr; s = s->next) {
+        printf("%-16s %5lu %12llu %12llu %12llu %8lu %8lu\r\n",
+               s->owner->name(),
+               (unsigned long)percentOf(s->run_cycles, elapsed.to_cycles()),
+               (unsigned long long)s->run_cycles,
+               (unsigned long long)s->blocked_in_cycles,
+               (unsigned long long)s->blocked_out_cycles,
+               (unsigned long)s->msgs_sent,
+               (unsigned long)s->msgs_received);
+    }
+
+    printf("--- CSP Channel Stats ---\r\n");
+    printf("%-10s %8s %10s %10s %10s %10s %5s\r\n",
+           "channel", "xfers", "in_mean", "in_max", "out_mean", "out_max", "hwm");
+    for (ChannelStats* s = StatsRegistry::channels(); s != nullptr; s = s->next) {
+        uint32_t n_in = s->transfers ? s->transfers : 1;
+        uint32_t n_out = s->writes ? s->writes : 1;
+        printf("%-10p %8lu %10lu %10lu %10lu %10lu %5lu\r\n",
+               s->channel,
+               (unsigned long)s->transfers,
+               (unsigned long)(s->in_wait_cycles / n_in),
+               (unsigned long)s->in_wait_max,
+               (unsigned long)(s->out_wait_cycles / n_out),
+               (unsigned long)s->out_wait_max,
+               (unsigned long)s->high_water);
+    }
+    printf("---------------------------------\r\n");
+}
+
+void ResetStats() {
+    internal::StatsRegistry::reset();
+}
+
+#else
+
+void PrintStats() {
+    printf("[CSP] Statistics disabled (build with -DCSP4CMSIS_STATS=1).\r\n");
+}
+
+void ResetStats() {}
+
+#endif // CSP4CMSIS_STATS
+
+} // namespace csp
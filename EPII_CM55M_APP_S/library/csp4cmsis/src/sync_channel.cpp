@@ -5,14 +5,14 @@
 namespace csp::internal {
 
 // Interval to check for task suspension or timeouts during blocking
-#define WAIT_SLICE_TICKS pdMS_TO_TICKS(100)
+#define WAIT_SLICE_TICKS (os::tickRate() / 10) // 100 ms
 
 // =============================================================
 // SyncChannel Core Implementation
 // =============================================================
 
 SyncChannel::SyncChannel()
-    : mutex(xSemaphoreCreateMutex()),
+    : mutex(os::mutexCreate()),
       state(IDLE),
       data_ptr(nullptr),
       data_len(0),
@@ -22,16 +22,16 @@ SyncChannel::SyncChannel()
       waiting_alt_out(nullptr),
       waiting_alt_bit_out(0),
       waiting_guard_out(nullptr),
-      sender_queue(xQueueCreate(1, 0)),
-      receiver_queue(xQueueCreate(1, 0)),
+      sender_queue(os::semCreate(1, 0)),
+      receiver_queue(os::semCreate(1, 0)),
       res_in_guard(this),  
       res_out_guard(this)  
 {}
 
 SyncChannel::~SyncChannel() {
-    if (mutex) vSemaphoreDelete(mutex);
-    if (sender_queue) vQueueDelete(sender_queue);
-    if (receiver_queue) vQueueDelete(receiver_queue);
+    if (mutex) os::mutexDelete(mutex);
+    if (sender_queue) os::semDelete(sender_queue);
+    if (receiver_queue) os::semDelete(receiver_queue);
 }
 
 void SyncChannel::reset() {
@@ -48,44 +48,44 @@ void SyncChannel::reset() {
 
 // --- Blocking Output (Sender) ---
 void SyncChannel::output(const void* const data_ptr_in) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return;
+    if (!os::mutexLock(mutex)) return;
 
     if (state == RECEIVER_WAITING) {
         // A receiver is already waiting (either blocking or in an ALT)
         data_ptr = data_ptr_in;
         
         AltScheduler* rx_alt = waiting_alt_in; 
-        EventBits_t rx_alt_bit = waiting_alt_bit_in;
+        os::Flags rx_alt_bit = waiting_alt_bit_in;
         bool is_alt_waiter = (waiting_alt_in != nullptr);
 
         waiting_alt_in = nullptr; 
-        xSemaphoreGive(mutex);
+        os::mutexUnlock(mutex);
 
         if (is_alt_waiter) {
             // Wake up the Alternative selection loop
-            xEventGroupSetBits(rx_alt->getEventGroupHandle(), rx_alt_bit);
+            os::flagsSet(rx_alt->getEventGroupHandle(), rx_alt_bit);
         } else {
             // Wake up a blocking input() call
-            xQueueSend(receiver_queue, nullptr, 0);
+            os::semGive(receiver_queue);
         }
 
         // BLOCK: Wait for the Receiver to finish copying data and acknowledge
-        while (xQueueReceive(sender_queue, nullptr, WAIT_SLICE_TICKS) != pdPASS);
+        while (!os::semTake(sender_queue, WAIT_SLICE_TICKS));
     }
     else {
         // No receiver present, wait here as the primary sender
         state = SENDER_WAITING;
         data_ptr = data_ptr_in;
-        xSemaphoreGive(mutex);
+        os::mutexUnlock(mutex);
         
         // Wait until a receiver arrives and signals this queue
-        while (xQueueReceive(sender_queue, nullptr, WAIT_SLICE_TICKS) != pdPASS);
+        while (!os::semTake(sender_queue, WAIT_SLICE_TICKS));
     }
 }
 
 // --- Blocking Input (Receiver) ---
 void SyncChannel::input(void* const data_ptr_out) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return;
+    if (!os::mutexLock(mutex)) return;
 
     if (state == SENDER_WAITING) {
         // Sender is already waiting; perform immediate transfer
@@ -95,36 +95,36 @@ void SyncChannel::input(void* const data_ptr_out) {
 
         AltScheduler* tx_alt = waiting_alt_out;
         bool is_alt_waiter = (waiting_alt_out != nullptr);
-        EventBits_t tx_alt_bit = waiting_alt_bit_out;
+        os::Flags tx_alt_bit = waiting_alt_bit_out;
         
         waiting_alt_out = nullptr; 
 
         if (is_alt_waiter) {
-            xEventGroupSetBits(tx_alt->getEventGroupHandle(), tx_alt_bit);
+            os::flagsSet(tx_alt->getEventGroupHandle(), tx_alt_bit);
         } else {
             // Release the blocking sender
-            xQueueSend(sender_queue, nullptr, 0);
+            os::semGive(sender_queue);
         }
         
         reset(); 
-        xSemaphoreGive(mutex);
+        os::mutexUnlock(mutex);
     }
     else {
         // No sender present, register as the waiting receiver
         state = RECEIVER_WAITING;
-        xSemaphoreGive(mutex);
+        os::mutexUnlock(mutex);
 
         // Wait for a sender to signal the receiver_queue
-        while (xQueueReceive(receiver_queue, nullptr, WAIT_SLICE_TICKS) != pdPASS);
+        while (!os::semTake(receiver_queue, WAIT_SLICE_TICKS));
 
         // After waking, sender has provided data_ptr. Hold mutex to copy and ACK.
-        xSemaphoreTake(mutex, portMAX_DELAY);
+        os::mutexLock(mutex);
         if (data_ptr != nullptr && data_ptr_out != nullptr) {
             memcpy(data_ptr_out, data_ptr, data_len);
         }
-        xQueueSend(sender_queue, nullptr, 0); // Release Sender
+        os::semGive(sender_queue); // Release Sender
         reset();
-        xSemaphoreGive(mutex);
+        os::mutexUnlock(mutex);
     }
 }
 
@@ -132,11 +132,11 @@ void SyncChannel::input(void* const data_ptr_out) {
 // ALT Registration Logic
 // =============================================================
 
-bool SyncChannel::registerAltIn(AltScheduler* alt, EventBits_t bit, SyncChannelInputGuard* guard) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return false;
+bool SyncChannel::registerAltIn(AltScheduler* alt, os::Flags bit, SyncChannelInputGuard* guard) {
+    if (!os::mutexLock(mutex)) return false;
     
     if (state == SENDER_WAITING) { 
-        xSemaphoreGive(mutex); 
+        os::mutexUnlock(mutex); 
         return true; // Already ready for immediate activation
     }
     
@@ -144,23 +144,23 @@ bool SyncChannel::registerAltIn(AltScheduler* alt, EventBits_t bit, SyncChannelI
     waiting_alt_in = alt;
     waiting_alt_bit_in = bit;
     waiting_guard_in = guard;
-    xSemaphoreGive(mutex);
+    os::mutexUnlock(mutex);
     return false;
 }
 
 bool SyncChannel::unregisterAltIn(AltScheduler* alt) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return false;
+    if (!os::mutexLock(mutex)) return false;
     bool completed = (state != RECEIVER_WAITING);
     if (!completed && waiting_alt_in == alt) reset();
-    xSemaphoreGive(mutex);
+    os::mutexUnlock(mutex);
     return completed;
 }
 
-bool SyncChannel::registerAltOut(AltScheduler* alt, EventBits_t bit, SyncChannelOutputGuard* guard) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return false;
+bool SyncChannel::registerAltOut(AltScheduler* alt, os::Flags bit, SyncChannelOutputGuard* guard) {
+    if (!os::mutexLock(mutex)) return false;
     
     if (state == RECEIVER_WAITING) { 
-        xSemaphoreGive(mutex); 
+        os::mutexUnlock(mutex); 
         return true; 
     }
     
@@ -168,15 +168,15 @@ bool SyncChannel::registerAltOut(AltScheduler* alt, EventBits_t bit, SyncChannel
     waiting_alt_out = alt;
     waiting_alt_bit_out = bit;
     waiting_guard_out = guard;
-    xSemaphoreGive(mutex);
+    os::mutexUnlock(mutex);
     return false;
 }
 
 bool SyncChannel::unregisterAltOut(AltScheduler* alt) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return false;
+    if (!os::mutexLock(mutex)) return false;
     bool completed = (state != SENDER_WAITING);
     if (!completed && waiting_alt_out == alt) reset();
-    xSemaphoreGive(mutex);
+    os::mutexUnlock(mutex);
     return completed;
 }
 
@@ -186,7 +186,7 @@ bool SyncChannel::unregisterAltOut(AltScheduler* alt) {
 
 
 
-bool SyncChannelInputGuard::enable(AltScheduler* alt, EventBits_t bit) {
+bool SyncChannelInputGuard::enable(AltScheduler* alt, os::Flags bit) {
     this->parent_alt = alt;
     return channel->registerAltIn(alt, bit, this);
 }
@@ -196,7 +196,7 @@ bool SyncChannelInputGuard::disable() {
 }
 
 void SyncChannelInputGuard::activate() {
-    xSemaphoreTake(channel->getMutex(), portMAX_DELAY);
+    os::mutexLock(channel->getMutex());
     
     // Transfer data from the waiting sender to the bound destination
     if (channel->getDataPtr() != nullptr && user_data_dest != nullptr) {
@@ -204,13 +204,13 @@ void SyncChannelInputGuard::activate() {
     }
     
     // Finalize the rendezvous: Release the blocked sender
-    xQueueSend(channel->getSenderQueue(), nullptr, 0);
+    os::semGive(channel->getSenderQueue());
     
     channel->reset();
-    xSemaphoreGive(channel->getMutex());
+    os::mutexUnlock(channel->getMutex());
 }
 
-bool SyncChannelOutputGuard::enable(AltScheduler* alt, EventBits_t bit) {
+bool SyncChannelOutputGuard::enable(AltScheduler* alt, os::Flags bit) {
     this->parent_alt = alt;
     return channel->registerAltOut(alt, bit, this);
 }
@@ -220,18 +220,18 @@ bool SyncChannelOutputGuard::disable() {
 }
 
 void SyncChannelOutputGuard::activate() {
-    xSemaphoreTake(channel->getMutex(), portMAX_DELAY);
+    os::mutexLock(channel->getMutex());
     
     // Set the data pointer for the arriving receiver to find
     channel->setChannelData(user_data_source, data_size);
     
     // If a receiver was already blocking, wake them now
     if (channel->getState() == SyncChannel::RECEIVER_WAITING) {
-        xQueueSend(channel->getReceiverQueue(), nullptr, 0);
+        os::semGive(channel->getReceiverQueue());
     }
     
     // Note: We do NOT call reset() here; the receiver will call it after copying data.
-    xSemaphoreGive(channel->getMutex());
+    os::mutexUnlock(channel->getMutex());
 }
 
 } // namespace csp::internal
\ No newline at end of file
@@ -0,0 +1,102 @@
+// --- trace.cpp ---
+#include "trace.h"
+#include "process.h"
+#include "os.h"
+#include <cstdio>
+
+#if CSP4CMSIS_TRACE
+#include "cycles.h"
+
+namespace csp::internal {
+
+std::atomic<bool> trace_armed{false};
+
+static TraceRecord ring[CSP4CMSIS_TRACE_DEPTH];
+static std::atomic<uint32_t> ring_head{0};
+static std::atomic<bool> ring_wraps{false};
+
+static std::atomic<uint16_t> next_process_id{1};
+static std::atomic<uint16_t> next_channel_id{1};
+static const char* process_names[CSP4CMSIS_TRACE_MAX_PROCESSES + 1];
+
+uint16_t traceNewId(TraceKind kind) {
+    std::atomic<uint16_t>& next = (kind == TraceKind::Process) ? next_process_id : next_channel_id;
+    return next.fetch_add(1, std::memory_order_relaxed);
+}
+
+void traceNameProcess(uint16_t id, const char* name) {
+    if (id <= CSP4CMSIS_TRACE_MAX_PROCESSES) process_names[id] = name;
+}
+
+void traceWrite(TraceEvent event, uint16_t channel, uint8_t arg) {
+    uint32_t index = ring_head.fetch_add(1, std::memory_order_relaxed);
+    if (index >= CSP4CMSIS_TRACE_DEPTH && !ring_wraps.load(std::memory_order_relaxed)) return;
+
+    // In an ISR the thread-local process is the task it interrupted.
+    const bool isr = os::inIsr();
+    ProcessPtr p = isr ? nullptr : currentProcess();
+    TraceRecord& r = ring[index & (CSP4CMSIS_TRACE_DEPTH - 1)];
+    r.cycles = cycleCount();
+    r.process = isr ? TraceProcessIsr : (p ? p->traceId() : 0);
+    r.channel = channel;
+    r.event = (uint8_t)event;
+    r.arg = arg;
+}
+
+} // namespace csp::internal
+
+namespace csp {
+
+void TraceStart(TraceMode mode) {
+    using namespace csp::internal;
+    cycleCounterInit();
+    trace_armed.store(false, std::memory_order_relaxed);
+    ring_wraps.store(mode == TraceMode::Wrap, std::memory_order_relaxed);
+    ring_head.store(0, std::memory_order_relaxed);
+    trace_armed.store(true, std::memory_order_release);
+}
+
+void TraceStop() {
+    internal::trace_armed.store(false, std::memory_order_release);
+}
+
+void TraceDump() {
+    using namespace csp::internal;
+    TraceStop();
+
+    uint32_t claimed = ring_head.load(std::memory_order_acquire);
+    uint32_t count = claimed < CSP4CMSIS_TRACE_DEPTH ? claimed : CSP4CMSIS_TRACE_DEPTH;
+    uint32_t dropped = claimed - count;
+    // Oldest first: a wrapped ring starts at the slot written next.
+    const bool wraps = ring_wraps.load(std::memory_order_relaxed);
+    uint32_t first = (wraps && claimed > CSP4CMSIS_TRACE_DEPTH) ? claimed : 0;
+
+    printf("trace,begin,%lu,%lu,%lu,%s\r\n", (unsigned long)cycleFrequency(),
+           (unsigned long)count, (unsigned long)dropped, wraps ? "wrap" : "oneshot");
+    for (uint16_t id = 1; id <= CSP4CMSIS_TRACE_MAX_PROCESSES; ++id) {
+        if (process_names[id]) printf("trace,process,%u,%s\r\n", (unsigned)id, process_names[id]);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        const TraceRecord& r = ring[(first + i) & (CSP4CMSIS_TRACE_DEPTH - 1)];
+        printf("trace,%lu,%u,%u,%u,%u\r\n", (unsigned long)r.cycles,
+               (unsigned)r.process, (unsigned)r.channel, (unsigned)r.event, (unsigned)r.arg);
+    }
+    printf("trace,end\r\n");
+}
+
+} // namespace csp
+
+#else
+
+namespace csp {
+
+void TraceStart(TraceMode) {}
+void TraceStop() {}
+
+void TraceDump() {
+    printf("[CSP] Tracing disabled (build with -DCSP4CMSIS_TRACE=1).\r\n");
+}
+
+} // namespace csp
+
+#endif // CSP4CMSIS_TRACE
@@ -0,0 +1,79 @@
+// --- xcore.cpp (Cross-Core Channel Transport) ---
+#include "xcore.h"
+#include "alt.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace csp::internal {
+
+static XcoreTransport* transport = nullptr;
+static os::EventFlags doorbells = nullptr;
+
+// The local end of each channel id that waits in an ALT, if any.
+static AltScheduler* alt_waiter[CSP4CMSIS_XCORE_MAX_CHANNELS];
+static os::Flags alt_bit[CSP4CMSIS_XCORE_MAX_CHANNELS];
+
+XcoreTransport* xcoreTransport() { return transport; }
+
+XcoreRing* xcoreRing(uint32_t id) {
+    if (transport == nullptr || id >= CSP4CMSIS_XCORE_MAX_CHANNELS) {
+        printf("ERROR: Cross-core channel %lu used without xcore::attach() or out of range.\r\n",
+               (unsigned long)id);
+        std::abort();
+    }
+    return reinterpret_cast<XcoreRing*>(static_cast<uint8_t*>(transport->segment())
+                                        + id * CSP4CMSIS_XCORE_SLOT_BYTES);
+}
+
+void xcoreWait(uint32_t id) {
+    os::flagsWaitAny(doorbells, (os::Flags)1U << id);
+}
+
+void xcoreSignal(uint32_t id) {
+    transport->signal(1U << id);
+}
+
+void xcoreRegisterAlt(uint32_t id, AltScheduler* alt, os::Flags bit) {
+    os::CriticalState cs = os::criticalEnter();
+    alt_waiter[id] = alt;
+    alt_bit[id] = bit;
+    os::criticalExit(cs);
+}
+
+void xcoreUnregisterAlt(uint32_t id) {
+    os::CriticalState cs = os::criticalEnter();
+    alt_waiter[id] = nullptr;
+    os::criticalExit(cs);
+}
+
+} // namespace csp::internal
+
+namespace csp::xcore {
+
+using namespace csp::internal;
+
+void attach(XcoreTransport* t, bool owner) {
+    if (doorbells == nullptr) doorbells = os::flagsCreate();
+    if (owner) {
+        const size_t bytes = CSP4CMSIS_XCORE_MAX_CHANNELS * CSP4CMSIS_XCORE_SLOT_BYTES;
+        memset(t->segment(), 0, bytes);
+        t->clean(t->segment(), bytes);
+    }
+    transport = t;
+}
+
+void deliver(uint32_t channel_mask) {
+    channel_mask &= (1U << CSP4CMSIS_XCORE_MAX_CHANNELS) - 1U;
+    if (channel_mask == 0 || doorbells == nullptr) return;
+
+    os::flagsSet(doorbells, channel_mask);
+
+    os::CriticalState cs = os::criticalEnter();
+    for (uint32_t id = 0; id < CSP4CMSIS_XCORE_MAX_CHANNELS; ++id) {
+        if ((channel_mask & (1U << id)) && alt_waiter[id]) alt_waiter[id]->wakeUp(alt_bit[id]);
+    }
+    os::criticalExit(cs);
+}
+
+} // namespace csp::xcore
@@ -0,0 +1,77 @@
+// --- xcore_mailbox.cpp (Cross-Core Transport over the WE2 hxmb Mailbox) ---
+#include "xcore.h"
+
+#if CSP4CMSIS_XCORE_MAILBOX && !defined(CSP4CMSIS_HOST)
+
+#include "WE2_device.h" // CMSIS core_cm55.h: SCB data cache maintenance
+#include "hx_drv_mb.h"
+
+#if CSP4CMSIS_XCORE_SHM_BASE == 0
+#error "CSP4CMSIS_XCORE_MAILBOX needs CSP4CMSIS_XCORE_SHM_BASE: a RAM range both cores leave out of their images."
+#endif
+
+namespace csp::internal {
+
+static const uint32_t DOORBELL_MASK =
+    ((1U << CSP4CMSIS_XCORE_MAX_CHANNELS) - 1U) << CSP4CMSIS_XCORE_DOORBELL_SHIFT;
+
+static void (*forward_event)(uint32_t event) = nullptr;
+
+// Mailbox interrupt of this core: our doorbells go to the channels, the
+// rest to the app's hxmb handler, which clears its own bits.
+static void mailboxIsr(uint32_t event) {
+    const uint32_t doorbells = event & DOORBELL_MASK;
+    if (doorbells) {
+#if CSP4CMSIS_XCORE_LITTLE
+        hx_drv_mb_clear_cm55s_irq(doorbells);
+#else
+        hx_drv_mb_clear_cm55m_irq(doorbells);
+#endif
+        xcore::deliver(doorbells >> CSP4CMSIS_XCORE_DOORBELL_SHIFT);
+    }
+    if ((event & ~DOORBELL_MASK) && forward_event) forward_event(event & ~DOORBELL_MASK);
+}
+
+class MailboxTransport : public XcoreTransport {
+public:
+    void* segment() override { return reinterpret_cast<void*>(CSP4CMSIS_XCORE_SHM_BASE); }
+
+    void signal(uint32_t channel_mask) override {
+        // The other core's interrupt: CM55S from the big core and vice versa.
+#if CSP4CMSIS_XCORE_LITTLE
+        hx_drv_mb_trigger_cm55m_irq(channel_mask << CSP4CMSIS_XCORE_DOORBELL_SHIFT);
+#else
+        hx_drv_mb_trigger_cm55s_irq(channel_mask << CSP4CMSIS_XCORE_DOORBELL_SHIFT);
+#endif
+    }
+
+    void clean(const void* addr, size_t bytes) override {
+        SCB_CleanDCache_by_Addr(const_cast<void*>(addr), (int32_t)bytes);
+    }
+
+    void invalidate(const void* addr, size_t bytes) override {
+        SCB_InvalidateDCache_by_Addr(const_cast<void*>(addr), (int32_t)bytes);
+    }
+};
+
+static MailboxTransport mailbox;
+
+} // namespace csp::internal
+
+namespace csp::xcore {
+
+using namespace csp::internal;
+
+void attachMailbox(void (*forward)(uint32_t event)) {
+    forward_event = forward;
+    attach(&mailbox, !CSP4CMSIS_XCORE_LITTLE);
+#if CSP4CMSIS_XCORE_LITTLE
+    hx_drv_mb_register_cm55s_cb(mailboxIsr);
+#else
+    hx_drv_mb_register_cm55m_cb(mailboxIsr);
+#endif
+}
+
+} // namespace csp::xcore
+
+#endif // CSP4CMSIS_XCORE_MAILBOX && !CSP4CMSIS_HOST
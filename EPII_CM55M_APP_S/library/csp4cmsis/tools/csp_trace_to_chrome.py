@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""Convert a csp4cmsis channel trace dump into Chrome trace JSON.
+
+TraceDump() (library/csp4cmsis/inc/csp/trace.h) prints the trace ring over
+the console UART as lines starting with "trace,". Capture the UART log, e.g.
+with xmodem/serReadLoop.py or the host build, and convert it:
+
+    python3 csp_trace_to_chrome.py uart.log -o frame.json
+
+Open the result in https://ui.perfetto.dev or chrome://tracing. Every CSP
+process is one track; the time it spends blocked on a channel or an ALT is
+shown as a slice, completed handshakes and ALT decisions as instant events,
+and an arrow links the process that completed a rendezvous to the partner it
+woke up. Other lines in the log are ignored; with several dumps in one log
+the last one is converted unless --dump selects another.
+"""
+
+import argparse
+import json
+import sys
+
+EVENTS = ("block", "unblock", "handshake", "alt-enable", "alt-fire")
+BLOCK, UNBLOCK, HANDSHAKE, ALT_ENABLE, ALT_FIRE = range(len(EVENTS))
+OPS = ("read", "write", "alt")
+PID = 1
+ISR = 0xFFFF  # TraceProcessIsr: records made in interrupt context
+
+
+class Dump:
+    def __init__(self, core_hz, count, dropped, mode):
+        self.core_hz = core_hz
+        self.count = count
+        self.dropped = dropped
+        self.mode = mode
+        self.names = {}
+        self.records = []
+        self.complete = False
+
+
+def parse(lines):
+    """Returns every dump found in the log, in order."""
+    dumps = []
+    current = None
+    for line in lines:
+        start = line.find("trace,")
+        if start < 0:
+            continue
+        fields = line[start:].strip().split(",")
+        kind = fields[1] if len(fields) > 1 else ""
+        try:
+            if kind == "begin":
+                current = Dump(int(fields[2]), int(fields[3]), int(fields[4]),
+                               fields[5] if len(fields) > 5 else "oneshot")
+                dumps.append(current)
+            elif current is None:
+                continue
+            elif kind == "process":
+                current.names[int(fields[2])] = ",".join(fields[3:])
+            elif kind == "end":
+                current.complete = True
+                current = None
+            else:
+                cycles, process, channel, event, arg = (int(f) for f in fields[1:6])
+                current.records.append((cycles, process, channel, event, arg))
+        except (IndexError, ValueError):
+            print("skipping malformed line: %s" % line.strip(), file=sys.stderr)
+    return dumps
+
+
+def unwrap(records):
+    """Extends the 32-bit cycle stamps to a monotonic 64-bit time base.
+    Records claimed concurrently may be stamped slightly out of order, so a
+    backward step of less than half the range is kept as such, not a wrap."""
+    out = []
+    now = None
+    previous = None
+    for cycles, process, channel, event, arg in records:
+        if now is None:
+            now = cycles
+        else:
+            delta = (cycles - previous) & 0xFFFFFFFF
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            now += delta
+        previous = cycles
+        out.append((now, process, channel, event, arg))
+    out.sort(key=lambda r: r[0])
+    return out
+
+
+def channel_name(channel):
+    return "c%d" % channel if channel else "timer"
+
+
+def convert(dump):
+    records = unwrap(dump.records)
+    if not records:
+        return {"traceEvents": []}
+
+    origin = records[0][0]
+    scale = 1e6 / dump.core_hz
+
+    def us(t):
+        return round((t - origin) * scale, 3)
+
+    events = [{"ph": "M", "pid": PID, "name": "process_name", "args": {"name": "csp4cmsis"}}]
+    for tid in sorted({r[1] for r in records}):
+        if tid == ISR:
+            label = "interrupt"
+        else:
+            label = "%s #%d" % (dump.names.get(tid, "process"), tid) if tid else "kernel thread"
+        events.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_name", "args": {"name": label}})
+        events.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_sort_index", "args": {"sort_index": tid}})
+
+    blocked = {}      # process -> (start, channel, op) of the open wait
+    completer = {}    # channel -> (process, time) that last completed a handshake on it
+    flow_id = 0
+
+    for t, process, channel, event, arg in records:
+        if event == BLOCK:
+            blocked[process] = (t, channel, arg)
+        elif event == UNBLOCK:
+            start, waited_on, op = blocked.pop(process, (t, channel, arg))
+            op_name = OPS[op] if op < len(OPS) else str(op)
+            name = "wait %s %s" % (op_name, channel_name(waited_on)) if op_name != "alt" else "wait alt"
+            events.append({"ph": "X", "pid": PID, "tid": process, "cat": "block", "name": name,
+                           "ts": us(start), "dur": round((t - start) * scale, 3),
+                           "args": {"channel": waited_on, "cycles": t - start}})
+            source = completer.pop(channel, None)
+            if channel and source and source[0] != process:
+                flow_id += 1
+                events.append({"ph": "s", "pid": PID, "tid": source[0], "cat": "handshake",
+                               "name": channel_name(channel), "id": flow_id, "ts": us(source[1])})
+                events.append({"ph": "f", "bp": "e", "pid": PID, "tid": process, "cat": "handshake",
+                               "name": channel_name(channel), "id": flow_id, "ts": us(t)})
+        elif event in (HANDSHAKE, ALT_ENABLE, ALT_FIRE):
+            if event == HANDSHAKE:
+                op_name = OPS[arg] if arg < len(OPS) else str(arg)
+                name = "%s %s" % (op_name, channel_name(channel))
+            else:
+                name = "%s %s [%d]" % (EVENTS[event], channel_name(channel), arg)
+            events.append({"ph": "i", "s": "t", "pid": PID, "tid": process, "cat": EVENTS[event],
+                           "name": name, "ts": us(t), "args": {"channel": channel, "arg": arg}})
+            if event in (HANDSHAKE, ALT_FIRE) and channel:
+                completer[channel] = (process, t)
+
+    end = records[-1][0]
+    for process, (start, waited_on, op) in blocked.items():
+        events.append({"ph": "X", "pid": PID, "tid": process, "cat": "block",
+                       "name": "wait (still blocked)", "ts": us(start), "dur": round((end - start) * scale, 3),
+                       "args": {"channel": waited_on}})
+
+    return {
+        "traceEvents": events,
+        "displayTimeUnit": "ns",
+        "otherData": {"core_hz": dump.core_hz, "records": len(records),
+                      "dropped": dump.dropped, "mode": dump.mode},
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="UART log containing TraceDump() output ('-' for stdin)")
+    parser.add_argument("-o", "--output", help="JSON file to write (default: stdout)")
+    parser.add_argument("--dump", type=int, default=-1,
+                        help="index of the dump to convert when the log holds several (default: last)")
+    args = parser.parse_args()
+
+    if args.log == "-":
+        dumps = parse(sys.stdin)
+    else:
+        with open(args.log, errors="replace") as f:
+            dumps = parse(f)
+    if not dumps:
+        sys.exit("no trace dump found in %s" % args.log)
+
+    dump = dumps[args.dump]
+    if not dump.complete:
+        print("warning: dump is truncated (no trace,end line)", file=sys.stderr)
+    if dump.dropped:
+        print("note: %d records %s" % (dump.dropped, "overwritten" if dump.mode == "wrap" else "dropped, ring full"),
+              file=sys.stderr)
+
+    trace = convert(dump)
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+        sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+    main()
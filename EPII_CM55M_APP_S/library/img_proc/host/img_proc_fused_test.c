@@ -0,0 +1,266 @@
+/*
+ * library/img_proc/host/img_proc_fused_test.c
+ *
+ * Checks the fused kernels of img_proc_fused.h against a two-pass reference:
+ * resize every plane into a uint8 buffer, then the separate conversion the
+ * apps ran over the tensor (the "- 128" loop, and BGRU3C_to_RGB24(),
+ * Y_to_YYY() and BGRU3C_to_GRAY() of cvapp_fd_fm.cpp). The sizes are those
+ * of the scenario apps plus odd and upscaling ones. It also checks that the
+ * integer resampling stays within 3 of float bilinear (both fractions are
+ * truncated to 1/256 pixel, each worth up to one step of 255/256 on a hard
+ * edge, plus the rounding of either side), and times both.
+ *
+ *   img_proc_fused_test [-r repeats] [-s seed]
+ *
+ * Exits with 1 if any output byte differs.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "img_proc_fused.h"
+
+#define MAX_IN  (640 * 640)
+#define MAX_OUT (320 * 320)
+
+typedef struct {
+    const char *name;
+    int layout;
+    int input_w, input_h, output_w, output_h;
+} test_case_t;
+
+static uint8_t src[3 * MAX_IN];
+static uint8_t resized[3 * MAX_OUT];
+static int8_t ref_out[3 * MAX_OUT], fused_out[3 * MAX_OUT];
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/* ---- pass 1: bilinear resize of one plane, as specified in img_proc_fused.h ---- */
+static void ref_resize(const uint8_t *in, int in_w, int in_h, uint8_t *out, int out_w, int out_h)
+{
+    uint32_t step_x = out_w > 1 ? ((uint32_t)(in_w - 1) << 16) / (uint32_t)(out_w - 1) : 0;
+    uint32_t step_y = out_h > 1 ? ((uint32_t)(in_h - 1) << 16) / (uint32_t)(out_h - 1) : 0;
+    for (int oy = 0; oy < out_h; oy++) {
+        uint32_t y0 = (oy * step_y) >> 16, fy = ((oy * step_y) >> 8) & 0xFF;
+        uint32_t y1 = y0 + 1 < (uint32_t)in_h ? y0 + 1 : y0;
+        for (int ox = 0; ox < out_w; ox++) {
+            uint32_t x0 = (ox * step_x) >> 16, fx = ((ox * step_x) >> 8) & 0xFF;
+            uint32_t x1 = x0 + 1 < (uint32_t)in_w ? x0 + 1 : x0;
+            uint32_t p00 = in[y0 * in_w + x0], p01 = in[y0 * in_w + x1];
+            uint32_t p10 = in[y1 * in_w + x0], p11 = in[y1 * in_w + x1];
+            uint32_t top = p00 * (256 - fx) + p01 * fx;
+            uint32_t bot = p10 * (256 - fx) + p11 * fx;
+            out[oy * out_w + ox] = (uint8_t)((top * (256 - fy) + bot * fy + 32768) >> 16);
+        }
+    }
+}
+
+/* ---- pass 2: the conversions of the apps ---- */
+static void ref_minus_128(const uint8_t *in, int8_t *out, int n)
+{
+    for (int i = 0; i < n; ++i) out[i] = (int8_t)(in[i] - 128);
+}
+
+/* BGRU3C_to_RGB24() of cvapp_fd_fm.cpp */
+static void ref_BGRU3C_to_RGB24(const uint8_t *in_image, int8_t *out_image, int32_t in_image_width, int32_t in_image_height)
+{
+    const uint8_t *b_image = in_image, *g_image = in_image + in_image_width * in_image_height,
+                  *r_image = g_image + in_image_width * in_image_height;
+    for (int32_t y = 0; y < in_image_height; y++) {
+        for (int32_t x = 0; x < in_image_width; x++) {
+            int8_t b = b_image[y * in_image_width + x];
+            int8_t g = g_image[y * in_image_width + x];
+            int8_t r = r_image[y * in_image_width + x];
+            out_image[(in_image_width * y + x) * 3] = r - 128;
+            out_image[(in_image_width * y + x) * 3 + 1] = g - 128;
+            out_image[(in_image_width * y + x) * 3 + 2] = b - 128;
+        }
+    }
+}
+
+/* Y_to_YYY() of cvapp_fd_fm.cpp */
+static void ref_Y_to_YYY(const uint8_t *in_image, int8_t *out_image, int32_t in_image_width, int32_t in_image_height)
+{
+    for (int32_t y = 0; y < in_image_height; y++) {
+        for (int32_t x = 0; x < in_image_width; x++) {
+            int8_t Y = in_image[y * in_image_width + x];
+            out_image[(in_image_width * y + x) * 3] = Y - 128;
+            out_image[(in_image_width * y + x) * 3 + 1] = Y - 128;
+            out_image[(in_image_width * y + x) * 3 + 2] = Y - 128;
+        }
+    }
+}
+
+/* BGRU3C_to_GRAY() of cvapp_fd_fm.cpp. Its weights add up to 1.03, and the
+ * original cast wraps sums above 255 to negative values; the fused kernel
+ * saturates them, so the reference does too. */
+static void ref_BGRU3C_to_GRAY(const uint8_t *in_image, int8_t *out_image, int32_t in_image_width, int32_t in_image_height)
+{
+    const uint8_t *b_image = in_image, *g_image = in_image + in_image_width * in_image_height,
+                  *r_image = g_image + in_image_width * in_image_height;
+    for (int32_t y = 0; y < in_image_height; y++) {
+        for (int32_t x = 0; x < in_image_width; x++) {
+            int32_t b = b_image[y * in_image_width + x];
+            int32_t g = g_image[y * in_image_width + x];
+            int32_t r = r_image[y * in_image_width + x];
+            int16_t r_i = (int16_t)((float)r * (float)0.299);
+            int16_t g_i = (int16_t)((float)g * (float)0.587);
+            int16_t b_i = (int16_t)((float)b * (float)0.144);
+            int32_t v = (b_i + g_i + r_i) - 128;
+            out_image[(in_image_width * y + x)] = (int8_t)(v > 127 ? 127 : v);
+        }
+    }
+}
+
+static int planes_of(int layout)
+{
+    return (layout == IMG_FUSED_BGR8U3C_TO_RGB24 || layout == IMG_FUSED_BGR8U3C_TO_GRAY) ? 3 : 1;
+}
+
+static int channels_of(int layout)
+{
+    return (layout == IMG_FUSED_BGR8U3C_TO_RGB24 || layout == IMG_FUSED_Y8_TO_YYY) ? 3 : 1;
+}
+
+static void two_pass(const test_case_t *tc)
+{
+    int in_plane = tc->input_w * tc->input_h, out_plane = tc->output_w * tc->output_h;
+    for (int p = 0; p < planes_of(tc->layout); p++) {
+        ref_resize(src + p * in_plane, tc->input_w, tc->input_h, resized + p * out_plane, tc->output_w, tc->output_h);
+    }
+    switch (tc->layout) {
+    case IMG_FUSED_Y8_TO_Y8: ref_minus_128(resized, ref_out, out_plane); break;
+    case IMG_FUSED_Y8_TO_YYY: ref_Y_to_YYY(resized, ref_out, tc->output_w, tc->output_h); break;
+    case IMG_FUSED_BGR8U3C_TO_RGB24: ref_BGRU3C_to_RGB24(resized, ref_out, tc->output_w, tc->output_h); break;
+    default: ref_BGRU3C_to_GRAY(resized, ref_out, tc->output_w, tc->output_h); break;
+    }
+}
+
+/* Largest distance of the resized first plane to float bilinear */
+static int float_error(const test_case_t *tc)
+{
+    float w_scale = tc->output_w > 1 ? (float)(tc->input_w - 1) / (tc->output_w - 1) : 0.f;
+    float h_scale = tc->output_h > 1 ? (float)(tc->input_h - 1) / (tc->output_h - 1) : 0.f;
+    int worst = 0;
+    for (int oy = 0; oy < tc->output_h; oy++) {
+        float fy = oy * h_scale;
+        int y0 = (int)fy, y1 = y0 + 1 < tc->input_h ? y0 + 1 : y0;
+        for (int ox = 0; ox < tc->output_w; ox++) {
+            float fx = ox * w_scale;
+            int x0 = (int)fx, x1 = x0 + 1 < tc->input_w ? x0 + 1 : x0;
+            float ax = fx - x0, ay = fy - y0;
+            float top = src[y0 * tc->input_w + x0] * (1 - ax) + src[y0 * tc->input_w + x1] * ax;
+            float bot = src[y1 * tc->input_w + x0] * (1 - ax) + src[y1 * tc->input_w + x1] * ax;
+            int v = (int)(top * (1 - ay) + bot * ay + 0.5f);
+            int d = abs(v - resized[oy * tc->output_w + ox]);
+            if (d > worst) worst = d;
+        }
+    }
+    return worst;
+}
+
+/* Smooth gradients, edges and noise, different per plane */
+static void synth(int w, int h, unsigned seed)
+{
+    srand(seed);
+    for (int p = 0; p < 3; p++) {
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                int v = (x * 255 / w + y * (p + 1) * 97 / h) & 0xFF;
+                if (((x / 17) ^ (y / 13) ^ p) & 1) v = 255 - v;
+                if (rand() % 8 == 0) v = rand() & 0xFF;
+                src[p * w * h + y * w + x] = (uint8_t)v;
+            }
+        }
+    }
+}
+
+static int run_case(const test_case_t *tc, int repeats, unsigned seed)
+{
+    int bytes = tc->output_w * tc->output_h * channels_of(tc->layout);
+    synth(tc->input_w, tc->input_h, seed);
+
+    double t0 = now_us();
+    for (int r = 0; r < repeats; r++) two_pass(tc);
+    double ref_us = (now_us() - t0) / repeats;
+
+    memset(fused_out, 0x5A, sizeof(fused_out));
+    t0 = now_us();
+    for (int r = 0; r < repeats; r++) {
+        hx_lib_image_resize_fused_int8_helium(src, fused_out, tc->input_w, tc->input_h, tc->output_w, tc->output_h,
+                                              -128, tc->layout);
+    }
+    double fused_us = (now_us() - t0) / repeats;
+
+    int diff = 0;
+    for (int i = 0; i < bytes; i++) diff += (ref_out[i] != fused_out[i]);
+    int tail_ok = (fused_out[bytes] == 0x5A); /* nothing written past the tensor */
+    int err = float_error(tc);
+    int ok = (diff == 0 && tail_ok && err <= 3);
+
+    printf("%-15s %3dx%-3d -> %3dx%-3dx%d: two-pass %8.1f us, fused %8.1f us (%4.2fx), float err %d, %s\n",
+           tc->name, tc->input_w, tc->input_h, tc->output_w, tc->output_h, channels_of(tc->layout), ref_us, fused_us,
+           fused_us > 0 ? ref_us / fused_us : 0.0, err, ok ? "match" : "MISMATCH");
+    if (diff) printf("  %d of %d bytes differ\n", diff, bytes);
+    if (!tail_ok) printf("  wrote past the output\n");
+    return ok;
+}
+
+static int check_gray_weights(void)
+{
+    for (int v = 0; v < 256; v++) {
+        if (((v * IMG_FUSED_GRAY_R) >> 16) != (int16_t)((float)v * (float)0.299) ||
+            ((v * IMG_FUSED_GRAY_G) >> 16) != (int16_t)((float)v * (float)0.587) ||
+            ((v * IMG_FUSED_GRAY_B) >> 16) != (int16_t)((float)v * (float)0.144)) {
+            printf("gray weights differ from float at %d\n", v);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    int repeats = 10, opt;
+    unsigned seed = 1;
+    while ((opt = getopt(argc, argv, "r:s:")) != -1) {
+        switch (opt) {
+        case 'r': repeats = atoi(optarg); break;
+        case 's': seed = (unsigned)atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-r repeats] [-s seed]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (repeats <= 0) return 2;
+
+    static const test_case_t cases[] = {
+        /* tflm_yolov8_od / yolo11_od / peoplenet, tflm_yolov8_pose */
+        { "rgb_yolov8", IMG_FUSED_BGR8U3C_TO_RGB24, 640, 480, 224, 224 },
+        { "rgb_pose", IMG_FUSED_BGR8U3C_TO_RGB24, 640, 480, 256, 256 },
+        /* tflm_fd_fm: face detection (YUV and RGB builds), face mesh, iris */
+        { "y_fd", IMG_FUSED_Y8_TO_Y8, 640, 480, 160, 160 },
+        { "gray_fd", IMG_FUSED_BGR8U3C_TO_GRAY, 320, 240, 160, 160 },
+        { "yyy_fm", IMG_FUSED_Y8_TO_YYY, 173, 173, 192, 192 },
+        { "rgb_fm", IMG_FUSED_BGR8U3C_TO_RGB24, 301, 301, 192, 192 },
+        { "yyy_iris", IMG_FUSED_Y8_TO_YYY, 41, 27, 64, 64 },
+        /* tails of the 4-pixel vectors, single row/column, identity */
+        { "rgb_odd", IMG_FUSED_BGR8U3C_TO_RGB24, 37, 23, 13, 7 },
+        { "gray_odd", IMG_FUSED_BGR8U3C_TO_GRAY, 5, 3, 9, 11 },
+        { "y_column", IMG_FUSED_Y8_TO_Y8, 50, 40, 1, 5 },
+        { "y_identity", IMG_FUSED_Y8_TO_Y8, 99, 33, 99, 33 },
+    };
+
+    int ok = check_gray_weights();
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ok &= run_case(&cases[i], repeats, seed + (unsigned)i);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+/*
+ * library/img_proc/host/img_proc_strip_test.cpp
+ *
+ * Checks the band chain of img_proc_strip.h against the frame-sized chain it
+ * replaces in tflm_fd_fm: crop the face box, pad it to a square, then resize
+ * and convert the whole padded image (hx_lib_image_resize_fused_int8_helium).
+ * The windows are face boxes of both fd_fm builds, boxes that leave the
+ * frame and whole frames, each with bands of 1, 2, 7 and 16 rows, and once
+ * with the resized planes only. It prints the scratch each chain needs.
+ *
+ * Then it runs the same jobs through the StripCrop/StripResize processes of
+ * img_proc_strip_csp.h on the csp4cmsis host backend, with two bands in
+ * flight, and exits with 1 if any output byte differs.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include "csp/csp4cmsis.h"
+#include "img_proc_strip_csp.h"
+
+using namespace csp;
+using namespace img_strip;
+
+#define MAX_FRAME   (640 * 480 * 3)
+#define MAX_WIDTH   640
+#define MAX_OUT     (224 * 224 * 3)
+#define CSP_BANDS   2
+
+namespace {
+
+    struct TestCase {
+        const char* name;
+        int layout;
+        int image_w, image_h;
+        int x, y, w, h;             // Face box, padded to a square; w == 0: the whole frame
+        int output_w, output_h;
+    };
+
+    const TestCase cases[] = {
+        // tflm_fd_fm, RGB_320_240_INPUT and YUV_640_480_INPUT
+        { "fm_rgb_wide", IMG_FUSED_BGR8U3C_TO_RGB24, 320, 240, 101, 60, 131, 97, 192, 192 },
+        { "fm_rgb_tall", IMG_FUSED_BGR8U3C_TO_RGB24, 320, 240, 140, 20, 77, 150, 192, 192 },
+        { "fm_yuv", IMG_FUSED_Y8_TO_YYY, 640, 480, 200, 100, 260, 300, 192, 192 },
+        { "fm_yuv_small", IMG_FUSED_Y8_TO_YYY, 640, 480, 300, 200, 41, 41, 192, 192 },
+        // Boxes past the left/top and right/bottom edges
+        { "edge_top_left", IMG_FUSED_BGR8U3C_TO_RGB24, 320, 240, -20, -10, 90, 70, 64, 64 },
+        { "edge_bottom_right", IMG_FUSED_Y8_TO_Y8, 640, 480, 560, 400, 120, 110, 96, 96 },
+        // Whole frames, as the detectors read them
+        { "frame_rgb", IMG_FUSED_BGR8U3C_TO_RGB24, 640, 480, 0, 0, 0, 0, 224, 224 },
+        { "frame_gray", IMG_FUSED_BGR8U3C_TO_GRAY, 320, 240, 0, 0, 0, 0, 160, 160 },
+    };
+    const int band_rows[] = { 1, 2, 7, 16 };
+
+    uint8_t frame[MAX_FRAME];
+    uint8_t crop_img[MAX_FRAME];
+    uint8_t pad_img[MAX_WIDTH * MAX_WIDTH * 3];
+    int8_t ref_out[MAX_OUT], strip_out[MAX_OUT];
+    uint8_t ref_keep[MAX_OUT], strip_keep[MAX_OUT];
+    uint8_t scratch[IMG_STRIP_SCRATCH_SIZE(MAX_WIDTH, 3, 16)];
+    int failures = 0;
+
+    img_strip_window_t window_of(const TestCase& tc)
+    {
+        if (tc.w == 0) return img_strip_window_t{ 0, 0, tc.image_w, tc.image_h, 0, 0, tc.image_w, tc.image_h };
+        return img_strip_square_window(tc.x, tc.y, tc.w, tc.h);
+    }
+
+    size_t output_bytes(const TestCase& tc)
+    {
+        return (size_t)tc.output_w * tc.output_h * img_fused_channels(tc.layout);
+    }
+
+    void synth(const TestCase& tc)
+    {
+        srand(tc.image_w * 7 + tc.x);
+        const int planes = img_fused_planes(tc.layout);
+        for (int p = 0; p < planes; p++) {
+            for (int y = 0; y < tc.image_h; y++) {
+                for (int x = 0; x < tc.image_w; x++) {
+                    int v = (x * 3 + y * (p + 2)) & 0xFF;
+                    if (((x / 11) ^ (y / 9)) & 1) v = 255 - v;
+                    if (rand() % 6 == 0) v = rand() & 0xFF;
+                    frame[(size_t)p * tc.image_w * tc.image_h + (size_t)y * tc.image_w + x] = (uint8_t)v;
+                }
+            }
+        }
+    }
+
+    /* The frame-sized chain: crop_img and pad_img as in cvapp_fd_fm.cpp, then one resize */
+    size_t reference(const TestCase& tc)
+    {
+        const img_strip_window_t win = window_of(tc);
+        const int planes = img_fused_planes(tc.layout);
+        memset(pad_img, 0, sizeof(pad_img));
+        for (int p = 0; p < planes; p++) {
+            for (int y = 0; y < win.h; y++) {
+                for (int x = 0; x < win.w; x++) {
+                    int sx = win.x + x, sy = win.y + y;
+                    uint8_t v = (sx < 0 || sy < 0 || sx >= tc.image_w || sy >= tc.image_h)
+                                ? 0 : frame[(size_t)p * tc.image_w * tc.image_h + (size_t)sy * tc.image_w + sx];
+                    crop_img[(size_t)p * win.w * win.h + (size_t)y * win.w + x] = v;
+                }
+            }
+            for (int y = 0; y < win.h; y++) {
+                memcpy(pad_img + (size_t)p * win.width * win.height + (size_t)(y + win.top) * win.width + win.left,
+                       crop_img + (size_t)p * win.w * win.h + (size_t)y * win.w, win.w);
+            }
+        }
+        hx_lib_image_resize_fused_int8_helium(pad_img, ref_out, win.width, win.height, tc.output_w, tc.output_h,
+                                              -128, tc.layout);
+        // The resized planes, as the iris crop of fd_fm reads them: v - 128 + 128 is exact for 0..255
+        const size_t plane_out = (size_t)tc.output_w * tc.output_h;
+        for (int p = 0; p < planes; p++) {
+            int8_t* q = (int8_t*)ref_keep + p * plane_out;
+            hx_lib_image_resize_fused_int8_helium(pad_img + (size_t)p * win.width * win.height, q,
+                                                  win.width, win.height, tc.output_w, tc.output_h, -128,
+                                                  IMG_FUSED_Y8_TO_Y8);
+            for (size_t i = 0; i < plane_out; i++) ref_keep[p * plane_out + i] = (uint8_t)(q[i] + 128);
+        }
+        return (size_t)planes * win.w * win.h + (size_t)planes * win.width * win.height;
+    }
+
+    bool same(const TestCase& tc, const char* how)
+    {
+        const size_t planes_out = (size_t)img_fused_planes(tc.layout) * tc.output_w * tc.output_h;
+        size_t diff = 0;
+        for (size_t i = 0; i < output_bytes(tc); i++) diff += (ref_out[i] != strip_out[i]);
+        for (size_t i = 0; i < planes_out; i++) diff += (ref_keep[i] != strip_keep[i]);
+        if (diff) {
+            printf("%-18s %s: %zu bytes differ\r\n", tc.name, how, diff);
+            failures++;
+        }
+        return diff == 0;
+    }
+
+    void run_sync(const TestCase& tc)
+    {
+        synth(tc);
+        size_t frame_sized = reference(tc);
+        const img_strip_window_t win = window_of(tc);
+        bool ok = true;
+        for (int rows : band_rows) {
+            memset(strip_out, 0x5A, sizeof(strip_out));
+            memset(strip_keep, 0x5A, sizeof(strip_keep));
+            hx_lib_image_crop_pad_resize_strip_int8(frame, tc.image_w, tc.image_h, &win, strip_out, strip_keep,
+                                                    tc.output_w, tc.output_h, -128, tc.layout, scratch, rows);
+            char how[32];
+            snprintf(how, sizeof(how), "%d-row bands", rows);
+            ok &= same(tc, how);
+        }
+        // Resized planes only (tflm_fd_fm's CSP cascade): the tensor is left alone
+        memcpy(strip_out, ref_out, output_bytes(tc));
+        memset(strip_keep, 0x5A, sizeof(strip_keep));
+        hx_lib_image_crop_pad_resize_strip_int8(frame, tc.image_w, tc.image_h, &win, NULL, strip_keep,
+                                                tc.output_w, tc.output_h, -128, tc.layout, scratch, IMG_STRIP_ROWS);
+        ok &= same(tc, "keep-only");
+        printf("%-18s %3dx%-3d canvas -> %3dx%-3d: crop+pad %7zu B, bands of %d rows %6zu B, %s\r\n",
+               tc.name, win.width, win.height, tc.output_w, tc.output_h, tc.w ? frame_sized : (size_t)0,
+               IMG_STRIP_ROWS, IMG_STRIP_SCRATCH_SIZE(win.width, img_fused_planes(tc.layout), IMG_STRIP_ROWS),
+               ok ? "match" : "MISMATCH");
+    }
+
+    /**
+     * @brief Sends every case through the strip processes and compares the
+     * tensors with the reference, then ends the host run with the result.
+     */
+    class Checker : public CSProcess {
+    private:
+        Chanout<StripJob> jobs;
+        Chanin<StripJob> done;
+    public:
+        Checker(Chanout<StripJob> j, Chanin<StripJob> d) : jobs(j), done(d) {}
+        const char* name() const override { return "checker"; }
+
+        void run() override {
+            for (const TestCase& tc : cases) {
+                synth(tc);
+                reference(tc);
+                memset(strip_out, 0x5A, sizeof(strip_out));
+                memset(strip_keep, 0x5A, sizeof(strip_keep));
+
+                StripJob job;
+                job.image = frame;
+                job.image_w = tc.image_w;
+                job.image_h = tc.image_h;
+                job.window = window_of(tc);
+                job.out = strip_out;
+                job.keep = strip_keep;
+                job.output_w = tc.output_w;
+                job.output_h = tc.output_h;
+                job.layout = tc.layout;
+                job.arg = (void*)&tc;
+                jobs << job;
+                done >> job;
+                bool ok = job.status == 0 && job.arg == &tc && same(tc, "csp");
+                if (job.status != 0) failures++;
+                printf("%-18s csp, %d bands of %d rows: %s\r\n", tc.name, CSP_BANDS, IMG_STRIP_ROWS,
+                       ok ? "match" : "MISMATCH");
+            }
+
+            // A window wider than the bands comes back with status -1
+            StripJob wide;
+            wide.image = frame;
+            wide.image_w = 640;
+            wide.image_h = 480;
+            wide.window = img_strip_square_window(0, 0, MAX_WIDTH + 8, 100);
+            wide.out = strip_out;
+            wide.output_w = wide.output_h = 8;
+            jobs << wide;
+            done >> wide;
+            if (wide.status != -1) failures++;
+            printf("too_wide           csp: %s\r\n", wide.status == -1 ? "rejected" : "NOT REJECTED");
+
+            printf("%s\r\n", failures ? "FAILED" : "all match");
+            fflush(stdout);
+            _exit(failures ? 1 : 0);
+        }
+    };
+
+    void StripTest_Task(void*)
+    {
+        static StripBands<CSP_BANDS, IMG_STRIP_ROWS, MAX_WIDTH, 3> bands;
+        static BufferedOne2OneChannel<StripJob, 1> jobs, done;
+        static BufferedOne2OneChannel<StripBand*, CSP_BANDS> full, free_bands;
+        static uint8_t line[MAX_WIDTH * 3];
+        static StripCrop crop(bands.pool(), bands.count(), jobs.reader(), free_bands.reader(), full.writer());
+        static StripResize resize(line, sizeof(line), full.reader(), free_bands.writer(), done.writer());
+        static Checker checker(jobs.writer(), done.reader());
+
+        Run(InParallel(checker, crop, resize));
+    }
+
+} // namespace
+
+extern "C" void csp_app_main_init(void)
+{
+    for (const TestCase& tc : cases) run_sync(tc);
+    os::spawn(StripTest_Task, NULL, "StripTest", 4096, CSP_OS_PRIORITY_IDLE + 3);
+}
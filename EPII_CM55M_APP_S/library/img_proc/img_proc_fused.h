@@ -0,0 +1,297 @@
+#ifndef _LIB_IMG_PROC_FUSED_H_
+#define _LIB_IMG_PROC_FUSED_H_
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Resize + colour layout + int8 quantization in one pass, writing straight
+ * into a TFLM input tensor:
+ *
+ *   hx_lib_image_resize_BGR8U3C_to_RGB24_int8_helium((uint8_t*)raw_addr, input->data.int8,
+ *           img_w, img_h, 224, 224, -128);
+ *
+ * replaces hx_lib_image_resize_BGR8U3C_to_RGB24_helium() into the tensor
+ * followed by a "data[i] - 128" loop over it.
+ *
+ * Resampling is bilinear with corners aligned, i.e. the mapping of
+ * w_scale = (input_w - 1) / (output_w - 1) used with the img_proc_helium.h
+ * resizers, evaluated in exact integer arithmetic: 16 fractional bits for
+ * the source position, truncated to 8-bit weights, the result rounded to
+ * nearest (within 3 of float bilinear on hard edges). The Helium path
+ * (4 pixels per iteration) and the scalar path therefore give identical bytes;
+ * library/img_proc/host checks them against a two-pass reference.
+ *
+ * The output is saturate(value + zero_point), value being the resized 0..255
+ * pixel: zero_point -128 gives the usual uint8 -> int8 shift.
+ *
+ * Header-only: img_proc itself is shipped as a prebuilt library.
+ * Limits: input_w, input_h < 32768.
+ */
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define IMG_PROC_FUSED_MVE 1
+#else
+#define IMG_PROC_FUSED_MVE 0
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+enum {
+    IMG_FUSED_Y8_TO_Y8,             /* 1 plane -> 1 channel */
+    IMG_FUSED_Y8_TO_YYY,            /* 1 plane -> 3 equal interleaved channels */
+    IMG_FUSED_BGR8U3C_TO_RGB24,     /* B, G, R planes -> interleaved RGB */
+    IMG_FUSED_BGR8U3C_TO_GRAY,      /* B, G, R planes -> 1 channel */
+};
+
+/* Gray weights of cvapp_fd_fm's BGRU3C_to_GRAY() (0.299, 0.587, 0.144) in Q16:
+ * (v * IMG_FUSED_GRAY_R) >> 16 == (int16_t)((float)v * 0.299f) for all v in 0..255 */
+#define IMG_FUSED_GRAY_R 19595
+#define IMG_FUSED_GRAY_G 38470
+#define IMG_FUSED_GRAY_B 9438
+
+/* Source step per output pixel in Q16, corners aligned */
+static inline uint32_t img_fused_step(int input_n, int output_n)
+{
+    return (output_n > 1) ? ((uint32_t)(input_n - 1) << 16) / (uint32_t)(output_n - 1) : 0;
+}
+
+static inline int8_t img_fused_sat(int32_t v)
+{
+    return (int8_t)(v < -128 ? -128 : (v > 127 ? 127 : v));
+}
+
+/* Bilinear sample: rows r0/r1, columns x0/x1, Q8 weights fx/fy */
+static inline int32_t img_fused_sample(const uint8_t *r0, const uint8_t *r1, uint32_t x0, uint32_t x1,
+                                       uint32_t fx, uint32_t fy)
+{
+    uint32_t top = r0[x0] * (256 - fx) + r0[x1] * fx;
+    uint32_t bot = r1[x0] * (256 - fx) + r1[x1] * fx;
+    return (int32_t)((top * (256 - fy) + bot * fy + 32768) >> 16);
+}
+
+static inline int32_t img_fused_gray(int32_t b, int32_t g, int32_t r)
+{
+    return ((r * IMG_FUSED_GRAY_R) >> 16) + ((g * IMG_FUSED_GRAY_G) >> 16) + ((b * IMG_FUSED_GRAY_B) >> 16);
+}
+
+#if IMG_PROC_FUSED_MVE
+static inline int32x4_t img_fused_sample_mve(const uint8_t *r0, const uint8_t *r1, uint32x4_t x0, uint32x4_t x1,
+                                             uint32x4_t fx, uint32x4_t wx, uint32_t fy, mve_pred16_t p)
+{
+    uint32x4_t top = vmulq_u32(vldrbq_gather_offset_z_u32(r0, x0, p), wx);
+    top = vmlaq_u32(top, vldrbq_gather_offset_z_u32(r0, x1, p), fx);
+    uint32x4_t bot = vmulq_u32(vldrbq_gather_offset_z_u32(r1, x0, p), wx);
+    bot = vmlaq_u32(bot, vldrbq_gather_offset_z_u32(r1, x1, p), fx);
+    uint32x4_t v = vmlaq_n_u32(vmulq_n_u32(top, 256 - fy), bot, fy);
+    return vreinterpretq_s32_u32(vshrq_n_u32(vaddq_n_u32(v, 32768), 16));
+}
+
+static inline int32x4_t img_fused_sat_mve(int32x4_t v, int32_t zero_point)
+{
+    v = vaddq_n_s32(v, zero_point);
+    return vminq_s32(vmaxq_s32(v, vdupq_n_s32(-128)), vdupq_n_s32(127));
+}
+#endif
+
+/* Input planes of a layout: 3 for the BGR8U3C ones */
+static inline int img_fused_planes(int layout)
+{
+    return (layout == IMG_FUSED_BGR8U3C_TO_RGB24 || layout == IMG_FUSED_BGR8U3C_TO_GRAY) ? 3 : 1;
+}
+
+/* Output channels of a layout: 3 for RGB24 and YYY */
+static inline int img_fused_channels(int layout)
+{
+    return (layout == IMG_FUSED_BGR8U3C_TO_RGB24 || layout == IMG_FUSED_Y8_TO_YYY) ? 3 : 1;
+}
+
+/**
+ * @brief One output row: interpolates between source rows r0 and r1 with
+ * weight fy, converts and quantizes into row.
+ *
+ * @param[in] r0 upper source row of each input plane (B, G, R or Y)
+ * @param[in] r1 lower source row of each input plane
+ * @param[in] fy Q8 weight of r1
+ * @param[out] row output_w x (1 or 3) int8, or NULL to write keep only
+ * @param[out] keep if not NULL, also receives the resized 0..255 row of each input plane
+ */
+static inline void img_fused_resize_row(const uint8_t *const r0[], const uint8_t *const r1[], int input_w,
+                                        uint32_t step_x, uint32_t fy, int8_t *row, uint8_t *const keep[],
+                                        int output_w, int32_t zero_point, int layout)
+{
+    const int planes = img_fused_planes(layout);
+#if IMG_PROC_FUSED_MVE
+    const uint32x4_t last = vdupq_n_u32((uint32_t)input_w - 1);
+    const uint32x4_t rgb = vmulq_n_u32(vidupq_n_u32(0, 1), 3);
+    for (int ox = 0; ox < output_w; ox += 4) {
+        mve_pred16_t p = vctp32q((uint32_t)(output_w - ox));
+        uint32x4_t sx = vmulq_n_u32(vidupq_n_u32((uint32_t)ox, 1), step_x);
+        uint32x4_t x0 = vshrq_n_u32(sx, 16);
+        uint32x4_t x1 = vminq_u32(vaddq_n_u32(x0, 1), last);
+        uint32x4_t fx = vandq_u32(vshrq_n_u32(sx, 8), vdupq_n_u32(0xFF));
+        uint32x4_t wx = vsubq_u32(vdupq_n_u32(256), fx);
+        int32x4_t v = img_fused_sample_mve(r0[0], r1[0], x0, x1, fx, wx, fy, p);
+        if (keep) vstrbq_p_u32(keep[0] + ox, vreinterpretq_u32_s32(v), p);
+        if (row == NULL) {
+            for (int c = 1; c < planes; c++) {
+                int32x4_t s = img_fused_sample_mve(r0[c], r1[c], x0, x1, fx, wx, fy, p);
+                vstrbq_p_u32(keep[c] + ox, vreinterpretq_u32_s32(s), p);
+            }
+            continue;
+        }
+
+        switch (layout) {
+        case IMG_FUSED_Y8_TO_Y8:
+            vstrbq_p_s32(row + ox, img_fused_sat_mve(v, zero_point), p);
+            break;
+        case IMG_FUSED_Y8_TO_YYY:
+            v = img_fused_sat_mve(v, zero_point);
+            for (int c = 0; c < 3; c++) vstrbq_scatter_offset_p_s32(row + 3 * ox + c, rgb, v, p);
+            break;
+        case IMG_FUSED_BGR8U3C_TO_RGB24: {
+            int32x4_t g = img_fused_sample_mve(r0[1], r1[1], x0, x1, fx, wx, fy, p);
+            int32x4_t r = img_fused_sample_mve(r0[2], r1[2], x0, x1, fx, wx, fy, p);
+            if (keep) {
+                vstrbq_p_u32(keep[1] + ox, vreinterpretq_u32_s32(g), p);
+                vstrbq_p_u32(keep[2] + ox, vreinterpretq_u32_s32(r), p);
+            }
+            vstrbq_scatter_offset_p_s32(row + 3 * ox, rgb, img_fused_sat_mve(r, zero_point), p);
+            vstrbq_scatter_offset_p_s32(row + 3 * ox + 1, rgb, img_fused_sat_mve(g, zero_point), p);
+            vstrbq_scatter_offset_p_s32(row + 3 * ox + 2, rgb, img_fused_sat_mve(v, zero_point), p);
+            break;
+        }
+        default: { /* IMG_FUSED_BGR8U3C_TO_GRAY */
+            int32x4_t g = img_fused_sample_mve(r0[1], r1[1], x0, x1, fx, wx, fy, p);
+            int32x4_t r = img_fused_sample_mve(r0[2], r1[2], x0, x1, fx, wx, fy, p);
+            if (keep) {
+                vstrbq_p_u32(keep[1] + ox, vreinterpretq_u32_s32(g), p);
+                vstrbq_p_u32(keep[2] + ox, vreinterpretq_u32_s32(r), p);
+            }
+            int32x4_t gray = vshrq_n_s32(vmulq_n_s32(r, IMG_FUSED_GRAY_R), 16);
+            gray = vaddq_s32(gray, vshrq_n_s32(vmulq_n_s32(g, IMG_FUSED_GRAY_G), 16));
+            gray = vaddq_s32(gray, vshrq_n_s32(vmulq_n_s32(v, IMG_FUSED_GRAY_B), 16));
+            vstrbq_p_s32(row + ox, img_fused_sat_mve(gray, zero_point), p);
+            break;
+        }
+        }
+    }
+#else
+    for (int ox = 0; ox < output_w; ox++) {
+        uint32_t sx = (uint32_t)ox * step_x;
+        uint32_t x0 = sx >> 16, fx = (sx >> 8) & 0xFF;
+        uint32_t x1 = (x0 + 1 < (uint32_t)input_w) ? x0 + 1 : x0;
+        int32_t b = img_fused_sample(r0[0], r1[0], x0, x1, fx, fy), g = 0, r = 0;
+        if (planes == 3) {
+            g = img_fused_sample(r0[1], r1[1], x0, x1, fx, fy);
+            r = img_fused_sample(r0[2], r1[2], x0, x1, fx, fy);
+        }
+        if (keep) {
+            keep[0][ox] = (uint8_t)b;
+            if (planes == 3) {
+                keep[1][ox] = (uint8_t)g;
+                keep[2][ox] = (uint8_t)r;
+            }
+        }
+        if (row == NULL) continue;
+
+        switch (layout) {
+        case IMG_FUSED_Y8_TO_Y8:
+            row[ox] = img_fused_sat(b + zero_point);
+            break;
+        case IMG_FUSED_Y8_TO_YYY:
+            row[3 * ox] = row[3 * ox + 1] = row[3 * ox + 2] = img_fused_sat(b + zero_point);
+            break;
+        case IMG_FUSED_BGR8U3C_TO_RGB24:
+            row[3 * ox] = img_fused_sat(r + zero_point);
+            row[3 * ox + 1] = img_fused_sat(g + zero_point);
+            row[3 * ox + 2] = img_fused_sat(b + zero_point);
+            break;
+        default: /* IMG_FUSED_BGR8U3C_TO_GRAY */
+            row[ox] = img_fused_sat(img_fused_gray(b, g, r) + zero_point);
+            break;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Resize, convert and quantize in one pass (see the IMG_FUSED_* layouts).
+ *
+ * @param[in] im input image: one plane, or B, G and R planes of input_w x input_h
+ * @param[out] out output tensor, output_w x output_h x (1 or 3) int8
+ * @param[in] zero_point added to each 0..255 value before saturating to int8
+ * @param[in] layout IMG_FUSED_*
+ */
+static inline void hx_lib_image_resize_fused_int8_helium(const uint8_t *im, int8_t *out, int input_w, int input_h,
+                                                         int output_w, int output_h, int32_t zero_point, int layout)
+{
+    const uint32_t plane = (uint32_t)input_w * (uint32_t)input_h;
+    const uint32_t step_x = img_fused_step(input_w, output_w);
+    const uint32_t step_y = img_fused_step(input_h, output_h);
+    const int planes = img_fused_planes(layout);
+    const int out_c = img_fused_channels(layout);
+
+    for (int oy = 0; oy < output_h; oy++) {
+        uint32_t sy = (uint32_t)oy * step_y;
+        uint32_t y0 = sy >> 16, fy = (sy >> 8) & 0xFF;
+        uint32_t y1 = (y0 + 1 < (uint32_t)input_h) ? y0 + 1 : y0;
+        const uint8_t *r0[3], *r1[3];
+        for (int c = 0; c < planes; c++) {
+            r0[c] = im + c * plane + y0 * input_w;
+            r1[c] = im + c * plane + y1 * input_w;
+        }
+        img_fused_resize_row(r0, r1, input_w, step_x, fy, out + (uint32_t)oy * output_w * out_c, NULL,
+                             output_w, zero_point, layout);
+    }
+}
+
+/**
+ * @brief Resize a B, G, R planar image (BBB.../GGG.../RRR...) into an
+ * interleaved RGB int8 tensor.
+ */
+static inline void hx_lib_image_resize_BGR8U3C_to_RGB24_int8_helium(const uint8_t *im, int8_t *out, int input_w, int input_h,
+                                                                    int output_w, int output_h, int32_t zero_point)
+{
+    hx_lib_image_resize_fused_int8_helium(im, out, input_w, input_h, output_w, output_h, zero_point,
+                                          IMG_FUSED_BGR8U3C_TO_RGB24);
+}
+
+/**
+ * @brief Resize a B, G, R planar image into a 1-channel gray int8 tensor.
+ */
+static inline void hx_lib_image_resize_BGR8U3C_to_GRAY_int8_helium(const uint8_t *im, int8_t *out, int input_w, int input_h,
+                                                                   int output_w, int output_h, int32_t zero_point)
+{
+    hx_lib_image_resize_fused_int8_helium(im, out, input_w, input_h, output_w, output_h, zero_point,
+                                          IMG_FUSED_BGR8U3C_TO_GRAY);
+}
+
+/**
+ * @brief Resize a 1-channel (Y) image into a 1-channel int8 tensor.
+ */
+static inline void hx_lib_image_resize_Y8_int8_helium(const uint8_t *im, int8_t *out, int input_w, int input_h,
+                                                      int output_w, int output_h, int32_t zero_point)
+{
+    hx_lib_image_resize_fused_int8_helium(im, out, input_w, input_h, output_w, output_h, zero_point,
+                                          IMG_FUSED_Y8_TO_Y8);
+}
+
+/**
+ * @brief Resize a 1-channel (Y) image into a 3-channel (YYY) int8 tensor.
+ */
+static inline void hx_lib_image_resize_Y8_to_YYY_int8_helium(const uint8_t *im, int8_t *out, int input_w, int input_h,
+                                                             int output_w, int output_h, int32_t zero_point)
+{
+    hx_lib_image_resize_fused_int8_helium(im, out, input_w, input_h, output_w, output_h, zero_point,
+                                          IMG_FUSED_Y8_TO_YYY);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LIB_IMG_PROC_FUSED_H_ */
@@ -0,0 +1,253 @@
+#ifndef _LIB_IMG_PROC_STRIP_H_
+#define _LIB_IMG_PROC_STRIP_H_
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "img_proc_fused.h"
+
+/*
+ * Band (strip) streaming of the crop -> pad -> resize -> convert chain, so
+ * that no frame-sized intermediate image is materialised:
+ *
+ *   frame --crop/pad--> band of rows --resize/convert--> int8 tensor rows
+ *
+ * img_strip_crop_pad() produces rows [y, y + rows) of a padded window of
+ * the frame into a band buffer. img_strip_resize_band() consumes bands in
+ * order and writes every output row whose two source rows it has seen,
+ * through img_fused_resize_row() of img_proc_fused.h. Between bands the
+ * resizer keeps a single source line per plane, so the only scratch is one
+ * band plus one line:
+ *
+ *   uint8_t scratch[IMG_STRIP_SCRATCH_SIZE(640, 1, IMG_STRIP_ROWS)];   // 11KB for a 640-wide Y window
+ *   hx_lib_image_crop_pad_resize_strip_int8(raw, 640, 480, &win, fm_input->data.int8, NULL,
+ *                                           192, 192, -128, IMG_FUSED_Y8_TO_YYY, scratch, IMG_STRIP_ROWS);
+ *
+ * instead of a cropped and a padded copy of the frame. The output is
+ * byte-identical to cropping, padding and calling
+ * hx_lib_image_resize_fused_int8_helium() on the whole padded image.
+ *
+ * img_proc_strip_csp.h runs the two stages as csp4cmsis processes passing
+ * the bands through channels.
+ */
+
+/* Default band height */
+#ifndef IMG_STRIP_ROWS
+#define IMG_STRIP_ROWS 16
+#endif
+
+/* Scratch of the synchronous chain: one band and one line */
+#define IMG_STRIP_SCRATCH_SIZE(width, planes, rows) ((size_t)(width) * (size_t)(planes) * ((size_t)(rows) + 1))
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Rows [y, y + rows) of an image, each plane stored as capacity rows of width bytes */
+typedef struct {
+    uint8_t *data;
+    int capacity;
+    int width;
+    int planes;
+    int y;
+    int rows;
+} img_strip_band_t;
+
+/*
+ * Rectangle (x, y, w, h) of the frame placed at (left, top) of a
+ * width x height canvas. The rest of the canvas, including any part of the
+ * rectangle outside the frame, is zero, as with hx_lib_pad_image().
+ */
+typedef struct {
+    int x, y, w, h;
+    int left, top;
+    int width, height;
+} img_strip_window_t;
+
+/* Resizer state between bands */
+typedef struct {
+    int input_w, input_h;
+    int output_w, output_h;
+    int planes, out_c;
+    uint32_t step_x, step_y;
+    int32_t zero_point;
+    int layout;
+    int8_t *out;
+    uint8_t *keep;
+    uint8_t *line;      /* planes x input_w: last row of the previous band */
+    int next;           /* next output row */
+} img_strip_resize_t;
+
+static inline uint8_t *img_strip_row(const img_strip_band_t *band, int plane, int y)
+{
+    return band->data + ((size_t)plane * band->capacity + (size_t)(y - band->y)) * band->width;
+}
+
+/**
+ * @brief Window of a whole frame, centred on a square canvas of the longer side:
+ * the crop-and-pad of a face box in tflm_fd_fm.
+ */
+static inline img_strip_window_t img_strip_square_window(int x, int y, int w, int h)
+{
+    img_strip_window_t win;
+    int side = (w > h) ? w : h;
+    win.x = x;
+    win.y = y;
+    win.w = w;
+    win.h = h;
+    win.left = (side - w) / 2;
+    win.top = (side - h) / 2;
+    win.width = side;
+    win.height = side;
+    return win;
+}
+
+/**
+ * @brief Fills a band with canvas rows [y, y + rows) of a window of the frame.
+ *
+ * @param[in] im frame, planes of img_w x img_h
+ * @param[in] win window, win->width <= band->width
+ * @param[in,out] band receives the rows; band->capacity >= rows
+ */
+static inline void img_strip_crop_pad(const uint8_t *im, int img_w, int img_h, const img_strip_window_t *win,
+                                      int y, int rows, img_strip_band_t *band)
+{
+    /* Canvas columns [c0, c1) come from frame columns [c0 - left + x, ...) */
+    int c0 = win->left + ((win->x < 0) ? -win->x : 0);
+    int c1 = win->left + win->w;
+    if (win->x + win->w > img_w) c1 -= win->x + win->w - img_w;
+
+    band->y = y;
+    band->rows = rows;
+    for (int p = 0; p < band->planes; p++) {
+        const uint8_t *plane = im + (size_t)p * img_w * img_h;
+        for (int cy = y; cy < y + rows; cy++) {
+            uint8_t *dst = img_strip_row(band, p, cy);
+            int sy = win->y + (cy - win->top);
+            if (cy < win->top || cy >= win->top + win->h || sy < 0 || sy >= img_h || c0 >= c1) {
+                memset(dst, 0, win->width);
+                continue;
+            }
+            memset(dst, 0, c0);
+            memcpy(dst + c0, plane + (size_t)sy * img_w + (win->x + c0 - win->left), c1 - c0);
+            memset(dst + c1, 0, win->width - c1);
+        }
+    }
+}
+
+/**
+ * @brief Starts resizing an input_w x input_h image that arrives in bands.
+ *
+ * @param[in] line scratch of img_fused_planes(layout) x input_w bytes
+ * @param[out] out output tensor, output_w x output_h x (1 or 3) int8, or NULL for keep only
+ * @param[out] keep if not NULL, also receives the resized planes (0..255)
+ */
+static inline void img_strip_resize_init(img_strip_resize_t *st, uint8_t *line, int input_w, int input_h,
+                                         int8_t *out, uint8_t *keep, int output_w, int output_h,
+                                         int32_t zero_point, int layout)
+{
+    st->input_w = input_w;
+    st->input_h = input_h;
+    st->output_w = output_w;
+    st->output_h = output_h;
+    st->planes = img_fused_planes(layout);
+    st->out_c = img_fused_channels(layout);
+    st->step_x = img_fused_step(input_w, output_w);
+    st->step_y = img_fused_step(input_h, output_h);
+    st->zero_point = zero_point;
+    st->layout = layout;
+    st->out = out;
+    st->keep = keep;
+    st->line = line;
+    st->next = 0;
+}
+
+/* Source row y of a plane: in the band, or the line kept from the band before */
+static inline const uint8_t *img_strip_source(const img_strip_resize_t *st, const img_strip_band_t *band,
+                                              int plane, int y)
+{
+    if (y >= band->y) return img_strip_row(band, plane, y);
+    return st->line + (size_t)plane * st->input_w;
+}
+
+/**
+ * @brief Writes the output rows that the band completes.
+ *
+ * Bands must follow each other without gaps, starting at row 0.
+ * @return number of output rows written
+ */
+static inline int img_strip_resize_band(img_strip_resize_t *st, const img_strip_band_t *band)
+{
+    const int last = band->y + band->rows - 1;
+    const size_t plane_out = (size_t)st->output_w * st->output_h;
+    int written = 0;
+
+    while (st->next < st->output_h) {
+        uint32_t sy = (uint32_t)st->next * st->step_y;
+        int y0 = (int)(sy >> 16), fy = (int)((sy >> 8) & 0xFF);
+        int y1 = (y0 + 1 < st->input_h) ? y0 + 1 : y0;
+        if (y1 > last) break;
+
+        const uint8_t *r0[3], *r1[3];
+        uint8_t *keep[3];
+        for (int c = 0; c < st->planes; c++) {
+            r0[c] = img_strip_source(st, band, c, y0);
+            r1[c] = img_strip_source(st, band, c, y1);
+            if (st->keep) keep[c] = st->keep + c * plane_out + (size_t)st->next * st->output_w;
+        }
+        img_fused_resize_row(r0, r1, st->input_w, st->step_x, (uint32_t)fy,
+                             st->out ? st->out + (size_t)st->next * st->output_w * st->out_c : NULL,
+                             st->keep ? keep : NULL, st->output_w, st->zero_point, st->layout);
+        st->next++;
+        written++;
+    }
+
+    /* A pending output row needs at most the last row of this band */
+    if (st->next < st->output_h) {
+        for (int c = 0; c < st->planes; c++) {
+            memcpy(st->line + (size_t)c * st->input_w, img_strip_row(band, c, last), st->input_w);
+        }
+    }
+    return written;
+}
+
+static inline int img_strip_resize_done(const img_strip_resize_t *st)
+{
+    return st->next >= st->output_h;
+}
+
+/**
+ * @brief Crops and pads a window of the frame, then resizes, converts and
+ * quantizes it, one band of band_rows rows at a time.
+ *
+ * @param[in] im frame, img_fused_planes(layout) planes of img_w x img_h
+ * @param[in] win window; the canvas (win->width x win->height) is resized to output_w x output_h
+ * @param[out] out output tensor, output_w x output_h x (1 or 3) int8, or NULL for keep only
+ * @param[out] keep if not NULL, also receives the resized planes (0..255)
+ * @param[in] scratch IMG_STRIP_SCRATCH_SIZE(win->width, planes, band_rows) bytes
+ */
+static inline void hx_lib_image_crop_pad_resize_strip_int8(const uint8_t *im, int img_w, int img_h,
+                                                           const img_strip_window_t *win, int8_t *out, uint8_t *keep,
+                                                           int output_w, int output_h, int32_t zero_point, int layout,
+                                                           uint8_t *scratch, int band_rows)
+{
+    img_strip_band_t band;
+    img_strip_resize_t st;
+    band.planes = img_fused_planes(layout);
+    band.width = win->width;
+    band.capacity = band_rows;
+    band.data = scratch + (size_t)band.planes * win->width;
+    img_strip_resize_init(&st, scratch, win->width, win->height, out, keep, output_w, output_h, zero_point, layout);
+
+    for (int y = 0; y < win->height && !img_strip_resize_done(&st); y += band_rows) {
+        int rows = (win->height - y < band_rows) ? win->height - y : band_rows;
+        img_strip_crop_pad(im, img_w, img_h, win, y, rows, &band);
+        img_strip_resize_band(&st, &band);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LIB_IMG_PROC_STRIP_H_ */
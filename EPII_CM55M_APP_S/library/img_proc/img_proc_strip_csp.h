@@ -0,0 +1,195 @@
+#ifndef _LIB_IMG_PROC_STRIP_CSP_H_
+#define _LIB_IMG_PROC_STRIP_CSP_H_
+#include <stddef.h>
+#include <stdint.h>
+#include "csp/csp4cmsis.h"
+#include "img_proc_strip.h"
+
+/*
+ * The band chain of img_proc_strip.h as two csp4cmsis processes. Bands
+ * circulate as pointers, like the frame slots of tflm_yolov8_od's pipeline:
+ *
+ *   jobs --> StripCrop --band--> StripResize --> done
+ *                ^                    |
+ *                +----free band-------+
+ *
+ * StripCrop cuts the next band while StripResize converts the previous one
+ * into the tensor; with BANDS bands, peak memory is BANDS bands + one line
+ * whatever the frame size. Colour conversion and quantization are part of
+ * the resize stage: they work on the interpolated pixel in registers, so a
+ * stage of their own would only add a band copy.
+ *
+ *   static StripBands<2, IMG_STRIP_ROWS, 640, 3> bands;
+ *   static BufferedOne2OneChannel<StripJob, 1> jobs, done;
+ *   static BufferedOne2OneChannel<StripBand*, 2> full, free_bands;
+ *   static uint8_t line[640 * 3];
+ *   static Pinned<StripCrop, 512> crop(bands.pool(), bands.count(), jobs.reader(), free_bands.reader(), full.writer());
+ *   static Pinned<StripResize, 512> resize(line, sizeof(line), full.reader(), free_bands.writer(), done.writer());
+ *
+ *   jobs.writer() << job;   ...   done.reader() >> job;   // tensor filled
+ */
+namespace img_strip {
+
+    /**
+     * @brief One crop -> pad -> resize -> convert of a frame, sent to StripCrop
+     * and handed back by StripResize when the tensor is complete.
+     */
+    struct StripJob {
+        const uint8_t* image = nullptr;     // Frame, img_fused_planes(layout) planes
+        int image_w = 0;
+        int image_h = 0;
+        img_strip_window_t window{};        // Canvas resized to output_w x output_h
+        int8_t* out = nullptr;
+        uint8_t* keep = nullptr;            // Optional resized planes (0..255)
+        int output_w = 0;
+        int output_h = 0;
+        int32_t zero_point = -128;
+        int layout = IMG_FUSED_BGR8U3C_TO_RGB24;
+        int status = 0;                     // -1 if the window does not fit the bands or the line
+        void* arg = nullptr;                // Caller's, passed through
+    };
+
+    /**
+     * @brief A band with a copy of its job: StripCrop moves on to the next
+     * job while StripResize still works on the bands of this one.
+     */
+    struct StripBand {
+        img_strip_band_t band;
+        StripJob job;
+        bool last;
+    };
+
+    /**
+     * @brief Static storage of BANDS bands of ROWS rows, up to WIDTH x PLANES.
+     */
+    template <size_t BANDS, int ROWS, int WIDTH, int PLANES>
+    class StripBands {
+    private:
+        uint8_t storage[BANDS][(size_t)ROWS * WIDTH * PLANES];
+        StripBand bands[BANDS];
+    public:
+        StripBands() {
+            for (size_t i = 0; i < BANDS; ++i) {
+                bands[i].band = img_strip_band_t{ storage[i], ROWS, WIDTH, PLANES, 0, 0 };
+                bands[i].last = false;
+            }
+        }
+        StripBand* pool() { return bands; }
+        size_t count() const { return BANDS; }
+    };
+
+    /**
+     * @brief Cuts each job's canvas into bands. Takes the pool's bands first,
+     * then waits for returned ones, which paces it to StripResize.
+     */
+    class StripCrop : public csp::CSProcess {
+    private:
+        StripBand* pool;
+        size_t pool_size;
+        size_t fresh = 0;
+        csp::Chanin<StripJob> jobs;
+        csp::Chanin<StripBand*> free_bands;
+        csp::Chanout<StripBand*> out;
+
+        StripBand* take() {
+            StripBand* b;
+            if (fresh < pool_size) b = &pool[fresh++];
+            else free_bands >> b;
+            return b;
+        }
+
+    public:
+        StripCrop(StripBand* bands, size_t count, csp::Chanin<StripJob> j, csp::Chanin<StripBand*> fb,
+                  csp::Chanout<StripBand*> o)
+            : pool(bands), pool_size(count), jobs(j), free_bands(fb), out(o) {}
+        const char* name() const override { return "strip_crop"; }
+
+        void run() override {
+            StripJob job;
+            while (true) {
+                jobs >> job;
+                const img_strip_window_t& win = job.window;
+                const int planes = img_fused_planes(job.layout);
+                StripBand* b = take();
+                if (win.width > b->band.width || planes > b->band.planes || win.height <= 0) {
+                    // Hand the job back unprocessed rather than overflow the band
+                    job.status = -1;
+                    b->band.y = 0;
+                    b->band.rows = 0;
+                    b->job = job;
+                    b->last = true;
+                    out << b;
+                    continue;
+                }
+                for (int y = 0; y < win.height; ) {
+                    int rows = (win.height - y < b->band.capacity) ? win.height - y : b->band.capacity;
+                    img_strip_band_t band = b->band;
+                    band.width = win.width;
+                    band.planes = planes;
+                    img_strip_crop_pad(job.image, job.image_w, job.image_h, &win, y, rows, &band);
+                    y += rows;
+                    b->band.y = band.y;
+                    b->band.rows = band.rows;
+                    b->job = job;
+                    b->last = (y >= win.height);
+                    out << b;
+                    if (y < win.height) b = take();
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Resizes and converts the bands into the job's tensor, returns
+     * them, and hands the job back after its last band.
+     */
+    class StripResize : public csp::CSProcess {
+    private:
+        uint8_t* line;
+        size_t line_size;
+        csp::Chanin<StripBand*> in;
+        csp::Chanout<StripBand*> free_bands;
+        csp::Chanout<StripJob> done;
+        img_strip_resize_t st;
+        bool ok = false;                    // The current job fits the line
+    public:
+        /**
+         * @param scratch one line: at least width x planes of the widest window
+         */
+        StripResize(uint8_t* scratch, size_t scratch_size, csp::Chanin<StripBand*> i,
+                    csp::Chanout<StripBand*> fb, csp::Chanout<StripJob> d)
+            : line(scratch), line_size(scratch_size), in(i), free_bands(fb), done(d) {}
+        const char* name() const override { return "strip_resize"; }
+
+        void run() override {
+            StripBand* b;
+            while (true) {
+                in >> b;
+                const StripJob& job = b->job;
+                const img_strip_window_t& win = job.window;
+                if (b->band.y == 0) {
+                    ok = (job.status == 0 && (size_t)win.width * img_fused_planes(job.layout) <= line_size);
+                    if (ok) {
+                        img_strip_resize_init(&st, line, win.width, win.height, job.out, job.keep,
+                                              job.output_w, job.output_h, job.zero_point, job.layout);
+                    }
+                }
+                if (ok) {
+                    // The band was cut at the window's width, not the pool's
+                    img_strip_band_t band = b->band;
+                    band.width = win.width;
+                    band.planes = img_fused_planes(job.layout);
+                    img_strip_resize_band(&st, &band);
+                }
+                bool last = b->last;
+                StripJob finished = job;
+                if (!ok) finished.status = -1;
+                free_bands << b;
+                if (last) done << finished;
+            }
+        }
+    };
+
+} // namespace img_strip
+
+#endif /* _LIB_IMG_PROC_STRIP_CSP_H_ */
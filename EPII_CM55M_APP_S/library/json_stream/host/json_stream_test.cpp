@@ -0,0 +1,257 @@
+/*
+ * library/json_stream/host/json_stream_test.cpp
+ *
+ * Builds tflm_yolov8_od's send_result.cpp against stand-ins for the UART and
+ * AON register drivers (stub/), sends the same results once through
+ * event_reply() and the std::string serializers and once through the
+ * streaming ones, and checks that the UART receives the same bytes: box and
+ * keypoint lists of several sizes, images from empty to a 30KB JPEG-sized
+ * buffer. The base64 encoder is also checked against el_base64_encode() and
+ * the RFC 4648 vectors for every length up to 100 bytes, with rings small
+ * enough that each group position wraps.
+ *
+ * It counts the heap allocations of each path, and times a 30KB image reply
+ * (on the host the scalar encoder runs; on the Cortex-M55 the Helium one).
+ *
+ * Exits with 1 if any check fails.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <forward_list>
+#include <new>
+#include <random>
+#include <string>
+#include <send_result.h>
+
+void el_base64_encode(const unsigned char* in, int in_len, char* out);
+
+/* Driver stand-ins: the UART writes into uart_capture */
+static char        uart_capture[1 << 20];
+static std::size_t uart_captured = 0;
+
+static int32_t uart_open(uint32_t) { return 0; }
+static int32_t uart_write(const void* data, uint32_t len) {
+    if (uart_captured + len > sizeof(uart_capture)) len = sizeof(uart_capture) - uart_captured;
+    std::memcpy(uart_capture + uart_captured, data, len);
+    uart_captured += len;
+    return (int32_t)len;
+}
+static int32_t uart_read(void*, uint32_t) { return 0; }
+
+static DEV_UART uart_dev = {uart_open, uart_write, uart_read, uart_read};
+
+extern "C" {
+DEV_UART_PTR hx_drv_uart_get_dev(USE_DW_UART_E) { return &uart_dev; }
+void         hx_drv_swreg_aon_set_appused1(uint32_t) {}
+void         hx_drv_swreg_aon_get_appused1(uint32_t* data) { *data = 0; }
+void         SetPSPDNoVid() {}
+}
+
+/* Heap allocations, to show the streaming path makes none */
+static std::size_t allocations = 0;
+
+void* operator new(std::size_t size) {
+    ++allocations;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void  operator delete(void* p) noexcept { std::free(p); }
+void  operator delete[](void* p) noexcept { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("  FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+static std::string take_capture() {
+    std::string s(uart_capture, uart_captured);
+    uart_captured = 0;
+    return s;
+}
+
+struct Frame {
+    uint32_t                        tick;
+    std::forward_list<el_box_t>      boxes;
+    std::forward_list<el_keypoint_t> keypoints;
+    std::vector<uint8_t>             jpeg;
+    el_img_t                         img;
+};
+
+static void make_frame(Frame& f, std::mt19937& rng, int boxes, int people, std::size_t jpeg_size) {
+    auto u16 = [&]() { return (uint16_t)((rng() & 1) ? rng() : (rng() & 1) * 65535u); };
+    f.tick = (rng() & 3) ? rng() : 0xffffffffu;
+    f.boxes.clear();
+    for (int i = 0; i < boxes; i++)
+        f.boxes.push_front(el_box_t{u16(), u16(), u16(), u16(), (uint8_t)rng(), (uint8_t)rng()});
+    f.keypoints.clear();
+    for (int i = 0; i < people; i++) {
+        el_keypoint_t kp{};
+        kp.el_box = el_box_t{u16(), u16(), u16(), u16(), (uint8_t)rng(), (uint8_t)rng()};
+        for (int k = 0; k < KEYPOINT_NUM; k++)
+            kp.el_keypoint[k] = el_point_t{u16(), u16(), (uint8_t)rng(), (uint8_t)rng()};
+        f.keypoints.push_front(kp);
+    }
+    f.jpeg.resize(jpeg_size);
+    for (auto& b : f.jpeg) b = (uint8_t)rng();
+    f.img        = el_img_t{};
+    f.img.data   = jpeg_size ? f.jpeg.data() : nullptr;
+    f.img.size   = jpeg_size;
+    f.img.width  = 640;
+    f.img.height = 480;
+    f.img.format = EL_PIXEL_FORMAT_JPEG;
+}
+
+static void send_legacy(Frame& f, bool keypoints) {
+    if (keypoints)
+        event_reply(concat_strings(", ", algo_tick_2_json_str(f.tick), ", ", keypoint_results_2_json_str(f.keypoints),
+                                   ", ", img_2_json_str(&f.img)));
+    else
+        event_reply(concat_strings(", ", algo_tick_2_json_str(f.tick), ", ", box_results_2_json_str(f.boxes), ", ",
+                                   img_2_json_str(&f.img)));
+}
+
+static void send_stream(Frame& f, bool keypoints) {
+    json_stream_t* reply = event_reply_begin();
+    json_stream_str(reply, ", ");
+    json_stream_algo_tick(reply, f.tick);
+    json_stream_str(reply, ", ");
+    if (keypoints)
+        keypoint_results_2_json_stream(reply, f.keypoints);
+    else
+        box_results_2_json_stream(reply, f.boxes);
+    json_stream_str(reply, ", ");
+    img_2_json_stream(reply, &f.img);
+    event_reply_end(reply);
+}
+
+/* Ring sink that takes at most 'limit' bytes per call, into a flat buffer */
+struct Collector {
+    std::string out;
+    uint32_t    limit;
+};
+
+static uint32_t collect(const char* data, uint32_t len, void* ctx) {
+    Collector* c = static_cast<Collector*>(ctx);
+    if (len > c->limit) len = c->limit;
+    c->out.append(data, len);
+    return len;
+}
+
+static void test_base64() {
+    static const char* const rfc[][2] = {{"", ""},         {"f", "Zg=="},         {"fo", "Zm8="},
+                                         {"foo", "Zm9v"}, {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="},
+                                         {"foobar", "Zm9vYmFy"}};
+    static char ring[4096];
+    for (const auto& v : rfc) {
+        Collector      c{std::string(), 4096};
+        json_stream_t  s;
+        json_stream_init(&s, ring, sizeof(ring), collect, &c);
+        json_stream_base64(&s, reinterpret_cast<const uint8_t*>(v[0]), (uint32_t)std::strlen(v[0]));
+        json_stream_flush(&s);
+        check(c.out == v[1], "RFC 4648 test vector");
+    }
+
+    std::mt19937 rng(1);
+    uint8_t      data[100];
+    char         legacy[140];
+    for (auto& b : data) b = (uint8_t)rng();
+    for (uint32_t size : {16u, 32u, 64u, 4096u}) {
+        for (uint32_t prefix = 0; prefix < 4; prefix++) {
+            for (uint32_t len = 0; len <= sizeof(data); len++) {
+                for (uint32_t limit : {1u, 5u, 4096u}) {
+                    Collector     c{std::string(), limit};
+                    json_stream_t s;
+                    json_stream_init(&s, ring, size, collect, &c);
+                    json_stream_write(&s, "\"\"\"", prefix);
+                    json_stream_base64(&s, data, len);
+                    json_stream_flush(&s);
+
+                    std::memset(legacy, 0, sizeof(legacy));
+                    el_base64_encode(data, (int)len, legacy);
+                    if (c.out != std::string("\"\"\"", prefix) + legacy) {
+                        std::printf("  ring %u, offset %u, %u bytes, sink %u: %s\n", size, prefix, len, limit,
+                                    c.out.c_str());
+                        failures++;
+                    }
+                }
+            }
+        }
+    }
+    std::printf("base64: RFC 4648 vectors, lengths 0..%u on 16..4096 byte rings checked\n", (unsigned)sizeof(data));
+}
+
+int main() {
+    test_base64();
+
+    std::mt19937 rng(2);
+    Frame        f;
+    const struct {
+        int         boxes, people;
+        std::size_t jpeg;
+    } cases[] = {{0, 0, 0}, {1, 0, 1}, {0, 1, 2}, {5, 3, 3}, {100, 10, 17}, {3, 2, 30000}, {20, 1, 30001}};
+
+    for (const auto& k : cases) {
+        for (bool keypoints : {false, true}) {
+            make_frame(f, rng, k.boxes, k.people, k.jpeg);
+            send_legacy(f, keypoints);
+            std::string legacy = take_capture();
+
+            std::size_t before = allocations;
+            send_stream(f, keypoints);
+            std::size_t streamed = allocations - before;
+            std::string stream   = take_capture();
+
+            char what[96];
+            std::snprintf(what, sizeof(what), "%s reply, %d boxes, %d people, %u byte image",
+                          keypoints ? "keypoint" : "box", k.boxes, k.people, (unsigned)k.jpeg);
+            check(stream == legacy, what);
+            check(streamed == 0, "streaming reply allocates nothing");
+            if (stream != legacy) {
+                std::size_t i = 0;
+                while (i < stream.size() && i < legacy.size() && stream[i] == legacy[i]) i++;
+                std::printf("  first difference at byte %u of %u/%u\n", (unsigned)i, (unsigned)stream.size(),
+                            (unsigned)legacy.size());
+            }
+        }
+    }
+    f.img.data = nullptr;
+    send_legacy(f, false);
+    std::string legacy = take_capture();
+    send_stream(f, false);
+    check(take_capture() == legacy, "reply without image data");
+    std::printf("replies: %u result sets byte for byte equal\n", (unsigned)(2 * sizeof(cases) / sizeof(cases[0]) + 1));
+
+    /* 30KB image reply: time and allocations of both paths */
+    make_frame(f, rng, 10, 0, 30000);
+    const int   runs = 200;
+    std::size_t a0   = allocations;
+    auto        t0   = std::chrono::steady_clock::now();
+    for (int r = 0; r < runs; r++) {
+        send_legacy(f, false);
+        uart_captured = 0;
+    }
+    auto        t1 = std::chrono::steady_clock::now();
+    std::size_t a1 = allocations;
+    for (int r = 0; r < runs; r++) {
+        send_stream(f, false);
+        uart_captured = 0;
+    }
+    auto        t2 = std::chrono::steady_clock::now();
+    std::size_t a2 = allocations;
+    auto        us = [](auto d) { return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() / 1000.0; };
+    std::printf("30KB image, 10 boxes: std::string %.1f us and %.1f allocations per reply, stream %.1f us and %.1f\n",
+                us(t1 - t0) / runs, (double)(a1 - a0) / runs, us(t2 - t1) / runs, (double)(a2 - a1) / runs);
+
+    std::printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1 @@
+/* Host stand-in for the WE2 core header: send_result.cpp needs nothing from it */
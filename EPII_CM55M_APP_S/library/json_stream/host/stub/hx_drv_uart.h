@@ -0,0 +1,32 @@
+/*
+ * Host stand-in for drivers/inc/hx_drv_uart.h: the parts send_result.cpp
+ * uses. json_stream_test.cpp provides hx_drv_uart_get_dev().
+ */
+#ifndef JSON_STREAM_HOST_HX_DRV_UART_H
+#define JSON_STREAM_HOST_HX_DRV_UART_H
+#include <stdint.h>
+
+typedef enum USE_DW_UART_S
+{
+    USE_DW_UART_0 = 0,
+    USE_DW_UART_MAX
+} USE_DW_UART_E;
+
+#define UART_BAUDRATE_921600 (921600)
+
+typedef struct dev_uart {
+    int32_t (*uart_open)(uint32_t baud);
+    int32_t (*uart_write)(const void *data, uint32_t len);
+    int32_t (*uart_read)(void *data, uint32_t len);
+    int32_t (*uart_read_nonblock)(void *data, uint32_t len);
+} DEV_UART, *DEV_UART_PTR;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+DEV_UART_PTR hx_drv_uart_get_dev(USE_DW_UART_E uart_id);
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,213 @@
+#include <string.h>
+#include "json_stream.h"
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define JSON_STREAM_MVE 1
+#else
+#define JSON_STREAM_MVE 0
+#endif
+
+/* Ring size */
+static uint32_t ring_size(const json_stream_t *s)
+{
+    return s->mask + 1;
+}
+
+/* Hands the oldest contiguous bytes to the sink */
+static void drain(json_stream_t *s)
+{
+    uint32_t used = s->head - s->tail;
+    uint32_t off = s->tail & s->mask;
+    uint32_t chunk = ring_size(s) - off;
+    if (chunk > used) chunk = used;
+    s->tail += s->sink(s->ring + off, chunk, s->ctx);
+}
+
+/* Contiguous free bytes at the head, after waiting for at least min free ones */
+static uint32_t room(json_stream_t *s, uint32_t min)
+{
+    if (ring_size(s) - (s->head - s->tail) < min) {
+        s->stalls++;
+        do {
+            drain(s);
+        } while (ring_size(s) - (s->head - s->tail) < min);
+    }
+    uint32_t free = ring_size(s) - (s->head - s->tail);
+    uint32_t contiguous = ring_size(s) - (s->head & s->mask);
+    return (free < contiguous) ? free : contiguous;
+}
+
+void json_stream_init(json_stream_t *s, char *ring, uint32_t size, json_stream_sink_t sink, void *ctx)
+{
+    memset(s, 0, sizeof(*s));
+    s->ring = ring;
+    s->mask = size - 1;
+    s->sink = sink;
+    s->ctx = ctx;
+}
+
+void json_stream_write(json_stream_t *s, const char *data, uint32_t len)
+{
+    while (len > 0) {
+        uint32_t n = room(s, 1);
+        if (n > len) n = len;
+        memcpy(s->ring + (s->head & s->mask), data, n);
+        s->head += n;
+        data += n;
+        len -= n;
+    }
+}
+
+void json_stream_str(json_stream_t *s, const char *str)
+{
+    json_stream_write(s, str, (uint32_t)strlen(str));
+}
+
+void json_stream_uint(json_stream_t *s, uint32_t v)
+{
+    char digits[10];
+    uint32_t n = 0;
+    do {
+        digits[sizeof(digits) - ++n] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v != 0);
+    json_stream_write(s, digits + sizeof(digits) - n, n);
+}
+
+void json_stream_int(json_stream_t *s, int32_t v)
+{
+    if (v < 0) {
+        json_stream_write(s, "-", 1);
+        json_stream_uint(s, 0u - (uint32_t)v);
+    } else {
+        json_stream_uint(s, (uint32_t)v);
+    }
+}
+
+/*
+ * Base64. The Helium path maps the 6-bit indices to characters without a
+ * table, four groups per vector: c + 'A', c + 'a' - 26, c + '0' - 52, '+' or
+ * '/' selected by compares. The scalar path (tail groups, and builds without
+ * MVE) looks them up.
+ */
+static const char base64_chars[64] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/* groups * 3 bytes to groups * 4 characters */
+static void base64_groups(const uint8_t *in, char *out, uint32_t groups)
+{
+#if JSON_STREAM_MVE
+    static const uint32_t lane_offsets[4] = { 0, 3, 6, 9 };
+    const uint32x4_t offsets = vld1q_u32(lane_offsets);
+    for (; groups >= 4; groups -= 4, in += 12, out += 16) {
+        uint32x4_t b0 = vldrbq_gather_offset_u32(in, offsets);
+        uint32x4_t b1 = vldrbq_gather_offset_u32(in + 1, offsets);
+        uint32x4_t b2 = vldrbq_gather_offset_u32(in + 2, offsets);
+        uint32x4_t w = vorrq_u32(vorrq_u32(vshlq_n_u32(b0, 16), vshlq_n_u32(b1, 8)), b2);
+        uint32x4_t idx = vorrq_u32(vorrq_u32(vshrq_n_u32(w, 18), vandq_u32(vshrq_n_u32(w, 4), vdupq_n_u32(0x3f00u))),
+                                   vorrq_u32(vandq_u32(vshlq_n_u32(w, 10), vdupq_n_u32(0x3f0000u)),
+                                             vandq_u32(vshlq_n_u32(w, 24), vdupq_n_u32(0x3f000000u))));
+        uint8x16_t c = vreinterpretq_u8_u32(idx);
+        uint8x16_t off = vdupq_n_u8('A');
+        off = vpselq_u8(vdupq_n_u8((uint8_t)('a' - 26)), off, vcmphiq_n_u8(c, 25));
+        off = vpselq_u8(vdupq_n_u8((uint8_t)('0' - 52)), off, vcmphiq_n_u8(c, 51));
+        off = vpselq_u8(vdupq_n_u8((uint8_t)('+' - 62)), off, vcmpeqq_n_u8(c, 62));
+        off = vpselq_u8(vdupq_n_u8((uint8_t)('/' - 63)), off, vcmpeqq_n_u8(c, 63));
+        vst1q_u8((uint8_t *)out, vaddq_u8(c, off));
+    }
+#endif
+    for (; groups > 0; groups--, in += 3, out += 4) {
+        uint32_t w = ((uint32_t)in[0] << 16) | ((uint32_t)in[1] << 8) | in[2];
+        out[0] = base64_chars[w >> 18];
+        out[1] = base64_chars[(w >> 12) & 0x3f];
+        out[2] = base64_chars[(w >> 6) & 0x3f];
+        out[3] = base64_chars[w & 0x3f];
+    }
+}
+
+void json_stream_base64(json_stream_t *s, const uint8_t *data, uint32_t len)
+{
+    char quad[4];
+    while (len >= 3) {
+        uint32_t groups = room(s, 4) / 4;
+        if (groups > len / 3) groups = len / 3;
+        if (groups == 0) {
+            /* Less than a group before the end of the ring: wrap through write() */
+            base64_groups(data, quad, 1);
+            json_stream_write(s, quad, 4);
+            groups = 1;
+        } else {
+            base64_groups(data, s->ring + (s->head & s->mask), groups);
+            s->head += groups * 4;
+        }
+        data += groups * 3;
+        len -= groups * 3;
+    }
+    if (len > 0) {
+        uint8_t last[3] = { data[0], (len > 1) ? data[1] : (uint8_t)0, 0 };
+        base64_groups(last, quad, 1);
+        quad[3] = '=';
+        if (len == 1) quad[2] = '=';
+        json_stream_write(s, quad, 4);
+    }
+}
+
+void json_stream_flush(json_stream_t *s)
+{
+    while (s->head != s->tail) drain(s);
+}
+
+void json_stream_invoke_begin(json_stream_t *s)
+{
+    json_stream_str(s, "\r{\"type\": 1, \"name\": \"INVOKE\", \"code\": 0, \"data\": {\"count\": 0");
+}
+
+void json_stream_invoke_end(json_stream_t *s)
+{
+    json_stream_str(s, "}}\n");
+    json_stream_flush(s);
+}
+
+void json_stream_box(json_stream_t *s, uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint32_t score, uint32_t target)
+{
+    json_stream_write(s, "[", 1);
+    json_stream_uint(s, x);
+    json_stream_write(s, ", ", 2);
+    json_stream_uint(s, y);
+    json_stream_write(s, ", ", 2);
+    json_stream_uint(s, w);
+    json_stream_write(s, ", ", 2);
+    json_stream_uint(s, h);
+    json_stream_write(s, ", ", 2);
+    json_stream_uint(s, score);
+    json_stream_write(s, ", ", 2);
+    json_stream_uint(s, target);
+    json_stream_write(s, "]", 1);
+}
+
+void json_stream_point(json_stream_t *s, uint32_t x, uint32_t y, uint32_t score, uint32_t target)
+{
+    json_stream_write(s, "[", 1);
+    json_stream_uint(s, x);
+    json_stream_write(s, ", ", 2);
+    json_stream_uint(s, y);
+    json_stream_write(s, ", ", 2);
+    json_stream_uint(s, score);
+    json_stream_write(s, ", ", 2);
+    json_stream_uint(s, target);
+    json_stream_write(s, "]", 1);
+}
+
+void json_stream_algo_tick(json_stream_t *s, uint32_t tick)
+{
+    json_stream_str(s, "\"algo_tick\": [[");
+    json_stream_uint(s, tick);
+    json_stream_str(s, "]]");
+}
+
+void json_stream_image(json_stream_t *s, const uint8_t *data, uint32_t size)
+{
+    json_stream_str(s, "\"image\": \"");
+    if (data != NULL && size != 0) json_stream_base64(s, data, size);
+    json_stream_write(s, "\"", 1);
+}
@@ -0,0 +1,86 @@
+#ifndef _LIB_JSON_STREAM_H_
+#define _LIB_JSON_STREAM_H_
+#include <stdint.h>
+
+/*
+ * Streaming JSON writer for the result replies of the tflm_* scenario apps.
+ *
+ * send_result.cpp of the apps builds each reply as one std::string, with a
+ * base64 copy of the whole JPEG, before the first byte goes out. Here the
+ * tokens and the base64 text are written straight into a fixed transmit
+ * ring, and a sink (the UART sender) is handed the oldest bytes whenever the
+ * ring fills up and at the end of the reply. Nothing is allocated, and the
+ * memory needed is the ring, whatever the size of the image.
+ *
+ *   static char ring[4096];
+ *   static json_stream_t tx;
+ *   json_stream_init(&tx, ring, sizeof(ring), uart_sink, NULL);
+ *   json_stream_invoke_begin(&tx);
+ *   json_stream_str(&tx, ", ");
+ *   json_stream_image(&tx, jpeg, jpeg_size);
+ *   json_stream_invoke_end(&tx);
+ *
+ * The output is byte for byte the one of send_result.cpp (see host/).
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Takes up to len bytes from the ring. Returns the number taken, at
+ * least 1; they may be overwritten as soon as it returns.
+ */
+typedef uint32_t (*json_stream_sink_t)(const char *data, uint32_t len, void *ctx);
+
+typedef struct {
+    char *ring;
+    uint32_t mask;              /* ring size - 1 */
+    uint32_t head;              /* bytes written */
+    uint32_t tail;              /* bytes taken by the sink */
+    json_stream_sink_t sink;
+    void *ctx;
+    uint32_t stalls;            /* times the writer waited for the sink */
+} json_stream_t;
+
+/**
+ * @brief Starts an empty ring.
+ * @param[in] size ring size, a power of two of at least 16 bytes
+ */
+void json_stream_init(json_stream_t *s, char *ring, uint32_t size, json_stream_sink_t sink, void *ctx);
+
+void json_stream_write(json_stream_t *s, const char *data, uint32_t len);
+void json_stream_str(json_stream_t *s, const char *str);
+/* Decimal, as std::to_string() */
+void json_stream_uint(json_stream_t *s, uint32_t v);
+void json_stream_int(json_stream_t *s, int32_t v);
+/* Standard base64 (RFC 4648) with '=' padding, encoded into the ring */
+void json_stream_base64(json_stream_t *s, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Hands everything written so far to the sink.
+ */
+void json_stream_flush(json_stream_t *s);
+
+/*
+ * Tokens of the SSCMA replies, as send_result.cpp writes them
+ */
+/* "\r{"type": 1, "name": "INVOKE", "code": 0, "data": {"count": 0", as event_reply() */
+void json_stream_invoke_begin(json_stream_t *s);
+/* Closes the reply and flushes it */
+void json_stream_invoke_end(json_stream_t *s);
+/* [x, y, w, h, score, target] of an el_box_t */
+void json_stream_box(json_stream_t *s, uint32_t x, uint32_t y, uint32_t w, uint32_t h, uint32_t score, uint32_t target);
+/* [x, y, score, target] of an el_point_t */
+void json_stream_point(json_stream_t *s, uint32_t x, uint32_t y, uint32_t score, uint32_t target);
+/* "algo_tick": [[tick]] */
+void json_stream_algo_tick(json_stream_t *s, uint32_t tick);
+/* "image": "<base64>", empty for no data */
+void json_stream_image(json_stream_t *s, const uint8_t *data, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LIB_JSON_STREAM_H_ */
@@ -0,0 +1,173 @@
+/*
+ * library/tflm_arena/host/tflm_arena_test.c
+ *
+ * Plans model sets shaped like the apps' (tflm_fd_fm's three models, a
+ * detector hot-swapped for a smaller and a larger one) and checks every plan:
+ * blocks inside the region and aligned, no live blocks overlapping, models
+ * that fit around the resident ones placed without moving them, and a
+ * failed plan leaving the old placements alone. It prints the bytes saved
+ * over one arena per model and the time a plan takes.
+ *
+ * The sizes follow the proportions of the apps' Vela-compiled models: a
+ * kilobyte or a few of persistent data, hundreds of kilobytes of scratch.
+ *
+ * Exits with 1 if any check fails.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tflm_arena.h"
+
+#define KB 1024u
+
+static int failures = 0;
+
+static uint32_t host_clock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec);
+}
+
+static void check(int ok, const char *what)
+{
+    if (!ok) {
+        printf("  FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+static int live_together(const tflm_arena_t *a, int i, int k, int j, int l)
+{
+    if (i == j) return 1;
+    if (k == 0 || l == 0) return 1;
+    return ((a->model[i].concurrent >> j) & 1) || ((a->model[j].concurrent >> i) & 1);
+}
+
+/* Every resident block in the region, aligned, and apart from the blocks live with it */
+static void validate(const tflm_arena_t *a)
+{
+    uint32_t off[TFLM_ARENA_MAX_MODELS][2], size[TFLM_ARENA_MAX_MODELS][2];
+    for (uint32_t i = 0; i < a->count; i++) {
+        const tflm_arena_model_t *m = &a->model[i];
+        off[i][0] = m->persistent_off;
+        off[i][1] = m->scratch_off;
+        size[i][0] = m->persistent;
+        size[i][1] = m->scratch;
+        if (!m->resident) continue;
+        check(m->placed, "resident model placed");
+        for (int k = 0; k < 2; k++) {
+            check(off[i][k] % TFLM_ARENA_ALIGN == 0, "block aligned");
+            check(off[i][k] + size[i][k] <= a->used && a->used <= a->size, "block inside the plan");
+        }
+    }
+    for (uint32_t i = 0; i < a->count; i++) {
+        for (uint32_t j = i; j < a->count; j++) {
+            if (!a->model[i].resident || !a->model[j].resident) continue;
+            for (int k = 0; k < 2; k++) {
+                for (int l = (i == j) ? k + 1 : 0; l < 2; l++) {
+                    if (!size[i][k] || !size[j][l] || !live_together(a, i, k, j, l)) continue;
+                    if (off[i][k] < off[j][l] + size[j][l] && off[j][l] < off[i][k] + size[i][k]) {
+                        printf("  %s %s [%u, %u) overlaps %s %s [%u, %u)\n",
+                               a->model[i].name, k ? "scratch" : "persistent", off[i][k], off[i][k] + size[i][k],
+                               a->model[j].name, l ? "scratch" : "persistent", off[j][l], off[j][l] + size[j][l]);
+                        failures++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void print_plan(const char *title, const tflm_arena_t *a)
+{
+    printf("%s\n", title);
+    for (uint32_t i = 0; i < a->count; i++) {
+        const tflm_arena_model_t *m = &a->model[i];
+        if (!m->resident) continue;
+        printf("  %-8s persistent %7u B at %7u, scratch %7u B at %7u%s\n", m->name, m->persistent,
+               m->persistent_off, m->scratch, m->scratch_off, m->stale ? ", (re)create" : "");
+    }
+    printf("  used %u of %u B, %u B saved over one arena per model, plan %u ns\n", a->used, a->size,
+           tflm_arena_saved(a), a->plan_cycles);
+}
+
+static uint8_t region[1600 * KB];
+
+int main(void)
+{
+    tflm_arena_t a;
+
+    /* tflm_fd_fm: detection, mesh and iris take turns on the NPU */
+    tflm_arena_init(&a, region, 460 * KB, host_clock);
+    tflm_arena_add(&a, "fd", 1224, 452 * KB, 0);
+    tflm_arena_add(&a, "fm", 1180, 292 * KB, 0);
+    tflm_arena_add(&a, "il", 1100, 61 * KB, 0);
+    check(tflm_arena_plan(&a) == 0, "fd_fm fits in 460KB");
+    print_plan("fd_fm, sequential", &a);
+    validate(&a);
+    check(a.used == 452 * KB + 1232 + 1184 + 1104, "scratch overlaid, persistent stacked");
+    check(tflm_arena_saved(&a) == 292 * KB + 61 * KB, "saved the two smaller scratch blocks");
+
+    /* Iris of one face while mesh of the next: their scratch must not overlap */
+    tflm_arena_init(&a, region, 1024 * KB, host_clock);
+    tflm_arena_add(&a, "fd", 1224, 452 * KB, 0);
+    tflm_arena_add(&a, "fm", 1180, 292 * KB, 1u << 2);
+    tflm_arena_add(&a, "il", 1100, 61 * KB, 0);
+    check(tflm_arena_plan(&a) == 0, "fd_fm concurrent fits in 1MB");
+    print_plan("fd_fm, mesh and iris concurrent", &a);
+    validate(&a);
+    check(a.used == 452 * KB + 1232 + 1184 + 1104, "iris scratch beside mesh scratch, under detection's");
+
+    /* Detector hot-swap (day/night): a smaller model fits where the old one was */
+    tflm_arena_init(&a, region, 1100 * KB, host_clock);
+    int od = tflm_arena_add(&a, "yolov8n", 5200, 1053 * KB, 0);
+    int cls = tflm_arena_add(&a, "cls", 900, 24 * KB, 0);
+    check(tflm_arena_plan(&a) == 0, "detector and classifier fit");
+    print_plan("detector + classifier", &a);
+    validate(&a);
+    uint32_t cls_off = a.model[cls].persistent_off;
+
+    tflm_arena_swap(&a, od, "night", 4100, 800 * KB);
+    check(tflm_arena_plan(&a) == 0, "smaller detector fits");
+    print_plan("swap for a smaller detector", &a);
+    validate(&a);
+    check(a.model[od].stale && !a.model[cls].stale, "only the new detector (re)created");
+    check(a.model[cls].persistent_off == cls_off && a.replans == 0, "classifier left in place");
+
+    /* A larger one does not fit around the classifier: everything is re-planned */
+    tflm_arena_swap(&a, od, "yolov8s", 9000, 1060 * KB);
+    check(tflm_arena_plan(&a) == 0, "larger detector fits after a re-plan");
+    print_plan("swap for a larger detector", &a);
+    validate(&a);
+    check(a.replans == 1 && a.model[cls].stale, "classifier moved and flagged");
+
+    /* Too large: the plan fails and the resident model keeps its blocks */
+    tflm_arena_release(&a, od);
+    check(tflm_arena_plan(&a) == 0, "classifier alone");
+    cls_off = a.model[cls].persistent_off;
+    tflm_arena_swap(&a, od, "huge", 64 * KB, 1100 * KB);
+    check(tflm_arena_plan(&a) == -1, "oversized detector rejected");
+    check(a.model[cls].persistent_off == cls_off && a.model[cls].placed, "classifier placement kept");
+    printf("oversized detector: rejected, classifier kept at %u\n", cls_off);
+
+    /* Plan time, eight models */
+    tflm_arena_init(&a, region, sizeof(region), host_clock);
+    for (int i = 0; i < TFLM_ARENA_MAX_MODELS; i++) {
+        tflm_arena_add(&a, "m", 700 + 300 * i, (uint32_t)(17 + 29 * i) * KB, (i & 1) ? 1u : 0);
+    }
+    uint32_t best = UINT32_MAX;
+    for (int r = 0; r < 200; r++) {
+        for (int i = 0; i < TFLM_ARENA_MAX_MODELS; i++) tflm_arena_release(&a, i);
+        for (int i = 0; i < TFLM_ARENA_MAX_MODELS; i++) a.model[i].resident = 1;
+        check(tflm_arena_plan(&a) == 0, "eight models fit");
+        if (a.plan_cycles < best) best = a.plan_cycles;
+    }
+    validate(&a);
+    printf("%d models: used %u B, %u B saved, full plan %u ns\n", TFLM_ARENA_MAX_MODELS, a.used,
+           tflm_arena_saved(&a), best);
+
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,170 @@
+#include <string.h>
+#include "tflm_arena.h"
+
+/* Blocks: 2 * model + 0 for the persistent block, 2 * model + 1 for the scratch block */
+#define BLOCKS (2 * TFLM_ARENA_MAX_MODELS)
+
+typedef struct {
+    uint32_t off[BLOCKS];
+    uint32_t size[BLOCKS];
+    uint8_t placed[BLOCKS];
+} layout_t;
+
+/* Two blocks are live at the same time unless both are scratch of models that never run together */
+static int conflict(const tflm_arena_t *a, int b0, int b1)
+{
+    int m0 = b0 >> 1, m1 = b1 >> 1;
+    if (m0 == m1) return 1;
+    if (!(b0 & 1) || !(b1 & 1)) return 1;
+    return ((a->model[m0].concurrent >> m1) & 1) || ((a->model[m1].concurrent >> m0) & 1);
+}
+
+static int overlaps(const layout_t *l, int b, uint32_t off, uint32_t size)
+{
+    return off < l->off[b] + l->size[b] && l->off[b] < off + size;
+}
+
+/* Lowest offset where block b fits next to the placed blocks it conflicts with */
+static int place(const tflm_arena_t *a, layout_t *l, int b)
+{
+    uint32_t best = UINT32_MAX;
+    for (int c = -1; c < BLOCKS; c++) {
+        uint32_t off;
+        if (c < 0) {
+            off = 0;
+        } else {
+            if (!l->placed[c] || !l->size[c] || !conflict(a, b, c)) continue;
+            off = tflm_arena_align(l->off[c] + l->size[c]);
+        }
+        if (off >= best || off + l->size[b] > a->size || off + l->size[b] < off) continue;
+
+        int free = 1;
+        for (int o = 0; o < BLOCKS && free; o++) {
+            if (l->placed[o] && l->size[o] && conflict(a, b, o) && overlaps(l, o, off, l->size[b])) free = 0;
+        }
+        if (free) best = off;
+    }
+    if (best == UINT32_MAX) return -1;
+    l->off[b] = best;
+    l->placed[b] = 1;
+    return 0;
+}
+
+/* Places the unplaced blocks of the layout, largest first */
+static int place_all(const tflm_arena_t *a, layout_t *l, const uint8_t *todo)
+{
+    uint8_t done[BLOCKS];
+    memcpy(done, todo, sizeof(done));
+    for (int b = 0; b < BLOCKS; b++) done[b] = !done[b];
+
+    for (;;) {
+        int next = -1;
+        for (int b = 0; b < BLOCKS; b++) {
+            if (!done[b] && (next < 0 || l->size[b] > l->size[next])) next = b;
+        }
+        if (next < 0) return 0;
+        done[next] = 1;
+        if (l->size[next] == 0) {
+            l->off[next] = 0;
+            l->placed[next] = 1;
+            continue;
+        }
+        if (place(a, l, next) != 0) return -1;
+    }
+}
+
+void tflm_arena_init(tflm_arena_t *a, uint8_t *base, uint32_t size, uint32_t (*clock)(void))
+{
+    memset(a, 0, sizeof(*a));
+    a->base = base;
+    a->size = size;
+    a->clock = clock;
+}
+
+int tflm_arena_add(tflm_arena_t *a, const char *name, uint32_t persistent, uint32_t scratch, uint32_t concurrent)
+{
+    if (a->count >= TFLM_ARENA_MAX_MODELS) return -1;
+    int id = (int)a->count++;
+    tflm_arena_model_t *m = &a->model[id];
+    memset(m, 0, sizeof(*m));
+    m->name = name;
+    m->persistent = persistent;
+    m->scratch = scratch;
+    m->concurrent = concurrent;
+    m->resident = 1;
+    return id;
+}
+
+void tflm_arena_release(tflm_arena_t *a, int id)
+{
+    tflm_arena_model_t *m = &a->model[id];
+    m->resident = 0;
+    m->placed = 0;
+    m->stale = 0;
+}
+
+void tflm_arena_swap(tflm_arena_t *a, int id, const char *name, uint32_t persistent, uint32_t scratch)
+{
+    tflm_arena_model_t *m = &a->model[id];
+    tflm_arena_release(a, id);
+    m->name = name;
+    m->persistent = persistent;
+    m->scratch = scratch;
+    m->resident = 1;
+}
+
+int tflm_arena_plan(tflm_arena_t *a)
+{
+    uint32_t start = a->clock ? a->clock() : 0;
+    layout_t l;
+    uint8_t todo[BLOCKS];
+    int status = 0;
+
+    memset(&l, 0, sizeof(l));
+    memset(todo, 0, sizeof(todo));
+    for (uint32_t i = 0; i < a->count; i++) {
+        const tflm_arena_model_t *m = &a->model[i];
+        if (!m->resident) continue;
+        l.size[2 * i] = tflm_arena_align(m->persistent);
+        l.size[2 * i + 1] = tflm_arena_align(m->scratch);
+        if (m->placed) {
+            l.off[2 * i] = m->persistent_off;
+            l.off[2 * i + 1] = m->scratch_off;
+            l.placed[2 * i] = l.placed[2 * i + 1] = 1;
+        } else {
+            todo[2 * i] = todo[2 * i + 1] = 1;
+        }
+    }
+
+    /* Around the models already placed, else from scratch */
+    if (place_all(a, &l, todo) != 0) {
+        for (uint32_t i = 0; i < a->count; i++) {
+            todo[2 * i] = todo[2 * i + 1] = a->model[i].resident;
+            l.placed[2 * i] = l.placed[2 * i + 1] = 0;
+        }
+        if (place_all(a, &l, todo) != 0) status = -1;
+    }
+
+    if (status == 0) {
+        a->used = 0;
+        a->separate = 0;
+        int moved = 0;
+        for (uint32_t i = 0; i < a->count; i++) {
+            tflm_arena_model_t *m = &a->model[i];
+            if (!m->resident) continue;
+            uint32_t p = l.off[2 * i], s = l.off[2 * i + 1];
+            m->stale = !m->placed || m->persistent_off != p || m->scratch_off != s;
+            if (m->placed && m->stale) moved = 1;
+            m->persistent_off = p;
+            m->scratch_off = s;
+            m->placed = 1;
+            if (p + l.size[2 * i] > a->used) a->used = p + l.size[2 * i];
+            if (s + l.size[2 * i + 1] > a->used) a->used = s + l.size[2 * i + 1];
+            a->separate += l.size[2 * i] + l.size[2 * i + 1];
+        }
+        a->replans += moved;
+    }
+    a->plans++;
+    if (a->clock) a->plan_cycles = a->clock() - start;
+    return status;
+}
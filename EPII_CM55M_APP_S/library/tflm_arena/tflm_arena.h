@@ -0,0 +1,132 @@
+#ifndef _LIB_TFLM_ARENA_H_
+#define _LIB_TFLM_ARENA_H_
+#include <stdint.h>
+
+/*
+ * Shared tensor-arena planner for TFLM models that stay resident together.
+ *
+ * A TFLM interpreter needs two kinds of arena memory:
+ *
+ *   persistent  tensor structs, node data, kernel state and the allocator
+ *               objects; live for as long as the interpreter exists
+ *   scratch     activations and scratch buffers (the "head" of the arena);
+ *               live only while the model runs
+ *
+ * Models that never run at the same time (one NPU, one caller) can share
+ * their scratch. The planner takes the requirements of every model, measured
+ * once by the app (tflm_arena_probe() of tflm_arena_tflm.h), and places the blocks
+ * in one region reserved with mm_reserve_align(): scratch blocks overlay each
+ * other unless the models are marked concurrent, persistent blocks never
+ * overlap anything. Placement is first-fit, largest block first, as the
+ * greedy memory planner of TFLM does for tensors.
+ *
+ *   static tflm_arena_t arena;
+ *   tflm_arena_init(&arena, (uint8_t *)mm_reserve_align(size, 0x20), size, clock);
+ *   int fd = tflm_arena_add(&arena, "fd", fd_persistent, fd_scratch, 0);
+ *   int fm = tflm_arena_add(&arena, "fm", fm_persistent, fm_scratch, 0);
+ *   tflm_arena_plan(&arena);
+ *   allocator = tflm_arena_allocator(&arena, fd);    // tflm_arena_tflm.h
+ *
+ * Hot swap: tflm_arena_release() frees the blocks of a model, tflm_arena_swap()
+ * gives its slot the requirements of the next one, and tflm_arena_plan()
+ * places it. The models already placed stay where they are if the new blocks
+ * fit around them; otherwise everything is re-planned and each model whose
+ * blocks moved is flagged stale, so the app re-creates its interpreter.
+ */
+
+#ifndef TFLM_ARENA_MAX_MODELS
+#define TFLM_ARENA_MAX_MODELS 8
+#endif
+
+/* Block alignment (MicroArenaBufferAlignment() of TFLM) */
+#define TFLM_ARENA_ALIGN 16
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct {
+    const char *name;
+    uint32_t persistent;        /* persistent bytes */
+    uint32_t scratch;           /* scratch (non-persistent) bytes */
+    uint32_t concurrent;        /* bit j: may run while model j runs, so no shared scratch */
+    uint32_t persistent_off;    /* planned offsets in the region */
+    uint32_t scratch_off;
+    uint8_t resident;           /* has blocks in the plan */
+    uint8_t placed;             /* offsets valid */
+    uint8_t stale;              /* placed or moved by the last plan: (re)create the interpreter */
+} tflm_arena_model_t;
+
+typedef struct {
+    uint8_t *base;
+    uint32_t size;
+    uint32_t (*clock)(void);    /* free-running cycle counter for plan_cycles, or NULL */
+    tflm_arena_model_t model[TFLM_ARENA_MAX_MODELS];
+    uint32_t count;
+    uint32_t used;              /* end of the highest planned block */
+    uint32_t separate;          /* sum of the requirements of the resident models */
+    uint32_t plan_cycles;       /* duration of the last tflm_arena_plan() */
+    uint32_t plans;             /* tflm_arena_plan() calls */
+    uint32_t replans;           /* of which moved models that were already placed */
+} tflm_arena_t;
+
+/**
+ * @brief Starts an empty plan over a region.
+ * @param[in] base region, TFLM_ARENA_ALIGN aligned
+ * @param[in] clock cycle counter to time tflm_arena_plan(), or NULL
+ */
+void tflm_arena_init(tflm_arena_t *a, uint8_t *base, uint32_t size, uint32_t (*clock)(void));
+
+/**
+ * @brief Adds a resident model. It is placed by the next tflm_arena_plan().
+ * @param[in] concurrent bit j set if the model may run while model j runs
+ * @return model index, or -1 if TFLM_ARENA_MAX_MODELS are registered
+ */
+int tflm_arena_add(tflm_arena_t *a, const char *name, uint32_t persistent, uint32_t scratch, uint32_t concurrent);
+
+/**
+ * @brief Frees the blocks of a model. Its interpreter must not be used any more.
+ */
+void tflm_arena_release(tflm_arena_t *a, int id);
+
+/**
+ * @brief Gives the slot of a model to another model, to be placed by the next
+ * tflm_arena_plan(). The old model is released first if it is resident.
+ */
+void tflm_arena_swap(tflm_arena_t *a, int id, const char *name, uint32_t persistent, uint32_t scratch);
+
+/**
+ * @brief Places the resident models that have no blocks yet, around the ones
+ * that have. If they do not fit, re-plans all resident models.
+ * @return 0, or -1 if the models do not fit in the region (the old placements stay valid)
+ */
+int tflm_arena_plan(tflm_arena_t *a);
+
+/* Size of the block that holds the given bytes */
+static inline uint32_t tflm_arena_align(uint32_t bytes)
+{
+    return (bytes + TFLM_ARENA_ALIGN - 1) & ~(uint32_t)(TFLM_ARENA_ALIGN - 1);
+}
+
+/* Bytes saved by the plan over one arena per model */
+static inline uint32_t tflm_arena_saved(const tflm_arena_t *a)
+{
+    return (a->separate > a->used) ? a->separate - a->used : 0;
+}
+
+static inline uint8_t *tflm_arena_persistent(const tflm_arena_t *a, int id)
+{
+    return a->base + a->model[id].persistent_off;
+}
+
+static inline uint8_t *tflm_arena_scratch(const tflm_arena_t *a, int id)
+{
+    return a->base + a->model[id].scratch_off;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LIB_TFLM_ARENA_H_ */
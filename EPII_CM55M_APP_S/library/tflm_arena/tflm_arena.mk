@@ -0,0 +1,61 @@
+# directory declaration
+LIB_TFLM_ARENA_DIR = $(LIBRARIES_ROOT)/tflm_arena
+
+LIB_TFLM_ARENA_ASMSRCDIR	= $(LIB_TFLM_ARENA_DIR) 
+LIB_TFLM_ARENA_CSRCDIR	= $(LIB_TFLM_ARENA_DIR) 
+LIB_TFLM_ARENA_INCDIR	= $(LIB_TFLM_ARENA_DIR) 
+
+# find all the source files in the target directories
+LIB_TFLM_ARENA_CSRCS = $(call get_csrcs, $(LIB_TFLM_ARENA_CSRCDIR))
+LIB_TFLM_ARENA_ASMSRCS = $(call get_asmsrcs, $(LIB_TFLM_ARENA_ASMSRCDIR))
+
+# get object files
+LIB_TFLM_ARENA_COBJS = $(call get_relobjs, $(LIB_TFLM_ARENA_CSRCS))
+LIB_TFLM_ARENA_ASMOBJS = $(call get_relobjs, $(LIB_TFLM_ARENA_ASMSRCS))
+LIB_TFLM_ARENA_OBJS = $(LIB_TFLM_ARENA_COBJS) $(LIB_TFLM_ARENA_ASMOBJS)
+
+# get dependency files
+LIB_TFLM_ARENA_DEPS = $(call get_deps, $(LIB_TFLM_ARENA_OBJS))
+
+# extra macros to be defined
+LIB_TFLM_ARENA_DEFINES = -DLIB_TFLM_ARENA
+
+# genearte library
+ifeq ($(TFLM_ARENA_LIB_FORCE_PREBUILT), y)
+override LIB_TFLM_ARENA_OBJS:=
+endif
+TFLM_ARENA_LIB_NAME = libtflm_arena.a
+LIB_TFLM_ARENA := $(subst /,$(PS), $(strip $(OUT_DIR)/$(TFLM_ARENA_LIB_NAME)))
+
+# library generation rule
+$(LIB_TFLM_ARENA): $(LIB_TFLM_ARENA_OBJS)
+	$(TRACE_ARCHIVE)
+ifeq "$(strip $(LIB_TFLM_ARENA_OBJS))" ""
+	$(CP) $(PREBUILT_LIB)$(TFLM_ARENA_LIB_NAME) $(LIB_TFLM_ARENA)
+else
+	$(Q)$(AR) $(AR_OPT) $@ $(LIB_TFLM_ARENA_OBJS)
+	$(CP) $(LIB_TFLM_ARENA) $(PREBUILT_LIB)$(TFLM_ARENA_LIB_NAME)
+endif
+
+# specific compile rules
+# user can add rules to compile this middleware
+# if not rules specified to this middleware, it will use default compiling rules
+
+# Middleware Definitions
+LIB_INCDIR += $(LIB_TFLM_ARENA_INCDIR)
+LIB_CSRCDIR += $(LIB_TFLM_ARENA_CSRCDIR)
+LIB_ASMSRCDIR += $(LIB_TFLM_ARENA_ASMSRCDIR)
+
+LIB_CSRCS += $(LIB_TFLM_ARENA_CSRCS)
+LIB_CXXSRCS +=
+LIB_ASMSRCS += $(LIB_TFLM_ARENA_ASMSRCS)
+LIB_ALLSRCS += $(LIB_TFLM_ARENA_CSRCS) $(LIB_TFLM_ARENA_ASMSRCS)
+
+LIB_COBJS += $(LIB_TFLM_ARENA_COBJS)
+LIB_CXXOBJS +=
+LIB_ASMOBJS += $(LIB_TFLM_ARENA_ASMOBJS)
+LIB_ALLOBJS += $(LIB_TFLM_ARENA_OBJS)
+
+LIB_DEFINES += $(LIB_TFLM_ARENA_DEFINES)
+LIB_DEPS += $(LIB_TFLM_ARENA_DEPS)
+LIB_LIBS += $(LIB_TFLM_ARENA)
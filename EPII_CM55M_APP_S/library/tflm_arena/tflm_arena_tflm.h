@@ -0,0 +1,72 @@
+#ifndef _LIB_TFLM_ARENA_TFLM_H_
+#define _LIB_TFLM_ARENA_TFLM_H_
+#include <stdint.h>
+#include "WE2_device.h"
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tflm_arena.h"
+
+/*
+ * TFLM side of the tensor-arena planner (C++ only): measures the
+ * requirements of a model and builds the allocator of a planned model.
+ *
+ *   uint32_t persistent, scratch;
+ *   tflm_arena_probe(base, size, model, op_resolver, &persistent, &scratch);
+ *   tflm_arena_init(&arena, base, size, tflm_arena_clock);
+ *   int id = tflm_arena_add(&arena, "fd", persistent, scratch, 0);
+ *   tflm_arena_plan(&arena);
+ *   tflite::MicroInterpreter interpreter(model, op_resolver, tflm_arena_allocator(&arena, id));
+ */
+
+/* Persistent bytes the probe leaves room for at the top of the region */
+#ifndef TFLM_ARENA_PROBE_PERSISTENT
+#define TFLM_ARENA_PROBE_PERSISTENT (16 * 1024)
+#endif
+
+/* Cycle counter for tflm_arena_init(), from the SysTick and its wrap count */
+static inline uint32_t tflm_arena_clock(void)
+{
+    uint32_t systick, loop_cnt;
+    SystemGetTick(&systick, &loop_cnt);
+    return loop_cnt * (0xffffff + 1) - systick;
+}
+
+/**
+ * @brief Persistent and scratch bytes of a model: allocated once on the whole
+ * (not yet planned) region, scratch from the bottom, persistent from the top.
+ * @return 0, or -1 if the model does not fit in the region
+ */
+static inline int tflm_arena_probe(uint8_t *base, uint32_t size, const tflite::Model *model,
+                                   const tflite::MicroOpResolver &op_resolver,
+                                   uint32_t *persistent, uint32_t *scratch)
+{
+    uint8_t *top = base + size;
+    tflite::MicroAllocator *allocator = tflite::MicroAllocator::Create(
+        top - TFLM_ARENA_PROBE_PERSISTENT, TFLM_ARENA_PROBE_PERSISTENT,
+        base, size - TFLM_ARENA_PROBE_PERSISTENT);
+    if (allocator == nullptr)
+        return -1;
+    tflite::MicroInterpreter interpreter(model, op_resolver, allocator);
+    if (interpreter.AllocateTensors() != kTfLiteOk)
+        return -1;
+    /* the persistent area grows down from the top: one more (aligned) byte marks its end */
+    uint8_t *end = (uint8_t *)allocator->AllocatePersistentBuffer(1);
+    if (end == nullptr)
+        return -1;
+    *persistent = top - end;
+    *scratch = interpreter.arena_used_bytes() - *persistent;
+    return 0;
+}
+
+/**
+ * @brief Allocator over the planned blocks of a model. Its objects live in the
+ * model's persistent block, so a new one starts that block empty.
+ */
+static inline tflite::MicroAllocator *tflm_arena_allocator(const tflm_arena_t *a, int id)
+{
+    const tflm_arena_model_t *m = &a->model[id];
+    return tflite::MicroAllocator::Create(tflm_arena_persistent(a, id), tflm_arena_align(m->persistent),
+                                          tflm_arena_scratch(a, id), m->scratch);
+}
+
+#endif /* _LIB_TFLM_ARENA_TFLM_H_ */
@@ -0,0 +1,366 @@
+/*
+ * library/yolo_post/host/yolo_nms_bench.cpp
+ *
+ * Runs yolo_nms.h and the NMS code it replaces on the same candidates,
+ * checks that they keep the same boxes and times both:
+ *
+ *   yolov8       yolov8_NMSBoxes() of the tflm_yolov8_od/yolo11_od/yolov8_pose
+ *                apps (copied below: it is static there), class-agnostic IoU
+ *   darknet_diou diounms_sort() of yolo_postprocessing.cc (tflm_fd_fm,
+ *                tflm_yolov8_gender_cls): DIoU, beta 0.6
+ *   darknet_nms  do_nms_sort() with several classes: class-aware IoU
+ *   fd           the whole face detector post-processing: get_network_boxes()
+ *                + diounms_sort() + free_dets() against get_network_cands()
+ *                + yolo_nms(), on synthetic int8 heads of the 160x160 model
+ *
+ * The reference side includes building its std::vector / std::forward_list,
+ * as the apps do every frame; "new" counts the calls to operator new.
+ *
+ *   yolo_nms_bench [-n candidates] [-r repeats] [-s seed]
+ *
+ * Exits with 1 if any case keeps a different set of boxes.
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <forward_list>
+#include <new>
+#include <set>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+#include "yolo_postprocessing.h"
+#include "yolo_nms.h"
+
+#define MAX_BOXES YOLO_NMS_CAPACITY
+
+static unsigned long news = 0;
+
+void* operator new(std::size_t size) {
+    news++;
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// =============================================================
+// Reference: yolov8_NMSBoxes() as in cvapp_yolov8n_ob.cpp
+// =============================================================
+typedef struct detection_cls_yolov8{
+    box bbox;
+    float confidence;
+    float index;
+
+} detection_cls_yolov8;
+
+static bool yolov8_det_comparator(detection_cls_yolov8 &pa, detection_cls_yolov8 &pb)
+{
+    return pa.confidence > pb.confidence;
+}
+
+static void  yolov8_NMSBoxes(std::vector<box> &boxes,std::vector<float> &confidences,float modelScoreThreshold,float modelNMSThreshold,std::vector<int>& nms_result)
+{
+    detection_cls_yolov8 yolov8_bbox;
+    std::vector<detection_cls_yolov8> yolov8_bboxes{};
+    for(int i = 0; i < boxes.size(); i++)
+    {
+        yolov8_bbox.bbox = boxes[i];
+        yolov8_bbox.confidence = confidences[i];
+        yolov8_bbox.index = i;
+        yolov8_bboxes.push_back(yolov8_bbox);
+    }
+    sort(yolov8_bboxes.begin(), yolov8_bboxes.end(), yolov8_det_comparator);
+    int updated_size = yolov8_bboxes.size();
+    for(int k = 0; k < updated_size; k++)
+    {
+        if(yolov8_bboxes[k].confidence < modelScoreThreshold)
+        {
+            continue;
+        }
+
+        nms_result.push_back(yolov8_bboxes[k].index);
+        for(int j = k + 1; j < updated_size; j++)
+        {
+            float iou = box_iou(yolov8_bboxes[k].bbox, yolov8_bboxes[j].bbox);
+            if(iou > modelNMSThreshold)
+            {
+                yolov8_bboxes.erase(yolov8_bboxes.begin() + j);
+                updated_size = yolov8_bboxes.size();
+                j = j -1;
+            }
+        }
+    }
+}
+
+// =============================================================
+// Synthetic frame
+// =============================================================
+// A few objects, each seen by several anchors with jittered boxes (what NMS
+// is for), plus scattered false positives. Coordinates are integers and the
+// sizes even, so the centre form of the reference code and the top-left form
+// of yolo_post describe exactly the same boxes.
+struct Frame {
+    uint32_t n = 0;
+    float cx[MAX_BOXES], cy[MAX_BOXES];
+    float x[MAX_BOXES], y[MAX_BOXES], w[MAX_BOXES], h[MAX_BOXES];
+    float score[MAX_BOXES];
+    uint16_t cls[MAX_BOXES];
+};
+
+static uint32_t hash(uint32_t v) {
+    v ^= v >> 16; v *= 0x7feb352d;
+    v ^= v >> 15; v *= 0x846ca68b;
+    return v ^ (v >> 16);
+}
+
+static void synth(Frame& f, uint32_t n, int classes, uint32_t seed) {
+    f.n = n;
+    uint32_t objects = 1 + n / 12;
+    for (uint32_t i = 0; i < n; ++i) {
+        uint32_t r = hash(seed * 1000003u + i);
+        uint32_t o = r % (objects + 2); // the last two "objects" are noise
+        float cx, cy, w, h;
+        if (o < objects) {
+            uint32_t q = hash(seed * 7919u + o);
+            cx = 20 + q % 180 + (int)(r >> 8) % 9 - 4;
+            cy = 20 + (q >> 8) % 180 + (int)(r >> 12) % 9 - 4;
+            w = 2 * (8 + (q >> 16) % 40 + (int)(r >> 16) % 7 - 3);
+            h = 2 * (8 + (q >> 22) % 40 + (int)(r >> 20) % 7 - 3);
+            f.cls[i] = (uint16_t)(o % classes);
+        } else {
+            cx = (r >> 8) % 224;
+            cy = (r >> 16) % 224;
+            w = 2 * (4 + hash(r) % 60);
+            h = 2 * (4 + hash(r + 1) % 60);
+            f.cls[i] = (uint16_t)(hash(r + 2) % classes);
+        }
+        f.cx[i] = cx;
+        f.cy[i] = cy;
+        f.w[i] = w;
+        f.h[i] = h;
+        f.x[i] = cx - 0.5f * w;
+        f.y[i] = cy - 0.5f * h;
+        f.score[i] = 0.25f + 0.75f * (float)(hash(r + 3) >> 8) / (float)(1u << 24);
+    }
+}
+
+// =============================================================
+// Cases
+// =============================================================
+static uint16_t keep[MAX_BOXES];
+static yolo_nms_work_t nms_work;
+
+static double now_us() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void report(const char* name, uint32_t n, size_t kept, double ref_us, unsigned long ref_news,
+                   double nms_us, bool match) {
+    printf("%-13s %4u candidates: %3u kept, reference %8.2f us (%4lu new), yolo_nms %7.2f us (0 new) (%5.1fx) %s\n",
+           name, (unsigned)n, (unsigned)kept, ref_us, ref_news, nms_us, nms_us > 0 ? ref_us / nms_us : 0.0,
+           match ? "match" : "MISMATCH");
+}
+
+static bool run_yolov8(const Frame& f, int repeats) {
+    yolo_post_boxes_t b = { const_cast<float*>(f.x), const_cast<float*>(f.y), const_cast<float*>(f.w), const_cast<float*>(f.h) };
+    std::vector<int> nms_result;
+
+    unsigned long n0 = news;
+    double t0 = now_us();
+    for (int r = 0; r < repeats; ++r) {
+        // What the apps did: fill vectors, then NMS
+        std::vector<box> boxes;
+        std::vector<float> confidences;
+        for (uint32_t i = 0; i < f.n; ++i) {
+            boxes.push_back(box{ f.cx[i], f.cy[i], f.w[i], f.h[i] });
+            confidences.push_back(f.score[i]);
+        }
+        nms_result.clear();
+        yolov8_NMSBoxes(boxes, confidences, 0.25f, 0.45f, nms_result);
+    }
+    double ref_us = (now_us() - t0) / repeats;
+    unsigned long ref_news = (news - n0) / repeats;
+
+    uint32_t kept = 0;
+    t0 = now_us();
+    for (int r = 0; r < repeats; ++r) kept = yolo_nms(&b, f.score, nullptr, f.n, 0.45f, 0.f, MAX_BOXES, &nms_work, keep);
+    double nms_us = (now_us() - t0) / repeats;
+
+    // Scores are distinct, so both keep the same boxes in the same order.
+    bool match = (kept == nms_result.size());
+    for (uint32_t i = 0; match && i < kept; ++i) match = (keep[i] == nms_result[i]);
+    report("yolov8", f.n, kept, ref_us, ref_news, nms_us, match);
+    return match;
+}
+
+// One darknet detection per anchor with a probability per class; the
+// candidates for yolo_nms are its (anchor, class) pairs.
+static bool run_darknet(const char* name, const Frame& f, int classes, bool diou, int repeats) {
+    static float cand_x[MAX_BOXES], cand_y[MAX_BOXES], cand_w[MAX_BOXES], cand_h[MAX_BOXES], cand_score[MAX_BOXES];
+    static uint16_t cand_cls[MAX_BOXES], cand_det[MAX_BOXES];
+    static detection* det_of[MAX_BOXES];
+    uint32_t dets_n = f.n / classes;
+    uint32_t n = 0;
+    for (uint32_t d = 0; d < dets_n; ++d) {
+        for (int k = 0; k < classes; ++k) {
+            // Its own class, and a second one for every third detection
+            if (classes > 1 && k != f.cls[d] && (d % 3 != 0 || k != (f.cls[d] + 1) % classes)) continue;
+            cand_x[n] = f.x[d];
+            cand_y[n] = f.y[d];
+            cand_w[n] = f.w[d];
+            cand_h[n] = f.h[d];
+            cand_score[n] = f.score[d * classes + k];
+            cand_cls[n] = (uint16_t)k;
+            cand_det[n] = (uint16_t)d;
+            n++;
+        }
+    }
+    yolo_post_boxes_t b = { cand_x, cand_y, cand_w, cand_h };
+
+    std::set<std::pair<float, int>> ref_kept;
+    unsigned long n0 = news;
+    double t0 = now_us();
+    for (int r = 0; r < repeats; ++r) {
+        // What get_network_boxes() builds, then the NMS, then free_dets()
+        std::forward_list<detection> dets;
+        for (uint32_t d = 0; d < dets_n; ++d) {
+            detection det;
+            det.bbox = box{ f.cx[d], f.cy[d], f.w[d], f.h[d] };
+            det.objectness = 1.f;
+            det.prob = (float*)calloc(classes, sizeof(float));
+            dets.emplace_front(det);
+            det_of[d] = &dets.front();
+        }
+        for (uint32_t i = 0; i < n; ++i) det_of[cand_det[i]]->prob[cand_cls[i]] = cand_score[i];
+        if (diou) diounms_sort(dets, classes, 0.45f);
+        else do_nms_sort(dets, classes, 0.45f);
+        if (r == 0) {
+            for (auto& det : dets)
+                for (int k = 0; k < classes; ++k)
+                    if (det.prob[k] > 0) ref_kept.insert({ det.prob[k], k });
+        }
+        free_dets(dets);
+    }
+    double ref_us = (now_us() - t0) / repeats;
+    unsigned long ref_news = (news - n0) / repeats;
+
+    uint32_t kept = 0;
+    t0 = now_us();
+    for (int r = 0; r < repeats; ++r) {
+        kept = yolo_nms(&b, cand_score, cand_cls, n, 0.45f, diou ? 0.6f : 0.f, MAX_BOXES, &nms_work, keep);
+    }
+    double nms_us = (now_us() - t0) / repeats;
+
+    // Compare (score, class) sets: darknet keeps its list in its own order.
+    std::set<std::pair<float, int>> nms_kept;
+    for (uint32_t i = 0; i < kept; ++i) nms_kept.insert({ cand_score[keep[i]], (int)cand_cls[keep[i]] });
+    bool match = (ref_kept == nms_kept);
+    report(name, n, kept, ref_us, ref_news, nms_us, match);
+    return match;
+}
+
+// The two heads of the tflm_fd_fm / tflm_yolov8_gender_cls face detector:
+// 5x5 and 10x10 cells, 3 anchors of (x, y, w, h, objectness, face) each.
+static bool run_fd(uint32_t seed, int repeats) {
+    static int8_t head1[5 * 5 * 18], head2[10 * 10 * 18];
+    static float anchor1[] = { 38, 63, 66, 100, 121, 163 };
+    static float anchor2[] = { 6, 10, 12, 22, 23, 39 };
+    static float cand_x[MAX_BOXES], cand_y[MAX_BOXES], cand_w[MAX_BOXES], cand_h[MAX_BOXES], cand_score[MAX_BOXES];
+    static uint16_t cand_anchor[MAX_BOXES], cand_cls[MAX_BOXES];
+
+    // Background cells, and a few faces that light up neighbouring cells
+    int8_t* heads[2] = { head1, head2 };
+    int cells[2] = { 5, 10 };
+    for (int b = 0; b < 2; ++b) {
+        for (int i = 0; i < cells[b] * cells[b] * 18; ++i) heads[b][i] = (int8_t)(hash(seed * 31u + b * 4096u + i) % 64 - 128);
+        for (int f = 0; f < 3; ++f) {
+            uint32_t q = hash(seed * 131u + b * 8u + f);
+            int cx = q % cells[b], cy = (q >> 8) % cells[b];
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int x = cx + dx, y = cy + dy;
+                    if (x < 0 || y < 0 || x >= cells[b] || y >= cells[b]) continue;
+                    for (int anc = 0; anc < 3; ++anc) {
+                        int8_t* p = heads[b] + (y * cells[b] + x) * 18 + anc * 6;
+                        uint32_t r = hash(q + (dy + 1) * 16 + (dx + 1) * 4 + anc);
+                        p[0] = (int8_t)(r % 40 - 20 - dx * 20);
+                        p[1] = (int8_t)((r >> 8) % 40 - 20 - dy * 20);
+                        p[2] = (int8_t)((r >> 16) % 30 - 15);
+                        p[3] = (int8_t)((r >> 24) % 30 - 15);
+                        p[4] = (int8_t)(r % 100);
+                        p[5] = (int8_t)((r >> 7) % 100);
+                    }
+                }
+            }
+        }
+    }
+    branch branchs[2] = {
+        create_brach(5, 3, anchor1, head1, sizeof(head1), 0.0625f, -10),
+        create_brach(10, 3, anchor2, head2, sizeof(head2), 0.0625f, -10),
+    };
+    network net = creat_network(160, 160, 1, 2, branchs, 0);
+
+    std::set<std::pair<float, int>> ref_kept;
+    unsigned long n0 = news;
+    double t0 = now_us();
+    for (int r = 0; r < repeats; ++r) {
+        int nboxes = 0;
+        std::forward_list<detection> dets = get_network_boxes(&net, 640, 480, 0.5f, &nboxes);
+        diounms_sort(dets, net.num_classes, 0.45f);
+        if (r == 0) {
+            for (auto& det : dets)
+                if (det.prob[0] > 0) ref_kept.insert({ det.prob[0], 0 });
+        }
+        free_dets(dets);
+    }
+    double ref_us = (now_us() - t0) / repeats;
+    unsigned long ref_news = (news - n0) / repeats;
+
+    yolo_post_cands_t c = { cand_anchor, cand_cls, cand_score, { cand_x, cand_y, cand_w, cand_h }, MAX_BOXES, 0, 0 };
+    uint32_t kept = 0;
+    t0 = now_us();
+    for (int r = 0; r < repeats; ++r) {
+        c.count = 0;
+        get_network_cands(&net, 640, 480, 0.5f, &c);
+        kept = yolo_nms(&c.box, cand_score, cand_cls, c.count, 0.45f, 0.6f, MAX_BOXES, &nms_work, keep);
+    }
+    double nms_us = (now_us() - t0) / repeats;
+
+    std::set<std::pair<float, int>> nms_kept;
+    for (uint32_t i = 0; i < kept; ++i) nms_kept.insert({ cand_score[keep[i]], (int)cand_cls[keep[i]] });
+    bool match = (ref_kept == nms_kept && c.dropped == 0);
+    report("fd", c.count, kept, ref_us, ref_news, nms_us, match);
+    return match;
+}
+
+int main(int argc, char** argv) {
+    uint32_t n = 120;
+    int repeats = 2000, opt;
+    unsigned seed = 1;
+    while ((opt = getopt(argc, argv, "n:r:s:")) != -1) {
+        switch (opt) {
+        case 'n': n = (uint32_t)atoi(optarg); break;
+        case 'r': repeats = atoi(optarg); break;
+        case 's': seed = (unsigned)atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-n candidates] [-r repeats] [-s seed]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (n == 0 || n > MAX_BOXES || repeats <= 0) return 2;
+
+    static Frame one, multi;
+    synth(one, n, 1, seed);
+    synth(multi, n, 3, seed + 1);
+
+    bool ok = run_yolov8(one, repeats);
+    ok &= run_darknet("darknet_diou", one, 1, true, repeats);
+    ok &= run_darknet("darknet_nms", multi, 3, false, repeats);
+    ok &= run_fd(seed, repeats);
+    return ok ? 0 : 1;
+}
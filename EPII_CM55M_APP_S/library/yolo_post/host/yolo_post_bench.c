@@ -0,0 +1,195 @@
+/*
+ * library/yolo_post/host/yolo_post_bench.c
+ *
+ * Checks yolo_post against the float loops of the tflm_yolo* apps and times
+ * both. Without arguments it runs on seeded synthetic heads shaped like the
+ * apps' outputs; with a file it runs on a score tensor recorded on the board
+ * (the raw int8 bytes of the output tensor, e.g. from GDB
+ * "dump binary memory scores.bin output->data.int8 output->data.int8+60480").
+ *
+ *   yolo_post_bench
+ *   yolo_post_bench [-n anchors] [-k classes] [-s scale] [-z zero_point]
+ *                   [-t threshold] [-c] [-g] [-r repeats] scores.bin
+ *
+ *     -c  scores are [classes][anchors] (default [anchors][classes])
+ *     -g  threshold the sigmoid of the score (yolo11, pose)
+ *
+ * Exits with 1 if any selected anchor, class or score (bitwise) differs.
+ */
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "yolo_post.h"
+
+#define MAX_CANDS 8400
+
+typedef struct {
+    const char *name;
+    yolo_post_scores_t s;
+    float threshold;
+} bench_case_t;
+
+static uint16_t ref_anchor[MAX_CANDS], ref_cls[MAX_CANDS];
+static float ref_score[MAX_CANDS];
+static uint16_t eng_anchor[MAX_CANDS], eng_cls[MAX_CANDS];
+static float eng_score[MAX_CANDS];
+
+static float sigmoid(float x)
+{
+    return 1.f / (1.f + expf(-x));
+}
+
+/* Dequantize every score, as the apps do */
+static uint32_t reference(const yolo_post_scores_t *s, float threshold)
+{
+    uint32_t n = 0;
+    for (int32_t a = 0; a < s->num_anchors; a++) {
+        const int8_t *p = s->data + a * s->anchor_stride;
+        float maxScore = s->sigmoid ? ((float)p[0] - (float)s->zero_point) * s->scale : (-1);
+        uint16_t maxClassIndex = 0;
+        for (int32_t k = 0; k < s->num_classes; k++) {
+            float deq_value = ((float)p[k * s->class_stride] - (float)s->zero_point) * s->scale;
+            if (maxScore < deq_value) {
+                maxScore = deq_value;
+                maxClassIndex = k;
+            }
+        }
+        if (s->sigmoid) maxScore = sigmoid(maxScore);
+        if (maxScore >= threshold) {
+            ref_anchor[n] = a;
+            ref_cls[n] = maxClassIndex;
+            ref_score[n] = maxScore;
+            n++;
+        }
+    }
+    return n;
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int run_case(const bench_case_t *bc, int repeats)
+{
+    yolo_post_cands_t c = { eng_anchor, eng_cls, eng_score, { NULL, NULL, NULL, NULL }, MAX_CANDS, 0, 0 };
+    volatile uint32_t sink = 0;
+
+    double t0 = now_us();
+    for (int i = 0; i < repeats; i++) sink += reference(&bc->s, bc->threshold);
+    double ref_us = (now_us() - t0) / repeats;
+
+    t0 = now_us();
+    for (int i = 0; i < repeats; i++) {
+        c.count = 0;
+        sink += yolo_post_select(&bc->s, bc->threshold, 0, &c);
+    }
+    double eng_us = (now_us() - t0) / repeats;
+    (void)sink;
+
+    uint32_t n = reference(&bc->s, bc->threshold);
+    int match = (n == c.count && c.dropped == 0 &&
+                 memcmp(ref_anchor, eng_anchor, n * sizeof(uint16_t)) == 0 &&
+                 memcmp(ref_cls, eng_cls, n * sizeof(uint16_t)) == 0 &&
+                 memcmp(ref_score, eng_score, n * sizeof(float)) == 0);
+
+    printf("%-14s %5dx%-3d thr %.2f: %4u candidates, reference %8.1f us, yolo_post %7.1f us (%4.1fx) %s\n",
+           bc->name, (int)bc->s.num_anchors, (int)bc->s.num_classes, bc->threshold, (unsigned)n,
+           ref_us, eng_us, eng_us > 0 ? ref_us / eng_us : 0.0, match ? "match" : "MISMATCH");
+    return match;
+}
+
+/* Mostly background logits with a few confident anchors, like a real frame */
+static void synth(int8_t *t, int32_t anchors, int32_t classes, int32_t anchor_stride, int32_t class_stride,
+                  unsigned seed)
+{
+    srand(seed);
+    for (int32_t a = 0; a < anchors; a++) {
+        for (int32_t k = 0; k < classes; k++) {
+            t[a * anchor_stride + k * class_stride] = (int8_t)(-128 + rand() % 48);
+        }
+        if (rand() % 50 == 0) {
+            int32_t k = rand() % classes;
+            t[a * anchor_stride + k * class_stride] = (int8_t)(-40 + rand() % 168);
+        }
+    }
+}
+
+static int run_synthetic(int repeats)
+{
+    static int8_t v8[756 * 80], v8_chw[84 * 756], v11[576 * 144], pose[576];
+    int ok = 1;
+
+    /* tflm_yolov8_od: [1,756,80] scores, and [1,84,756] without the output reshape */
+    synth(v8, 756, 80, 80, 1, 1);
+    synth(v8_chw + 4 * 756, 756, 80, 1, 756, 2);
+    /* tflm_yolo11_od: the 28x28 tensor of [1,H,W,144], classes at channel 64 */
+    synth(v11 + 64, 576, 80, 144, 1, 3);
+    /* tflm_yolov8_pose: one person score per anchor */
+    synth(pose, 576, 1, 1, 1, 4);
+
+    const bench_case_t cases[] = {
+        { "yolov8_od", { v8, 756, 80, 80, 1, 0.00390625f, -128, 0 }, 0.25f },
+        { "yolov8_od_chw", { v8_chw + 4 * 756, 756, 80, 1, 756, 0.00390625f, -128, 0 }, 0.25f },
+        { "yolo11_od", { v11 + 64, 576, 80, 144, 1, 0.0732f, 11, 1 }, 0.25f },
+        { "yolov8_pose", { pose, 576, 1, 1, 1, 0.0821f, 37, 1 }, 0.25f },
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        ok &= run_case(&cases[i], repeats);
+    }
+    return ok;
+}
+
+static int run_recorded(const char *path, bench_case_t *bc, int channel_major, int repeats)
+{
+    size_t bytes = (size_t)bc->s.num_anchors * bc->s.num_classes;
+    int8_t *t = malloc(bytes);
+    FILE *f = fopen(path, "rb");
+    if (!t || !f || fread(t, 1, bytes, f) != bytes) {
+        printf("ERROR: cannot read %zu bytes from %s\n", bytes, path);
+        if (f) fclose(f);
+        free(t);
+        return 0;
+    }
+    fclose(f);
+
+    bc->name = "recorded";
+    bc->s.data = t;
+    bc->s.anchor_stride = channel_major ? 1 : bc->s.num_classes;
+    bc->s.class_stride = channel_major ? bc->s.num_anchors : 1;
+    int ok = run_case(bc, repeats);
+    free(t);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    bench_case_t bc = { "recorded", { NULL, 756, 80, 80, 1, 0.00390625f, -128, 0 }, 0.25f };
+    int channel_major = 0, repeats = 200, opt;
+
+    while ((opt = getopt(argc, argv, "n:k:s:z:t:cgr:")) != -1) {
+        switch (opt) {
+        case 'n': bc.s.num_anchors = atoi(optarg); break;
+        case 'k': bc.s.num_classes = atoi(optarg); break;
+        case 's': bc.s.scale = strtof(optarg, NULL); break;
+        case 'z': bc.s.zero_point = atoi(optarg); break;
+        case 't': bc.threshold = strtof(optarg, NULL); break;
+        case 'c': channel_major = 1; break;
+        case 'g': bc.s.sigmoid = 1; break;
+        case 'r': repeats = atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-n anchors] [-k classes] [-s scale] [-z zp] [-t thr] [-c] [-g] [-r n] [scores.bin]\n",
+                    argv[0]);
+            return 2;
+        }
+    }
+    if (bc.s.num_anchors * bc.s.num_classes <= 0 || repeats <= 0) return 2;
+
+    int ok = (optind < argc) ? run_recorded(argv[optind], &bc, channel_major, repeats) : run_synthetic(repeats);
+    return ok ? 0 : 1;
+}
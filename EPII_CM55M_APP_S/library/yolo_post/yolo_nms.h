@@ -0,0 +1,208 @@
+#ifndef _LIB_YOLO_NMS_H_
+#define _LIB_YOLO_NMS_H_
+#include <math.h>
+#include <stdint.h>
+#include "yolo_post.h"
+
+/*
+ * Top-K selection and non-maximum suppression over yolo_post candidates,
+ * with no heap and no sorting containers. All scratch lives in a
+ * yolo_nms_work_t of YOLO_NMS_CAPACITY boxes that the caller keeps static:
+ *
+ *   static yolo_nms_work_t nms_work;
+ *   uint16_t keep[10];
+ *   uint32_t n = yolo_nms(&c.box, c.score, NULL, c.count, 0.45f, 0.f, 10, &nms_work, keep);
+ *   for (uint32_t i = 0; i < n; i++) ...     // candidate keep[i], best score first
+ *
+ * - Partial selection: only the YOLO_NMS_CAPACITY best scores take part,
+ *   picked with a bounded heap (O(n log K)) instead of a full sort.
+ * - class_idx != NULL gives class-aware (batched) NMS: one pass over all
+ *   classes in which a box only suppresses boxes of its own class.
+ * - diou_beta > 0 gives DIoU-NMS: a box is suppressed if
+ *   IoU - (d^2 / c^2)^diou_beta > threshold, d being the distance between
+ *   the centres and c the diagonal of the enclosing box (darknet's
+ *   diounms_sort uses 0.6).
+ *
+ * The selected boxes are gathered into corner arrays, so each kept box is
+ * tested against the rest in a straight loop over contiguous floats: 4 boxes
+ * per Helium instruction on the Cortex-M55. IoU > t is evaluated as
+ * intersection > t * union (MVE has no vector divide); ties in score go to
+ * the lower candidate index.
+ */
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+#include <arm_mve.h>
+#define YOLO_NMS_MVE 1
+#else
+#define YOLO_NMS_MVE 0
+#endif
+
+#ifndef YOLO_NMS_CAPACITY
+#define YOLO_NMS_CAPACITY 256
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Scratch of one NMS call, in score order */
+typedef struct {
+    float x1[YOLO_NMS_CAPACITY];
+    float y1[YOLO_NMS_CAPACITY];
+    float x2[YOLO_NMS_CAPACITY];
+    float y2[YOLO_NMS_CAPACITY];
+    float area[YOLO_NMS_CAPACITY];
+    float cls[YOLO_NMS_CAPACITY];
+    uint16_t order[YOLO_NMS_CAPACITY];
+    uint8_t removed[YOLO_NMS_CAPACITY];
+} yolo_nms_work_t;
+
+/* a ranks before b: higher score, then lower index */
+static inline int yolo_nms_before(const float *score, uint16_t a, uint16_t b)
+{
+    return (score[a] > score[b]) || (score[a] == score[b] && a < b);
+}
+
+/* Heap whose root is the worst-ranked entry */
+static inline void yolo_nms_sift_down(const float *score, uint16_t *heap, uint32_t n, uint32_t i)
+{
+    for (;;) {
+        uint32_t l = 2 * i + 1, r = l + 1, worst = i;
+        if (l < n && yolo_nms_before(score, heap[worst], heap[l])) worst = l;
+        if (r < n && yolo_nms_before(score, heap[worst], heap[r])) worst = r;
+        if (worst == i) return;
+        uint16_t t = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = t;
+        i = worst;
+    }
+}
+
+/**
+ * @brief Indices of the k best of n scores, best first.
+ * @param[out] order at least min(k, n) entries
+ * @return min(k, n)
+ */
+static inline uint32_t yolo_topk(const float *score, uint32_t n, uint32_t k, uint16_t *order)
+{
+    if (k > n) k = n;
+    if (k == 0) return 0;
+
+    for (uint32_t i = 0; i < k; i++) order[i] = (uint16_t)i;
+    for (uint32_t i = k / 2; i-- > 0;) yolo_nms_sift_down(score, order, k, i);
+    for (uint32_t i = k; i < n; i++) {
+        if (yolo_nms_before(score, (uint16_t)i, order[0])) {
+            order[0] = (uint16_t)i;
+            yolo_nms_sift_down(score, order, k, 0);
+        }
+    }
+    /* Move the worst to the back until the heap is sorted best first */
+    for (uint32_t m = k; m > 1; m--) {
+        uint16_t t = order[0];
+        order[0] = order[m - 1];
+        order[m - 1] = t;
+        yolo_nms_sift_down(score, order, m - 1, 0);
+    }
+    return k;
+}
+
+static inline float yolo_nms_min(float a, float b) { return a < b ? a : b; }
+static inline float yolo_nms_max(float a, float b) { return a > b ? a : b; }
+
+/* Whether the kept box i suppresses box j (positions in score order) */
+static inline int yolo_nms_suppresses(const yolo_nms_work_t *w, uint32_t i, uint32_t j, float threshold, float diou_beta)
+{
+    if (w->cls[i] != w->cls[j]) return 0;
+
+    float iw = yolo_nms_max(yolo_nms_min(w->x2[i], w->x2[j]) - yolo_nms_max(w->x1[i], w->x1[j]), 0.f);
+    float ih = yolo_nms_max(yolo_nms_min(w->y2[i], w->y2[j]) - yolo_nms_max(w->y1[i], w->y1[j]), 0.f);
+    float inter = iw * ih;
+    float uni = (w->area[i] + w->area[j]) - inter;
+    if (!(inter > threshold * uni)) return 0;
+    if (diou_beta <= 0.f) return 1;
+
+    /* DIoU <= IoU, so only boxes that pass the IoU test need the penalty */
+    float cw = yolo_nms_max(w->x2[i], w->x2[j]) - yolo_nms_min(w->x1[i], w->x1[j]);
+    float ch = yolo_nms_max(w->y2[i], w->y2[j]) - yolo_nms_min(w->y1[i], w->y1[j]);
+    float c = cw * cw + ch * ch;
+    float iou = inter / uni;
+    if (c == 0.f) return iou > threshold;
+    float dx = 0.5f * ((w->x1[i] + w->x2[i]) - (w->x1[j] + w->x2[j]));
+    float dy = 0.5f * ((w->y1[i] + w->y2[i]) - (w->y1[j] + w->y2[j]));
+    return (iou - powf((dx * dx + dy * dy) / c, diou_beta)) > threshold;
+}
+
+/* Removes the boxes after position i that the kept box i suppresses */
+static inline void yolo_nms_suppress(yolo_nms_work_t *w, uint32_t i, uint32_t m, float threshold, float diou_beta)
+{
+#if YOLO_NMS_MVE
+    const float32x4_t ax1 = vdupq_n_f32(w->x1[i]), ay1 = vdupq_n_f32(w->y1[i]);
+    const float32x4_t ax2 = vdupq_n_f32(w->x2[i]), ay2 = vdupq_n_f32(w->y2[i]);
+    const float32x4_t aarea = vdupq_n_f32(w->area[i]), acls = vdupq_n_f32(w->cls[i]);
+    const float32x4_t zero = vdupq_n_f32(0.f);
+    for (uint32_t j0 = i + 1; j0 < m; j0 += 4) {
+        mve_pred16_t p = vctp32q(m - j0);
+        float32x4_t iw = vsubq_f32(vminnmq_f32(vld1q_z_f32(&w->x2[j0], p), ax2), vmaxnmq_f32(vld1q_z_f32(&w->x1[j0], p), ax1));
+        float32x4_t ih = vsubq_f32(vminnmq_f32(vld1q_z_f32(&w->y2[j0], p), ay2), vmaxnmq_f32(vld1q_z_f32(&w->y1[j0], p), ay1));
+        float32x4_t inter = vmulq_f32(vmaxnmq_f32(iw, zero), vmaxnmq_f32(ih, zero));
+        float32x4_t uni = vsubq_f32(vaddq_f32(aarea, vld1q_z_f32(&w->area[j0], p)), inter);
+        mve_pred16_t hit = vcmpgtq_m_f32(inter, vmulq_n_f32(uni, threshold), p);
+        hit = vcmpeqq_m_f32(vld1q_z_f32(&w->cls[j0], p), acls, hit);
+        if (hit == 0) continue;
+
+        for (uint32_t l = 0; l < 4; l++) {
+            if ((hit & (1u << (4 * l))) == 0) continue;
+            if (diou_beta <= 0.f || yolo_nms_suppresses(w, i, j0 + l, threshold, diou_beta)) w->removed[j0 + l] = 1;
+        }
+    }
+#else
+    for (uint32_t j = i + 1; j < m; j++) {
+        if (!w->removed[j] && yolo_nms_suppresses(w, i, j, threshold, diou_beta)) w->removed[j] = 1;
+    }
+#endif
+}
+
+/**
+ * @brief Greedy NMS over candidate boxes (top-left corner and size).
+ * @param[in] b boxes, n entries per coordinate
+ * @param[in] score candidate scores
+ * @param[in] class_idx class of each candidate for class-aware NMS, NULL for class-agnostic
+ * @param[in] n number of candidates; beyond YOLO_NMS_CAPACITY only the best are considered
+ * @param[in] threshold IoU (or DIoU) above which the lower-scored box is removed
+ * @param[in] diou_beta > 0 for DIoU-NMS with this exponent, 0 for plain IoU
+ * @param[in] max_det length of keep; NMS stops once it is full
+ * @param[in,out] w scratch
+ * @param[out] keep candidate indices of the kept boxes, best score first
+ * @return number of kept boxes
+ */
+static inline uint32_t yolo_nms(const yolo_post_boxes_t *b, const float *score, const uint16_t *class_idx,
+                                uint32_t n, float threshold, float diou_beta, uint32_t max_det,
+                                yolo_nms_work_t *w, uint16_t *keep)
+{
+    uint32_t m = yolo_topk(score, n, YOLO_NMS_CAPACITY, w->order);
+    for (uint32_t i = 0; i < m; i++) {
+        uint16_t o = w->order[i];
+        w->x1[i] = b->x[o];
+        w->y1[i] = b->y[o];
+        w->x2[i] = b->x[o] + b->w[o];
+        w->y2[i] = b->y[o] + b->h[o];
+        w->area[i] = b->w[o] * b->h[o];
+        w->cls[i] = class_idx ? (float)class_idx[o] : 0.f;
+        w->removed[i] = 0;
+    }
+
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < m && kept < max_det; i++) {
+        if (w->removed[i]) continue;
+        keep[kept++] = w->order[i];
+        yolo_nms_suppress(w, i, m, threshold, diou_beta);
+    }
+    return kept;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LIB_YOLO_NMS_H_ */
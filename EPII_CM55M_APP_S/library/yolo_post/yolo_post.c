@@ -0,0 +1,163 @@
+#include <math.h>
+#include <stddef.h>
+#include "yolo_post.h"
+
+#if defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 1)
+#include <arm_mve.h>
+#define YOLO_POST_MVE 1
+#else
+#define YOLO_POST_MVE 0
+#endif
+
+static float yolo_post_sigmoid(float x)
+{
+    return 1.f / (1.f + expf(-x));
+}
+
+static float yolo_post_score(int8_t q, const yolo_post_scores_t *s)
+{
+    float v = yolo_post_dequant(q, s->scale, s->zero_point);
+    return s->sigmoid ? yolo_post_sigmoid(v) : v;
+}
+
+int32_t yolo_post_quant_threshold(float threshold, float scale, int32_t zero_point, uint8_t sigmoid)
+{
+    /* The score is monotonic in q (scale > 0): the first q that passes is the
+     * threshold. Evaluating the exact float expressions keeps the selection
+     * bit-identical to dequantizing everything. */
+    for (int32_t q = INT8_MIN; q <= INT8_MAX; q++) {
+        float v = yolo_post_dequant((int8_t)q, scale, zero_point);
+        if (sigmoid) v = yolo_post_sigmoid(v);
+        if (v >= threshold) return q;
+    }
+    return INT8_MAX + 1;
+}
+
+static void yolo_post_push(yolo_post_cands_t *c, uint32_t anchor, uint32_t cls, int8_t q, const yolo_post_scores_t *s)
+{
+    if (c->count >= c->capacity) {
+        c->dropped++;
+        return;
+    }
+    c->anchor[c->count] = (uint16_t)anchor;
+    c->class_idx[c->count] = (uint16_t)cls;
+    c->score[c->count] = yolo_post_score(q, s);
+    c->count++;
+}
+
+/* Largest value of a contiguous row */
+static int8_t yolo_post_row_max(const int8_t *row, int32_t n)
+{
+#if YOLO_POST_MVE
+    int8_t m = INT8_MIN;
+    while (n > 0) {
+        mve_pred16_t p = vctp8q((uint32_t)n);
+        int8x16_t v = vld1q_z_s8(row, p);
+        m = vmaxvq_p_s8(m, v, p);
+        row += 16;
+        n -= 16;
+    }
+    return m;
+#else
+    int8_t m = INT8_MIN;
+    for (int32_t i = 0; i < n; i++) {
+        if (row[i] > m) m = row[i];
+    }
+    return m;
+#endif
+}
+
+/* [anchors][classes]: one horizontal max per anchor, the index only for survivors */
+static uint32_t yolo_post_select_rows(const yolo_post_scores_t *s, int8_t qthr, uint32_t anchor_base, yolo_post_cands_t *c)
+{
+    uint32_t found = 0;
+    const int8_t *row = s->data;
+    for (int32_t a = 0; a < s->num_anchors; a++, row += s->anchor_stride) {
+        int8_t m = yolo_post_row_max(row, s->num_classes);
+        if (m < qthr) continue;
+
+        int32_t cls = 0;
+        while (row[cls] != m) cls++;
+        yolo_post_push(c, anchor_base + a, cls, m, s);
+        found++;
+    }
+    return found;
+}
+
+/* [classes][anchors]: running max over the class rows, 16 anchors at a time */
+static uint32_t yolo_post_select_columns(const yolo_post_scores_t *s, int8_t qthr, uint32_t anchor_base, yolo_post_cands_t *c)
+{
+    uint32_t found = 0;
+    const int32_t cs = s->class_stride;
+#if YOLO_POST_MVE
+    if (s->num_classes <= 256) {
+        int8_t best_val[16];
+        uint8_t best_cls[16];
+        for (int32_t a0 = 0; a0 < s->num_anchors; a0 += 16) {
+            mve_pred16_t p = vctp8q((uint32_t)(s->num_anchors - a0));
+            const int8_t *col = s->data + a0;
+            int8x16_t best = vld1q_z_s8(col, p);
+            uint8x16_t best_c = vdupq_n_u8(0);
+            for (int32_t k = 1; k < s->num_classes; k++) {
+                int8x16_t v = vld1q_z_s8(col + k * cs, p);
+                mve_pred16_t gt = vcmpgtq_s8(v, best); /* Strictly greater: the first max wins */
+                best = vpselq_s8(v, best, gt);
+                best_c = vpselq_u8(vdupq_n_u8((uint8_t)k), best_c, gt);
+            }
+            mve_pred16_t hit = vcmpgeq_m_n_s8(best, qthr, p);
+            if (hit == 0) continue;
+
+            vst1q_s8(best_val, best);
+            vst1q_u8(best_cls, best_c);
+            for (int32_t l = 0; l < 16; l++) {
+                if (hit & (1u << l)) {
+                    yolo_post_push(c, anchor_base + a0 + l, best_cls[l], best_val[l], s);
+                    found++;
+                }
+            }
+        }
+        return found;
+    }
+#endif
+    for (int32_t a = 0; a < s->num_anchors; a++) {
+        const int8_t *col = s->data + a;
+        int8_t m = col[0];
+        int32_t cls = 0;
+        for (int32_t k = 1; k < s->num_classes; k++) {
+            if (col[k * cs] > m) {
+                m = col[k * cs];
+                cls = k;
+            }
+        }
+        if (m < qthr) continue;
+        yolo_post_push(c, anchor_base + a, cls, m, s);
+        found++;
+    }
+    return found;
+}
+
+uint32_t yolo_post_select(const yolo_post_scores_t *s, float threshold, uint32_t anchor_base, yolo_post_cands_t *c)
+{
+    int32_t qthr = yolo_post_quant_threshold(threshold, s->scale, s->zero_point, s->sigmoid);
+    if (qthr > INT8_MAX || s->num_anchors <= 0 || s->num_classes <= 0) return 0;
+
+    if (s->class_stride == 1) return yolo_post_select_rows(s, (int8_t)qthr, anchor_base, c);
+    return yolo_post_select_columns(s, (int8_t)qthr, anchor_base, c);
+}
+
+void yolo_post_decode_xywh(const int8_t *boxes, int32_t num_anchors, float scale, int32_t zero_point,
+                           float input_w, float input_h, yolo_post_cands_t *c, uint32_t first)
+{
+    for (uint32_t i = first; i < c->count; i++) {
+        int32_t a = c->anchor[i];
+        float cx = yolo_post_dequant(boxes[a], scale, zero_point) * input_w;
+        float cy = yolo_post_dequant(boxes[a + num_anchors], scale, zero_point) * input_h;
+        float w = yolo_post_dequant(boxes[a + 2 * num_anchors], scale, zero_point) * input_w;
+        float h = yolo_post_dequant(boxes[a + 3 * num_anchors], scale, zero_point) * input_h;
+
+        c->box.x[i] = (cx - (0.5 * w));
+        c->box.y[i] = (cy - (0.5 * h));
+        c->box.w[i] = w;
+        c->box.h[i] = h;
+    }
+}
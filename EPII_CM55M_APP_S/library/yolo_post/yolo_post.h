@@ -0,0 +1,108 @@
+#ifndef _LIB_YOLO_POST_H_
+#define _LIB_YOLO_POST_H_
+#include <stdint.h>
+
+/*
+ * Candidate selection for YOLOv8-style detection heads, on the int8 output
+ * tensors as they come from the NPU.
+ *
+ * The class scores are compared in the quantized domain: the per-anchor
+ * argmax and the score threshold work on the int8 values (Helium on the
+ * Cortex-M55, 16 lanes at a time), and only the anchors that pass are
+ * dequantized. Because dequantization (and the sigmoid) is monotonic, the
+ * selected anchors, classes and scores are exactly those of the float
+ * reference loop that dequantizes every score first.
+ *
+ * Results go into caller-provided arrays of fixed capacity (no heap):
+ *
+ *   static uint16_t anchor[64], cls[64];
+ *   static float score[64], x[64], y[64], w[64], h[64];
+ *   yolo_post_cands_t c = { anchor, cls, score, { x, y, w, h }, 64, 0, 0 };
+ *
+ *   yolo_post_scores_t s = { scores, 756, 80, 80, 1, scale, zp, 0 };
+ *   yolo_post_select(&s, 0.25f, 0, &c);               // fills anchor/cls/score
+ *   yolo_post_decode_xywh(boxes, 756, bscale, bzp, 192.f, 192.f, &c, 0);
+ *
+ * A head split over several tensors (one per stride) calls yolo_post_select()
+ * once per tensor with the running anchor offset; candidates accumulate in c.
+ * yolo_nms.h then reduces the candidates to the final detections.
+ */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Boxes as one array per coordinate (SoA): top-left corner and size in model input pixels */
+typedef struct {
+    float *x, *y, *w, *h;
+} yolo_post_boxes_t;
+
+/* Candidates that passed the threshold, in anchor order */
+typedef struct {
+    uint16_t *anchor;           /* anchor index (plus the anchor_base of its tensor) */
+    uint16_t *class_idx;        /* argmax class */
+    float *score;               /* dequantized score (after the sigmoid if requested) */
+    yolo_post_boxes_t box;      /* filled by a decoder or by the caller */
+    uint32_t capacity;          /* length of each array */
+    uint32_t count;             /* candidates stored */
+    uint32_t dropped;           /* candidates past capacity, not stored */
+} yolo_post_cands_t;
+
+/*
+ * int8 class scores of one tensor. Score (anchor a, class c) is at
+ * data[a * anchor_stride + c * class_stride]. Either stride may be 1:
+ * [anchors][classes] heads reduce each row horizontally, [classes][anchors]
+ * heads compare 16 anchors per vector across the class rows.
+ */
+typedef struct {
+    const int8_t *data;
+    int32_t num_anchors;
+    int32_t num_classes;
+    int32_t anchor_stride;
+    int32_t class_stride;
+    float scale;
+    int32_t zero_point;
+    uint8_t sigmoid;            /* 1: scores are logits, thresholded after sigmoid() */
+} yolo_post_scores_t;
+
+/**
+ * @brief Smallest int8 value whose score reaches the threshold.
+ * Computed with the same float expressions as the reference loop
+ * ((q - zp) * scale, then 1 / (1 + expf(-x)) if sigmoid).
+ * @return The int8 threshold, or 128 if no int8 value reaches it.
+ */
+int32_t yolo_post_quant_threshold(float threshold, float scale, int32_t zero_point, uint8_t sigmoid);
+
+/**
+ * @brief Appends the anchors whose best class score reaches the threshold.
+ * Ties go to the lowest class index.
+ * @param[in] s class scores of one tensor
+ * @param[in] threshold score threshold (probability if s->sigmoid)
+ * @param[in] anchor_base added to the stored anchor index
+ * @param[in,out] c candidate arrays; count and dropped are advanced
+ * @return number of candidates found in this tensor (stored or dropped)
+ */
+uint32_t yolo_post_select(const yolo_post_scores_t *s, float threshold, uint32_t anchor_base, yolo_post_cands_t *c);
+
+/**
+ * @brief Decodes boxes of candidates first..count-1 from a [4][num_anchors]
+ * int8 tensor of normalized centre x, y, width, height (YOLOv8 with the
+ * box decoding inside the model), scaled to input_w x input_h pixels.
+ */
+void yolo_post_decode_xywh(const int8_t *boxes, int32_t num_anchors, float scale, int32_t zero_point,
+                           float input_w, float input_h, yolo_post_cands_t *c, uint32_t first);
+
+/**
+ * @brief Dequantizes one int8 value the way the reference loops do.
+ */
+static inline float yolo_post_dequant(int8_t q, float scale, int32_t zero_point)
+{
+    return ((float)q - (float)zero_point) * scale;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LIB_YOLO_POST_H_ */
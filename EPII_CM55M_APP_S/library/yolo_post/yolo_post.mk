@@ -0,0 +1,61 @@
+# directory declaration
+LIB_YOLO_POST_DIR = $(LIBRARIES_ROOT)/yolo_post
+
+LIB_YOLO_POST_ASMSRCDIR	= $(LIB_YOLO_POST_DIR) 
+LIB_YOLO_POST_CSRCDIR	= $(LIB_YOLO_POST_DIR) 
+LIB_YOLO_POST_INCDIR	= $(LIB_YOLO_POST_DIR) 
+
+# find all the source files in the target directories
+LIB_YOLO_POST_CSRCS = $(call get_csrcs, $(LIB_YOLO_POST_CSRCDIR))
+LIB_YOLO_POST_ASMSRCS = $(call get_asmsrcs, $(LIB_YOLO_POST_ASMSRCDIR))
+
+# get object files
+LIB_YOLO_POST_COBJS = $(call get_relobjs, $(LIB_YOLO_POST_CSRCS))
+LIB_YOLO_POST_ASMOBJS = $(call get_relobjs, $(LIB_YOLO_POST_ASMSRCS))
+LIB_YOLO_POST_OBJS = $(LIB_YOLO_POST_COBJS) $(LIB_YOLO_POST_ASMOBJS)
+
+# get dependency files
+LIB_YOLO_POST_DEPS = $(call get_deps, $(LIB_YOLO_POST_OBJS))
+
+# extra macros to be defined
+LIB_YOLO_POST_DEFINES = -DLIB_YOLO_POST
+
+# genearte library
+ifeq ($(YOLO_POST_LIB_FORCE_PREBUILT), y)
+override LIB_YOLO_POST_OBJS:=
+endif
+YOLO_POST_LIB_NAME = libyolo_post.a
+LIB_YOLO_POST := $(subst /,$(PS), $(strip $(OUT_DIR)/$(YOLO_POST_LIB_NAME)))
+
+# library generation rule
+$(LIB_YOLO_POST): $(LIB_YOLO_POST_OBJS)
+	$(TRACE_ARCHIVE)
+ifeq "$(strip $(LIB_YOLO_POST_OBJS))" ""
+	$(CP) $(PREBUILT_LIB)$(YOLO_POST_LIB_NAME) $(LIB_YOLO_POST)
+else
+	$(Q)$(AR) $(AR_OPT) $@ $(LIB_YOLO_POST_OBJS)
+	$(CP) $(LIB_YOLO_POST) $(PREBUILT_LIB)$(YOLO_POST_LIB_NAME)
+endif
+
+# specific compile rules
+# user can add rules to compile this middleware
+# if not rules specified to this middleware, it will use default compiling rules
+
+# Middleware Definitions
+LIB_INCDIR += $(LIB_YOLO_POST_INCDIR)
+LIB_CSRCDIR += $(LIB_YOLO_POST_CSRCDIR)
+LIB_ASMSRCDIR += $(LIB_YOLO_POST_ASMSRCDIR)
+
+LIB_CSRCS += $(LIB_YOLO_POST_CSRCS)
+LIB_CXXSRCS +=
+LIB_ASMSRCS += $(LIB_YOLO_POST_ASMSRCS)
+LIB_ALLSRCS += $(LIB_YOLO_POST_CSRCS) $(LIB_YOLO_POST_ASMSRCS)
+
+LIB_COBJS += $(LIB_YOLO_POST_COBJS)
+LIB_CXXOBJS +=
+LIB_ASMOBJS += $(LIB_YOLO_POST_ASMOBJS)
+LIB_ALLOBJS += $(LIB_YOLO_POST_OBJS)
+
+LIB_DEFINES += $(LIB_YOLO_POST_DEFINES)
+LIB_DEPS += $(LIB_YOLO_POST_DEPS)
+LIB_LIBS += $(LIB_YOLO_POST)
@@ -73,8 +73,12 @@
 /* Memory allocation related definitions. */
 #define configSUPPORT_STATIC_ALLOCATION         1
 #define configSUPPORT_DYNAMIC_ALLOCATION        1
+#ifndef configTOTAL_HEAP_SIZE
 #define configTOTAL_HEAP_SIZE                   ((size_t)(50 * 1024))//jacky//((size_t)(10 * 1024))
+#endif
+#ifndef configAPPLICATION_ALLOCATED_HEAP
 #define configAPPLICATION_ALLOCATED_HEAP        0
+#endif
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK                     0
@@ -174,4 +178,9 @@ standard names. */
 #define vPortPendSVHandler PendSV_Handler
 #define vPortSysTickHandler SysTick_Handler
 
+/* csp4cmsis per-process run-time statistics (opt-in with -DCSP4CMSIS_STATS=1). */
+#if defined(CSP4CMSIS_STATS) && (CSP4CMSIS_STATS == 1)
+#include "csp_trace_hooks.h"
+#endif
+
 #endif /* FREERTOS_CONFIG_H */